@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/culling_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+
+using Clock = std::chrono::steady_clock;
+
+// A grid of ~100k boxes, seen by clusters of cameras (e.g. the sensors of a
+// robot), each camera looking at a small part of the grid
+constexpr int GRID_HALF_SIZE = 158;
+constexpr float GRID_SPACING = 2.0F;
+constexpr size_t MAX_CAMERAS = 16;
+constexpr size_t NUM_ITERATIONS = 100;
+
+auto CreateUnitCube() -> ::renderer::Geometry::ptr {
+    std::vector<float> positions;
+    for (uint32_t i = 0; i < 8; ++i) {
+        positions.push_back((i & 1) != 0 ? 0.5F : -0.5F);
+        positions.push_back((i & 2) != 0 ? 0.5F : -0.5F);
+        positions.push_back((i & 4) != 0 ? 0.5F : -0.5F);
+    }
+    std::vector<float> normals(positions.size(), 0.0F);
+    std::vector<float> texcoords(16, 0.0F);
+    return std::make_shared<::renderer::Geometry>(
+        8, positions.data(), normals.data(), texcoords.data());
+}
+
+template <typename Func>
+auto TimeIt(Func&& func) -> double {
+    const auto START = Clock::now();
+    for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        func();
+    }
+    const auto END = Clock::now();
+    return std::chrono::duration<double, std::milli>(END - START).count() /
+           static_cast<double>(NUM_ITERATIONS);
+}
+
+auto main() -> int {
+    auto geometry = CreateUnitCube();
+    auto scene = std::make_shared<::renderer::Scene>();
+    for (int i = -GRID_HALF_SIZE; i <= GRID_HALF_SIZE; ++i) {
+        for (int j = -GRID_HALF_SIZE; j <= GRID_HALF_SIZE; ++j) {
+            scene->CreateObject<::renderer::Mesh>(
+                ("box_" + std::to_string(i) + "_" + std::to_string(j)).c_str(),
+                geometry,
+                Pose(Vec3(GRID_SPACING * static_cast<float>(i),
+                          GRID_SPACING * static_cast<float>(j), 0.0F),
+                     Quat()));
+        }
+    }
+    scene->UpdateWorldTransforms();
+
+    std::vector<::renderer::Camera::ptr> cameras;
+    for (size_t i = 0; i < MAX_CAMERAS; ++i) {
+        auto camera = std::make_shared<::renderer::Camera>(
+            ("camera_" + std::to_string(i)).c_str());
+        const auto ANGLE = 2.0F * PI * static_cast<float>(i) / MAX_CAMERAS;
+        camera->SetPosition(
+            Vec3(5.0F * std::cos(ANGLE), 5.0F * std::sin(ANGLE), 2.0F));
+        camera->LookAt(Vec3(0.0F, 0.0F, 0.0F));
+        camera->data.far = 50.0F;
+        cameras.push_back(camera);
+    }
+
+    std::printf("Culling benchmark: %zu objects, %zu iterations\n",
+                scene->bvh().num_objects(), NUM_ITERATIONS);
+    std::printf("%-10s %-16s %-16s %-14s\n", "cameras", "separate (ms)",
+                "multi-view (ms)", "nodes visited");
+
+    const auto& bounds = scene->bounds_array();
+    std::vector<uint8_t> visible(bounds.size());
+    ::renderer::MultiViewVisibility visibility;
+    for (size_t num_cameras = 1; num_cameras <= MAX_CAMERAS;
+         num_cameras *= 2) {
+        std::vector<::renderer::Camera::ptr> views(
+            cameras.begin(), cameras.begin() + num_cameras);
+        const auto SEPARATE_MS = TimeIt([&]() {
+            for (const auto& camera : views) {
+                ::renderer::CullBounds(camera->ComputeCullingParams(), bounds,
+                                       visible.data());
+            }
+        });
+        const auto MULTI_MS =
+            TimeIt([&]() { scene->CullCameras(views, 0.0F, visibility); });
+        std::printf("%-10zu %-16.3f %-16.3f %-14zu\n", num_cameras,
+                    SEPARATE_MS, MULTI_MS, visibility.num_nodes_visited);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <renderer/engine/object_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+using Clock = std::chrono::steady_clock;
+
+// Layout of the synthetic scene: many independent bodies, each one a tree
+// with a few levels of branching, for a total of ~100k nodes
+constexpr size_t NUM_BODIES = 100;
+constexpr size_t BRANCHING = 10;
+constexpr size_t DEPTH = 3;  // 1 + 10 + 100 + 1000 = 1111 nodes per body
+
+constexpr size_t NUM_ITERATIONS = 50;
+constexpr float PARTIAL_DIRTY_RATIO = 0.01F;
+
+auto BuildTree(const std::string& prefix, size_t depth,
+               std::vector<::renderer::Object3D::ptr>& nodes)
+    -> ::renderer::Object3D::ptr {
+    auto node = std::make_shared<::renderer::Object3D>(
+        prefix.c_str(), Vec3(0.1F, 0.0F, 0.0F));
+    nodes.push_back(node);
+    if (depth > 0) {
+        for (size_t i = 0; i < BRANCHING; ++i) {
+            node->AddChild(BuildTree(prefix + "_" + std::to_string(i),
+                                     depth - 1, nodes));
+        }
+    }
+    return node;
+}
+
+template <typename Func>
+auto TimeIt(Func&& func) -> double {
+    const auto START = Clock::now();
+    func();
+    const auto END = Clock::now();
+    return std::chrono::duration<double, std::milli>(END - START).count();
+}
+
+auto main() -> int {
+    auto scene = std::make_shared<::renderer::Scene>();
+    std::vector<::renderer::Object3D::ptr> nodes;
+    for (size_t i = 0; i < NUM_BODIES; ++i) {
+        scene->AddChild(BuildTree("body_" + std::to_string(i), DEPTH, nodes));
+    }
+
+    std::mt19937 rng(0);  // NOLINT
+    std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+    const auto NUM_PARTIAL =
+        static_cast<size_t>(PARTIAL_DIRTY_RATIO * nodes.size());
+
+    auto mark_all = [&]() { scene->MarkTransformDirty(); };
+    auto mark_partial = [&]() {
+        for (size_t i = 0; i < NUM_PARTIAL; ++i) {
+            nodes[pick(rng)]->MarkTransformDirty();
+        }
+    };
+
+    std::printf("Transform update benchmark: %zu nodes, %zu iterations\n",
+                nodes.size(), NUM_ITERATIONS);
+    std::printf("%-10s %-14s %-14s %-14s\n", "threads", "full (ms)",
+                "partial (ms)", "speedup");
+
+    double full_serial_ms = 0.0;
+    const size_t MAX_THREADS =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t num_threads = 1; num_threads <= MAX_THREADS;
+         num_threads *= 2) {
+        ::renderer::ThreadPool pool(num_threads - 1);
+        double full_ms = 0.0;
+        double partial_ms = 0.0;
+        for (size_t iter = 0; iter < NUM_ITERATIONS; ++iter) {
+            mark_all();
+            full_ms += TimeIt([&]() {
+                if (num_threads == 1) {
+                    scene->UpdateWorldTransforms();
+                } else {
+                    scene->UpdateWorldTransforms(pool);
+                }
+            });
+            mark_partial();
+            partial_ms += TimeIt([&]() {
+                if (num_threads == 1) {
+                    scene->UpdateWorldTransforms();
+                } else {
+                    scene->UpdateWorldTransforms(pool);
+                }
+            });
+        }
+        full_ms /= static_cast<double>(NUM_ITERATIONS);
+        partial_ms /= static_cast<double>(NUM_ITERATIONS);
+        if (num_threads == 1) {
+            full_serial_ms = full_ms;
+        }
+        std::printf("%-10zu %-14.3f %-14.3f %-14.2f\n", num_threads, full_ms,
+                    partial_ms, full_serial_ms / full_ms);
+    }
+
+    return 0;
+}
@@ -47,6 +47,7 @@ mark_as_advanced(RENDERER_DEP_VERSION_pybind11)
 
 # -------------------------------------
 find_package(OpenGL REQUIRED)
+find_package(Threads REQUIRED)
 
 if(OpenGL_EGL_FOUND)
   target_link_libraries(OpenGL::OpenGL INTERFACE OpenGL::EGL)
@@ -9,6 +9,7 @@
 
 #include <renderer/engine/graphics/window_t.hpp>
 #include <renderer/backend/graphics/opengl/resources_manager_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_buffer_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_array_opengl_t.hpp>
 #include <renderer/engine/camera_t.hpp>
@@ -118,7 +119,7 @@ auto main() -> int {
 
     constexpr float FRUSTUM_SIZE = 20.0F;
     auto camera = std::make_shared<::renderer::Camera>("main_camera");
-    camera->pose.position = {0.0F, -3.0F, 0.0F};
+    camera->SetPosition({0.0F, -3.0F, 0.0F});
     camera->target = {0.0F, 0.0F, 0.0F};
     camera->data.projection = ::renderer::eProjectionType::PERSPECTIVE;
 
@@ -135,7 +136,8 @@ auto main() -> int {
         g_window_height = height;
         g_window_aspect = static_cast<float>(g_window_width) /
                           static_cast<float>(g_window_height);
-        glViewport(0, 0, width, height);
+        ::renderer::opengl::OpenGLStateCache::Current().SetViewport(
+            0, 0, width, height);
         camera->data.aspect = g_window_aspect;
         camera->data.width = FRUSTUM_SIZE * g_window_aspect;
         camera->data.height = FRUSTUM_SIZE;
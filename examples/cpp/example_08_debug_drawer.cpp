@@ -8,6 +8,7 @@
 #include <renderer/engine/orbit_camera_controller_t.hpp>
 #include <renderer/engine/graphics/window_t.hpp>
 #include <renderer/backend/graphics/opengl/debug_drawer_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 
 #if defined(RENDERER_IMGUI)
 #include <imgui.h>
@@ -33,7 +34,7 @@ auto main() -> int {
 
     constexpr float FRUSTUM_SIZE = 20.0F;
     auto camera = std::make_shared<::renderer::Camera>("main_camera");
-    camera->pose.position = {0.0F, -3.0F, 0.0F};
+    camera->SetPosition({0.0F, -3.0F, 0.0F});
     camera->target = {0.0F, 0.0F, 0.0F};
     camera->data.projection = ::renderer::eProjectionType::PERSPECTIVE;
 
@@ -44,7 +45,8 @@ auto main() -> int {
 
     window->RegisterResizeCallback([&](int width, int height) {
         auto aspect = static_cast<float>(width) / static_cast<float>(height);
-        glViewport(0, 0, width, height);
+        ::renderer::opengl::OpenGLStateCache::Current().SetViewport(
+            0, 0, width, height);
         camera->data.aspect = aspect;
         camera->data.width = FRUSTUM_SIZE * aspect;
         camera->data.height = FRUSTUM_SIZE;
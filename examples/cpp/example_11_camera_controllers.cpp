@@ -12,6 +12,7 @@
 #include <renderer/geometry/geometry_t.hpp>
 #include <renderer/geometry/geometry_factory.hpp>
 #include <renderer/light/light_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 
 #include <utils/logging.hpp>
 #include <utils/timing.hpp>
@@ -73,7 +74,8 @@ auto main() -> int {
         g_window_height = height;
         auto window_aspect =
             static_cast<float>(width) / static_cast<float>(height);
-        glViewport(0, 0, width, height);
+        ::renderer::opengl::OpenGLStateCache::Current().SetViewport(
+            0, 0, width, height);
         // Update the camera projection accordingly
         auto data = camera->proj_data();
         data.aspect = window_aspect;
@@ -5,13 +5,16 @@
 
 #include <renderer/common.hpp>
 #include <renderer/engine/camera_t.hpp>
+#include <renderer/backend/graphics/opengl/frame_uniforms_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/program_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/streaming_buffer_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_array_opengl_t.hpp>
 
 namespace renderer {
 namespace opengl {
 
-/// Number of lines that can be drawn per batch
+/// Number of lines each frame of the lines stream has room for initially (it
+/// grows to fit all lines requested in a frame, which get drawn at once)
 static constexpr uint32_t LINES_BATCH_SIZE = 1024;
 /// Number of vertex positions stored per line
 static constexpr uint32_t POSITIONS_PER_LINE = 2;
@@ -20,7 +23,8 @@ static constexpr uint32_t COLORS_PER_LINE = 2;
 /// Number of floats per vertex in each line
 static constexpr uint32_t FLOATS_PER_LINE =
     3 * (POSITIONS_PER_LINE + COLORS_PER_LINE);
-/// The size of the VBO (in bytes) used to store both positions and colors
+/// The initial size (in bytes) of each frame of the stream used to store both
+/// positions and colors
 static constexpr uint32_t LINES_VBO_SIZE =
     sizeof(Vec3) * (POSITIONS_PER_LINE + COLORS_PER_LINE) * LINES_BATCH_SIZE;
 
@@ -69,10 +73,15 @@ class RENDERER_API OpenGLDebugDrawer {
     auto DrawCylinder(float radius, float height, Pose pose,
                       Vec3 color) -> void;
 
-    /// Renders all primitives from the given viewpoint
+    /// Renders all primitives from the given viewpoint, uploading the camera
+    /// into a per-frame uniform block owned by this drawer
     /// \param[in] camera The camera used to render from
     auto Render(const Camera& camera) -> void;
 
+    /// Renders all primitives using the per-frame uniform block currently
+    /// attached to its binding point (e.g. the one uploaded by the renderer)
+    auto Render() -> void;
+
     /// Resets all running counters. Call after the user reads the data
     auto ClearCounters() -> void;
 
@@ -86,16 +95,15 @@ class RENDERER_API OpenGLDebugDrawer {
         return m_NumLinesDrawn;
     }
 
+    /// Returns the number of bytes of vertices uploaded during the render
+    /// process
+    RENDERER_NODISCARD auto num_bytes_uploaded() const -> size_t {
+        return m_NumBytesUploaded;
+    }
+
     /// Returns a string representation of this debug drawer
     RENDERER_NODISCARD auto ToString() const -> std::string;
 
- protected:
-    /// Renders a single batch of lines into the current render target
-    /// \param[in] lines_number The number of lines to draw in this batch
-    /// \param[in] lines_data A pointer to the vertex data of this batch
-    auto _RenderBatchOfLines(size_t lines_number,
-                             const float32_t* lines_data) -> void;
-
  protected:
     /// Owned reference to the main shader used for debug drawing lines
     OpenGLProgram::uptr m_LinesProgram{nullptr};
@@ -103,6 +111,15 @@ class RENDERER_API OpenGLDebugDrawer {
     /// VAO used to handle all lines drawing
     OpenGLVertexArray::uptr m_LinesVAO{nullptr};
 
+    /// Layout of the vertices of the lines (position and color)
+    OpenGLBufferLayout m_LinesLayout{};
+
+    /// Ring buffer the vertices of the lines of each frame are written into
+    OpenGLStreamingBuffer::uptr m_LinesStream{nullptr};
+
+    /// Per-frame uniform block, used when rendering from a given camera
+    OpenGLFrameUniforms::uptr m_FrameUniforms{nullptr};
+
     /// Container for all lines being requested by the user
     std::vector<Line> m_LinesContainer;
 
@@ -111,6 +128,9 @@ class RENDERER_API OpenGLDebugDrawer {
 
     /// Counter for the number of draw calls spent by this object
     size_t m_NumDrawCalls{0};
+
+    /// Counter for the number of bytes of vertices uploaded by this object
+    size_t m_NumBytesUploaded{0};
 };
 
 }  // namespace opengl
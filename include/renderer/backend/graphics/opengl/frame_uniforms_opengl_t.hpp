@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/light_t.hpp>
+#include <renderer/engine/graphics/std140_writer_t.hpp>
+#include <renderer/backend/graphics/opengl/uniform_buffer_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Binding point of the per-frame uniform block, shared by all programs
+static constexpr uint32_t FRAME_UNIFORMS_BINDING = 0;
+
+/// Name of the per-frame uniform block in the shaders
+static constexpr const char* FRAME_UNIFORMS_BLOCK = "FrameUniforms";
+
+/// Maximum number of lights in the per-frame uniform block
+static constexpr uint32_t MAX_FRAME_LIGHTS = 8;
+
+/// Returns the given shader source (without its #version line) preceded by
+/// the version and the declaration of the per-frame uniform block
+RENDERER_API auto WithFrameUniforms(const char* shader_src) -> std::string;
+
+/// Per-frame uniform block (view, projection, camera position and lights),
+/// uploaded once per frame (or per camera) and shared by all programs through
+/// the FRAME_UNIFORMS_BINDING binding point
+class RENDERER_API OpenGLFrameUniforms {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLFrameUniforms)
+
+    DEFINE_SMART_POINTERS(OpenGLFrameUniforms)
+
+ public:
+    /// Creates the uniform buffer of the block
+    OpenGLFrameUniforms();
+
+    /// Releases the resources of the block
+    ~OpenGLFrameUniforms() = default;
+
+    /// Packs the uniforms for the given camera and lights, uploads them and
+    /// attaches the buffer to its binding point. Only the first
+    /// MAX_FRAME_LIGHTS lights are used
+    auto Update(const Camera& camera, const std::vector<Light::ptr>& lights)
+        -> void;
+
+    /// Attaches the buffer of the block to its binding point
+    auto Bind() const -> void;
+
+    /// Returns the number of lights uploaded by the last update
+    RENDERER_NODISCARD auto num_lights() const -> uint32_t {
+        return m_NumLights;
+    }
+
+    /// Returns the uniform buffer of the block
+    RENDERER_NODISCARD auto buffer() const -> const OpenGLUniformBuffer& {
+        return *m_Buffer;
+    }
+
+    /// Returns a string representation of this block
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Writer used to pack the block in the std140 layout
+    Std140Writer m_Writer;
+
+    /// Buffer the block is uploaded into
+    OpenGLUniformBuffer::uptr m_Buffer{nullptr};
+
+    /// Number of lights uploaded by the last update
+    uint32_t m_NumLights{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/lod_t.hpp>
+#include <renderer/backend/graphics/opengl/mesh_pool_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/program_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Number of objects tested by each work group of the culling shader
+static constexpr uint32_t GPU_CULLING_GROUP_SIZE = 64;
+
+/// Number of floats per instance written by the culling shader: the model
+/// matrix (column-major) followed by the tint of the mesh
+static constexpr uint32_t FLOATS_PER_CULLED_INSTANCE = 16 + 3;
+
+/// Texture unit the depth textures of the culling shaders get bound to
+static constexpr uint32_t GPU_CULLING_TEXTURE_UNIT = 1;
+
+/// Flag of the objects to be drawn at all (see OpenGLCullObject::flags)
+static constexpr uint32_t GPU_CULLING_FLAG_VISIBLE = 1U << 0;
+
+/// First bit of the number of levels of detail of an object, in its flags
+static constexpr uint32_t GPU_CULLING_LODS_SHIFT = 8;
+
+/// Largest number of levels of detail of an object
+static constexpr uint32_t GPU_CULLING_MAX_LODS = 255;
+
+/// Object tested by the culling shader. The layout matches the one of its
+/// storage block (std430), hence the padding
+struct RENDERER_API OpenGLCullObject {
+    /// World transform of the mesh (column-major)
+    std::array<float32_t, 16> model{};
+    /// Tint of the mesh
+    std::array<float32_t, 3> color{};
+    /// State of the mesh: GPU_CULLING_FLAG_VISIBLE, and the number of levels
+    /// of detail of the mesh from bit GPU_CULLING_LODS_SHIFT on (0 means 1)
+    uint32_t flags{GPU_CULLING_FLAG_VISIBLE};
+    /// Center of the world bounds of the mesh
+    std::array<float32_t, 3> center{};
+    /// Index of the draw command the mesh is an instance of. With levels of
+    /// detail, the one of the full level, followed by the coarser ones
+    uint32_t command{0};
+    /// Half-sizes of the world bounds of the mesh
+    std::array<float32_t, 3> extent{};
+    /// Layers the mesh belongs to, tested against the mask of the camera
+    uint32_t layers{~0U};
+};
+
+/// GPU-driven culling of the instances of a set of indirect draw commands.
+///
+/// The objects (transform, tint and bounds) live on the GPU, and only the ones
+/// that change get uploaded again. Each frame, a compute shader tests every
+/// object against the frustum and against a depth pyramid (Hi-Z) built from
+/// the depth buffer of the previous frame. The survivors select their level of
+/// detail (as SelectLod does, keeping their levels on the GPU), then get
+/// compacted into the instance buffer, right after the base instance of the
+/// command of that level. The instance counts of the commands are written on
+/// the GPU as well, such that the draws are submitted without reading anything
+/// back.
+///
+/// Objects hidden in the previous frame are culled even if the camera moved
+/// since, so objects that come into view from behind an occluder show up a
+/// frame late. Requires OpenGL 4.3 (compute shaders and multi-draw indirect)
+class RENDERER_API OpenGLGpuCuller {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLGpuCuller)
+
+    DEFINE_SMART_POINTERS(OpenGLGpuCuller)
+
+ public:
+    /// Creates the compute programs and the buffers of the culler
+    OpenGLGpuCuller();
+
+    /// Releases the GPU resources of the culler
+    ~OpenGLGpuCuller();
+
+    /// Replaces the objects and the draw commands. The instance counts of
+    /// the commands are ignored, and their base instances must leave room for
+    /// all the objects that can reference them. The objects start from their
+    /// full levels of detail
+    /// \param[in] objects The objects to be culled every frame
+    /// \param[in] commands The draw commands the objects are instances of
+    /// \param[in] lod_errors The geometric error of the level of detail drawn
+    ///                       by each command (0 for the full levels)
+    /// \param[in] num_instances The number of instances the base instances
+    ///                          of the commands leave room for
+    auto SetObjects(const std::vector<OpenGLCullObject>& objects,
+                    const std::vector<DrawElementsIndirectCommand>& commands,
+                    const std::vector<float32_t>& lod_errors,
+                    uint32_t num_instances) -> void;
+
+    /// Overwrites a range of the objects set last
+    /// \param[in] first The index of the first object to overwrite
+    /// \param[in] count The number of objects to overwrite
+    /// \param[in] objects The new data of the objects in the range
+    auto UpdateObjects(uint32_t first, uint32_t count,
+                       const OpenGLCullObject* objects) -> void;
+
+    /// Sets the view and settings the levels of detail get selected with by
+    /// the next calls to Cull
+    /// \param[in] view The view the objects are drawn from
+    /// \param[in] settings The settings of the selection
+    auto SetLodView(const LodView& view, const LodSettings& settings) -> void {
+        m_LodView = view;
+        m_LodSettings = settings;
+    }
+
+    /// Culls the objects against the given view, writing the instances and
+    /// the instance counts of the commands for the draws of this frame.
+    /// Hidden objects, and objects in none of the layers of the mask, are
+    /// culled as well
+    /// \param[in] view_proj The product of the projection and view matrices
+    /// \param[in] reverse_z Whether the projection uses a reversed depth range
+    /// \param[in] culling_mask The layers seen from the view
+    auto Cull(const Mat4& view_proj, bool reverse_z,
+              uint32_t culling_mask = ~0U) -> void;
+
+    /// Builds the depth pyramid from the depth buffer of the default
+    /// framebuffer, to cull the objects of the next frame. Call it once the
+    /// occluders of the frame (e.g. the opaque meshes) have been drawn
+    /// \param[in] width The width of the viewport (in pixels)
+    /// \param[in] height The height of the viewport (in pixels)
+    auto UpdateHiZ(int32_t width, int32_t height) -> void;
+
+    /// Drops the depth pyramid (e.g. after a camera cut), such that the next
+    /// frame is only culled against the frustum
+    auto ResetHiZ() -> void { m_HiZValid = false; }
+
+    /// Submits a range of the culled commands in a single multi-draw call.
+    /// The vertex array of the mesh pool must be bound, with its per-instance
+    /// attributes pointed to the instance buffer
+    auto MultiDraw(size_t first, size_t count) const -> void;
+
+    /// Returns whether or not the current context supports GPU culling
+    static auto IsSupported() -> bool;
+
+    /// Returns the id of the buffer the culled instances are written into,
+    /// packed as the per-instance attributes of the mesh programs
+    RENDERER_NODISCARD auto instance_buffer() const -> uint32_t {
+        return m_InstanceBuffer;
+    }
+
+    /// Returns the id of the buffer with the draw commands written by the
+    /// last call to Cull
+    RENDERER_NODISCARD auto command_buffer() const -> uint32_t {
+        return m_CommandBuffer;
+    }
+
+    /// Returns the number of objects tested every frame
+    RENDERER_NODISCARD auto num_objects() const -> uint32_t {
+        return m_NumObjects;
+    }
+
+    /// Returns the number of draw commands written every frame
+    RENDERER_NODISCARD auto num_commands() const -> uint32_t {
+        return m_NumCommands;
+    }
+
+    /// Returns whether or not the objects get tested against a depth pyramid
+    RENDERER_NODISCARD auto hiz_valid() const -> bool { return m_HiZValid; }
+
+    /// Returns a string representation of this culler
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// (Re)creates the depth textures for a viewport of the given size
+    auto _CreateHiZ(int32_t width, int32_t height) -> void;
+
+    /// Releases the depth textures
+    auto _ReleaseHiZ() -> void;
+
+ private:
+    /// Program that tests the objects and writes the surviving instances
+    OpenGLProgram::uptr m_CullProgram{nullptr};
+
+    /// Program that builds each level of the depth pyramid from the previous
+    OpenGLProgram::uptr m_ReduceProgram{nullptr};
+
+    /// Buffer with the objects to be culled
+    uint32_t m_ObjectBuffer{0};
+
+    /// Buffer with the draw commands, written by the culling shader and read
+    /// by the indirect draws
+    uint32_t m_CommandBuffer{0};
+
+    /// Buffer with the draw commands as set, with zero instances, copied into
+    /// the command buffer at the start of every frame
+    uint32_t m_CommandTemplateBuffer{0};
+
+    /// Buffer the surviving instances get written into
+    uint32_t m_InstanceBuffer{0};
+
+    /// Buffer with the geometric error of the level drawn by each command
+    uint32_t m_LodErrorBuffer{0};
+
+    /// Buffer with the level of detail each object was drawn with last
+    uint32_t m_LevelBuffer{0};
+
+    /// Sizes (in bytes) of the storage of the buffers above
+    uint32_t m_ObjectBufferSize{0};
+    uint32_t m_CommandBufferSize{0};
+    uint32_t m_CommandTemplateBufferSize{0};
+    uint32_t m_InstanceBufferSize{0};
+    uint32_t m_LodErrorBufferSize{0};
+    uint32_t m_LevelBufferSize{0};
+
+    /// Number of objects and commands set last
+    uint32_t m_NumObjects{0};
+    uint32_t m_NumCommands{0};
+
+    /// Copy of the depth buffer of the last frame
+    uint32_t m_DepthTexture{0};
+
+    /// Depth pyramid, whose level i holds the farthest depth of each block of
+    /// 2^(i+1) x 2^(i+1) pixels of the depth buffer
+    uint32_t m_HiZTexture{0};
+
+    /// Size of the viewport the depth textures were created for
+    int32_t m_HiZWidth{0};
+    int32_t m_HiZHeight{0};
+
+    /// Number of levels of the depth pyramid
+    int32_t m_HiZLevels{0};
+
+    /// Whether or not the depth pyramid holds the depth of the last frame
+    bool m_HiZValid{false};
+
+    /// View the depth pyramid was rendered from
+    Mat4 m_HiZViewProj;
+
+    /// Depth conventions of the view the depth pyramid was rendered from
+    bool m_HiZReverseZ{false};
+    bool m_HiZZeroToOne{false};
+
+    /// View of the current frame, given to the last call to Cull
+    Mat4 m_ViewProj;
+
+    /// Whether the view of the current frame uses a reversed depth range
+    bool m_ReverseZ{false};
+
+    /// View the levels of detail get selected for
+    LodView m_LodView{};
+
+    /// Settings of the selection of the levels of detail
+    LodSettings m_LodSettings{};
+};
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Number of sets of queries in flight. The queries of a frame are read back
+/// when their set gets reused, this many frames later
+static constexpr uint32_t GPU_TIMER_LATENCY = 2;
+
+/// Times passes of a frame on the GPU with GL_TIME_ELAPSED queries.
+///
+/// Each frame issues its queries from its own set, and the results of a set
+/// are only collected once they are available (when the set is about to be
+/// reused), so reading them back never stalls the pipeline. Results that
+/// aren't ready by then are dropped instead of waited for. Timed passes can't
+/// overlap, as only one GL_TIME_ELAPSED query can be active at a time
+class RENDERER_API OpenGLGpuTimer {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLGpuTimer)
+
+    DEFINE_SMART_POINTERS(OpenGLGpuTimer)
+
+ public:
+    /// Creates the queries to time the given number of passes per frame
+    explicit OpenGLGpuTimer(uint32_t num_passes);
+
+    /// Releases the queries of the timer
+    ~OpenGLGpuTimer();
+
+    /// Starts a new frame, collecting the results of the frame that last used
+    /// the set of queries this one is about to use (if they're available)
+    auto BeginFrame(uint64_t frame_index) -> void;
+
+    /// Starts timing the given pass of the current frame
+    auto Begin(uint32_t pass) -> void;
+
+    /// Stops timing the pass that's being timed
+    auto End() -> void;
+
+    /// Returns the time (in milliseconds) spent on the given pass in the frame
+    /// given by result_frame (0 if the pass wasn't timed in that frame)
+    RENDERER_NODISCARD auto elapsed_ms(uint32_t pass) const -> float;
+
+    /// Returns the index of the frame the collected results belong to (0 if
+    /// no results have been collected yet)
+    RENDERER_NODISCARD auto result_frame() const -> uint64_t {
+        return m_ResultFrame;
+    }
+
+    /// Returns the number of passes timed per frame
+    RENDERER_NODISCARD auto num_passes() const -> uint32_t {
+        return m_NumPasses;
+    }
+
+    /// Returns the number of frames whose results weren't ready in time
+    RENDERER_NODISCARD auto num_dropped() const -> size_t {
+        return m_NumDropped;
+    }
+
+    /// Returns a string representation of this timer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Collects the results of the current set, if all of them are available
+    auto _CollectResults() -> void;
+
+ private:
+    /// Number of passes timed per frame
+    uint32_t m_NumPasses{0};
+
+    /// Queries of all sets (set-major, one per pass)
+    std::vector<uint32_t> m_Queries;
+
+    /// Whether or not each query was issued since its set was last collected
+    std::vector<uint8_t> m_Issued;
+
+    /// Index of the frame that's using each set
+    std::vector<uint64_t> m_SetFrames;
+
+    /// Time (in milliseconds) spent on each pass, from the last results
+    std::vector<float> m_ElapsedMs;
+
+    /// Set of queries used by the current frame
+    uint32_t m_Set{0};
+
+    /// Pass being timed, if any
+    uint32_t m_ActivePass{0};
+
+    /// Whether or not a pass is being timed
+    bool m_Active{false};
+
+    /// Index of the frame the last collected results belong to
+    uint64_t m_ResultFrame{0};
+
+    /// Number of frames whose results weren't ready in time
+    size_t m_NumDropped{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
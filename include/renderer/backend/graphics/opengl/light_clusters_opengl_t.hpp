@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/light_clusters_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Texture unit the data of the clustered lights gets bound to
+static constexpr uint32_t CLUSTER_LIGHTS_TEXTURE_UNIT = 3;
+
+/// Texture unit the grid of clusters (offset and count of their lists) gets
+/// bound to
+static constexpr uint32_t CLUSTER_GRID_TEXTURE_UNIT = 4;
+
+/// Texture unit the lists of lights of the clusters get bound to
+static constexpr uint32_t CLUSTER_INDICES_TEXTURE_UNIT = 5;
+
+/// Number of texels (RGBA32F) of each light in the buffer of lights
+static constexpr uint32_t TEXELS_PER_CLUSTER_LIGHT = 4;
+
+/// Clusters of the point and spot lights uploaded to the GPU, for the lit
+/// program to loop over the lights of the cluster of each fragment.
+///
+/// The lights, the grid of clusters and their lists of lights are each kept
+/// in a buffer read through a buffer texture (texelFetch), which works with
+/// OpenGL 3.3 and has no size limit of practical concern, unlike a uniform
+/// block. The buffers are orphaned and rewritten every frame
+class RENDERER_API OpenGLLightClusters {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLLightClusters)
+
+    DEFINE_SMART_POINTERS(OpenGLLightClusters)
+
+ public:
+    /// Creates the (empty) buffers and their textures
+    OpenGLLightClusters();
+
+    /// Releases the buffers and their textures
+    ~OpenGLLightClusters();
+
+    /// Uploads the given clusters, along with the data of their lights
+    /// \returns The number of bytes uploaded
+    auto Update(const LightClusters& clusters) -> size_t;
+
+    /// Binds the textures of the buffers to their texture units
+    auto Bind() const -> void;
+
+    /// Returns the number of lights uploaded
+    RENDERER_NODISCARD auto num_lights() const -> size_t {
+        return m_NumLights;
+    }
+
+    /// Returns the number of clusters uploaded
+    RENDERER_NODISCARD auto num_clusters() const -> size_t {
+        return m_NumClusters;
+    }
+
+    /// Returns a string representation of these clusters
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Buffers of the lights, the grid and the lists of lights
+    std::array<uint32_t, 3> m_Buffers{};
+
+    /// Buffer textures reading each of the buffers
+    std::array<uint32_t, 3> m_Textures{};
+
+    /// Data of the lights, packed as TEXELS_PER_CLUSTER_LIGHT texels each
+    std::vector<float32_t> m_LightData;
+
+    /// Offset and count of the list of lights of each cluster
+    std::vector<uint32_t> m_GridData;
+
+    /// Number of lights uploaded
+    size_t m_NumLights{0};
+
+    /// Number of clusters uploaded
+    size_t m_NumClusters{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/range_allocator_t.hpp>
+#include <renderer/backend/graphics/opengl/index_buffer_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/vertex_array_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/vertex_buffer_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Number of floats per vertex in a mesh pool (position, normal, texcoord)
+static constexpr uint32_t FLOATS_PER_POOL_VERTEX = 3 + 3 + 2;
+
+/// Location of a geometry within the buffers of a mesh pool
+struct RENDERER_API OpenGLMeshRange {
+    /// Offset of the first vertex of the geometry in the vertex buffer
+    uint32_t base_vertex{INVALID_RANGE};
+    /// Number of vertices of the geometry
+    uint32_t num_vertices{0};
+    /// Offset of the first index of the geometry in the index buffer
+    uint32_t first_index{INVALID_RANGE};
+    /// Number of indices of the geometry
+    uint32_t num_indices{0};
+    /// Number of indices of the coarser levels of detail of the geometry,
+    /// stored right after the ones of the geometry
+    uint32_t num_lod_indices{0};
+
+    /// Returns whether or not this range refers to a geometry in the pool
+    RENDERER_NODISCARD auto valid() const -> bool {
+        return base_vertex != INVALID_RANGE && first_index != INVALID_RANGE;
+    }
+};
+
+/// Draw command read by glMultiDrawElementsIndirect (layout fixed by GL)
+struct RENDERER_API DrawElementsIndirectCommand {
+    /// Number of indices to draw
+    uint32_t count{0};
+    /// Number of instances to draw
+    uint32_t instance_count{0};
+    /// Offset of the first index in the index buffer
+    uint32_t first_index{0};
+    /// Value added to the indices before fetching the vertices
+    int32_t base_vertex{0};
+    /// Offset of the first instance in the instanced attributes
+    uint32_t base_instance{0};
+};
+
+/// Shared storage for the vertices and indices of many static geometries,
+/// suballocated from one large vertex buffer and one large index buffer.
+/// Every geometry is then drawn with the same vertex array, such that the
+/// draws of a frame can be submitted as arrays of indirect commands instead of
+/// binding a vertex array per geometry
+class RENDERER_API OpenGLMeshPool {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLMeshPool)
+
+    DEFINE_SMART_POINTERS(OpenGLMeshPool)
+
+ public:
+    /// Creates a pool with room for the given number of vertices and indices
+    /// \param[in] instance_layout Layout of the per-instance attributes,
+    /// enabled in the vertex array of the pool right after the vertex ones
+    /// \param[in] vertex_capacity Initial number of vertices of the pool
+    /// \param[in] index_capacity Initial number of indices of the pool
+    explicit OpenGLMeshPool(OpenGLBufferLayout instance_layout,
+                            uint32_t vertex_capacity, uint32_t index_capacity);
+
+    ~OpenGLMeshPool();
+
+    /// Copies the given geometry into the pool, growing it if required.
+    /// Geometries without indices get a trivial list of indices, followed by
+    /// the indices of their levels of detail (if any)
+    auto Add(const Geometry& geometry) -> OpenGLMeshRange;
+
+    /// Releases the room taken by a geometry previously added to the pool
+    auto Remove(const OpenGLMeshRange& range) -> void;
+
+    /// Uploads the draw commands of a frame into the indirect buffer
+    auto SetCommands(const std::vector<DrawElementsIndirectCommand>& commands)
+        -> void;
+
+    /// Submits a range of the uploaded commands in a single multi-draw call.
+    /// The vertex array of the pool must be bound
+    auto MultiDraw(size_t first, size_t count) const -> void;
+
+    /// Binds the vertex array shared by all geometries in the pool
+    auto Bind() const -> void;
+
+    /// Unbinds the vertex array of the pool
+    auto Unbind() const -> void;
+
+    /// Returns whether or not the current context supports multi-draw
+    /// indirect (OpenGL 4.3). Otherwise, commands have to be submitted one by
+    /// one, with base-vertex draws
+    static auto SupportsMultiDrawIndirect() -> bool;
+
+    /// Returns the vertex array shared by all geometries in the pool
+    RENDERER_NODISCARD auto vertex_array() const -> const OpenGLVertexArray& {
+        return *m_VertexArray;
+    }
+
+    /// Returns the allocator of the vertices of the pool
+    RENDERER_NODISCARD auto vertices() const -> const RangeAllocator& {
+        return m_Vertices;
+    }
+
+    /// Returns the allocator of the indices of the pool
+    RENDERER_NODISCARD auto indices() const -> const RangeAllocator& {
+        return m_Indices;
+    }
+
+    /// Returns a string representation of this pool
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Reallocates the buffers with room for at least the given number of
+    /// vertices and indices, keeping their contents
+    auto _Grow(uint32_t min_vertices, uint32_t min_indices) -> void;
+
+    /// Creates the vertex array from the current buffers
+    auto _CreateVertexArray() -> void;
+
+ private:
+    /// Interleaved vertices of all the geometries in the pool
+    OpenGLVertexBuffer::ptr m_VertexBuffer{nullptr};
+
+    /// Indices of all the geometries in the pool (relative to their base)
+    OpenGLIndexBuffer::ptr m_IndexBuffer{nullptr};
+
+    /// Layout of the per-instance attributes, streamed by the renderer
+    OpenGLBufferLayout m_InstanceLayout{};
+
+    /// Vertex array shared by all geometries in the pool
+    OpenGLVertexArray::uptr m_VertexArray{nullptr};
+
+    /// Suballocator of the vertex buffer
+    RangeAllocator m_Vertices;
+
+    /// Suballocator of the index buffer
+    RangeAllocator m_Indices;
+
+    /// Id of the buffer holding the indirect draw commands
+    uint32_t m_IndirectBufferId{0};
+
+    /// Size (in bytes) of the indirect buffer
+    uint32_t m_IndirectBufferSize{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
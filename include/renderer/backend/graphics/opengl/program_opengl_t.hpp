@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <initializer_list>
 #include <string>
 #include <unordered_map>
 
@@ -29,6 +30,10 @@ class RENDERER_API OpenGLProgram {
     /// \param[in] frag_src Source code of the fragment-shader
     explicit OpenGLProgram(const char* vert_src, const char* frag_src);
 
+    /// Creates a compute program with the given source code (GL 4.3+)
+    /// \param[in] comp_src Source code of the compute-shader
+    explicit OpenGLProgram(const char* comp_src);
+
     /// Releases the resources allocated for this Shader Program on GPU
     ~OpenGLProgram();
 
@@ -41,9 +46,17 @@ class RENDERER_API OpenGLProgram {
     /// Unbinds the current program from the rendering pipeline
     auto Unbind() const -> void;
 
+    /// Links the uniform block with the given name to the given binding point,
+    /// where its uniform buffer gets attached (call after building)
+    /// \returns Whether or not the program has a block with the given name
+    auto BindUniformBlock(const char* block_name, uint32_t binding) -> bool;
+
     /// Sets an int32 uniform given its name and desired value
     auto SetInt(const char* uname, int32_t uvalue) -> void;
 
+    /// Sets an uint32 uniform given its name and desired value
+    auto SetUint(const char* uname, uint32_t uvalue) -> void;
+
     /// Sets a float32 uniform given its name and desired value
     auto SetFloat(const char* uname, float uvalue) -> void;
 
@@ -75,10 +88,18 @@ class RENDERER_API OpenGLProgram {
         return m_FragSource;
     }
 
+    /// Returns the code used for the compute shader stage (if any)
+    RENDERER_NODISCARD auto compute_source() const -> std::string {
+        return m_CompSource;
+    }
+
  private:
     /// Caches and returns the requested uniform location
     auto _GetUniformLocation(const char* uname) -> int32_t;
 
+    /// Links the given (compiled) shaders into the program, releasing them
+    auto _Link(std::initializer_list<uint32_t> shaders) -> void;
+
  private:
     /// Source code for the vertex shader stage
     std::string m_VertSource;
@@ -86,6 +107,9 @@ class RENDERER_API OpenGLProgram {
     /// Source code for the fragment shader stage
     std::string m_FragSource;
 
+    /// Source code for the compute shader stage (empty for render programs)
+    std::string m_CompSource;
+
     // THe OpenGL ID associated to this program
     uint32_t m_OpenGLId{0};
 
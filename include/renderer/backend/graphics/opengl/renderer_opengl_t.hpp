@@ -1,8 +1,22 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <renderer/engine/renderer_t.hpp>
+#include <renderer/engine/render_queue_t.hpp>
+#include <renderer/backend/graphics/opengl/frame_uniforms_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/gpu_culling_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/gpu_timer_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/light_clusters_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/mesh_pool_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/program_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/shadow_maps_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/streaming_buffer_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/texture_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_buffer_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_array_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/resources_manager_t.hpp>
@@ -11,6 +25,103 @@
 namespace renderer {
 namespace opengl {
 
+/// Shader programs used by the mesh pass, indexed by the program id stored in
+/// the render keys
+enum class eMeshProgram : uint8_t {
+    /// Flat color (and albedo map), used by basic materials
+    UNLIT = 0,
+    /// Blinn-Phong shading, used by every other material type
+    LIT = 1,
+};
+
+/// Number of shader programs used by the mesh pass
+static constexpr size_t NUM_MESH_PROGRAMS = 2;
+
+/// Number of floats per instance in the instance buffer: the model matrix
+/// (column-major) followed by the color of the mesh
+static constexpr uint32_t FLOATS_PER_INSTANCE = 16 + 3;
+
+/// Location of the first per-instance attribute of the mesh shaders, right
+/// after the vertex attributes (position, normal and texcoord)
+static constexpr uint32_t INSTANCE_ATTRIB_LOCATION = 3;
+
+/// Initial number of instances each frame of the instance stream has room for
+static constexpr uint32_t INITIAL_INSTANCE_CAPACITY = 1024;
+
+/// Initial number of vertices the mesh pool has room for
+static constexpr uint32_t INITIAL_POOL_VERTICES = 1 << 16;
+
+/// Initial number of indices the mesh pool has room for
+static constexpr uint32_t INITIAL_POOL_INDICES = 1 << 18;
+
+/// Indices of a level of detail of a mesh
+struct RENDERER_API OpenGLMeshLod {
+    /// Offset of the first index of the level w.r.t. the first index of the
+    /// mesh (in its own index buffer, or in the one of the mesh pool)
+    uint32_t first_index{0};
+    /// Number of indices of the level (0 if the mesh isn't indexed)
+    uint32_t num_indices{0};
+};
+
+/// GPU copy of a geometry, created the first time the geometry is drawn
+struct RENDERER_API OpenGLMesh {
+    /// Geometry this copy was made from (used to detect stale entries)
+    std::weak_ptr<Geometry> geometry;
+    /// Vertex array with the attributes and indices of the geometry (unused
+    /// when the geometry lives in the mesh pool)
+    OpenGLVertexArray::uptr vao{nullptr};
+    /// Location of the geometry in the mesh pool, when enabled
+    OpenGLMeshRange range{};
+    /// Id of this mesh in the render keys
+    uint32_t id{0};
+    /// Number of vertices of the geometry
+    uint32_t num_vertices{0};
+    /// Number of indices of the geometry (0 if not indexed)
+    uint32_t num_indices{0};
+    /// Levels of detail of the geometry, starting with the full one
+    std::vector<OpenGLMeshLod> lods;
+    /// Version of the levels of detail of the geometry this copy was made
+    /// from (used to detect stale entries)
+    uint64_t lod_version{0};
+    /// Last frame the mesh was drawn in
+    uint64_t last_frame{0};
+};
+
+/// GPU-side state of a material, resolved the first time it's drawn
+struct RENDERER_API OpenGLMaterial {
+    /// Material this entry refers to (used to detect stale entries)
+    std::weak_ptr<Material> material;
+    /// Id of this material in the render keys
+    uint32_t id{0};
+    /// Name of the albedo map the texture below was resolved from
+    std::string albedo_name;
+    /// Albedo map of the material, if it has one loaded
+    OpenGLTexture::ptr albedo{nullptr};
+    /// Last frame the material was drawn in
+    uint64_t last_frame{0};
+};
+
+/// Draw of the render queue, referenced by the index of its queue entry
+struct RENDERER_API OpenGLQueuedDraw {
+    /// Item of the draw list to be drawn
+    const DrawItem* item{nullptr};
+    /// GPU copy of the geometry of the item
+    OpenGLMesh* mesh{nullptr};
+    /// GPU-side state of the material of the item
+    OpenGLMaterial* material{nullptr};
+    /// Level of detail of the mesh to be drawn
+    uint32_t lod{0};
+};
+
+/// Run of consecutive draws of the render queue that share all their state,
+/// submitted as a single instanced draw call
+struct RENDERER_API OpenGLDrawBatch {
+    /// Index of the first entry of the queue in this batch
+    uint32_t first{0};
+    /// Number of entries of the queue in this batch
+    uint32_t count{0};
+};
+
 class RENDERER_API OpenGLRenderer : public ::renderer::IRenderer {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLRenderer)
@@ -25,23 +136,289 @@ class RENDERER_API OpenGLRenderer : public ::renderer::IRenderer {
 
     auto Render(const Scene& scene, const Camera& camera) -> void override;
 
-    /// Returns the number of drawcalls spent in a render call
+    /// Returns the number of drawcalls spent in the last render call
     RENDERER_NODISCARD auto numDrawcalls() const -> int {
-        return m_NumDrawcalls;
+        return static_cast<int>(m_Stats.num_draw_calls);
     }
 
     /// Returns a string representation of the renderer
     RENDERER_NODISCARD auto ToString() const -> std::string override;
 
+    /// Enables/Disables the mesh pool. When enabled, all geometries are copied
+    /// into a pair of shared vertex and index buffers, and the draws of each
+    /// run of batches that share their program and material are submitted
+    /// with a single multi-draw-indirect call (or, on contexts older than
+    /// OpenGL 4.3, with one base-vertex draw per batch, still without
+    /// rebinding any vertex array)
+    auto SetMeshPoolEnabled(bool enable) -> void;
+
+    /// Returns whether or not the mesh pool is enabled
+    RENDERER_NODISCARD auto mesh_pool_enabled() const -> bool {
+        return m_MeshPool != nullptr;
+    }
+
+    /// Enables/Disables GPU-driven culling (OpenGL 4.3+, ignored otherwise).
+    /// When enabled, the opaque meshes are culled by a compute shader against
+    /// the frustum and the depth of the previous frame, which also writes the
+    /// indirect draw commands, so the CPU only uploads the meshes that change.
+    /// Translucent meshes are still culled and sorted on the CPU. It requires
+    /// the mesh pool, which gets enabled along (and disabling the mesh pool
+    /// disables it too)
+    auto SetGpuCullingEnabled(bool enable) -> void;
+
+    /// Returns whether or not GPU-driven culling is enabled
+    RENDERER_NODISCARD auto gpu_culling_enabled() const -> bool {
+        return m_GpuCuller != nullptr;
+    }
+
+    /// Enables/Disables the depth pre-pass. When enabled, the opaque batches
+    /// of the render queue are first drawn into the depth buffer alone, with
+    /// a position-only program, such that the scene pass then shades a single
+    /// fragment per pixel (early depth test against the pre-pass depth)
+    auto SetDepthPrepassEnabled(bool enable) -> void {
+        m_DepthPrepass = enable;
+    }
+
+    /// Returns whether or not the depth pre-pass is enabled
+    RENDERER_NODISCARD auto depth_prepass_enabled() const -> bool {
+        return m_DepthPrepass;
+    }
+
+    /// Returns the shadow maps of the directional light, created the first
+    /// time shadows get drawn (nullptr until then)
+    RENDERER_NODISCARD auto shadow_maps() const -> const OpenGLShadowMaps* {
+        return m_ShadowMaps.get();
+    }
+
+    /// Returns the clusters of the lights uploaded to the GPU, created the
+    /// first time clustered lighting gets used (nullptr until then)
+    RENDERER_NODISCARD auto gpu_light_clusters() const
+        -> const OpenGLLightClusters* {
+        return m_GpuLightClusters.get();
+    }
+
+    /// Returns the render queue built in the last render call
+    RENDERER_NODISCARD auto render_queue() const -> const RenderQueue& {
+        return m_RenderQueue;
+    }
+
  protected:
-    /// A counter for the number of draw calls executed
-    int m_NumDrawcalls{0};
+    /// Fills the render queue with the visible items of the draw list
+    auto _BuildRenderQueue(const Camera& camera) -> void;
+
+    /// Draws the casters into the shadow maps of the cascades of the frame.
+    /// Static casters are only redrawn into the cached layers that got
+    /// invalidated, and the dynamic ones get drawn on top every frame
+    auto _DrawShadows() -> void;
+
+    /// Submits the shadow draws in the given range, whose instances start at
+    /// the instance of the first one, with an instanced draw per mesh
+    auto _DrawShadowCasters(size_t first, size_t last) -> void;
+
+    /// Points the lit program to the shadow maps and cascades of the frame
+    /// (or turns its shadows off, if there's no light casting them). The
+    /// given lights are the ones of the per-frame block
+    auto _SetShadowUniforms(const std::vector<Light::ptr>& lights,
+                            const Light* light) -> void;
+
+    /// Uploads the clusters of the lights of the frame, and points the lit
+    /// program to them (or turns them off, if clustered lighting is disabled)
+    auto _SetLightClusterUniforms() -> void;
+
+    /// Splits the render queue into batches of draws that share their state,
+    /// writing the data of their instances into the instance buffer
+    auto _BuildDrawBatches() -> void;
+
+    /// Draws the opaque batches of the render queue into the depth buffer
+    auto _DrawDepthPrepass() -> void;
+
+    /// Submits the batches of the render queue, in order, binding only the
+    /// state that changes from one batch to the next
+    auto _DrawRenderQueue() -> void;
+
+    /// Brings the objects and draw commands of the GPU culler up to date with
+    /// the draw list, rebuilding them only if the set of items changed, and
+    /// moves the objects to the commands of their levels of detail
+    auto _SyncGpuCulling(const Camera& camera) -> void;
+
+    /// Submits the draws culled on the GPU (all opaque), either for the
+    /// depth pre-pass or for the scene pass
+    auto _DrawGpuCulled(bool depth_only) -> void;
+
+    /// Sets the uniforms of the given material on the given (bound) program,
+    /// binding its albedo map unless it's the given (already bound) one
+    auto _SetMaterialUniforms(OpenGLProgram& program,
+                              const OpenGLMaterial& gpu_material,
+                              const Material& material,
+                              const OpenGLTexture*& bound_texture) -> void;
+
+    /// Submits the given batch with the vertex array of its mesh, binding it
+    /// unless it's the given (already bound) one
+    auto _DrawBatch(const OpenGLDrawBatch& batch,
+                    const OpenGLVertexArray*& bound_vao) -> void;
+
+    /// Submits the batches in the given range, drawn from the mesh pool
+    auto _DrawPooledBatches(size_t first, size_t last) -> void;
+
+    /// Points the per-instance attributes of the bound vertex array to the
+    /// instances of the frame starting at the given one
+    auto _BindInstances(uint32_t first_instance) -> void;
 
+    /// Returns the GPU copy of the given geometry, creating it if required
+    auto _GetMesh(const Geometry::ptr& geometry) -> OpenGLMesh&;
+
+    /// Returns the GPU-side state of the given material, creating it if
+    /// required. The default material is used for meshes without one
+    auto _GetMaterial(const Material::ptr& material) -> OpenGLMaterial&;
+
+    /// Returns an id to identify a mesh or material in the render keys,
+    /// reusing the ids of released ones first
+    static auto _AllocateId(std::vector<uint32_t>& free_ids, uint32_t& next_id)
+        -> uint32_t;
+
+    /// Releases the GPU resources of geometries and materials that are gone
+    auto _CollectGarbage() -> void;
+
+    /// Releases the GPU copies of all geometries
+    auto _ClearMeshes() -> void;
+
+ protected:
     /// Resources manager to handle shaders and textures
     ResourcesManager::uptr m_ResourcesManager{nullptr};
 
     /// Debug drawer to be used to render debug primitives
     OpenGLDebugDrawer::uptr m_DebugDrawer{nullptr};
+
+    /// Shader programs of the mesh pass, indexed by eMeshProgram
+    std::array<OpenGLProgram::uptr, NUM_MESH_PROGRAMS> m_MeshPrograms;
+
+    /// Position-only program used by the depth pre-pass
+    OpenGLProgram::uptr m_DepthProgram{nullptr};
+
+    /// Program used to draw the casters into the shadow maps
+    OpenGLProgram::uptr m_ShadowProgram{nullptr};
+
+    /// Per-frame uniform block (camera and lights), shared by all programs
+    OpenGLFrameUniforms::uptr m_FrameUniforms{nullptr};
+
+    /// Timer of the passes of each frame on the GPU, indexed by eFramePass
+    OpenGLGpuTimer::uptr m_GpuTimer{nullptr};
+
+    /// Material used by the meshes that don't have one
+    Material::ptr m_DefaultMaterial{nullptr};
+
+    /// GPU copies of the geometries drawn so far
+    std::unordered_map<const Geometry*, OpenGLMesh> m_Meshes;
+
+    /// GPU-side state of the materials drawn so far
+    std::unordered_map<const Material*, OpenGLMaterial> m_Materials;
+
+    /// Ids of meshes and materials released, to be reused by new ones
+    std::vector<uint32_t> m_FreeMeshIds;
+    std::vector<uint32_t> m_FreeMaterialIds;
+
+    /// Next id to give to a mesh or material when there are none to reuse
+    uint32_t m_NextMeshId{0};
+    uint32_t m_NextMaterialId{0};
+
+    /// Draws of the current frame, sorted by their render keys
+    RenderQueue m_RenderQueue;
+
+    /// Draws referenced by the entries of the render queue
+    std::vector<OpenGLQueuedDraw> m_QueuedDraws;
+
+    /// Batches of the render queue, in the order they're drawn
+    std::vector<OpenGLDrawBatch> m_DrawBatches;
+
+    /// Number of opaque batches, which come before the translucent ones
+    size_t m_NumOpaqueBatches{0};
+
+    /// Layout of the per-instance attributes, shared by all meshes
+    OpenGLBufferLayout m_InstanceLayout{};
+
+    /// Ring buffer the per-instance data of each frame is written into
+    OpenGLStreamingBuffer::uptr m_InstanceStream{nullptr};
+
+    /// Offset (in bytes) of the instance data of the frame in the stream
+    uint32_t m_InstanceOffset{0};
+
+    /// Shared storage of the geometries, when the mesh pool is enabled
+    OpenGLMeshPool::uptr m_MeshPool{nullptr};
+
+    /// Indirect draw commands of the frame, one per batch (mesh pool only)
+    std::vector<DrawElementsIndirectCommand> m_IndirectCommands;
+
+    /// Shadow maps of the directional light, created the first time shadows
+    /// get drawn (and again whenever their layout changes)
+    OpenGLShadowMaps::uptr m_ShadowMaps{nullptr};
+
+    /// Draws of the shadow pass, grouped by the layer they're drawn into and
+    /// sorted by mesh within each group
+    std::vector<OpenGLQueuedDraw> m_ShadowDraws;
+
+    /// Ring buffer the instances of the shadow draws are written into
+    OpenGLStreamingBuffer::uptr m_ShadowInstanceStream{nullptr};
+
+    /// Offset (in bytes) of the shadow instances of the frame in the stream
+    uint32_t m_ShadowInstanceOffset{0};
+
+    /// Whether or not the lit program was last pointed to the shadow maps
+    bool m_ShadowUniformsSet{false};
+
+    /// Lights of the per-frame block when clustered lighting is enabled (the
+    /// directional ones only, as the rest get shaded from their clusters)
+    std::vector<Light::ptr> m_FrameLights;
+
+    /// Clusters of the lights uploaded to the GPU, when clustered lighting is
+    /// enabled
+    OpenGLLightClusters::uptr m_GpuLightClusters{nullptr};
+
+    /// Whether or not the lit program was last pointed to the clusters
+    bool m_LightClusterUniformsSet{false};
+
+    /// Culler of the opaque meshes on the GPU, when enabled
+    OpenGLGpuCuller::uptr m_GpuCuller{nullptr};
+
+    /// Draws of the GPU culler, one per command (its first item stands for
+    /// the mesh and material of all of them). The meshes with levels of
+    /// detail get a command per level, one after the other
+    std::vector<OpenGLQueuedDraw> m_GpuDraws;
+
+    /// Draw commands of the GPU culler, with room for all of their objects
+    std::vector<DrawElementsIndirectCommand> m_GpuCommands;
+
+    /// Copy of the objects of the GPU culler, to patch them in place
+    std::vector<OpenGLCullObject> m_GpuObjects;
+
+    /// Item of the draw list of each object of the GPU culler
+    std::vector<const DrawItem*> m_GpuObjectItems;
+
+    /// Object of the GPU culler of each slot of the draw list (or
+    /// INVALID_DRAW_SLOT for the items drawn by the CPU path)
+    std::vector<uint32_t> m_GpuSlotObjects;
+
+    /// Version of the items of the draw list the GPU culler was built from
+    uint64_t m_GpuItemsVersion{0};
+
+    /// Whether or not the GPU culler has to be rebuilt (e.g. the geometries
+    /// were moved out of the mesh pool)
+    bool m_GpuCullingDirty{true};
+
+    /// Number of items of the draw list left to the CPU path
+    size_t m_NumCpuDraws{0};
+
+    /// Whether or not the opaque batches get a depth pre-pass
+    bool m_DepthPrepass{false};
+
+    /// Whether or not the current frame uses a reversed depth range
+    bool m_ReverseZ{false};
+
+    /// Viewport (x, y, width, height) of the current frame, queried from the
+    /// context, as the one of the state cache may not be set
+    std::array<int32_t, 4> m_Viewport{};
+
+    /// Number of frames rendered so far
+    uint64_t m_FrameIndex{0};
 };
 
 }  // namespace opengl
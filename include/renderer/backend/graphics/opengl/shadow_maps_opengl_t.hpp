@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Texture unit the shadow maps get bound to for the lit program
+static constexpr uint32_t SHADOW_MAP_TEXTURE_UNIT = 2;
+
+/// Shadow maps of the cascades of the directional light, as the layers of a
+/// depth texture array (sampled with hardware depth comparisons).
+///
+/// When caching, a second array keeps the depth of the static casters alone.
+/// Each frame, the layers of the cascades start as a copy of their cached
+/// layers (a blit, no draws), and only the dynamic casters get drawn on top.
+/// The cached layers themselves are redrawn only when told so. Requires
+/// OpenGL 3.3, like the rest of the backend
+class RENDERER_API OpenGLShadowMaps {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLShadowMaps)
+
+    DEFINE_SMART_POINTERS(OpenGLShadowMaps)
+
+ public:
+    /// Creates the maps of the given number of cascades, with the given size
+    /// (in texels) per side, along with the cached layers if requested
+    OpenGLShadowMaps(uint32_t resolution, uint32_t num_cascades, bool cached);
+
+    /// Releases the textures and framebuffers of the maps
+    ~OpenGLShadowMaps();
+
+    /// Starts drawing into the maps, saving the framebuffer and viewport
+    /// bound at the moment, to be restored by EndPass
+    auto BeginPass() -> void;
+
+    /// Starts redrawing the cached layer of the given cascade (cleared)
+    auto BeginStaticLayer(uint32_t cascade) -> void;
+
+    /// Starts drawing the layer of the given cascade, which starts as a copy
+    /// of its cached layer (or cleared, when not caching)
+    auto BeginLayer(uint32_t cascade) -> void;
+
+    /// Stops drawing into the maps, restoring the framebuffer and viewport
+    auto EndPass() -> void;
+
+    /// Binds the maps to SHADOW_MAP_TEXTURE_UNIT
+    auto Bind() const -> void;
+
+    /// Returns whether or not these maps were created with the given layout
+    RENDERER_NODISCARD auto Matches(uint32_t resolution, uint32_t num_cascades,
+                                    bool cached) const -> bool {
+        return m_Resolution == resolution && m_NumCascades == num_cascades &&
+               m_Cached == cached;
+    }
+
+    /// Returns the size (in texels) of the side of each map
+    RENDERER_NODISCARD auto resolution() const -> uint32_t {
+        return m_Resolution;
+    }
+
+    /// Returns the number of cascades (layers) of the maps
+    RENDERER_NODISCARD auto num_cascades() const -> uint32_t {
+        return m_NumCascades;
+    }
+
+    /// Returns whether or not the static casters get their own cached layers
+    RENDERER_NODISCARD auto cached() const -> bool { return m_Cached; }
+
+    /// Returns whether or not the framebuffers of the maps are complete
+    RENDERER_NODISCARD auto IsValid() const -> bool { return m_Valid; }
+
+    /// Returns a string representation of these maps
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Attaches the given layer of the given texture to the draw framebuffer
+    /// and sets the viewport to cover it
+    auto _AttachLayer(uint32_t texture, uint32_t cascade) -> void;
+
+ private:
+    /// Size (in texels) of the side of each map
+    uint32_t m_Resolution{0};
+
+    /// Number of cascades (layers) of the maps
+    uint32_t m_NumCascades{0};
+
+    /// Whether or not the static casters get their own cached layers
+    bool m_Cached{false};
+
+    /// Whether or not the framebuffers of the maps are complete
+    bool m_Valid{false};
+
+    /// Depth texture array sampled by the lit program
+    uint32_t m_DepthTexture{0};
+
+    /// Depth texture array with the cached layers of the static casters
+    uint32_t m_StaticTexture{0};
+
+    /// Framebuffer the layers get drawn into
+    uint32_t m_DrawFramebuffer{0};
+
+    /// Framebuffer the cached layers get copied from
+    uint32_t m_ReadFramebuffer{0};
+
+    /// Framebuffers (draw and read) bound when the pass began
+    std::array<int32_t, 2> m_SavedFramebuffers{};
+
+    /// Viewport (x, y, width, height) set when the pass began
+    std::array<int32_t, 4> m_SavedViewport{};
+};
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Number of texture units tracked by the state cache
+static constexpr uint32_t MAX_CACHED_TEXTURE_UNITS = 16;
+
+/// Number of indexed uniform buffer binding points tracked by the state cache
+static constexpr uint32_t MAX_CACHED_UNIFORM_BINDINGS = 16;
+
+/// Number of (non-indexed) buffer targets tracked by the state cache
+static constexpr uint32_t NUM_CACHED_BUFFER_TARGETS = 8;
+
+/// Number of texture targets tracked per texture unit by the state cache
+static constexpr uint32_t NUM_CACHED_TEXTURE_TARGETS = 4;
+
+/// Shadow copy of the state of the OpenGL context, used to skip the calls that
+/// wouldn't change anything (e.g. binding the program that's already bound).
+/// It tracks the current program, vertex array, buffer and texture bindings,
+/// blending, depth state, polygon offset, color writes, clip-space depth range
+/// and viewport.
+///
+/// Resources get edited through direct state access (GL 4.5+) when available,
+/// such that editing them doesn't disturb the bindings at all. Otherwise the
+/// edits go through the copy-write buffer target (which, unlike the element
+/// array target, isn't part of the state of the bound vertex array) and the
+/// bindings are left in place instead of being reset to 0 afterwards.
+///
+/// Every GL call that changes the tracked state has to go through the cache.
+/// Code that issues such calls directly must call Invalidate afterwards
+class RENDERER_API OpenGLStateCache {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLStateCache)
+
+    DEFINE_SMART_POINTERS(OpenGLStateCache)
+
+ public:
+    /// Creates a cache with all state unknown
+    OpenGLStateCache();
+
+    /// Releases the resources of the cache (no GL resources are owned)
+    ~OpenGLStateCache() = default;
+
+    /// Returns the cache of the context current on the calling thread (an
+    /// OpenGL context is current on a single thread at a time)
+    static auto Current() -> OpenGLStateCache&;
+
+    /// Forgets all tracked state, such that the next calls are issued. Call it
+    /// after making a new context current, or after issuing GL calls directly
+    auto Invalidate() -> void;
+
+    /// Makes the given program the current one
+    auto UseProgram(uint32_t program) -> void;
+
+    /// Binds the given vertex array
+    auto BindVertexArray(uint32_t vertex_array) -> void;
+
+    /// Binds the given buffer to the given target
+    auto BindBuffer(uint32_t target, uint32_t buffer) -> void;
+
+    /// Binds the given buffer to the given indexed binding point of a target
+    auto BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+        -> void;
+
+    /// Binds the given texture to the given target of a texture unit
+    auto BindTexture(uint32_t unit, uint32_t target, uint32_t texture) -> void;
+
+    /// Enables or disables blending
+    auto SetBlend(bool enabled) -> void;
+
+    /// Sets the source and destination factors used for blending
+    auto SetBlendFunc(uint32_t src_factor, uint32_t dst_factor) -> void;
+
+    /// Enables or disables the depth test
+    auto SetDepthTest(bool enabled) -> void;
+
+    /// Enables or disables writes into the depth buffer
+    auto SetDepthMask(bool enabled) -> void;
+
+    /// Sets the comparison function used by the depth test
+    auto SetDepthFunc(uint32_t func) -> void;
+
+    /// Enables or disables the polygon offset of filled primitives
+    auto SetPolygonOffsetFill(bool enabled) -> void;
+
+    /// Sets the slope factor and the constant units of the polygon offset
+    auto SetPolygonOffset(float32_t factor, float32_t units) -> void;
+
+    /// Enables or disables writes into all channels of the color buffer
+    auto SetColorMask(bool enabled) -> void;
+
+    /// Selects the clip-space depth range, either [0, 1] or the default
+    /// [-1, 1]. Ignored when clip control isn't supported (before GL 4.5)
+    auto SetClipDepthZeroToOne(bool zero_to_one) -> void;
+
+    /// Sets the viewport
+    auto SetViewport(int32_t x, int32_t y, int32_t width, int32_t height)
+        -> void;
+
+    /// Creates a buffer object, ready to be edited
+    auto CreateBuffer() -> uint32_t;
+
+    /// Deletes the given buffer, forgetting the bindings that referenced it
+    auto DeleteBuffer(uint32_t buffer) -> void;
+
+    /// (Re)allocates the storage of the given buffer
+    auto BufferData(uint32_t buffer, uint32_t size, const void* data,
+                    uint32_t usage) -> void;
+
+    /// Allocates immutable storage for the given buffer (GL 4.4+)
+    auto BufferStorage(uint32_t buffer, uint32_t size, const void* data,
+                       uint32_t flags) -> void;
+
+    /// Updates a range of the storage of the given buffer
+    auto BufferSubData(uint32_t buffer, uint32_t offset, uint32_t size,
+                       const void* data) -> void;
+
+    /// Maps a range of the storage of the given buffer
+    auto MapBufferRange(uint32_t buffer, uint32_t offset, uint32_t size,
+                        uint32_t access) -> void*;
+
+    /// Unmaps the storage of the given buffer
+    auto UnmapBuffer(uint32_t buffer) -> void;
+
+    /// Copies a range of the storage of a buffer into another buffer
+    auto CopyBufferSubData(uint32_t src_buffer, uint32_t dst_buffer,
+                           uint32_t src_offset, uint32_t dst_offset,
+                           uint32_t size) -> void;
+
+    /// Sets an integer parameter of the given texture
+    auto TextureParameter(uint32_t target, uint32_t texture, uint32_t pname,
+                          int32_t value) -> void;
+
+    /// Sets a vector parameter of the given texture
+    auto TextureParameter(uint32_t target, uint32_t texture, uint32_t pname,
+                          const float32_t* values) -> void;
+
+    /// Deletes the given texture, forgetting the bindings that referenced it
+    auto DeleteTexture(uint32_t texture) -> void;
+
+    /// Deletes the given vertex array, forgetting it if it's bound
+    auto DeleteVertexArray(uint32_t vertex_array) -> void;
+
+    /// Deletes the given program, forgetting it if it's the current one
+    auto DeleteProgram(uint32_t program) -> void;
+
+    /// Resets the counters of issued and elided calls
+    auto ResetCounters() -> void;
+
+    /// Returns whether or not resources are edited with direct state access
+    RENDERER_NODISCARD auto direct_state_access() const -> bool {
+        return m_DirectStateAccess;
+    }
+
+    /// Returns whether or not the clip-space depth range can be selected
+    RENDERER_NODISCARD auto clip_control() const -> bool {
+        return m_ClipControl;
+    }
+
+    /// Returns the last viewport set through the cache (x, y, width, height),
+    /// or all zeros if none was set since the cache got invalidated
+    RENDERER_NODISCARD auto viewport() const -> const std::array<int32_t, 4>& {
+        return m_Viewport;
+    }
+
+    /// Returns the number of state changes issued since the counters reset
+    RENDERER_NODISCARD auto num_issued_calls() const -> size_t {
+        return m_NumIssuedCalls;
+    }
+
+    /// Returns the number of redundant state changes skipped since the
+    /// counters reset
+    RENDERER_NODISCARD auto num_elided_calls() const -> size_t {
+        return m_NumElidedCalls;
+    }
+
+    /// Returns a string representation of this cache
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Updates the given tracked value, returning whether the call is needed
+    auto _Update(uint32_t& tracked, uint32_t value) -> bool;
+
+    /// Binds the given buffer for an edit through the copy-write target
+    auto _BindForEdit(uint32_t buffer) -> void;
+
+    /// Binds the given texture to the active unit for an edit
+    auto _BindTextureForEdit(uint32_t target, uint32_t texture) -> void;
+
+ private:
+    /// Whether or not resources are edited through direct state access
+    bool m_DirectStateAccess{false};
+
+    /// Whether or not the clip-space depth range can be selected
+    bool m_ClipControl{false};
+
+    /// Current program
+    uint32_t m_Program{0};
+
+    /// Bound vertex array
+    uint32_t m_VertexArray{0};
+
+    /// Buffers bound to each tracked target
+    std::array<uint32_t, NUM_CACHED_BUFFER_TARGETS> m_Buffers{};
+
+    /// Buffers bound to each tracked uniform buffer binding point
+    std::array<uint32_t, MAX_CACHED_UNIFORM_BINDINGS> m_UniformBuffers{};
+
+    /// Active texture unit
+    uint32_t m_ActiveUnit{0};
+
+    /// Textures bound to each tracked target of each tracked texture unit
+    std::array<std::array<uint32_t, NUM_CACHED_TEXTURE_TARGETS>,
+               MAX_CACHED_TEXTURE_UNITS>
+        m_Textures{};
+
+    /// Whether or not blending is enabled
+    uint32_t m_Blend{0};
+
+    /// Blending factors (source, destination)
+    std::array<uint32_t, 2> m_BlendFunc{};
+
+    /// Whether or not the depth test is enabled
+    uint32_t m_DepthTest{0};
+
+    /// Whether or not depth writes are enabled
+    uint32_t m_DepthMask{0};
+
+    /// Depth comparison function
+    uint32_t m_DepthFunc{0};
+
+    /// Whether or not the polygon offset of filled primitives is enabled
+    uint32_t m_PolygonOffsetFill{0};
+
+    /// Polygon offset (slope factor, constant units)
+    std::array<float32_t, 2> m_PolygonOffset{};
+
+    /// Whether or not the polygon offset is known
+    bool m_PolygonOffsetKnown{false};
+
+    /// Whether or not color writes are enabled
+    uint32_t m_ColorMask{0};
+
+    /// Whether or not the clip-space depth range is [0, 1]
+    uint32_t m_ClipDepthZeroToOne{0};
+
+    /// Viewport (x, y, width, height)
+    std::array<int32_t, 4> m_Viewport{};
+
+    /// Whether or not the viewport is known
+    bool m_ViewportKnown{false};
+
+    /// Number of state changes issued since the counters were reset
+    size_t m_NumIssuedCalls{0};
+
+    /// Number of state changes skipped since the counters were reset
+    size_t m_NumElidedCalls{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
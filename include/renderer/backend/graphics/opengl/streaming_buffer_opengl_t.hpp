@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Default number of segments of a streaming buffer, such that the CPU can
+/// write a frame while the GPU still reads the two previous ones
+static constexpr uint32_t DEFAULT_STREAMING_SEGMENTS = 3;
+
+/// Chunk of a streaming buffer handed out to be written by the CPU
+struct RENDERER_API OpenGLStreamingAllocation {
+    /// Pointer to the mapped memory of the chunk (nullptr if it didn't fit)
+    void* data{nullptr};
+    /// Offset (in bytes) of the chunk from the start of the buffer, to be
+    /// used when sourcing attributes or binding ranges from the buffer
+    uint32_t offset{0};
+    /// Size (in bytes) of the chunk
+    uint32_t size{0};
+};
+
+/// Ring buffer used to stream data that changes every frame (e.g. instance
+/// transforms or debug lines) to the GPU without stalls. Its storage is split
+/// into segments, one per frame in flight, and each frame writes straight into
+/// the mapped memory of its segment. A fence placed after the draws of a frame
+/// guards the segment until the GPU is done reading it.
+///
+/// On OpenGL 4.4+ the storage is immutable and mapped once, persistently and
+/// coherently. On older contexts each segment is mapped unsynchronized for the
+/// frame, and if the GPU is still reading it, the whole buffer is orphaned
+/// instead of waiting
+class RENDERER_API OpenGLStreamingBuffer {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLStreamingBuffer)
+
+    DEFINE_SMART_POINTERS(OpenGLStreamingBuffer)
+
+ public:
+    /// Creates a streaming buffer with the given number of segments
+    /// \param[in] segment_size The size (in bytes) of each segment
+    /// \param[in] num_segments The number of segments (frames in flight)
+    explicit OpenGLStreamingBuffer(
+        uint32_t segment_size,
+        uint32_t num_segments = DEFAULT_STREAMING_SEGMENTS);
+
+    /// Releases the storage of this buffer
+    ~OpenGLStreamingBuffer();
+
+    /// Moves on to the next segment, waiting for (or orphaning) it if the GPU
+    /// is still reading it. The segment the previous frame used gets fenced,
+    /// so call this once per frame, after the draws of the previous one
+    /// \param[in] min_size Number of bytes the frame needs. The buffer gets
+    /// reallocated with bigger segments if they're smaller than this
+    auto BeginSegment(uint32_t min_size = 0) -> void;
+
+    /// Hands out a chunk of the current segment to be written
+    /// \param[in] size The size (in bytes) of the chunk
+    /// \param[in] alignment The alignment (in bytes) of the chunk offset
+    auto Allocate(uint32_t size, uint32_t alignment = 16)
+        -> OpenGLStreamingAllocation;
+
+    /// Finishes writing the current segment, making its contents available to
+    /// the draws that follow
+    auto EndSegment() -> void;
+
+    /// Returns whether or not the buffer is persistently mapped (GL 4.4+)
+    RENDERER_NODISCARD auto persistent() const -> bool { return m_Persistent; }
+
+    /// Returns the size (in bytes) of each segment
+    RENDERER_NODISCARD auto segment_size() const -> uint32_t {
+        return m_SegmentSize;
+    }
+
+    /// Returns the number of segments of the buffer
+    RENDERER_NODISCARD auto num_segments() const -> uint32_t {
+        return m_NumSegments;
+    }
+
+    /// Returns the number of times the CPU had to wait for the GPU
+    RENDERER_NODISCARD auto num_waits() const -> size_t { return m_NumWaits; }
+
+    /// Returns the number of times the buffer was orphaned to avoid waiting
+    RENDERER_NODISCARD auto num_orphans() const -> size_t {
+        return m_NumOrphans;
+    }
+
+    /// Returns the id of the OpenGL resource of this buffer
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    /// Returns a string representation of this buffer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Allocates the storage of the buffer, with segments of the given size
+    auto _Create(uint32_t segment_size) -> void;
+
+    /// Releases the storage of the buffer and its fences
+    auto _Destroy() -> void;
+
+    /// Makes sure the GPU is done with the given segment before writing it
+    auto _WaitForSegment(uint32_t segment) -> void;
+
+ private:
+    /// Id of the OpenGL resource allocated on the GPU
+    uint32_t m_OpenGLId{0};
+
+    /// Size (in bytes) of each segment
+    uint32_t m_SegmentSize{0};
+
+    /// Number of segments of the buffer
+    uint32_t m_NumSegments{DEFAULT_STREAMING_SEGMENTS};
+
+    /// Index of the segment being written
+    uint32_t m_Segment{0};
+
+    /// Offset (in bytes) of the next allocation within the current segment
+    uint32_t m_Cursor{0};
+
+    /// Whether or not a segment was begun (and thus has to be fenced)
+    bool m_Started{false};
+
+    /// Whether or not the storage is mapped persistently
+    bool m_Persistent{false};
+
+    /// Mapped memory of the current segment (or of the whole buffer, when
+    /// persistently mapped)
+    uint8_t* m_Mapped{nullptr};
+
+    /// Fences (GLsync handles) placed after the last frame using each segment
+    std::vector<void*> m_Fences;
+
+    /// Number of times the CPU had to wait for the GPU
+    size_t m_NumWaits{0};
+
+    /// Number of times the buffer was orphaned to avoid waiting
+    size_t m_NumOrphans{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/std140_writer_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Uniform Buffer Object (UBO), used to share a uniform block between programs.
+/// The buffer is attached to a fixed binding point, and programs link their
+/// blocks to that same binding point (see OpenGLProgram::BindUniformBlock)
+class RENDERER_API OpenGLUniformBuffer {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLUniformBuffer)
+
+    DEFINE_SMART_POINTERS(OpenGLUniformBuffer)
+
+ public:
+    /// Creates a uniform buffer for the given binding point
+    /// \param[in] binding The binding point the buffer gets attached to
+    /// \param[in] size The initial size (in bytes) of the buffer
+    explicit OpenGLUniformBuffer(uint32_t binding, uint32_t size);
+
+    /// Releases the resources allocated by this UBO
+    ~OpenGLUniformBuffer();
+
+    /// Replaces the contents of the buffer, growing it if required. The old
+    /// storage is orphaned, so draws still using it don't stall the upload
+    /// \param[in] data A pointer to the data to be transferred
+    /// \param[in] size How much data (in bytes) will be transferred
+    auto Update(const void* data, uint32_t size) -> void;
+
+    /// Replaces the contents of the buffer with the block packed by the writer
+    auto Update(const Std140Writer& writer) -> void;
+
+    /// Attaches this buffer to its binding point
+    auto Bind() const -> void;
+
+    /// Returns the binding point of this buffer
+    RENDERER_NODISCARD auto binding() const -> uint32_t { return m_Binding; }
+
+    /// Returns the size (in bytes) of this buffer
+    RENDERER_NODISCARD auto size() const -> uint32_t { return m_Size; }
+
+    /// Returns the id of the OpenGL resource allocated for this buffer
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    /// Returns a string representation of this buffer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Id of the OpenGL resource allocated on the GPU
+    uint32_t m_OpenGLId{0};
+
+    /// Binding point this buffer gets attached to
+    uint32_t m_Binding{0};
+
+    /// Size (in bytes) of the buffer on the GPU
+    uint32_t m_Size{0};
+};
+
+}  // namespace opengl
+}  // namespace renderer
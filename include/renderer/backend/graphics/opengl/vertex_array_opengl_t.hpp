@@ -13,6 +13,16 @@ namespace opengl {
 /// Returns the appropriate GL enum for the given etype
 RENDERER_NODISCARD auto ToOpenGLEnum(eElementType etype) -> uint32_t;
 
+/// Points the attributes of the bound VAO, starting at the given location, to
+/// the data in the given buffer laid out as described, starting at the offset
+/// \param[in] first_location Location of the first attribute of the layout
+/// \param[in] layout Layout of the data in the buffer
+/// \param[in] buffer_id Id of the OpenGL buffer the data is sourced from
+/// \param[in] offset Offset (in bytes) of the data from the start of the buffer
+auto SetVertexAttributes(uint32_t first_location,
+                         const OpenGLBufferLayout& layout, uint32_t buffer_id,
+                         uintptr_t offset) -> void;
+
 /// Vertex Array Object (VAO), used to handle vertex attribs
 class RENDERER_API OpenGLVertexArray {
     // cppcheck-suppress unknownMacro
@@ -30,6 +40,11 @@ class RENDERER_API OpenGLVertexArray {
     /// Adds the given VBO to the group managed by this VAO
     auto AddVertexBuffer(OpenGLVertexBuffer::ptr buffer) -> void;
 
+    /// Enables the attributes of the given layout, without sourcing them from
+    /// any buffer yet. Used for data streamed every frame into a different
+    /// place, which gets pointed to with SetVertexAttributes before drawing
+    auto AddStreamedAttributes(const OpenGLBufferLayout& layout) -> void;
+
     /// Adds the given IBO to the group managed by this VAO
     auto SetIndexBuffer(OpenGLIndexBuffer::ptr ibuffer) -> void;
 
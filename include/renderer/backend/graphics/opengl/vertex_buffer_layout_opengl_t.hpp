@@ -24,18 +24,22 @@ struct RENDERER_API OpenGLBufferElement {
     uint32_t offset = 0;
     /// Whether or not we should normalize the element (e.g. when using normals)
     bool normalized = false;
+    /// Number of instances drawn before the element advances (0 to advance it
+    /// per vertex instead, as usual)
+    uint32_t divisor = 0;
 
     /// Creates a default Vertex Buffer Element
     OpenGLBufferElement() = default;
 
     /// Creates a Vertex Buffer Element with the given description
     OpenGLBufferElement(const char* e_name, eElementType e_type,
-                        bool e_normalized)
+                        bool e_normalized, uint32_t e_divisor = 0)
         : name(e_name),
           type(e_type),
           count(GetElementCount(e_type)),
           nbytes(GetElementSize(e_type)),
-          normalized(e_normalized) {}
+          normalized(e_normalized),
+          divisor(e_divisor) {}
 
     /// \brief Returns a string representation of this elements
     RENDERER_NODISCARD auto ToString() const -> std::string;
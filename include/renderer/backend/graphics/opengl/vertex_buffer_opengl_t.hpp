@@ -38,6 +38,14 @@ class RENDERER_API OpenGLVertexBuffer {
     /// \param data A pointer to the data to be transferred
     auto UpdateData(uint32_t size, const float32_t* data) -> void;
 
+    /// Updates part of the memory associated with this buffer on the GPU,
+    /// keeping its size (the range must fit in the buffer)
+    /// \param offset Where the range starts (in bytes)
+    /// \param size How much data (in bytes) will be updated
+    /// \param data A pointer to the data to be transferred
+    auto UpdateRange(uint32_t offset, uint32_t size, const float32_t* data)
+        -> void;
+
     /// Binds the current buffer to the appropriate state of the pipeline
     auto Bind() const -> void;
 
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+
+namespace renderer {
+
+class Object3D;
+
+/// Stable identifier of a leaf (object) stored in a BVH
+using BvhLeafId = uint32_t;
+
+/// Identifier used for leaves that aren't stored in any BVH
+static constexpr BvhLeafId INVALID_BVH_LEAF =
+    std::numeric_limits<BvhLeafId>::max();
+
+/// Index used for nodes that don't exist (e.g. the parent of the root)
+static constexpr uint32_t INVALID_BVH_NODE =
+    std::numeric_limits<uint32_t>::max();
+
+/// Bounding volume hierarchy over the world bounds of a set of objects. The
+/// tree is built with the surface area heuristic (SAH), and afterwards bounds
+/// changes are handled by refitting only the ancestors of the changed leaves.
+/// Objects added to a built tree are inserted next to the node that makes the
+/// cheapest sibling (by SAH), so a full rebuild happens only for the first
+/// objects, when too many removed leaves pile up, or when the quality of the
+/// tree degrades past a threshold
+class RENDERER_API BVH {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(BVH)
+
+    DEFINE_SMART_POINTERS(BVH)
+
+ public:
+    /// Number of bins used to evaluate the SAH split candidates
+    static constexpr uint32_t NUM_SAH_BINS = 12;
+
+    /// Default ratio of SAH cost (refitted vs freshly built) that triggers a
+    /// full rebuild of the tree
+    static constexpr float DEFAULT_REBUILD_THRESHOLD = 1.5F;
+
+    /// Node of the tree. Leaf nodes reference a single object
+    struct Node {
+        /// Bounds enclosing all objects down this node
+        AABB bounds;
+        /// Index of the left child (internal nodes only)
+        uint32_t left{INVALID_BVH_NODE};
+        /// Index of the right child (internal nodes only)
+        uint32_t right{INVALID_BVH_NODE};
+        /// Index of the parent of this node
+        uint32_t parent{INVALID_BVH_NODE};
+        /// Leaf referenced by this node (leaf nodes only)
+        BvhLeafId leaf{INVALID_BVH_LEAF};
+
+        /// Returns whether or not this is a leaf node
+        RENDERER_NODISCARD auto is_leaf() const -> bool {
+            return leaf != INVALID_BVH_LEAF;
+        }
+    };
+
+    /// Object stored in the tree, along with its world bounds
+    struct Leaf {
+        /// The object referenced by this leaf (nullptr if the leaf is free).
+        /// Objects only leave their scene through Scene::RemoveChild, which
+        /// frees their leaves first, so it never dangles
+        Object3D* object{nullptr};
+        /// The world bounds of the object
+        AABB bounds;
+        /// The node that currently stores this leaf
+        uint32_t node{INVALID_BVH_NODE};
+        /// Whether or not the leaf is queued for the next refit
+        bool changed{false};
+    };
+
+    /// Creates an empty BVH
+    BVH() = default;
+
+    /// Releases the resources used by this BVH
+    ~BVH() = default;
+
+    /// Adds an object to the tree. Into a built tree it gets inserted right
+    /// away, otherwise the tree is built on the next commit
+    /// \param[in] object The object to be referenced by the new leaf
+    /// \param[in] bounds The world bounds of the object
+    /// \returns The id of the new leaf
+    auto Insert(Object3D* object, const AABB& bounds) -> BvhLeafId;
+
+    /// Updates the bounds of a leaf. Its ancestors are refit on next commit
+    auto Update(BvhLeafId leaf_id, const AABB& bounds) -> void;
+
+    /// Removes a leaf from the tree. Its node is kept (with empty bounds)
+    /// until the next rebuild
+    auto Remove(BvhLeafId leaf_id) -> void;
+
+    /// Applies the pending changes to the tree, either by refitting the
+    /// changed branches or by fully rebuilding it if required
+    auto Commit() -> void;
+
+    /// Fully rebuilds the tree from the current leaves using binned SAH
+    auto Build() -> void;
+
+    /// Removes all leaves and nodes from the tree
+    auto Clear() -> void;
+
+    /// Calls the given function with each object whose bounds overlap the
+    /// given box
+    template <typename Func>
+    auto Query(const AABB& box, Func&& func) const -> void {
+        if (m_Root == INVALID_BVH_NODE) {
+            return;
+        }
+        std::vector<uint32_t> stack{m_Root};
+        while (!stack.empty()) {
+            const auto& node = m_Nodes[stack.back()];
+            stack.pop_back();
+            if (!node.bounds.Intersects(box)) {
+                continue;
+            }
+            if (node.is_leaf()) {
+                const auto& leaf = m_Leaves[node.leaf];
+                if (leaf.object != nullptr) {
+                    func(leaf.object);
+                }
+                continue;
+            }
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    /// Sets the ratio of SAH cost that triggers a full rebuild
+    auto SetRebuildThreshold(float threshold) -> void {
+        m_RebuildThreshold = threshold;
+    }
+
+    /// Returns the ratio of SAH cost that triggers a full rebuild
+    RENDERER_NODISCARD auto rebuild_threshold() const -> float {
+        return m_RebuildThreshold;
+    }
+
+    /// Returns the ratio between the current SAH cost of the tree and its
+    /// cost right after the last rebuild (1.0 means no degradation)
+    RENDERER_NODISCARD auto quality() const -> float;
+
+    /// Returns the index of the root node (INVALID_BVH_NODE if empty)
+    RENDERER_NODISCARD auto root() const -> uint32_t { return m_Root; }
+
+    /// Returns an unmutable reference to the nodes of the tree (nodes taken
+    /// out of the tree stay in the storage, unreachable from the root)
+    RENDERER_NODISCARD auto nodes() const -> const std::vector<Node>& {
+        return m_Nodes;
+    }
+
+    /// Returns an unmutable reference to the leaves of the tree
+    RENDERER_NODISCARD auto leaves() const -> const std::vector<Leaf>& {
+        return m_Leaves;
+    }
+
+    /// Returns the number of objects stored in the tree
+    RENDERER_NODISCARD auto num_objects() const -> size_t {
+        return m_Leaves.size() - m_FreeLeaves.size();
+    }
+
+    /// Returns the number of full rebuilds done so far
+    RENDERER_NODISCARD auto num_rebuilds() const -> size_t {
+        return m_NumRebuilds;
+    }
+
+    /// Returns the number of nodes visited by the last refit
+    RENDERER_NODISCARD auto num_refit_nodes() const -> size_t {
+        return m_NumRefitNodes;
+    }
+
+    /// Returns a string representation of this BVH
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Refits the ancestors of the leaves changed since the last commit
+    auto _Refit() -> void;
+
+    /// Builds the subtree for the given range of leaves, returns its node
+    auto _BuildRecursive(BvhLeafId* leaf_ids, size_t count, uint32_t parent,
+                         const std::vector<Vec3>& centroids) -> uint32_t;
+
+    /// Inserts the node of the given leaf next to the sibling that makes the
+    /// cheapest tree, refitting the ancestors of the new parent
+    auto _InsertLeaf(BvhLeafId leaf_id) -> void;
+
+    /// Takes the given leaf node (and its parent) out of the tree, with its
+    /// sibling taking the place of the parent
+    auto _DetachLeaf(uint32_t node_idx) -> void;
+
+    /// Refits the given node and its ancestors, stopping once a node keeps
+    /// its bounds. Returns the number of nodes visited
+    auto _RefitAncestors(uint32_t node_idx) -> size_t;
+
+    /// Returns the index of a new node, reusing a free one if any
+    auto _AllocateNode() -> uint32_t;
+
+    /// Returns the SAH cost of the tree (internal area over root area)
+    RENDERER_NODISCARD auto _Cost() const -> float;
+
+ private:
+    /// Storage for the nodes of the tree
+    std::vector<Node> m_Nodes;
+
+    /// Storage for the leaves of the tree (indexed by leaf id)
+    std::vector<Leaf> m_Leaves;
+
+    /// Ids of the leaves that are free to be reused
+    std::vector<BvhLeafId> m_FreeLeaves;
+
+    /// Nodes taken out of the tree, free to be reused
+    std::vector<uint32_t> m_FreeNodes;
+
+    /// Ids of the leaves whose bounds changed since the last commit
+    std::vector<BvhLeafId> m_ChangedLeaves;
+
+    /// Index of the root node
+    uint32_t m_Root{INVALID_BVH_NODE};
+
+    /// Whether or not the structure changed, so a rebuild is required
+    bool m_NeedsRebuild{false};
+
+    /// Number of nodes that reference removed leaves
+    size_t m_NumDeadNodes{0};
+
+    /// Sum of the surface areas of the internal nodes of the tree
+    float m_InternalArea{0.0F};
+
+    /// SAH cost of the tree right after the last rebuild
+    float m_BuiltCost{0.0F};
+
+    /// Ratio of SAH cost that triggers a full rebuild
+    float m_RebuildThreshold{DEFAULT_REBUILD_THRESHOLD};
+
+    /// Number of full rebuilds done so far
+    size_t m_NumRebuilds{0};
+
+    /// Number of nodes visited by the last refit
+    size_t m_NumRefitNodes{0};
+};
+
+}  // namespace renderer
@@ -2,7 +2,9 @@
 
 #include <string>
 
+#include <renderer/engine/culling_t.hpp>
 #include <renderer/engine/graphics/enums.hpp>
+#include <renderer/engine/graphics/ray_t.hpp>
 #include <renderer/engine/object_t.hpp>
 
 namespace renderer {
@@ -23,6 +25,11 @@ struct RENDERER_API CameraData {
     float near{0.1F};
     /// Distance to the furthest plane of the view-volume
     float far{100.0F};
+    /// Whether or not to use a reversed depth range, mapping the near plane to
+    /// a depth of 1 and the far plane to a depth of 0. Paired with a [0, 1]
+    /// clip-space depth range (glClipControl), the precision of the floating
+    /// point depth values gets spread evenly over the whole view-volume
+    bool reverse_z{false};
 
     /// Returns the string representation of this object
     RENDERER_NODISCARD auto ToString() const -> std::string;
@@ -42,9 +49,28 @@ class RENDERER_API Camera : public Object3D {
     /// Computes the view matrix from the current state of the camera
     auto ComputeViewMatrix() const -> Mat4;
 
-    /// Computes the projection matrix from the current state of the camera
+    /// Computes the projection matrix from the current state of the camera.
+    /// With reverse-z enabled, the depth of the view-volume gets mapped into
+    /// [1, 0] (near to far) instead of [-1, 1]
     auto ComputeProjectionMatrix() const -> Mat4;
 
+    /// Computes the six planes of the view frustum of this camera
+    auto ComputeFrustum() const -> Frustum;
+
+    /// Computes the parameters used to cull objects against this camera view
+    /// \param[in] min_screen_size Minimum projected size (fraction of the
+    ///                            viewport height) of the visible objects
+    auto ComputeCullingParams(float min_screen_size = 0.0F) const
+        -> CullingParams;
+
+    /// Computes the ray that goes from the camera through the given point of
+    /// the viewport, given in normalized coordinates: (0, 0) is the top-left
+    /// corner and (1, 1) is the bottom-right corner (e.g. the mouse position
+    /// divided by the window size)
+    /// \param[in] x Horizontal coordinate of the point, in [0, 1]
+    /// \param[in] y Vertical coordinate of the point, in [0, 1]
+    auto ScreenPointToRay(float x, float y) const -> Ray;
+
     /// Computes the basis vectors from the given target point
     auto LookAt(Vec3 point) -> void;
 
@@ -54,6 +80,11 @@ class RENDERER_API Camera : public Object3D {
     /// Returns the string representation of this camera
     RENDERER_NODISCARD auto ToString() const -> std::string override;
 
+ private:
+    /// Computes the projection matrix, either with the reversed depth range
+    /// or with the standard one (which the frustum planes are extracted from)
+    auto _ComputeProjectionMatrix(bool reverse_z) const -> Mat4;
+
  public:
     /// Projection data for this camera's configuration
     CameraData data{};
@@ -61,6 +92,9 @@ class RENDERER_API Camera : public Object3D {
     /// Target point of the camera w.r.t. the world frame
     Vec3 target;
 
+    /// Layers of the objects seen by this camera (all of them by default)
+    uint32_t culling_mask{ALL_LAYERS};
+
     /// Value of the zoom used for this camera
     float zoom{1.0F};
 
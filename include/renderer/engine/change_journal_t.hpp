@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/enums.hpp>
+
+namespace renderer {
+
+class Object3D;
+
+/// Single entry of the change journal of a scene
+struct RENDERER_API SceneChange {
+    /// The kind of change
+    eSceneChange type{eSceneChange::ADDED};
+    /// The object that changed. Expired if the object was destroyed before
+    /// the change was read (its REMOVED entry comes later in the journal)
+    std::weak_ptr<Object3D> object;
+    /// Address of the object, used only to identify it (it might dangle once
+    /// the object is destroyed, so it must not be dereferenced)
+    const Object3D* id{nullptr};
+};
+
+/// Append-only log of the changes made to the objects of a scene. Readers
+/// keep the sequence number of the next entry they have to read, and consume
+/// the entries recorded since then, so the work they do every frame depends
+/// on what changed rather than on the size of the scene. To bound its memory,
+/// the oldest half of the journal is dropped when it reaches its capacity, in
+/// which case readers that fell behind have to resynchronize from scratch
+class RENDERER_API ChangeJournal {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(ChangeJournal)
+
+    DEFINE_SMART_POINTERS(ChangeJournal)
+
+ public:
+    /// Default number of entries kept before dropping the oldest ones
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+    /// Creates an empty journal that keeps at most the given number of entries
+    explicit ChangeJournal(size_t capacity = DEFAULT_CAPACITY);
+
+    ~ChangeJournal() = default;
+
+    /// Appends a change of the given object to the journal
+    auto Record(eSceneChange type, Object3D& object) -> void;
+
+    /// Drops the entries before the given sequence number (e.g. once every
+    /// reader has consumed them)
+    auto Trim(uint64_t sequence) -> void;
+
+    /// Calls the given function with each entry recorded since the given
+    /// sequence number, in order
+    /// \param[in] since Sequence number of the first entry to be read
+    /// \param[in] func Function called as func(const SceneChange&)
+    /// \returns The sequence number the reader should continue from
+    template <typename Func>
+    auto ForEachSince(uint64_t since, Func&& func) const -> uint64_t {
+        const auto FIRST = (since > m_FirstSequence) ? since : m_FirstSequence;
+        for (auto i = static_cast<size_t>(FIRST - m_FirstSequence);
+             i < m_Changes.size(); ++i) {
+            func(m_Changes[i]);
+        }
+        return end_sequence();
+    }
+
+    /// Returns whether or not all entries since the given sequence number are
+    /// still available. If not, the reader has to resynchronize from scratch
+    RENDERER_NODISCARD auto IsAvailable(uint64_t since) const -> bool {
+        return since >= m_FirstSequence;
+    }
+
+    /// Returns the sequence number of the oldest entry still in the journal
+    RENDERER_NODISCARD auto first_sequence() const -> uint64_t {
+        return m_FirstSequence;
+    }
+
+    /// Returns the sequence number the next recorded entry will get
+    RENDERER_NODISCARD auto end_sequence() const -> uint64_t {
+        return m_FirstSequence + m_Changes.size();
+    }
+
+    /// Returns the number of entries currently in the journal
+    RENDERER_NODISCARD auto size() const -> size_t { return m_Changes.size(); }
+
+    /// Returns the maximum number of entries kept by the journal
+    RENDERER_NODISCARD auto capacity() const -> size_t { return m_Capacity; }
+
+    /// Returns a string representation of this journal
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Entries of the journal, starting at m_FirstSequence
+    std::vector<SceneChange> m_Changes;
+
+    /// Sequence number of the first entry in the journal
+    uint64_t m_FirstSequence{0};
+
+    /// Maximum number of entries kept by the journal
+    size_t m_Capacity{DEFAULT_CAPACITY};
+};
+
+}  // namespace renderer
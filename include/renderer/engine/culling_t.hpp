@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/bvh_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+
+namespace renderer {
+
+/// Maximum number of views that can be culled in a single multi-view query
+static constexpr size_t MAX_CULLING_VIEWS = 64;
+
+/// Layers mask that matches every layer
+static constexpr uint32_t ALL_LAYERS = 0xFFFFFFFF;
+
+/// Plane given by the equation dot(normal, p) + d = 0, with its normal
+/// pointing towards the inside of the volume it bounds
+struct RENDERER_API Plane {
+    /// Unit normal of the plane
+    Vec3 normal{0.0F, 0.0F, 1.0F};
+    /// Signed offset of the plane along its normal
+    float d{0.0F};
+
+    /// Returns the signed distance from the given point to this plane
+    RENDERER_NODISCARD auto Distance(const Vec3& point) const -> float {
+        return normal.x() * point.x() + normal.y() * point.y() +
+               normal.z() * point.z() + d;
+    }
+};
+
+/// Result of testing a box against a frustum
+enum class eFrustumTest : uint8_t {
+    OUTSIDE,
+    INTERSECTS,
+    INSIDE,
+};
+
+/// Indices of the planes of a view frustum
+enum class eFrustumPlane : uint8_t {
+    LEFT = 0,
+    RIGHT = 1,
+    BOTTOM = 2,
+    TOP = 3,
+    ZNEAR = 4,
+    ZFAR = 5,
+};
+
+/// View volume of a camera, given by six inward-facing planes
+struct RENDERER_API Frustum {
+    /// The planes of the frustum, indexed by eFrustumPlane
+    std::array<Plane, 6> planes{};
+
+    /// Extracts the planes from a view-projection matrix (Gribb-Hartmann)
+    /// \param[in] view_proj The product of the projection and view matrices
+    static auto FromMatrix(const Mat4& view_proj) -> Frustum;
+
+    /// Returns whether or not the given box is (at least partially) inside
+    RENDERER_NODISCARD auto Intersects(const AABB& box) const -> bool;
+
+    /// Returns whether the given box is outside, fully inside, or crossing
+    /// the boundary of the frustum
+    RENDERER_NODISCARD auto Classify(const AABB& box) const -> eFrustumTest;
+
+    /// Returns a string representation of this frustum
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Bounds of many objects stored as center-extents in a structure of arrays,
+/// such that these can be tested in batches with SIMD instructions. Unused
+/// entries have negative extents, so they always fail the tests
+struct RENDERER_API BoundsArray {
+    std::vector<float> center_x;
+    std::vector<float> center_y;
+    std::vector<float> center_z;
+    std::vector<float> extent_x;
+    std::vector<float> extent_y;
+    std::vector<float> extent_z;
+
+    /// Resizes the arrays. New entries are left unused
+    auto Resize(size_t count) -> void;
+
+    /// Stores the given box at the given index (an empty box marks it unused)
+    auto Set(size_t index, const AABB& box) -> void;
+
+    /// Removes all entries
+    auto Clear() -> void;
+
+    /// Returns the number of entries
+    RENDERER_NODISCARD auto size() const -> size_t { return center_x.size(); }
+};
+
+/// Parameters used to cull a batch of bounds against a camera view
+struct RENDERER_API CullingParams {
+    /// Frustum of the camera
+    Frustum frustum;
+    /// Position of the camera in world space
+    Vec3 eye{0.0F, 0.0F, 0.0F};
+    /// Vertical scale of the projection (element (1, 1) of the matrix)
+    float projection_scale{1.0F};
+    /// Whether or not the projection is perspective (size depends on depth)
+    bool perspective{true};
+    /// Minimum projected size (fraction of the viewport height) to be visible
+    float min_screen_size{0.0F};
+    /// Layers visible from this view (objects in other layers are culled)
+    uint32_t culling_mask{ALL_LAYERS};
+
+    /// Returns whether or not a box of the given bounds is large enough on
+    /// screen to be visible from this view
+    RENDERER_NODISCARD auto PassesScreenSize(const AABB& box) const -> bool;
+};
+
+/// Results of a culling pass
+struct RENDERER_API CullingStats {
+    /// Number of entries that passed all tests
+    size_t num_visible{0};
+    /// Number of entries outside of the frustum (or unused)
+    size_t num_frustum_culled{0};
+    /// Number of entries inside the frustum, but too small on screen
+    size_t num_size_culled{0};
+};
+
+/// Results of culling a BVH against many views in a single traversal
+struct RENDERER_API MultiViewVisibility {
+    /// Visibility bitmask per BVH leaf: bit i is set if visible from view i
+    std::vector<uint64_t> masks;
+    /// Number of objects visible from each view
+    std::vector<size_t> num_visible;
+    /// Number of BVH nodes visited during the traversal
+    size_t num_nodes_visited{0};
+
+    /// Returns whether or not the given leaf is visible from the given view
+    RENDERER_NODISCARD auto IsVisible(BvhLeafId leaf_id, size_t view) const
+        -> bool {
+        return ((masks[leaf_id] >> view) & 1U) != 0;
+    }
+};
+
+/// Culls the objects of a BVH against all the given views at once. Each node
+/// is tested only against the views for which its parent straddles the
+/// frustum boundary, so views that fully contain (or miss) a branch cost
+/// nothing further down of it. Objects whose layers don't match the culling
+/// mask of a view are hidden from that view
+/// \param[in] bvh The hierarchy to be traversed
+/// \param[in] views The parameters of each view (at most MAX_CULLING_VIEWS)
+/// \param[in] num_views The number of views
+/// \param[out] result The per-object visibility masks and per-view counts
+RENDERER_API auto CullBvhMultiView(const BVH& bvh, const CullingParams* views,
+                                   size_t num_views,
+                                   MultiViewVisibility& result) -> void;
+
+/// Tests all bounds of the given array against the frustum and screen size
+/// threshold, using the widest SIMD instructions available at build time
+/// \param[in] params The parameters of the camera view
+/// \param[in] bounds The bounds to be tested
+/// \param[out] visible Buffer (same size as bounds) set to 1 for visible items
+RENDERER_API auto CullBounds(const CullingParams& params,
+                             const BoundsArray& bounds, uint8_t* visible)
+    -> CullingStats;
+
+/// Scalar version of CullBounds (reference, and fallback for other arches)
+RENDERER_API auto CullBoundsScalar(const CullingParams& params,
+                                   const BoundsArray& bounds, uint8_t* visible)
+    -> CullingStats;
+
+}  // namespace renderer
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/material_t.hpp>
+#include <renderer/engine/object_t.hpp>
+
+namespace renderer {
+
+class Scene;
+
+/// Index used for draw slots that don't exist
+static constexpr uint32_t INVALID_DRAW_SLOT =
+    std::numeric_limits<uint32_t>::max();
+
+/// Single entry of a draw list
+struct RENDERER_API DrawItem {
+    /// The mesh to be drawn
+    Object3D* object{nullptr};
+    /// The geometry of the mesh
+    const Geometry* geometry{nullptr};
+    /// The material of the mesh (nullptr for the default material)
+    const Material* material{nullptr};
+    /// Key used to order the items, such that similar draws end up together
+    uint64_t sort_key{0};
+    /// Slot of the world transform of the mesh in the transforms buffer
+    uint32_t slot{INVALID_DRAW_SLOT};
+};
+
+/// Returns the key used to order a draw with the given material and geometry.
+/// Opaque draws go first, and then draws are grouped by material and geometry
+RENDERER_API auto ComputeDrawSortKey(const Material* material,
+                                     const Geometry* geometry) -> uint64_t;
+
+/// Retained list of the meshes of a scene, sorted by state, along with a
+/// buffer with their world transforms. Instead of being rebuilt every frame,
+/// the list is patched with the changes recorded in the journal of the scene,
+/// so keeping it up to date costs in proportion to what changed
+class RENDERER_API DrawList {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(DrawList)
+
+    DEFINE_SMART_POINTERS(DrawList)
+
+ public:
+    /// Number of floats used by each transform (column-major 4x4 matrix)
+    static constexpr size_t FLOATS_PER_TRANSFORM = 16;
+
+    DrawList() = default;
+
+    ~DrawList() = default;
+
+    /// Brings the list up to date with the given scene, applying the changes
+    /// recorded in its journal since the last call (or rebuilding the list if
+    /// it has never seen this scene, or has fallen behind its journal)
+    auto Sync(const Scene& scene) -> void;
+
+    /// Rebuilds the list from scratch, walking the whole scene
+    auto Rebuild(const Scene& scene) -> void;
+
+    /// Drops all entries of the list
+    auto Clear() -> void;
+
+    /// Returns the items of the list, sorted by their keys
+    RENDERER_NODISCARD auto items() const -> const std::vector<DrawItem>& {
+        return m_Items;
+    }
+
+    /// Returns the world transforms of the meshes, indexed by slot
+    RENDERER_NODISCARD auto transforms() const -> const std::vector<float>& {
+        return m_Transforms;
+    }
+
+    /// Returns the slots whose transforms were written by the last call to
+    /// Sync, i.e. the ranges that have to be uploaded to the GPU. Slots of
+    /// meshes whose material (or tint) changed are rewritten too, so copies
+    /// of per-mesh data kept along with the transforms can be patched alike
+    RENDERER_NODISCARD auto dirty_slots() const
+        -> const std::vector<uint32_t>& {
+        return m_DirtySlots;
+    }
+
+    /// Returns the number of slots used by the transforms buffer
+    RENDERER_NODISCARD auto num_slots() const -> size_t {
+        return m_SlotItems.size();
+    }
+
+    /// Returns the number of journal entries applied by the last call to Sync
+    RENDERER_NODISCARD auto num_changes_applied() const -> size_t {
+        return m_NumChangesApplied;
+    }
+
+    /// Returns whether or not the last call to Sync had to rebuild the list
+    RENDERER_NODISCARD auto rebuilt() const -> bool { return m_Rebuilt; }
+
+    /// Returns a counter bumped every time the set of items (or their order)
+    /// changes, such that data derived from the items can be rebuilt lazily
+    RENDERER_NODISCARD auto items_version() const -> uint64_t {
+        return m_ItemsVersion;
+    }
+
+    /// Returns a string representation of this list
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Adds the given mesh to the list (if it's drawable)
+    auto _Add(Object3D* object) -> void;
+
+    /// Drops the given object from the list (if it's in there)
+    auto _Remove(const Object3D* object) -> void;
+
+    /// Refreshes the geometry, material and transform of the given object
+    auto _Refresh(Object3D* object) -> void;
+
+    /// Writes the world transform of the given object into its slot
+    auto _WriteTransform(const Object3D& object, uint32_t slot) -> void;
+
+    /// Compacts and sorts the items, if their set or their keys changed
+    auto _SortItems() -> void;
+
+ private:
+    /// The scene this list mirrors
+    const Scene* m_Scene{nullptr};
+
+    /// Sequence number of the next entry to read from the scene journal
+    uint64_t m_Sequence{0};
+
+    /// Items of the list, sorted by their keys
+    std::vector<DrawItem> m_Items;
+
+    /// Item stored in each slot (object is nullptr for free slots)
+    std::vector<DrawItem> m_SlotItems;
+
+    /// Slot used by each object in the list
+    std::unordered_map<const Object3D*, uint32_t> m_Object2Slot;
+
+    /// Slots that are free to be reused
+    std::vector<uint32_t> m_FreeSlots;
+
+    /// World transforms of the meshes, indexed by slot
+    std::vector<float> m_Transforms;
+
+    /// Slots whose transform was written by the last call to Sync
+    std::vector<uint32_t> m_DirtySlots;
+
+    /// Sync count at which each slot was last marked as dirty
+    std::vector<uint64_t> m_SlotDirtyStamp;
+
+    /// Number of calls to Sync so far (used to stamp dirty slots)
+    uint64_t m_SyncCount{0};
+
+    /// Whether or not the set of items or their keys changed
+    bool m_ItemsDirty{false};
+
+    /// Number of journal entries applied by the last call to Sync
+    size_t m_NumChangesApplied{0};
+
+    /// Whether or not the last call to Sync had to rebuild the list
+    bool m_Rebuilt{false};
+
+    /// Number of times the set of items (or their order) changed
+    uint64_t m_ItemsVersion{0};
+};
+
+}  // namespace renderer
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Phases of a render call on the CPU, timed separately in the frame stats
+enum class eFramePhase : uint8_t {
+    /// Patching the draw list with the changes made to the scene
+    SYNC = 0,
+    /// Culling the objects of the scene against the camera view
+    CULL = 1,
+    /// Building and sorting the render queue
+    QUEUE = 2,
+    /// Splitting the queue into batches and writing their instances
+    BATCH = 3,
+    /// Submitting the batches to the graphics API
+    SUBMIT = 4,
+    /// Rendering the debug primitives
+    DEBUG = 5,
+    /// Computing the shadow cascades and submitting their casters
+    SHADOW = 6,
+    /// Assigning the point and spot lights to the clusters of the view
+    LIGHTS = 7,
+};
+
+/// Number of phases of a render call timed on the CPU
+static constexpr size_t NUM_FRAME_PHASES = 8;
+
+/// Passes of a frame on the GPU, timed separately in the frame stats
+enum class eFramePass : uint8_t {
+    /// Depth-only pass over the opaque meshes of the scene (when enabled)
+    DEPTH_PREPASS = 0,
+    /// Meshes of the scene
+    SCENE = 1,
+    /// Debug primitives, drawn on top of the scene
+    DEBUG = 2,
+    /// Shadow maps of the directional light, drawn before the scene
+    SHADOW = 3,
+};
+
+/// Number of passes of a frame timed on the GPU
+static constexpr size_t NUM_FRAME_PASSES = 4;
+
+/// Default number of frames kept in a history of frame stats
+static constexpr size_t DEFAULT_FRAME_STATS_HISTORY = 120;
+
+RENDERER_API auto ToString(eFramePhase phase) -> std::string;
+
+RENDERER_API auto ToString(eFramePass pass) -> std::string;
+
+/// Statistics gathered during a render call
+struct RENDERER_API FrameStats {
+    /// Index of the frame these stats were gathered in
+    uint64_t frame_index{0};
+    /// Number of objects with bounds considered for rendering
+    size_t num_objects{0};
+    /// Number of objects that passed the culling tests
+    size_t num_visible{0};
+    /// Number of objects outside of the camera frustum
+    size_t num_frustum_culled{0};
+    /// Number of objects in the frustum, but too small on screen
+    size_t num_size_culled{0};
+    /// Number of meshes rasterized as occluders (when occlusion culling is on)
+    size_t num_occluders{0};
+    /// Number of objects in the frustum, but hidden behind the occluders
+    size_t num_occlusion_culled{0};
+    /// Number of items in the retained draw list
+    size_t num_draw_items{0};
+    /// Number of scene changes applied to the draw list this frame
+    size_t num_changes_applied{0};
+    /// Number of instance transforms patched this frame
+    size_t num_transforms_patched{0};
+    /// Number of draw calls submitted this frame (debug primitives included)
+    size_t num_draw_calls{0};
+    /// Number of meshes drawn this frame (as instances of the draw calls)
+    size_t num_instances{0};
+    /// Number of triangles drawn this frame, over all instances
+    size_t num_triangles{0};
+    /// Number of times a different shader program was bound this frame
+    size_t num_program_changes{0};
+    /// Number of times a different material was bound this frame
+    size_t num_material_changes{0};
+    /// Number of times a different texture was bound this frame
+    size_t num_texture_changes{0};
+    /// Number of times a different vertex array was bound this frame
+    size_t num_vao_changes{0};
+    /// Number of state changes issued to the graphics API this frame
+    size_t num_state_changes{0};
+    /// Number of redundant state changes skipped this frame
+    size_t num_elided_state_changes{0};
+    /// Number of bytes uploaded to the GPU this frame (geometries, instances,
+    /// uniforms and debug primitives)
+    size_t num_bytes_uploaded{0};
+    /// Number of meshes drawn into the shadow maps this frame, over all
+    /// cascades (static casters count only when their layer gets redrawn)
+    size_t num_shadow_casters{0};
+    /// Number of cached layers of static casters redrawn this frame
+    size_t num_shadow_layers_redrawn{0};
+    /// Number of point and spot lights assigned to the clusters of the view
+    /// (when clustered lighting is on)
+    size_t num_clustered_lights{0};
+    /// Number of entries of the lists of lights of all clusters
+    size_t num_light_assignments{0};
+    /// Time spent (in milliseconds) on each phase, indexed by eFramePhase
+    std::array<float, NUM_FRAME_PHASES> cpu_time_ms{};
+    /// Time spent (in milliseconds) by the GPU on each pass, indexed by
+    /// eFramePass. Measured in the frame given by gpu_frame_index
+    std::array<float, NUM_FRAME_PASSES> gpu_time_ms{};
+    /// Index of the frame the GPU times were measured in. GPU timings are read
+    /// back a few frames later (to avoid stalls), so they lag behind the rest
+    /// of the stats. It's 0 when no timings are available yet
+    uint64_t gpu_frame_index{0};
+
+    /// Returns the time spent (in milliseconds) on the given phase
+    RENDERER_NODISCARD auto cpu_time(eFramePhase phase) const -> float {
+        return cpu_time_ms.at(static_cast<size_t>(phase));
+    }
+
+    /// Returns the time spent (in milliseconds) by the GPU on the given pass
+    RENDERER_NODISCARD auto gpu_time(eFramePass pass) const -> float {
+        return gpu_time_ms.at(static_cast<size_t>(pass));
+    }
+
+    /// Returns the time spent (in milliseconds) on all phases
+    RENDERER_NODISCARD auto cpu_total_ms() const -> float;
+
+    /// Returns the time spent (in milliseconds) by the GPU on all passes
+    RENDERER_NODISCARD auto gpu_total_ms() const -> float;
+
+    /// Returns a string representation of these stats
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Rolling history of the stats of the last frames, oldest first
+class RENDERER_API FrameStatsHistory {
+ public:
+    /// Creates an empty history with room for the given number of frames
+    explicit FrameStatsHistory(
+        size_t capacity = DEFAULT_FRAME_STATS_HISTORY);
+
+    /// Adds the stats of a frame, dropping the oldest ones if full
+    auto Push(const FrameStats& stats) -> void;
+
+    /// Removes the stats of all frames
+    auto Clear() -> void;
+
+    /// Changes the number of frames kept, dropping the oldest ones if needed
+    auto SetCapacity(size_t capacity) -> void;
+
+    /// Returns the mean time (in milliseconds) spent on the given phase
+    RENDERER_NODISCARD auto ComputeMeanCpuTime(eFramePhase phase) const
+        -> float;
+
+    /// Returns the mean time (in milliseconds) spent by the GPU on the given
+    /// pass, over the frames that had GPU timings available
+    RENDERER_NODISCARD auto ComputeMeanGpuTime(eFramePass pass) const -> float;
+
+    /// Returns the mean time (in milliseconds) spent on all phases
+    RENDERER_NODISCARD auto ComputeMeanCpuTotal() const -> float;
+
+    /// Returns the largest time (in milliseconds) spent on all phases
+    RENDERER_NODISCARD auto ComputeMaxCpuTotal() const -> float;
+
+    /// Returns the stats of the given frame (0 is the oldest one)
+    RENDERER_NODISCARD auto operator[](size_t index) const
+        -> const FrameStats&;
+
+    /// Returns the stats of the most recent frame (the history can't be empty)
+    RENDERER_NODISCARD auto latest() const -> const FrameStats&;
+
+    /// Returns the number of frames in the history
+    RENDERER_NODISCARD auto size() const -> size_t { return m_Frames.size(); }
+
+    /// Returns the maximum number of frames kept
+    RENDERER_NODISCARD auto capacity() const -> size_t { return m_Capacity; }
+
+    /// Returns whether or not the history has no frames
+    RENDERER_NODISCARD auto empty() const -> bool { return m_Frames.empty(); }
+
+    /// Returns a string representation of this history
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Stats of the frames, stored as a ring once full
+    std::vector<FrameStats> m_Frames;
+
+    /// Position of the oldest frame in the ring
+    size_t m_Head{0};
+
+    /// Maximum number of frames kept
+    size_t m_Capacity{DEFAULT_FRAME_STATS_HISTORY};
+};
+
+}  // namespace renderer
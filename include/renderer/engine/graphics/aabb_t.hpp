@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Axis-aligned bounding box, given by its min and max corners. A default
+/// constructed box is empty (inverted), so it can be grown by expanding it
+struct RENDERER_API AABB {
+    /// Minimum corner of the box
+    Vec3 min{std::numeric_limits<float>::max(),
+             std::numeric_limits<float>::max(),
+             std::numeric_limits<float>::max()};
+
+    /// Maximum corner of the box
+    Vec3 max{std::numeric_limits<float>::lowest(),
+             std::numeric_limits<float>::lowest(),
+             std::numeric_limits<float>::lowest()};
+
+    /// Creates an empty box
+    AABB() = default;
+
+    /// Creates a box with the given corners
+    AABB(const Vec3& p_min, const Vec3& p_max) : min(p_min), max(p_max) {}
+
+    /// Returns whether or not this box contains no points at all
+    RENDERER_NODISCARD auto empty() const -> bool {
+        return min.x() > max.x() || min.y() > max.y() || min.z() > max.z();
+    }
+
+    /// Grows this box to contain the given point
+    auto Expand(const Vec3& point) -> void {
+        min = {std::min(min.x(), point.x()), std::min(min.y(), point.y()),
+               std::min(min.z(), point.z())};
+        max = {std::max(max.x(), point.x()), std::max(max.y(), point.y()),
+               std::max(max.z(), point.z())};
+    }
+
+    /// Grows this box to contain the given box
+    auto Expand(const AABB& other) -> void {
+        if (other.empty()) {
+            return;
+        }
+        Expand(other.min);
+        Expand(other.max);
+    }
+
+    /// Returns the center of the box
+    RENDERER_NODISCARD auto center() const -> Vec3 {
+        return 0.5F * (min + max);
+    }
+
+    /// Returns the half-sizes of the box along each axis
+    RENDERER_NODISCARD auto extents() const -> Vec3 {
+        return 0.5F * (max - min);
+    }
+
+    /// Returns the surface area of the box (zero if empty)
+    RENDERER_NODISCARD auto surface_area() const -> float {
+        if (empty()) {
+            return 0.0F;
+        }
+        const auto SIZE = max - min;
+        return 2.0F * (SIZE.x() * SIZE.y() + SIZE.y() * SIZE.z() +
+                       SIZE.z() * SIZE.x());
+    }
+
+    /// Returns whether or not this box overlaps with the given box
+    RENDERER_NODISCARD auto Intersects(const AABB& other) const -> bool {
+        return min.x() <= other.max.x() && max.x() >= other.min.x() &&
+               min.y() <= other.max.y() && max.y() >= other.min.y() &&
+               min.z() <= other.max.z() && max.z() >= other.min.z();
+    }
+
+    /// Returns whether or not this box contains the given point
+    RENDERER_NODISCARD auto Contains(const Vec3& point) const -> bool {
+        return point.x() >= min.x() && point.x() <= max.x() &&
+               point.y() >= min.y() && point.y() <= max.y() &&
+               point.z() >= min.z() && point.z() <= max.z();
+    }
+
+    /// Returns the box enclosing this box after being transformed by the
+    /// given homogeneous transform (Arvo's method, no corners expansion)
+    RENDERER_NODISCARD auto Transformed(const Mat4& transform) const -> AABB;
+
+    /// Returns the smallest box containing both given boxes
+    static auto Union(const AABB& lhs, const AABB& rhs) -> AABB {
+        AABB result = lhs;
+        result.Expand(rhs);
+        return result;
+    }
+
+    /// Returns a string representation of this box
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Returns whether or not both boxes have exactly the same corners
+inline auto operator==(const AABB& lhs, const AABB& rhs) -> bool {
+    return lhs.min == rhs.min && lhs.max == rhs.max;
+}
+
+/// Returns whether or not the boxes have different corners
+inline auto operator!=(const AABB& lhs, const AABB& rhs) -> bool {
+    return !(lhs == rhs);
+}
+
+}  // namespace renderer
@@ -141,6 +141,18 @@ enum class eObjectType : uint8_t {
 /// Returns a string representation of the given object type enum
 RENDERER_API auto ToString(eObjectType type) -> std::string;
 
+/// Kinds of changes recorded in the change journal of a scene
+enum class eSceneChange : uint8_t {
+    ADDED,               //< The object was added to the scene
+    REMOVED,             //< The object was removed from the scene
+    POSE_CHANGED,        //< The world transform of the object changed
+    MATERIAL_CHANGED,    //< The material of the object changed
+    VISIBILITY_CHANGED,  //< The visibility or the layers of the object changed
+};
+
+/// Returns a string representation of the given scene change enum
+RENDERER_API auto ToString(eSceneChange change) -> std::string;
+
 /// Available projection types
 enum class eProjectionType {
     PERSPECTIVE,  //< Pin-hole perspective-like camera
@@ -1,13 +1,30 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <renderer/common.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
 #include <renderer/engine/graphics/buffer_attribute_t.hpp>
+#include <renderer/engine/graphics/triangle_bvh_t.hpp>
 
 namespace renderer {
 
+/// Coarser level of detail of a geometry, drawn with its own indices over the
+/// vertices of the geometry
+struct RENDERER_API GeometryLod {
+    /// Offset of the first index of the level in the indices of the levels
+    size_t first_index{0};
+    /// Number of indices of the level
+    size_t num_indices{0};
+    /// Largest distance between the surface of the level and the one of the
+    /// full geometry (in the units of the positions)
+    float32_t error{0.0F};
+};
+
 class RENDERER_API Geometry {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(Geometry)
@@ -52,6 +69,58 @@ class RENDERER_API Geometry {
     /// \param[in] data A pointer to the
     auto SetIndices(size_t n_indices, const uint32_t* data) -> void;
 
+    /// Appends a coarser level of detail, given by a list of triangles over
+    /// the vertices of this geometry. Levels go from finest to coarsest, so
+    /// their errors can't decrease (the full geometry is level 0, error 0).
+    /// Renderers copy the levels along with the vertices, and copy both again
+    /// once the levels change (see lod_version)
+    /// \param[in] n_indices The number of indices of the level
+    /// \param[in] data A pointer to the indices of the level
+    /// \param[in] error The geometric error of the level (see GeometryLod)
+    auto AddLod(size_t n_indices, const uint32_t* data, float32_t error)
+        -> void;
+
+    /// Removes all the coarser levels of detail
+    auto ClearLods() -> void;
+
+    /// Returns the number of levels of detail, including the full geometry
+    RENDERER_NODISCARD auto num_lods() const -> size_t {
+        return 1 + m_Lods.size();
+    }
+
+    /// Returns the geometric error of the given level of detail (0 for the
+    /// full geometry)
+    RENDERER_NODISCARD auto lod_error(size_t level) const -> float32_t {
+        return (level == 0) ? 0.0F : m_Lods.at(level - 1).error;
+    }
+
+    /// Returns the coarser levels of detail (level 1 onwards)
+    RENDERER_NODISCARD auto lods() const -> const std::vector<GeometryLod>& {
+        return m_Lods;
+    }
+
+    /// Returns the indices of all the coarser levels of detail, one after the
+    /// other
+    RENDERER_NODISCARD auto lod_indices() const
+        -> const std::vector<uint32_t>& {
+        return m_LodIndices;
+    }
+
+    /// Returns the number of times the levels of detail changed, to detect
+    /// stale copies of them
+    RENDERER_NODISCARD auto lod_version() const -> uint64_t {
+        return m_LodVersion;
+    }
+
+    /// Recomputes the bounds of this geometry from its "position" attribute.
+    /// Must be called again if the positions are modified afterwards (it also
+    /// drops the triangle hierarchy, so it gets rebuilt on its next use)
+    auto ComputeBounds() -> void;
+
+    /// Returns the hierarchy over the triangles of this geometry, which is
+    /// built on first use (safe to call from several threads at once)
+    RENDERER_NODISCARD auto triangle_bvh() const -> const TriangleBVH&;
+
     /// Returns whether or not the attribute with given name exists
     RENDERER_NODISCARD auto HasAttribute(const std::string& name) const -> bool;
 
@@ -64,6 +133,9 @@ class RENDERER_API Geometry {
         return m_NumVertices;
     }
 
+    /// Returns the bounds of this geometry in its local frame
+    RENDERER_NODISCARD auto bounds() const -> const AABB& { return m_Bounds; }
+
  public:
     /// Storage for buffer attributes
     std::unordered_map<std::string, Float32BufferAttribute::uptr> attributes;
@@ -74,6 +146,27 @@ class RENDERER_API Geometry {
  protected:
     /// The number of vertices stored
     size_t m_NumVertices{0};
+
+    /// The bounds of the vertex positions of this geometry
+    AABB m_Bounds;
+
+    /// Coarser levels of detail (level 1 onwards)
+    std::vector<GeometryLod> m_Lods;
+
+    /// Indices of the coarser levels of detail, one after the other
+    std::vector<uint32_t> m_LodIndices;
+
+    /// Number of times the levels of detail changed
+    uint64_t m_LodVersion{0};
+
+    /// Hierarchy over the triangles, used for ray queries (built lazily)
+    mutable TriangleBVH::uptr m_TriangleBvh{nullptr};
+
+    /// Whether or not the triangle hierarchy has already been built
+    mutable std::atomic<bool> m_TriangleBvhReady{false};
+
+    /// Guards the lazy construction of the triangle hierarchy
+    mutable std::mutex m_TriangleBvhMutex;
 };
 
 }  // namespace renderer
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+
+namespace renderer {
+
+class ThreadPool;
+
+/// Options of the simplification of a geometry into levels of detail
+struct RENDERER_API SimplifyOptions {
+    /// Target fractions of the triangles of the geometry, one per level, from
+    /// finest to coarsest
+    std::vector<float> ratios{0.5F, 0.25F, 0.1F};
+    /// Weight of the differences of the attributes (normals and UVs) in the
+    /// cost of a collapse, w.r.t. the geometric error (measured in units of
+    /// the size of the geometry)
+    float attribute_weight{0.5F};
+    /// Whether or not the vertices on the open borders of the surface are
+    /// kept. Otherwise, these are kept close to the borders by the costs
+    bool lock_borders{true};
+    /// Largest geometric error of a level, as a fraction of the size of the
+    /// geometry. Levels stop short of their target once over it
+    float max_error{1.0F};
+
+    /// Returns the string representation of these options
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Level of detail produced by the simplifier
+struct RENDERER_API SimplifiedLod {
+    /// Indices of the triangles of the level, over the vertices of the
+    /// geometry it was simplified from
+    std::vector<uint32_t> indices;
+    /// Geometric error of the level (in the units of the positions)
+    float32_t error{0.0F};
+};
+
+/// Simplifies the triangles of the given geometry into a chain of levels of
+/// detail, collapsing edges in the order of their quadric error (Garland and
+/// Heckbert 1997) plus the differences of the attributes of their vertices.
+///
+/// Vertices are never moved nor created: each edge collapses into one of its
+/// ends, so the levels index the vertices of the geometry, and can be drawn
+/// from the same vertex buffer. Vertices at the same position are welded, so
+/// seams of the attributes don't stop the collapses. Each level continues the
+/// simplification of the previous one, so errors never decrease along the
+/// chain. Levels that couldn't get any coarser than the previous one are left
+/// out of the chain
+RENDERER_API auto SimplifyGeometry(const Geometry& geometry,
+                                   const SimplifyOptions& options = {})
+    -> std::vector<SimplifiedLod>;
+
+/// Simplifies the given geometry and sets the resulting chain as its levels
+/// of detail (replacing the ones it had)
+/// \returns The number of levels added
+RENDERER_API auto GenerateLods(Geometry& geometry,
+                               const SimplifyOptions& options = {}) -> size_t;
+
+/// Generates the levels of detail of many geometries, spread across the
+/// threads of the pool (if given). Each geometry is simplified by a single
+/// thread, so the results match the ones of a serial run
+RENDERER_API auto GenerateLods(const std::vector<Geometry::ptr>& geometries,
+                               const SimplifyOptions& options = {},
+                               ThreadPool* pool = nullptr) -> void;
+
+}  // namespace renderer
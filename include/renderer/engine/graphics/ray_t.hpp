@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+
+namespace renderer {
+
+class Object3D;
+
+/// Index used for hits that don't reference any triangle
+static constexpr uint32_t INVALID_TRIANGLE =
+    std::numeric_limits<uint32_t>::max();
+
+/// Half-line given by an origin and a (unit) direction
+struct RENDERER_API Ray {
+    /// Start point of the ray
+    Vec3 origin{0.0F, 0.0F, 0.0F};
+    /// Direction of the ray (expected to be normalized)
+    Vec3 direction{0.0F, 0.0F, 1.0F};
+
+    /// Returns the point at the given distance along the ray
+    RENDERER_NODISCARD auto At(float distance) const -> Vec3 {
+        return origin + distance * direction;
+    }
+};
+
+/// Result of casting a ray against a scene
+struct RENDERER_API RaycastHit {
+    /// The object that was hit (nullptr if nothing was hit)
+    Object3D* object{nullptr};
+    /// Distance along the ray to the hit point
+    float distance{std::numeric_limits<float>::max()};
+    /// Index of the triangle of the object's geometry that was hit
+    uint32_t triangle{INVALID_TRIANGLE};
+    /// Hit point in world space
+    Vec3 point{0.0F, 0.0F, 0.0F};
+
+    /// Returns whether or not the ray hit something
+    RENDERER_NODISCARD auto hit() const -> bool { return object != nullptr; }
+
+    /// Returns a string representation of this hit
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Returns the distance at which the ray enters the box (slab test), or a
+/// negative value if it misses it within [0, max_distance]
+/// \param[in] origin The origin of the ray
+/// \param[in] inv_dir The component-wise inverse of the ray direction
+/// \param[in] box The box to be tested
+/// \param[in] max_distance The maximum distance along the ray to consider
+inline auto IntersectRayAABB(const Vec3& origin, const Vec3& inv_dir,
+                             const AABB& box, float max_distance) -> float {
+    float t_min = 0.0F;
+    float t_max = max_distance;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        const float T_0 = (box.min[axis] - origin[axis]) * inv_dir[axis];
+        const float T_1 = (box.max[axis] - origin[axis]) * inv_dir[axis];
+        // Written this way so NaNs (0 * inf on the slab boundary) are ignored
+        t_min = std::max(t_min, std::min(T_0, T_1));
+        t_max = std::min(t_max, std::max(T_0, T_1));
+    }
+    return (t_min <= t_max) ? t_min : -1.0F;
+}
+
+/// Returns the distance at which the ray hits the triangle (Moller-Trumbore,
+/// double sided), or a negative value if it misses it
+inline auto IntersectRayTriangle(const Ray& ray, const Vec3& v0,
+                                 const Vec3& v1, const Vec3& v2) -> float {
+    constexpr float EPSILON = 1e-8F;
+    const auto EDGE_1 = v1 - v0;
+    const auto EDGE_2 = v2 - v0;
+    const auto P_VEC = ::math::cross<float>(ray.direction, EDGE_2);
+    const float DET = ::math::dot<float>(EDGE_1, P_VEC);
+    if (std::abs(DET) < EPSILON) {
+        return -1.0F;  // ray parallel to the triangle
+    }
+    const float INV_DET = 1.0F / DET;
+    const auto T_VEC = ray.origin - v0;
+    const float U = ::math::dot<float>(T_VEC, P_VEC) * INV_DET;
+    if (U < 0.0F || U > 1.0F) {
+        return -1.0F;
+    }
+    const auto Q_VEC = ::math::cross<float>(T_VEC, EDGE_1);
+    const float V = ::math::dot<float>(ray.direction, Q_VEC) * INV_DET;
+    if (V < 0.0F || U + V > 1.0F) {
+        return -1.0F;
+    }
+    return ::math::dot<float>(EDGE_2, Q_VEC) * INV_DET;
+}
+
+/// Returns the component-wise inverse of the given direction
+inline auto InverseDirection(const Vec3& direction) -> Vec3 {
+    return {1.0F / direction.x(), 1.0F / direction.y(), 1.0F / direction.z()};
+}
+
+}  // namespace renderer
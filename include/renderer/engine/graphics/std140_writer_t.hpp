@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Base alignment (in bytes) of vec4s, matrix columns, structs and array
+/// elements in the std140 layout
+static constexpr uint32_t STD140_VEC4_ALIGNMENT = 16;
+
+/// Helper used to pack the members of a uniform block following the std140
+/// layout rules, such that the result can be uploaded as is into a uniform
+/// buffer. Members must be written in the order they're declared in the block.
+///
+/// Scalars are aligned to 4 bytes, vec2s to 8 bytes, and vec3s and vec4s to 16
+/// bytes (vec3s still take 12 bytes, so a scalar can follow them). Matrices
+/// are written as 4 vec4 columns. Each struct (or element of an array of
+/// structs) has to be enclosed by BeginStruct and EndStruct, which align its
+/// start and end to 16 bytes
+class RENDERER_API Std140Writer {
+    // cppcheck-suppress unknownMacro
+    DEFAULT_COPY_AND_MOVE_AND_ASSIGN(Std140Writer)
+
+    DEFINE_SMART_POINTERS(Std140Writer)
+
+ public:
+    /// Creates an empty writer
+    Std140Writer() = default;
+
+    /// Releases the data written so far
+    ~Std140Writer() = default;
+
+    /// Drops all the data written so far, keeping the allocated memory
+    auto Clear() -> void;
+
+    /// Writes a float member, and returns its offset (in bytes)
+    auto Write(float32_t value) -> uint32_t;
+
+    /// Writes an int member, and returns its offset (in bytes)
+    auto Write(int32_t value) -> uint32_t;
+
+    /// Writes a vec2 member, and returns its offset (in bytes)
+    auto Write(const Vec2& value) -> uint32_t;
+
+    /// Writes a vec3 member, and returns its offset (in bytes)
+    auto Write(const Vec3& value) -> uint32_t;
+
+    /// Writes a vec4 member, and returns its offset (in bytes)
+    auto Write(const Vec4& value) -> uint32_t;
+
+    /// Writes a mat4 member (column-major), and returns its offset (in bytes)
+    auto Write(const Mat4& value) -> uint32_t;
+
+    /// Starts a struct member (or an element of an array of structs), and
+    /// returns its offset (in bytes)
+    auto BeginStruct() -> uint32_t;
+
+    /// Finishes the current struct member, padding it to its full size
+    auto EndStruct() -> void;
+
+    /// Pads the data written so far up to the given alignment (in bytes), and
+    /// returns the resulting size
+    auto Align(uint32_t alignment) -> uint32_t;
+
+    /// Returns a pointer to the data written so far
+    RENDERER_NODISCARD auto data() const -> const uint8_t* {
+        return m_Data.data();
+    }
+
+    /// Returns the size (in bytes) of the data written so far
+    RENDERER_NODISCARD auto size() const -> uint32_t {
+        return static_cast<uint32_t>(m_Data.size());
+    }
+
+    /// Returns a string representation of this writer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Aligns the data to the given alignment, and then copies the given bytes
+    /// at the end of it. Returns the offset the bytes were copied at
+    auto _Append(uint32_t alignment, const void* bytes, uint32_t num_bytes)
+        -> uint32_t;
+
+ private:
+    /// Data of the block written so far
+    std::vector<uint8_t> m_Data;
+};
+
+}  // namespace renderer
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+#include <renderer/engine/graphics/ray_t.hpp>
+
+namespace renderer {
+
+class Geometry;
+
+/// Bottom-level bounding volume hierarchy over the triangles of a geometry,
+/// used for ray queries against its surface (in the geometry's local frame)
+class RENDERER_API TriangleBVH {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(TriangleBVH)
+
+    DEFINE_SMART_POINTERS(TriangleBVH)
+
+ public:
+    /// Maximum number of triangles stored in a leaf node
+    static constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+
+    /// Node of the tree. Leaves reference a range of the triangles array,
+    /// internal nodes have their left child right after them
+    struct Node {
+        /// Bounds of the triangles down this node
+        AABB bounds;
+        /// First triangle (leaves) or index of the right child (internal)
+        uint32_t offset{0};
+        /// Number of triangles (zero for internal nodes)
+        uint32_t count{0};
+    };
+
+    /// Builds the hierarchy over the triangles of the given geometry. If the
+    /// geometry has no indices, each three consecutive vertices form one
+    explicit TriangleBVH(const Geometry& geometry);
+
+    ~TriangleBVH() = default;
+
+    /// Finds the closest hit of the ray within [0, max_distance]
+    /// \param[in] ray The ray to be tested, in the frame of the geometry
+    /// \param[in] max_distance The maximum distance along the ray
+    /// \param[out] distance The distance to the closest hit (if any)
+    /// \param[out] triangle The index of the triangle that was hit (if any)
+    /// \returns Whether or not the ray hit any triangle
+    auto Intersect(const Ray& ray, float max_distance, float& distance,
+                   uint32_t& triangle) const -> bool;
+
+    /// Returns the number of triangles in the hierarchy
+    RENDERER_NODISCARD auto num_triangles() const -> size_t {
+        return m_Triangles.size();
+    }
+
+    /// Returns an unmutable reference to the nodes of the hierarchy
+    RENDERER_NODISCARD auto nodes() const -> const std::vector<Node>& {
+        return m_Nodes;
+    }
+
+    /// Returns a string representation of this hierarchy
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Triangle stored by its vertices, along with its index in the geometry
+    struct Triangle {
+        Vec3 v0;
+        Vec3 v1;
+        Vec3 v2;
+        uint32_t index{0};
+    };
+
+    /// Builds the subtree over the triangles in [first, first + count)
+    auto _BuildRecursive(uint32_t first, uint32_t count) -> uint32_t;
+
+ private:
+    /// Triangles of the geometry, sorted such that leaves reference ranges
+    std::vector<Triangle> m_Triangles;
+
+    /// Nodes of the hierarchy (root at index 0)
+    std::vector<Node> m_Nodes;
+};
+
+}  // namespace renderer
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+#include <renderer/engine/light_t.hpp>
+
+namespace renderer {
+
+class ThreadPool;
+
+/// Value returned for points that don't fall into any cluster
+static constexpr uint32_t INVALID_CLUSTER = 0xFFFFFFFF;
+
+/// Settings of the clustered assignment of the point and spot lights
+struct RENDERER_API LightClusterSettings {
+    /// Whether or not the point and spot lights get assigned to clusters.
+    /// Otherwise, every fragment loops over the first few lights of the scene
+    bool enabled{false};
+    /// Number of tiles the view gets split into, horizontally
+    uint32_t tiles_x{16};
+    /// Number of tiles the view gets split into, vertically
+    uint32_t tiles_y{9};
+    /// Number of slices the depth of the view gets split into (exponentially,
+    /// from the near plane to the far plane of the camera)
+    uint32_t num_slices{24};
+    /// Radiance below which a light is out of reach. Lights get clipped at
+    /// the distance their attenuation drops to it, and fade out before it
+    float cutoff{0.01F};
+    /// Largest number of lights assigned to a cluster. Lights past it get
+    /// dropped from the cluster (counted as overflows)
+    uint32_t max_lights_per_cluster{128};
+
+    /// Returns the string representation of these settings
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Returns the distance at which the radiance of the given (point or spot)
+/// light drops below the given cutoff, given its attenuation. It's 0 for
+/// lights that never reach the cutoff, and infinite for lights that don't
+/// fade with the distance
+RENDERER_API auto ComputeLightRange(const Light& light, float cutoff)
+    -> float;
+
+/// Assignment of the point and spot lights of a scene to the clusters of the
+/// view of a camera: a grid of tiles of the screen by slices of the depth.
+///
+/// Each light is bound by a sphere of the radius its attenuation reaches the
+/// cutoff at, and gets listed in every cluster that sphere overlaps. The
+/// slices are processed in parallel (when given a pool), each one testing the
+/// lights that reach its depth range against the bounds of its clusters. The
+/// lists of all clusters are packed into a single array of light indices, so
+/// a fragment only loops over the lights of its own cluster
+class RENDERER_API LightClusters {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(LightClusters)
+
+    DEFINE_SMART_POINTERS(LightClusters)
+
+ public:
+    LightClusters() = default;
+
+    ~LightClusters() = default;
+
+    /// Assigns the point and spot lights among the given ones to the clusters
+    /// of the view of the given camera (directional lights are left out)
+    auto Build(const Camera& camera, const std::vector<Light::ptr>& lights,
+               const LightClusterSettings& settings,
+               ThreadPool* pool = nullptr) -> void;
+
+    /// Clears all clusters and lights
+    auto Clear() -> void;
+
+    /// Returns the cluster the given point (in world space) falls into, or
+    /// INVALID_CLUSTER if it's behind the camera. Points outside of the view
+    /// get the cluster of the closest tile and slice, as the shaders do
+    RENDERER_NODISCARD auto ClusterAt(const Vec3& point) const -> uint32_t;
+
+    /// Returns the number of clusters of the grid
+    RENDERER_NODISCARD auto num_clusters() const -> size_t {
+        return m_Offsets.size();
+    }
+
+    /// Returns the number of tiles of the grid, horizontally
+    RENDERER_NODISCARD auto tiles_x() const -> uint32_t { return m_TilesX; }
+
+    /// Returns the number of tiles of the grid, vertically
+    RENDERER_NODISCARD auto tiles_y() const -> uint32_t { return m_TilesY; }
+
+    /// Returns the number of depth slices of the grid
+    RENDERER_NODISCARD auto num_slices() const -> uint32_t {
+        return m_NumSlices;
+    }
+
+    /// Returns the distance from the camera at which the first slice starts
+    RENDERER_NODISCARD auto near() const -> float { return m_Near; }
+
+    /// Returns the factor that maps log(depth / near) to the index of a slice
+    RENDERER_NODISCARD auto slice_scale() const -> float {
+        return m_SliceScale;
+    }
+
+    /// Returns the lights assigned to the clusters (point and spot lights in
+    /// reach, in the order of the scene)
+    RENDERER_NODISCARD auto lights() const -> const std::vector<const Light*>& {
+        return m_Lights;
+    }
+
+    /// Returns the range of each of the lights assigned to the clusters
+    RENDERER_NODISCARD auto ranges() const -> const std::vector<float>& {
+        return m_Ranges;
+    }
+
+    /// Returns the offset of the list of lights of each cluster in indices()
+    RENDERER_NODISCARD auto offsets() const -> const std::vector<uint32_t>& {
+        return m_Offsets;
+    }
+
+    /// Returns the number of lights of each cluster
+    RENDERER_NODISCARD auto counts() const -> const std::vector<uint32_t>& {
+        return m_Counts;
+    }
+
+    /// Returns the lists of lights of all clusters, one after the other (as
+    /// indices into lights())
+    RENDERER_NODISCARD auto indices() const -> const std::vector<uint32_t>& {
+        return m_Indices;
+    }
+
+    /// Returns the number of lights dropped from full clusters
+    RENDERER_NODISCARD auto num_overflows() const -> size_t {
+        return m_NumOverflows;
+    }
+
+    /// Returns a string representation of these clusters
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Returns the slice the given depth (distance along the view) falls into
+    RENDERER_NODISCARD auto _SliceOf(float depth) const -> uint32_t;
+
+    /// Computes the view-space bounds of the clusters of the grid
+    auto _ComputeClusterBounds() -> void;
+
+    /// Assigns the lights that reach the given slice to its clusters
+    auto _AssignSlice(uint32_t slice, uint32_t max_per_cluster) -> void;
+
+ private:
+    /// Number of tiles of the grid, horizontally
+    uint32_t m_TilesX{0};
+
+    /// Number of tiles of the grid, vertically
+    uint32_t m_TilesY{0};
+
+    /// Number of depth slices of the grid
+    uint32_t m_NumSlices{0};
+
+    /// Distances from the camera at which the grid starts and ends
+    float m_Near{0.0F};
+    float m_Far{0.0F};
+
+    /// Factor that maps log(depth / near) to the index of a slice
+    float m_SliceScale{0.0F};
+
+    /// Whether or not the projection of the camera is perspective
+    bool m_Perspective{true};
+
+    /// View matrix of the camera
+    Mat4 m_View{Mat4::Identity()};
+
+    /// Projection matrix of the camera (only its x and y rows get used)
+    Mat4 m_Proj{Mat4::Identity()};
+
+    /// Bounds of each cluster in view space
+    std::vector<AABB> m_ClusterBounds;
+
+    /// Lights assigned to the clusters
+    std::vector<const Light*> m_Lights;
+
+    /// Range of each of the lights assigned to the clusters
+    std::vector<float> m_Ranges;
+
+    /// Center of each light in view space
+    std::vector<Vec3> m_ViewCenters;
+
+    /// Lights that reach the depth range of each slice
+    std::vector<std::vector<uint32_t>> m_SliceLights;
+
+    /// Lists of lights of the clusters of each slice, one after the other
+    std::vector<std::vector<uint32_t>> m_SliceIndices;
+
+    /// Number of lights dropped from the full clusters of each slice
+    std::vector<size_t> m_SliceOverflows;
+
+    /// Offset of the list of lights of each cluster in m_Indices
+    std::vector<uint32_t> m_Offsets;
+
+    /// Number of lights of each cluster
+    std::vector<uint32_t> m_Counts;
+
+    /// Lists of lights of all clusters, one after the other
+    std::vector<uint32_t> m_Indices;
+
+    /// Number of lights dropped from full clusters
+    size_t m_NumOverflows{0};
+};
+
+}  // namespace renderer
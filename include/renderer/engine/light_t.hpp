@@ -17,10 +17,10 @@ enum class eLightType {
 };
 
 /// Returns the string representation of the given light type
-auto ToString(const eLightType& light_type) -> std::string;
+RENDERER_API auto ToString(const eLightType& light_type) -> std::string;
 
 /// Representation of a light source in the scene
-class Light {
+class RENDERER_API Light {
     // cppcheck-suppress unknownMacro
     DEFAULT_COPY_AND_MOVE_AND_ASSIGN(Light)
 
@@ -57,7 +57,7 @@ class Light {
 };
 
 /// Representation of a directional light source
-class DirectionalLight : public Light {
+class RENDERER_API DirectionalLight : public Light {
     DEFINE_SMART_POINTERS(DirectionalLight)
 
  public:
@@ -71,7 +71,7 @@ class DirectionalLight : public Light {
 };
 
 /// Representation of a point light source
-class PointLight : public Light {
+class RENDERER_API PointLight : public Light {
     DEFINE_SMART_POINTERS(PointLight)
 
  public:
@@ -90,7 +90,7 @@ class PointLight : public Light {
 };
 
 /// Representation of a spot light source
-class SpotLight : public Light {
+class RENDERER_API SpotLight : public Light {
     DEFINE_SMART_POINTERS(SpotLight)
 
  public:
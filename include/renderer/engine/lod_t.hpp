@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+
+namespace renderer {
+
+/// Settings of the selection of the levels of detail of the meshes
+struct RENDERER_API LodSettings {
+    /// Whether or not coarser levels of detail get drawn at all
+    bool enabled{true};
+    /// Largest geometric error allowed on screen (in pixels)
+    float max_screen_error{1.0F};
+    /// Fraction of the largest error a coarser level has to stay under before
+    /// switching to it. Levels switch back to finer ones only once above the
+    /// largest error, so objects near a threshold don't pop back and forth
+    float hysteresis{0.25F};
+
+    /// Returns the string representation of these settings
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// View the levels of detail get selected for
+struct RENDERER_API LodView {
+    /// Position of the camera in world space
+    Vec3 eye{0.0F, 0.0F, 0.0F};
+    /// Number of pixels spanned by a unit of length at a unit distance from
+    /// the camera (perspective), or at any distance (orthographic)
+    float pixels_per_unit{1.0F};
+    /// Whether or not the projection is perspective (size depends on depth)
+    bool perspective{true};
+
+    /// Creates the view of the given camera onto a viewport of the given
+    /// height (in pixels)
+    static auto FromCamera(const Camera& camera, float viewport_height)
+        -> LodView;
+
+    /// Returns the size on screen (in pixels) of a geometric error (in world
+    /// units) of an object with the given bounds, measured at the point of
+    /// the bounds closest to the camera
+    RENDERER_NODISCARD auto ScreenError(float error, const AABB& bounds) const
+        -> float;
+};
+
+/// Selects the level of detail of a geometry: the coarsest one whose error
+/// stays under the largest error allowed on screen, with hysteresis w.r.t.
+/// the level the object is currently drawn with
+/// \param[in] geometry The geometry, with its levels of detail
+/// \param[in] bounds The world bounds of the object drawn with the geometry
+/// \param[in] view The view the object is drawn from
+/// \param[in] current The level the object was drawn with so far
+/// \param[in] settings The settings of the selection
+/// \returns The level the object should be drawn with (0 is full detail)
+RENDERER_API auto SelectLod(const Geometry& geometry, const AABB& bounds,
+                            const LodView& view, uint32_t current,
+                            const LodSettings& settings) -> uint32_t;
+
+}  // namespace renderer
@@ -3,7 +3,6 @@
 #include <string>
 
 #include <renderer/common.hpp>
-#include <renderer/core/texture_t.hpp>
 
 namespace renderer {
 
@@ -20,10 +19,10 @@ enum class eMaterialType {
 };
 
 /// Returns a string representation of the given material type Enum
-auto ToString(const eMaterialType& mat_type) -> std::string;
+RENDERER_API auto ToString(const eMaterialType& mat_type) -> std::string;
 
 /// Common interface for all avaialbe material types
-class Material {
+class RENDERER_API Material {
     // cppcheck-suppress unknownMacro
     DEFAULT_COPY_AND_MOVE_AND_ASSIGN(Material)
 
@@ -50,19 +49,21 @@ class Material {
     Vec3 specular = {0.8F, 0.3F, 0.5F};
     /// The power coefficient of the specular component
     float shininess = 32.0F;
-    /// The albedo map used by this material
-    ::renderer::Texture::ptr albedoMap = nullptr;
-    /// The specular map used by this material
-    ::renderer::Texture::ptr specularMap = nullptr;
+    /// Name of the albedo map used by this material (as loaded in the
+    /// resources manager of the renderer), or empty if it has none
+    std::string albedoMap;
+    /// Name of the specular map used by this material (as loaded in the
+    /// resources manager of the renderer), or empty if it has none
+    std::string specularMap;
 
  public:
+    Material() = default;
+
     /// Releases all resources associated with this material
     virtual ~Material() = default;
 
     /// Returns a string representation of this material
-    auto toString() const -> std::string;
-
- protected:
+    RENDERER_NODISCARD auto ToString() const -> std::string;
 };
 
 }  // namespace renderer
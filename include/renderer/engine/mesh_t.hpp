@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/material_t.hpp>
+#include <renderer/engine/object_t.hpp>
+
+namespace renderer {
+
+/// Renderable object, given by a geometry placed in the scene
+class RENDERER_API Mesh : public Object3D {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(Mesh)
+
+    DEFINE_SMART_POINTERS(Mesh)
+
+ public:
+    /// Creates a mesh with the given geometry
+    /// \param[in] name The name of this mesh
+    /// \param[in] geometry The geometry to be rendered by this mesh
+    explicit Mesh(const char* name, Geometry::ptr geometry);
+
+    /// Creates a mesh with the given geometry and initial pose
+    /// \param[in] name The name of this mesh
+    /// \param[in] geometry The geometry to be rendered by this mesh
+    /// \param[in] init_pose The pose of this mesh (relative to its parent)
+    explicit Mesh(const char* name, Geometry::ptr geometry, Pose init_pose);
+
+    ~Mesh() override = default;
+
+    /// Sets the geometry of this mesh, updating its bounds accordingly
+    auto SetGeometry(Geometry::ptr geometry) -> void;
+
+    /// Sets the material used to render this mesh
+    auto SetMaterial(Material::ptr material) -> void;
+
+    /// Lets the scene know that the properties of the material of this mesh
+    /// were edited in place, so renderers pick up the changes
+    auto MarkMaterialDirty() -> void;
+
+    /// Sets the color this mesh is tinted with. It multiplies the color of the
+    /// material, so meshes that share a material (and get drawn as instances
+    /// of a single draw call) can still be told apart
+    auto SetColor(const Vec3& color) -> void;
+
+    /// Returns the color this mesh is tinted with
+    RENDERER_NODISCARD auto color() const -> const Vec3& { return m_Color; }
+
+    /// Flags this mesh as an occluder, so it always gets rasterized into the
+    /// occlusion buffer of the renderer (when occlusion culling is enabled),
+    /// regardless of its size on screen and its number of triangles
+    auto SetOccluder(bool occluder) -> void { m_Occluder = occluder; }
+
+    /// Returns whether this mesh is flagged as an occluder
+    RENDERER_NODISCARD auto occluder() const -> bool { return m_Occluder; }
+
+    /// Flags this mesh as static, i.e. not expected to move. Static meshes
+    /// cast their shadows into layers that renderers cache across frames, and
+    /// moving one invalidates the cached shadows around its old and new spots
+    auto SetStatic(bool is_static) -> void;
+
+    /// Returns whether this mesh is flagged as static
+    RENDERER_NODISCARD auto is_static() const -> bool { return m_Static; }
+
+    /// Returns the geometry rendered by this mesh
+    RENDERER_NODISCARD auto geometry() const -> const Geometry::ptr& {
+        return m_Geometry;
+    }
+
+    /// Returns the material used to render this mesh
+    RENDERER_NODISCARD auto material() const -> const Material::ptr& {
+        return m_Material;
+    }
+
+    /// Returns the string representation of this mesh
+    RENDERER_NODISCARD auto ToString() const -> std::string override;
+
+ protected:
+    /// The geometry rendered by this mesh
+    Geometry::ptr m_Geometry{nullptr};
+
+    /// The material used to render this mesh
+    Material::ptr m_Material{nullptr};
+
+    /// The color this mesh is tinted with (white, i.e. no tint, by default)
+    Vec3 m_Color{1.0F, 1.0F, 1.0F};
+
+    /// Whether this mesh is flagged as an occluder
+    bool m_Occluder{false};
+
+    /// Whether this mesh is flagged as static
+    bool m_Static{false};
+};
+
+}  // namespace renderer
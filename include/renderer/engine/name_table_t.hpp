@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Compact identifier of a name interned in the global NameTable
+using NameId = uint32_t;
+
+/// Identifier used for names that haven't been interned
+static constexpr NameId INVALID_NAME_ID = std::numeric_limits<NameId>::max();
+
+/// Global table of interned names. Each unique string is stored only once and
+/// referenced by a small integer id, so lookups and comparisons of object
+/// names run on integers. The strings are only required for display purposes
+class RENDERER_API NameTable {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(NameTable)
+
+ public:
+    /// Interns the given name (if required), and returns its id
+    static auto Intern(std::string_view name) -> NameId;
+
+    /// Returns the id of the given name, or INVALID_NAME_ID if the name hasn't
+    /// been interned. Doesn't allocate, and doesn't grow the table
+    static auto Find(std::string_view name) -> NameId;
+
+    /// Returns the string associated with the given id. The reference stays
+    /// valid for the lifetime of the program
+    static auto GetString(NameId name_id) -> const std::string&;
+
+    /// Returns the number of names interned so far
+    static auto size() -> size_t;
+
+ private:
+    NameTable() = default;
+
+    ~NameTable() = default;
+
+    /// Returns the single instance of the table
+    static auto _Instance() -> NameTable&;
+
+ private:
+    /// Storage for the interned strings (references are never invalidated)
+    std::deque<std::string> m_Strings;
+
+    /// Map from the interned strings to their ids
+    std::unordered_map<std::string_view, NameId> m_Lookup;
+
+    /// Names can be interned and resolved from multiple threads
+    mutable std::shared_mutex m_Mutex;
+};
+
+}  // namespace renderer
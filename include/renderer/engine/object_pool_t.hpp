@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Pool of fixed-size memory blocks, grouped by size classes. Used to store
+/// many small objects contiguously instead of one heap allocation per object
+class RENDERER_API ObjectPool {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(ObjectPool)
+
+    DEFINE_SMART_POINTERS(ObjectPool)
+
+ public:
+    /// Granularity (in bytes) of the size classes handled by the pool
+    static constexpr size_t BLOCK_GRANULARITY = 16;
+    /// Biggest block (in bytes) handled by the pool. Bigger requests fallback
+    /// to the global allocator
+    static constexpr size_t MAX_BLOCK_SIZE = 1024;
+    /// Number of blocks allocated at once when a size class runs out
+    static constexpr size_t BLOCKS_PER_CHUNK = 256;
+
+    ObjectPool() = default;
+
+    /// Releases all memory chunks owned by this pool
+    ~ObjectPool() = default;
+
+    /// Returns a block of memory of (at least) the given size
+    /// \param[in] size The size in bytes of the requested block
+    /// \param[in] alignment The required alignment of the block
+    auto Allocate(size_t size, size_t alignment) -> void*;
+
+    /// Returns the given block to the pool
+    /// \param[in] ptr The block to be released
+    /// \param[in] size The size in bytes that was requested for this block
+    /// \param[in] alignment The alignment that was requested for this block
+    auto Deallocate(void* ptr, size_t size, size_t alignment) -> void;
+
+    /// Returns the number of blocks currently in use
+    RENDERER_NODISCARD auto num_allocated() const -> size_t {
+        return m_NumAllocated;
+    }
+
+    /// Returns the number of memory chunks owned by this pool
+    RENDERER_NODISCARD auto num_chunks() const -> size_t {
+        return m_Chunks.size();
+    }
+
+    /// Returns a string representation of this pool
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Returns whether or not a request can be served from the pool
+    static auto _IsPooled(size_t size, size_t alignment) -> bool {
+        return size <= MAX_BLOCK_SIZE && alignment <= alignof(std::max_align_t);
+    }
+
+ private:
+    /// Number of size classes handled by this pool
+    static constexpr size_t NUM_SIZE_CLASSES =
+        MAX_BLOCK_SIZE / BLOCK_GRANULARITY;
+
+    /// Intrusive free-list node, stored in the unused blocks
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /// Heads of the free-lists for each size class
+    std::array<FreeBlock*, NUM_SIZE_CLASSES> m_FreeLists{};
+
+    /// Memory chunks owned by this pool
+    std::vector<std::unique_ptr<uint8_t[]>> m_Chunks;  // NOLINT
+
+    /// Number of blocks currently in use
+    size_t m_NumAllocated{0};
+
+    /// Objects might be released from any thread (e.g. python's GC)
+    std::mutex m_Mutex;
+};
+
+/// Standard allocator adapter for ObjectPool (e.g. for std::allocate_shared).
+/// Keeps the pool alive for as long as some allocation is still in use
+template <typename T>
+class PoolAllocator {
+ public:
+    using value_type = T;
+
+    explicit PoolAllocator(ObjectPool::ptr pool) : m_Pool(std::move(pool)) {}
+
+    template <typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    PoolAllocator(const PoolAllocator<U>& other) : m_Pool(other.pool()) {}
+
+    auto allocate(size_t num) -> T* {
+        return static_cast<T*>(m_Pool->Allocate(num * sizeof(T), alignof(T)));
+    }
+
+    auto deallocate(T* ptr, size_t num) -> void {
+        m_Pool->Deallocate(ptr, num * sizeof(T), alignof(T));
+    }
+
+    RENDERER_NODISCARD auto pool() const -> const ObjectPool::ptr& {
+        return m_Pool;
+    }
+
+ private:
+    /// The pool from which memory is requested
+    ObjectPool::ptr m_Pool{nullptr};
+};
+
+template <typename T, typename U>
+auto operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+    -> bool {
+    return lhs.pool() == rhs.pool();
+}
+
+template <typename T, typename U>
+auto operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+    -> bool {
+    return !(lhs == rhs);
+}
+
+}  // namespace renderer
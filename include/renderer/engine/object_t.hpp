@@ -5,10 +5,31 @@
 #include <vector>
 
 #include <renderer/common.hpp>
+#include <renderer/engine/bvh_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
 #include <renderer/engine/graphics/enums.hpp>
+#include <renderer/engine/name_table_t.hpp>
 
 namespace renderer {
 
+class ThreadPool;
+class ChangeJournal;
+class Object3D;
+
+/// Collects the objects whose world bounds changed during a transforms update.
+/// Each thread taking part in the update appends to its own bucket (indexed by
+/// its index within the thread pool, or zero for serial updates)
+struct BoundsChangeList {
+    std::vector<std::vector<Object3D*>> buckets;
+};
+
+/// Minimum number of children of an object to split its transforms update
+/// across threads (when a thread pool is given)
+static constexpr size_t PARALLEL_TRANSFORMS_MIN_CHILDREN = 64;
+
+/// Returns the 4x4 homogeneous transform associated with the given pose
+RENDERER_API auto ComputeTransformMatrix(const Pose& pose) -> Mat4;
+
 /// Base interface for all objects supported by the engine
 class RENDERER_API Object3D : public std::enable_shared_from_this<Object3D> {
     DEFAULT_COPY_AND_MOVE_AND_ASSIGN(Object3D)
@@ -35,32 +56,148 @@ class RENDERER_API Object3D : public std::enable_shared_from_this<Object3D> {
     /// Adds the given object as child of this object
     virtual auto AddChild(Object3D::ptr child_obj) -> void;
 
+    /// Sets the layers this object belongs to (as a bitmask). Cameras only see
+    /// the objects in the layers enabled in their culling mask
+    auto SetLayers(uint32_t layers) -> void;
+
+    /// Shows or hides this object. Hidden objects are culled from all views
+    auto SetVisible(bool visible) -> void;
+
+    /// Sets the pose of this object (relative to its parent, if any)
+    auto SetPose(const Pose& pose) -> void;
+
+    /// Sets the position of this object (relative to its parent, if any)
+    auto SetPosition(const Vec3& position) -> void;
+
+    /// Sets the orientation of this object (relative to its parent, if any)
+    auto SetOrientation(const Quat& orientation) -> void;
+
+    /// Flags the world transform of this object as stale. Its children are
+    /// recomputed along with it on the next transforms update
+    auto MarkTransformDirty() -> void;
+
+    /// Recomputes the cached world transforms of this subtree, visiting only
+    /// the branches that have stale transforms
+    /// \param[in] parent_world The world transform of the parent of this object
+    /// \param[in] parent_changed Whether the parent transform changed this pass
+    /// \param[in] pool Optional pool used to split wide branches across threads
+    /// \param[in] changes Optional list that collects the objects with bounds
+    auto UpdateWorldTransform(const Mat4& parent_world, bool parent_changed,
+                              ThreadPool* pool = nullptr,
+                              BoundsChangeList* changes = nullptr) -> void;
+
     /// Returns the type of this object
     RENDERER_NODISCARD auto type() const -> eObjectType { return m_Type; }
 
-    /// Returns a copy of the name of the object
-    RENDERER_NODISCARD auto name() const -> std::string { return m_Name; }
+    /// Returns the name of the object (resolved from the names table)
+    RENDERER_NODISCARD auto name() const -> const std::string& {
+        return NameTable::GetString(m_NameId);
+    }
+
+    /// Returns the id of the interned name of this object
+    RENDERER_NODISCARD auto name_id() const -> NameId { return m_NameId; }
+
+    /// Returns the layers this object belongs to (as a bitmask)
+    RENDERER_NODISCARD auto layers() const -> uint32_t { return m_Layers; }
+
+    /// Returns whether or not this object is visible
+    RENDERER_NODISCARD auto visible() const -> bool { return m_Visible; }
+
+    /// Returns the children of this object. These are only detached through
+    /// the scene (see Scene::RemoveChild), which drops them from its BVH
+    RENDERER_NODISCARD auto children() const
+        -> const std::vector<Object3D::ptr>& {
+        return m_Children;
+    }
+
+    /// Returns the pose of this object relative to its parent (if any)
+    RENDERER_NODISCARD auto pose() const -> const Pose& { return m_Pose; }
+
+    /// Returns the cached transform of this object respect to world space
+    RENDERER_NODISCARD auto world_transform() const -> const Mat4& {
+        return m_WorldTransform;
+    }
+
+    /// Returns the bounds of this object in its local frame (empty if the
+    /// object has no geometry associated with it)
+    RENDERER_NODISCARD auto local_bounds() const -> const AABB& {
+        return m_LocalBounds;
+    }
+
+    /// Returns the cached bounds of this object in world space
+    RENDERER_NODISCARD auto world_bounds() const -> const AABB& {
+        return m_WorldBounds;
+    }
+
+    /// Returns the id of the leaf that stores this object in the scene BVH
+    RENDERER_NODISCARD auto bvh_leaf() const -> BvhLeafId { return m_BvhLeaf; }
+
+    /// Returns whether or not the cached world transform is stale
+    RENDERER_NODISCARD auto transform_dirty() const -> bool {
+        return m_TransformDirty;
+    }
 
     /// Returns a string representation of this object
     RENDERER_NODISCARD virtual auto ToString() const -> std::string;
 
- public:
-    /// The 3d pose of this object respect to world space. If object has a
-    /// parent object, then this pose is relative to that parent object
-    Pose pose;
+ protected:
+    /// Records a change of this object in the journal of its scene (if any)
+    auto _RecordChange(eSceneChange type) -> void;
+
+    /// Links this subtree to the journal of the scene it was added to,
+    /// recording the addition of each of its objects
+    auto _AttachJournal(ChangeJournal* journal) -> void;
+
+    /// Records the removal of each object of this subtree from its scene, and
+    /// unlinks them from the journal of that scene
+    auto _DetachJournal() -> void;
 
+ public:
     /// A weak reference to the parent of this object
     std::weak_ptr<Object3D> parent;
 
+ protected:
     /// A container for the children of this object
-    std::vector<Object3D::ptr> children;
+    std::vector<Object3D::ptr> m_Children;
 
- protected:
     /// The type of this object
     eObjectType m_Type{eObjectType::BASE};
 
-    /// A unique identifier of this object
-    std::string m_Name;
+    /// A unique identifier of this object (id of its interned name)
+    NameId m_NameId{INVALID_NAME_ID};
+
+    /// The 3d pose of this object respect to world space. If object has a
+    /// parent object, then this pose is relative to that parent object
+    Pose m_Pose;
+
+    /// Cached transform of this object respect to world space
+    Mat4 m_WorldTransform{Mat4::Identity()};
+
+    /// Whether or not the local pose changed since the last update
+    bool m_TransformDirty{true};
+
+    /// Whether or not some object down this subtree has a stale transform
+    bool m_SubtreeDirty{false};
+
+    /// Bounds of this object in its local frame (empty if it has no geometry)
+    AABB m_LocalBounds;
+
+    /// Cached bounds of this object in world space
+    AABB m_WorldBounds;
+
+    /// Layers this object belongs to (the first one by default)
+    uint32_t m_Layers{1};
+
+    /// Whether or not this object is visible
+    bool m_Visible{true};
+
+    /// Leaf that stores this object in the BVH of its scene (if any)
+    BvhLeafId m_BvhLeaf{INVALID_BVH_LEAF};
+
+    /// Journal of the scene this object belongs to (if any)
+    ChangeJournal* m_Journal{nullptr};
+
+    friend class Scene;
 };
 
 }  // namespace renderer
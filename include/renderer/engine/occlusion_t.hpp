@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/culling_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+
+namespace renderer {
+
+class ThreadPool;
+
+/// Width (in pixels) of a tile of the occlusion buffer (one bit per pixel)
+static constexpr uint32_t OCCLUSION_TILE_WIDTH = 32;
+
+/// Height (in pixels) of a tile of the occlusion buffer. The coverage masks of
+/// the rows of a tile fill a single 128-bit SIMD register
+static constexpr uint32_t OCCLUSION_TILE_HEIGHT = 4;
+
+/// Default width (in pixels) of the occlusion buffer
+static constexpr uint32_t DEFAULT_OCCLUSION_WIDTH = 256;
+
+/// Default height (in pixels) of the occlusion buffer
+static constexpr uint32_t DEFAULT_OCCLUSION_HEIGHT = 128;
+
+/// Geometries with more triangles than this aren't picked as occluders
+/// automatically (they can still be flagged as occluders explicitly)
+static constexpr size_t MAX_AUTO_OCCLUDER_TRIANGLES = 4096;
+
+/// Counters of the last frame of an occlusion buffer
+struct RENDERER_API OcclusionStats {
+    /// Number of meshes added as occluders
+    size_t num_occluders{0};
+    /// Number of occluder triangles that made it to the rasterizer
+    size_t num_triangles{0};
+    /// Number of boxes tested against the buffer
+    size_t num_tested{0};
+    /// Number of boxes found to be fully hidden behind the occluders
+    size_t num_occluded{0};
+};
+
+/// Low-resolution depth buffer for CPU occlusion culling, in the style of
+/// masked occlusion culling (Andersson et al. 2015).
+///
+/// The buffer is split in tiles of 32x4 pixels. Instead of a depth per pixel,
+/// each tile keeps two depth layers: the farthest depth of the whole tile, and
+/// a working layer given by a coverage mask (a bit per pixel) and the farthest
+/// depth of the covered pixels. Occluders get merged into the working layer,
+/// which replaces the tile depth once it covers the whole tile. Every depth
+/// stored is an upper bound of the real one, so boxes are only culled if they
+/// are hidden at the resolution of the buffer (pixels are covered when their
+/// centers are, so gaps thinner than a pixel of the buffer are missed).
+///
+/// Depths are normalized to [0, 1] (near to far) for both the standard and
+/// the reversed depth ranges. Triangles crossing the near plane are clipped
+/// against it, and boxes crossing it are always visible
+class RENDERER_API OcclusionBuffer {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(OcclusionBuffer)
+
+    DEFINE_SMART_POINTERS(OcclusionBuffer)
+
+ public:
+    /// Creates a buffer of (at least) the given resolution, rounded up to a
+    /// whole number of tiles
+    explicit OcclusionBuffer(uint32_t width = DEFAULT_OCCLUSION_WIDTH,
+                             uint32_t height = DEFAULT_OCCLUSION_HEIGHT);
+
+    /// Releases the resources of the buffer
+    ~OcclusionBuffer() = default;
+
+    /// Clears the buffer and sets the view used to project occluders and boxes
+    /// \param[in] view_proj The product of the projection and view matrices
+    /// \param[in] reverse_z Whether the projection uses a reversed depth range
+    auto Begin(const Mat4& view_proj, bool reverse_z = false) -> void;
+
+    /// Clears the buffer and sets the view of the given camera
+    auto Begin(const Camera& camera) -> void;
+
+    /// Queues the triangles of a mesh to be rasterized as occluders
+    /// \param[in] model The transform of the mesh w.r.t. the world frame
+    /// \param[in] positions The positions of the vertices (3 floats each)
+    /// \param[in] num_vertices The number of vertices
+    /// \param[in] indices The indices of the triangles (nullptr for a list)
+    /// \param[in] num_indices The number of indices
+    auto AddOccluder(const Mat4& model, const float32_t* positions,
+                     size_t num_vertices, const uint32_t* indices,
+                     size_t num_indices) -> void;
+
+    /// Queues the triangles of the given geometry to be rasterized as
+    /// occluders, placed with the given transform
+    auto AddOccluder(const Mat4& model, const Geometry& geometry) -> void;
+
+    /// Rasterizes the queued occluders into the buffer. Each row of tiles is
+    /// independent, so the rows get split across the threads of the pool (if
+    /// given), with the same results as a serial run
+    auto Rasterize(ThreadPool* pool = nullptr) -> void;
+
+    /// Returns whether the given box might be visible, i.e. false only if it's
+    /// fully hidden behind the occluders rasterized so far
+    RENDERER_NODISCARD auto TestBox(const AABB& box) const -> bool;
+
+    /// Tests the given bounds against the buffer, clearing the flags of the
+    /// entries that are hidden. Entries already flagged as not visible (and
+    /// unused entries) are skipped
+    /// \param[in] bounds The bounds to be tested
+    /// \param[in,out] visible Flags of the entries (same size as bounds)
+    /// \param[in] pool Optional pool used to test the bounds in parallel
+    /// \returns The number of entries found to be hidden
+    auto TestBounds(const BoundsArray& bounds, uint8_t* visible,
+                    ThreadPool* pool = nullptr) -> size_t;
+
+    /// Returns the upper bound of the depth at the given pixel, in [0, 1]. The
+    /// pixel (0, 0) is the top-left corner of the view
+    RENDERER_NODISCARD auto depth_bound(uint32_t x, uint32_t y) const -> float;
+
+    /// Returns the width of the buffer (in pixels)
+    RENDERER_NODISCARD auto width() const -> uint32_t { return m_Width; }
+
+    /// Returns the height of the buffer (in pixels)
+    RENDERER_NODISCARD auto height() const -> uint32_t { return m_Height; }
+
+    /// Returns the counters of the current frame
+    RENDERER_NODISCARD auto stats() const -> const OcclusionStats& {
+        return m_Stats;
+    }
+
+    /// Returns a string representation of this buffer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Occluder triangle in screen space, ready to be rasterized
+    struct ScreenTriangle {
+        /// Coefficients of the edge functions a * x + b * y + c, which are
+        /// non-negative for points inside of the triangle
+        std::array<float, 3> a{};
+        std::array<float, 3> b{};
+        std::array<float, 3> c{};
+        /// Plane of the depths of the triangle, as a function of the pixel
+        /// coordinates: depth_dx * x + depth_dy * y + depth_c
+        float depth_dx{0.0F};
+        float depth_dy{0.0F};
+        float depth_c{0.0F};
+        /// Farthest depth of the triangle
+        float depth{0.0F};
+        /// Range of columns (in pixels) touched by the triangle
+        int32_t x_min{0};
+        int32_t x_max{0};
+        /// Range of rows (in pixels) touched by the triangle
+        int32_t y_min{0};
+        int32_t y_max{0};
+    };
+
+    /// Clips the given triangle (clip coordinates) against the near plane and
+    /// queues the resulting triangles
+    auto _AddClipTriangle(const std::array<float, 4>& p0,
+                          const std::array<float, 4>& p1,
+                          const std::array<float, 4>& p2) -> void;
+
+    /// Sets up the given triangle (clip coordinates, in front of the near
+    /// plane) for rasterization, and queues it
+    auto _AddScreenTriangle(const std::array<float, 4>& p0,
+                            const std::array<float, 4>& p1,
+                            const std::array<float, 4>& p2) -> void;
+
+    /// Rasterizes all queued triangles into the given row of tiles
+    auto _RasterizeTileRow(uint32_t tile_row) -> void;
+
+    /// Returns the signed distance of a point (clip coordinates) to the near
+    /// plane, positive in front of it
+    RENDERER_NODISCARD auto _NearDistance(const std::array<float, 4>& p) const
+        -> float;
+
+    /// Returns the normalized depth of a point (clip coordinates)
+    RENDERER_NODISCARD auto _Depth(const std::array<float, 4>& p) const
+        -> float;
+
+ private:
+    /// Resolution of the buffer (in pixels)
+    uint32_t m_Width{0};
+    uint32_t m_Height{0};
+
+    /// Number of tiles along each axis
+    uint32_t m_TilesX{0};
+    uint32_t m_TilesY{0};
+
+    /// Coverage masks of the working layers, OCCLUSION_TILE_HEIGHT rows per
+    /// tile (bit i of a row is the pixel at column i of the tile)
+    std::vector<uint32_t> m_Masks;
+
+    /// Farthest depth of each tile
+    std::vector<float> m_TileDepths;
+
+    /// Farthest depth of the covered pixels of the working layer of each tile
+    std::vector<float> m_LayerDepths;
+
+    /// Product of the projection and view matrices of the current frame
+    Mat4 m_ViewProj;
+
+    /// Whether the projection of the current frame has a reversed depth range
+    bool m_ReverseZ{false};
+
+    /// Occluder triangles queued since the last rasterization
+    std::vector<ScreenTriangle> m_Triangles;
+
+    /// Clip coordinates of the vertices of the last occluder (reused storage)
+    std::vector<std::array<float, 4>> m_ClipVertices;
+
+    /// Counters of the current frame
+    OcclusionStats m_Stats{};
+};
+
+}  // namespace renderer
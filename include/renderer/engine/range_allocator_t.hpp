@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Offset returned when a range can't be allocated
+static constexpr uint32_t INVALID_RANGE = std::numeric_limits<uint32_t>::max();
+
+/// Suballocator of contiguous ranges of elements within a larger buffer (e.g.
+/// the vertices and indices of many geometries packed into a single GPU
+/// buffer). Uses first-fit over the free ranges, which get merged with their
+/// neighbours when released to keep fragmentation low
+class RENDERER_API RangeAllocator {
+    // cppcheck-suppress unknownMacro
+    DEFAULT_COPY_AND_MOVE_AND_ASSIGN(RangeAllocator)
+
+    DEFINE_SMART_POINTERS(RangeAllocator)
+
+ public:
+    /// Creates an allocator managing the given number of elements
+    explicit RangeAllocator(uint32_t size = 0);
+
+    ~RangeAllocator() = default;
+
+    /// Allocates a range of the given number of elements
+    /// \returns The offset of the range, or INVALID_RANGE if there's no free
+    /// range big enough for it
+    auto Allocate(uint32_t count) -> uint32_t;
+
+    /// Releases the range at the given offset, of the given number of elements
+    auto Free(uint32_t offset, uint32_t count) -> void;
+
+    /// Extends the managed elements up to the given size (e.g. after the
+    /// buffer got reallocated with more room), adding the new elements at its
+    /// end to the free ranges. Shrinking isn't supported
+    auto Grow(uint32_t new_size) -> void;
+
+    /// Returns the number of elements managed by this allocator
+    RENDERER_NODISCARD auto size() const -> uint32_t { return m_Size; }
+
+    /// Returns the number of elements not allocated
+    RENDERER_NODISCARD auto num_free() const -> uint32_t { return m_NumFree; }
+
+    /// Returns the number of disjoint free ranges
+    RENDERER_NODISCARD auto num_free_ranges() const -> size_t {
+        return m_FreeRanges.size();
+    }
+
+    /// Returns the number of elements of the largest free range
+    RENDERER_NODISCARD auto largest_free_range() const -> uint32_t;
+
+    /// Returns a string representation of this allocator
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Free ranges, given by their offsets mapped to their number of elements
+    std::map<uint32_t, uint32_t> m_FreeRanges;
+
+    /// Number of elements managed by this allocator
+    uint32_t m_Size{0};
+
+    /// Number of elements not allocated
+    uint32_t m_NumFree{0};
+};
+
+}  // namespace renderer
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Passes a draw can be queued in, in the order they're rendered
+enum class eRenderPass : uint8_t {
+    /// Main pass, where the meshes of the scene are shaded
+    MAIN = 0,
+    /// Drawn after the main pass (e.g. gizmos on top of the scene)
+    OVERLAY = 1,
+};
+
+/// Number of bits used by the depth bucket of a render key
+static constexpr uint32_t RENDER_KEY_DEPTH_BITS = 21;
+
+/// Largest depth bucket that fits in a render key
+static constexpr uint32_t MAX_DEPTH_BUCKET =
+    (1U << RENDER_KEY_DEPTH_BITS) - 1;
+
+/// Largest program id that fits in a render key
+static constexpr uint32_t MAX_RENDER_KEY_PROGRAM = 0xFF;
+
+/// Largest material or VAO id that fits in a render key
+static constexpr uint32_t MAX_RENDER_KEY_ID = 0xFFFF;
+
+/// Fields packed into a 64-bit render key
+struct RENDERER_API RenderKeyFields {
+    /// Pass the draw belongs to
+    eRenderPass pass{eRenderPass::MAIN};
+    /// Whether or not the draw is blended over what's behind it
+    bool translucent{false};
+    /// Id of the shader program used by the draw
+    uint32_t program{0};
+    /// Id of the material (uniforms and textures) used by the draw
+    uint32_t material{0};
+    /// Id of the vertex array used by the draw
+    uint32_t vao{0};
+    /// Quantized view depth of the draw, as given by ComputeDepthBucket
+    uint32_t depth{0};
+};
+
+/// Packs the given fields into a key, such that sorting draws by their keys
+/// renders the passes in order, opaque draws before translucent ones, and
+/// groups opaque draws by program, then material, then VAO (front-to-back
+/// within each group). Translucent draws are ordered back-to-front instead,
+/// with the state only breaking ties between draws at the same depth.
+///
+///   opaque:      | pass 2 | 0 | program 8 | material 16 | vao 16 | depth 21 |
+///   translucent: | pass 2 | 1 | ~depth 21 | program 8 | material 16 | vao 16 |
+///
+/// Ids beyond the size of their fields wrap around, which only makes the
+/// grouping less effective
+RENDERER_API auto MakeRenderKey(const RenderKeyFields& fields) -> uint64_t;
+
+/// Unpacks the fields of a key made with MakeRenderKey
+RENDERER_API auto DecodeRenderKey(uint64_t key) -> RenderKeyFields;
+
+/// Quantizes the given view depth into a bucket for a render key, where the
+/// range [near, far] maps linearly to [0, MAX_DEPTH_BUCKET]
+RENDERER_API auto ComputeDepthBucket(float depth, float near, float far)
+    -> uint32_t;
+
+/// Single entry of a render queue
+struct RENDERER_API RenderQueueEntry {
+    /// Key the entry is sorted by
+    uint64_t key{0};
+    /// Index of the draw this entry refers to (e.g. into a draw list)
+    uint32_t index{0};
+};
+
+/// Number of state changes needed to submit the entries of a queue in order
+struct RENDERER_API RenderStateChanges {
+    /// Number of times a different program had to be bound
+    size_t num_program_changes{0};
+    /// Number of times a different material had to be bound
+    size_t num_material_changes{0};
+    /// Number of times a different vertex array had to be bound
+    size_t num_vao_changes{0};
+
+    /// Returns a string representation of these counts
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Queue of the draws of a frame, sorted by their 64-bit render keys. The
+/// queue is refilled every frame, and sorted with a radix sort over the keys,
+/// which costs linear time and skips the digits shared by all keys
+class RENDERER_API RenderQueue {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(RenderQueue)
+
+    DEFINE_SMART_POINTERS(RenderQueue)
+
+ public:
+    RenderQueue() = default;
+
+    ~RenderQueue() = default;
+
+    /// Removes all entries (keeping the allocated memory)
+    auto Clear() -> void { m_Entries.clear(); }
+
+    /// Reserves memory for the given number of entries
+    auto Reserve(size_t capacity) -> void;
+
+    /// Appends a draw to the queue
+    auto Push(uint64_t key, uint32_t index) -> void {
+        m_Entries.push_back({key, index});
+    }
+
+    /// Sorts the entries by their keys. The sort is stable, so draws with the
+    /// same key keep the order they were pushed in
+    auto Sort() -> void;
+
+    /// Returns the number of state changes needed to submit the entries in
+    /// their current order (the first draw counts as a change of each kind)
+    RENDERER_NODISCARD auto CountStateChanges() const -> RenderStateChanges;
+
+    /// Returns the entries of the queue
+    RENDERER_NODISCARD auto entries() const
+        -> const std::vector<RenderQueueEntry>& {
+        return m_Entries;
+    }
+
+    /// Returns the number of entries in the queue
+    RENDERER_NODISCARD auto size() const -> size_t { return m_Entries.size(); }
+
+    /// Returns whether or not the queue has no entries
+    RENDERER_NODISCARD auto empty() const -> bool { return m_Entries.empty(); }
+
+    /// Returns a string representation of this queue
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Entries of the queue
+    std::vector<RenderQueueEntry> m_Entries;
+
+    /// Scratch buffer used by the passes of the radix sort
+    std::vector<RenderQueueEntry> m_Scratch;
+};
+
+}  // namespace renderer
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <renderer/common.hpp>
 #include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/draw_list_t.hpp>
+#include <renderer/engine/frame_stats_t.hpp>
+#include <renderer/engine/light_clusters_t.hpp>
+#include <renderer/engine/lod_t.hpp>
+#include <renderer/engine/occlusion_t.hpp>
 #include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/shadows_t.hpp>
 
 namespace renderer {
 
@@ -35,6 +43,118 @@ class RENDERER_API IRenderer {
     /// Enables/Disables the debug drawer pipeline
     auto SetDebugEnabled(bool enable) -> void { m_DebugEnabled = enable; }
 
+    /// Sets the minimum projected size (fraction of the viewport height) of an
+    /// object to be rendered. Smaller objects are culled
+    auto SetMinScreenSize(float size) -> void { m_MinScreenSize = size; }
+
+    /// Returns the minimum projected size of an object to be rendered
+    RENDERER_NODISCARD auto min_screen_size() const -> float {
+        return m_MinScreenSize;
+    }
+
+    /// Enables/Disables occlusion culling: after frustum culling, a few large
+    /// meshes get rasterized on the CPU into a low-resolution depth buffer,
+    /// and the objects fully hidden behind them are culled
+    auto SetOcclusionCullingEnabled(bool enable) -> void {
+        m_OcclusionCulling = enable;
+    }
+
+    /// Returns whether or not occlusion culling is enabled
+    RENDERER_NODISCARD auto occlusion_culling_enabled() const -> bool {
+        return m_OcclusionCulling;
+    }
+
+    /// Sets the minimum projected size (fraction of the viewport height) of a
+    /// mesh to be picked as occluder automatically. Meshes flagged as
+    /// occluders are always picked
+    auto SetOccluderMinScreenSize(float size) -> void {
+        m_OccluderMinScreenSize = size;
+    }
+
+    /// Returns the minimum projected size of a mesh picked as occluder
+    RENDERER_NODISCARD auto occluder_min_screen_size() const -> float {
+        return m_OccluderMinScreenSize;
+    }
+
+    /// Sets how the levels of detail of the meshes get selected
+    auto SetLodSettings(const LodSettings& settings) -> void {
+        m_LodSettings = settings;
+    }
+
+    /// Returns the settings of the selection of the levels of detail
+    RENDERER_NODISCARD auto lod_settings() const -> const LodSettings& {
+        return m_LodSettings;
+    }
+
+    /// Sets how the directional light casts shadows. The cached layers of the
+    /// static casters get redrawn, as they depend on these settings
+    auto SetShadowSettings(const ShadowSettings& settings) -> void {
+        m_ShadowSettings = settings;
+        m_ShadowCache.InvalidateAll();
+    }
+
+    /// Returns the settings of the shadows of the directional light
+    RENDERER_NODISCARD auto shadow_settings() const -> const ShadowSettings& {
+        return m_ShadowSettings;
+    }
+
+    /// Returns the cache of the shadows of the static casters, along with the
+    /// cascades of the last render call
+    RENDERER_NODISCARD auto shadow_cache() const -> const ShadowCache& {
+        return m_ShadowCache;
+    }
+
+    /// Sets how the point and spot lights get assigned to the clusters of the
+    /// view. When enabled, each fragment only shades the lights listed in its
+    /// cluster, instead of the first few lights of the scene
+    auto SetLightClusterSettings(const LightClusterSettings& settings)
+        -> void {
+        m_LightClusterSettings = settings;
+    }
+
+    /// Returns the settings of the clustered assignment of the lights
+    RENDERER_NODISCARD auto light_cluster_settings() const
+        -> const LightClusterSettings& {
+        return m_LightClusterSettings;
+    }
+
+    /// Returns the clusters of the lights of the last render call (empty if
+    /// clustered lighting is disabled)
+    RENDERER_NODISCARD auto light_clusters() const -> const LightClusters& {
+        return m_LightClusters;
+    }
+
+    /// Sets the pool used to spread the CPU work of a render call (e.g. the
+    /// occlusion culling) across threads. The pool must outlive the renderer,
+    /// or be unset before it's destroyed (nullptr runs the work serially)
+    auto SetThreadPool(ThreadPool* pool) -> void { m_ThreadPool = pool; }
+
+    /// Returns the occlusion buffer of the last render call (nullptr if
+    /// occlusion culling hasn't been used yet)
+    RENDERER_NODISCARD auto occlusion_buffer() const -> const OcclusionBuffer* {
+        return m_OcclusionBuffer.get();
+    }
+
+    /// Returns the statistics gathered during the last render call
+    RENDERER_NODISCARD auto stats() const -> const FrameStats& {
+        return m_Stats;
+    }
+
+    /// Returns the stats of the last render calls, oldest first
+    RENDERER_NODISCARD auto stats_history() const -> const FrameStatsHistory& {
+        return m_StatsHistory;
+    }
+
+    /// Changes the number of render calls kept in the history of stats
+    auto SetStatsHistorySize(size_t size) -> void {
+        m_StatsHistory.SetCapacity(size);
+    }
+
+    /// Returns the retained list of the meshes to be drawn
+    RENDERER_NODISCARD auto draw_list() const -> const DrawList& {
+        return m_DrawList;
+    }
+
     /// Returns whether or not the renderer is enabled
     RENDERER_NODISCARD auto enabled() const -> bool { return m_Enabled; }
 
@@ -45,12 +165,101 @@ class RENDERER_API IRenderer {
 
     RENDERER_NODISCARD virtual auto ToString() const -> std::string;
 
+ protected:
+    /// Culls the objects of the scene against the camera view, collecting the
+    /// visible ones and updating the culling stats
+    auto _CullScene(const Scene& scene, const Camera& camera) -> void;
+
+    /// Culls the objects that passed the frustum tests against the occluders
+    /// of the scene, and returns the number of objects culled
+    auto _CullOccluded(const Scene& scene, const Camera& camera,
+                       const CullingParams& params) -> size_t;
+
+    /// Patches the retained draw list with the changes made to the scene since
+    /// the last render call
+    auto _SyncDrawList(const Scene& scene) -> void;
+
+    /// Selects the level of detail of the given item of the draw list, and
+    /// keeps it as the current level of its slot
+    auto _SelectLod(const DrawItem& item, const LodView& view) -> uint32_t;
+
+    /// Computes the shadow cascades of the camera view for the directional
+    /// light of the scene (the first one), and invalidates the cached layers
+    /// of the static casters that changed since the last render call
+    /// \returns The light casting the shadows, or nullptr if there's none
+    auto _UpdateShadowCascades(const Scene& scene, const Camera& camera)
+        -> const Light*;
+
+    /// Assigns the point and spot lights of the scene to the clusters of the
+    /// camera view (spread across the thread pool), or clears the clusters if
+    /// clustered lighting is disabled
+    auto _UpdateLightClusters(const Scene& scene, const Camera& camera)
+        -> void;
+
  protected:
     /// Whether or not the renderer is enabled
     bool m_Enabled{true};
 
     /// Whether or not the debug drawer is enabled
     bool m_DebugEnabled{true};
+
+    /// Minimum projected size of an object to be rendered (about a pixel on a
+    /// 1080p viewport by default)
+    float m_MinScreenSize{0.001F};
+
+    /// Whether or not occlusion culling is enabled
+    bool m_OcclusionCulling{false};
+
+    /// Minimum projected size of a mesh to be picked as occluder automatically
+    float m_OccluderMinScreenSize{0.1F};
+
+    /// Settings of the selection of the levels of detail
+    LodSettings m_LodSettings{};
+
+    /// Level of detail each slot of the draw list was last drawn with
+    std::vector<uint8_t> m_LodLevels;
+
+    /// Settings of the shadows of the directional light
+    ShadowSettings m_ShadowSettings{};
+
+    /// Validity of the cached layers of the static shadow casters
+    ShadowCache m_ShadowCache;
+
+    /// Cascades of the current frame (storage reused across frames)
+    std::vector<ShadowCascade> m_ShadowCascades;
+
+    /// Settings of the clustered assignment of the lights
+    LightClusterSettings m_LightClusterSettings{};
+
+    /// Clusters of the lights of the current frame
+    LightClusters m_LightClusters;
+
+    /// Pool used to spread the CPU work of a render call (not owned)
+    ThreadPool* m_ThreadPool{nullptr};
+
+    /// Depth buffer used for occlusion culling (created on first use)
+    OcclusionBuffer::uptr m_OcclusionBuffer{nullptr};
+
+    /// Flags of the objects tested against the occlusion buffer
+    std::vector<uint8_t> m_OcclusionTests;
+
+    /// Indices (BVH leaf ids) of the occluders of the last render call
+    std::vector<size_t> m_Occluders;
+
+    /// Statistics gathered during the last render call
+    FrameStats m_Stats{};
+
+    /// Stats of the last render calls
+    FrameStatsHistory m_StatsHistory;
+
+    /// Visibility flags of the scene objects, indexed by BVH leaf id
+    std::vector<uint8_t> m_Visibility;
+
+    /// Objects that passed the culling tests in the last render call
+    std::vector<Object3D*> m_VisibleObjects;
+
+    /// Retained list of the meshes of the last scene rendered
+    DrawList m_DrawList;
 };
 
 }  // namespace renderer
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/slot_map_t.hpp>
+#include <renderer/engine/triple_buffer_t.hpp>
+
+namespace renderer {
+
+/// Stable reference to an object stored in a scene
+using ObjectHandle = SlotHandle;
+
+/// Pose and visibility state of a set of objects of a scene at some instant,
+/// as produced by a simulation. Stored as parallel arrays, such that refilling
+/// a snapshot every step reuses its memory
+struct RENDERER_API PoseSnapshot {
+    /// Handles of the objects in the snapshot
+    std::vector<ObjectHandle> handles;
+    /// Pose of each object (relative to its parent)
+    std::vector<Pose> poses;
+    /// Visibility of each object
+    std::vector<uint8_t> visible;
+    /// Step of the simulation this snapshot was taken at
+    uint64_t step{0};
+
+    /// Removes all entries (keeping the allocated memory)
+    auto Clear() -> void {
+        handles.clear();
+        poses.clear();
+        visible.clear();
+    }
+
+    /// Appends the state of an object to the snapshot
+    auto Add(ObjectHandle handle, const Pose& pose, bool is_visible = true)
+        -> void {
+        handles.push_back(handle);
+        poses.push_back(pose);
+        visible.push_back(is_visible ? 1 : 0);
+    }
+
+    /// Returns the number of objects in the snapshot
+    RENDERER_NODISCARD auto size() const -> size_t { return handles.size(); }
+
+    /// Returns a string representation of this snapshot
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Channel used to hand snapshots over from a simulation thread to the render
+/// thread without locking
+using SnapshotBuffer = TripleBuffer<PoseSnapshot>;
+
+}  // namespace renderer
@@ -1,13 +1,34 @@
 #pragma once
 
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <renderer/common.hpp>
+#include <renderer/engine/bvh_t.hpp>
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/change_journal_t.hpp>
+#include <renderer/engine/culling_t.hpp>
+#include <renderer/engine/graphics/ray_t.hpp>
+#include <renderer/engine/light_t.hpp>
 #include <renderer/engine/object_t.hpp>
+#include <renderer/engine/object_pool_t.hpp>
+#include <renderer/engine/scene_snapshot_t.hpp>
+#include <renderer/engine/slot_map_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
 
 namespace renderer {
 
+/// Returns the pose stored at the given index of contiguous arrays of
+/// positions (3 floats each) and quaternions (4 floats each, as w, x, y, z).
+/// Missing arrays (nullptr) default to the origin and the identity rotation
+RENDERER_API auto MakePose(const float* positions, const float* quats,
+                           size_t index) -> Pose;
+
 /// Scene container for engine objects of various types
 class RENDERER_API Scene : public Object3D {
     // cppcheck-suppress unknownMacro
@@ -25,24 +46,252 @@ class RENDERER_API Scene : public Object3D {
     /// Adds the given object to the list of this scene's children
     auto AddChild(Object3D::ptr obj) -> void override;
 
-    /// Returns whether or not an object with given name exists in the scene
-    auto ExistsChild(const std::string& name) -> bool;
+    /// Adds the given object to this scene, and returns its handle
+    /// \param[in] obj The object to be added as a child of this scene
+    /// \returns A handle to the object, or an invalid handle on failure
+    auto AddObject(Object3D::ptr obj) -> ObjectHandle;
+
+    /// Creates an object in this scene's pooled storage, and returns its handle
+    /// \param[in] args The arguments forwarded to the object's constructor
+    /// \returns A handle to the object, or an invalid handle on failure
+    template <typename T = Object3D, typename... Args>
+    auto CreateObject(Args&&... args) -> ObjectHandle {
+        return AddObject(std::allocate_shared<T>(
+            PoolAllocator<T>(m_ObjectsPool), std::forward<Args>(args)...));
+    }
+
+    /// Creates many objects at once in this scene's pooled storage, named as
+    /// the given prefix followed by their index (e.g. "body_0", "body_1", ...)
+    /// \param[in] prefix The prefix used for the names of the objects
+    /// \param[in] num_objects The number of objects to be created
+    /// \param[in] positions Initial positions as num_objects x 3 floats (or
+    ///                      nullptr to place all objects at the origin)
+    /// \param[in] quats Initial orientations as num_objects x 4 floats, each
+    ///                  given as (w, x, y, z) (or nullptr for no rotation)
+    /// \param[in] args Extra arguments forwarded to the objects' constructors,
+    ///                 placed between the name and the initial pose
+    /// \returns The handles of the objects (invalid for the ones that failed)
+    template <typename T = Object3D, typename... Args>
+    auto CreateObjects(const std::string& prefix, size_t num_objects,
+                       const float* positions, const float* quats,
+                       const Args&... args) -> std::vector<ObjectHandle> {
+        std::vector<ObjectHandle> handles(num_objects);
+        m_Children.reserve(m_Children.size() + num_objects);
+        m_Name2Handle.reserve(m_Name2Handle.size() + num_objects);
+        for (size_t i = 0; i < num_objects; ++i) {
+            const auto NAME = prefix + std::to_string(i);
+            handles[i] = CreateObject<T>(NAME.c_str(), args...,
+                                         MakePose(positions, quats, i));
+        }
+        return handles;
+    }
+
+    /// Sets the poses of many objects at once, from contiguous arrays. Handles
+    /// that don't reference an object in the scene are skipped
+    /// \param[in] handles Pointer to the first of the handles of the objects
+    /// \param[in] num_objects The number of objects
+    /// \param[in] positions Positions as num_objects x 3 floats
+    /// \param[in] quats Orientations as num_objects x 4 floats, each given as
+    ///                  (w, x, y, z)
+    /// \returns The number of objects that were updated
+    auto SetPoses(const ObjectHandle* handles, size_t num_objects,
+                  const float* positions, const float* quats) -> size_t;
+
+    /// Gets the poses of many objects at once, into contiguous arrays. The
+    /// entries of handles that don't reference an object are left untouched
+    /// \param[in] handles Pointer to the first of the handles of the objects
+    /// \param[in] num_objects The number of objects
+    /// \param[out] positions Buffer of num_objects x 3 floats for the positions
+    /// \param[out] quats Buffer of num_objects x 4 floats for the orientations
+    /// \returns The number of objects that were found
+    auto GetPoses(const ObjectHandle* handles, size_t num_objects,
+                  float* positions, float* quats) const -> size_t;
+
+    /// Adds the given light source to this scene (duplicates are ignored)
+    auto AddLight(Light::ptr light) -> void;
+
+    /// Removes the given light source from this scene
+    auto RemoveLight(const Light::ptr& light) -> void;
+
+    /// Returns whether or not an object with given name exists in the scene.
+    /// Lookups by name go through the NameTable, without allocating
+    auto ExistsChild(std::string_view name) const -> bool;
+
+    /// Returns whether or not an object with given name id exists in the scene
+    auto ExistsChild(NameId name_id) const -> bool;
+
+    /// Returns whether or not the given handle references an object in scene
+    auto ExistsChild(ObjectHandle handle) const -> bool;
 
     /// Removes the object with given name
-    auto RemoveChild(const std::string& name) -> void;
+    auto RemoveChild(std::string_view name) -> void;
+
+    /// Removes the object referenced by the given handle
+    auto RemoveChild(ObjectHandle handle) -> void;
 
     /// Returns the object requested by name
-    RENDERER_NODISCARD auto GetChild(const std::string& name) -> Object3D::ptr;
+    RENDERER_NODISCARD auto GetChild(std::string_view name) -> Object3D::ptr;
+
+    /// Returns the object requested by the id of its name
+    RENDERER_NODISCARD auto GetChild(NameId name_id) -> Object3D::ptr;
+
+    /// Returns the object referenced by the given handle (or nullptr if stale)
+    RENDERER_NODISCARD auto GetChild(ObjectHandle handle) -> Object3D::ptr;
+
+    /// Returns the handle of the object with the given name
+    RENDERER_NODISCARD auto GetHandle(std::string_view name) const
+        -> ObjectHandle;
+
+    /// Returns the handle of the object with the given name id
+    RENDERER_NODISCARD auto GetHandle(NameId name_id) const -> ObjectHandle;
+
+    /// Recomputes the cached world transforms of the objects in this scene.
+    /// Only the branches of the hierarchy with stale transforms are visited,
+    /// so static objects cost nothing after the first update. The BVH is
+    /// refit for the objects whose bounds changed
+    auto UpdateWorldTransforms() -> void;
+
+    /// Recomputes the cached world transforms of the objects in this scene,
+    /// splitting the work by subtrees across the threads of the given pool
+    /// \param[in] pool The pool of threads used to run the update
+    auto UpdateWorldTransforms(ThreadPool& pool) -> void;
+
+    /// Sets the poses and visibility of the objects in the given snapshot.
+    /// Handles that no longer reference an object in the scene are skipped
+    /// \returns The number of objects that were updated
+    auto ApplySnapshot(const PoseSnapshot& snapshot) -> size_t;
+
+    /// Applies the latest snapshot published by the writer of the snapshots
+    /// buffer, if there's a new one. Meant to be called by the render thread
+    /// at frame boundaries, before updating the world transforms
+    /// \returns Whether or not a new snapshot was applied
+    auto ApplyLatestSnapshot() -> bool;
+
+    /// Culls the objects of this scene against all given cameras in a single
+    /// traversal of the BVH (at most MAX_CULLING_VIEWS cameras)
+    /// \param[in] cameras Pointer to the first of the cameras to cull against
+    /// \param[in] num_cameras The number of cameras
+    /// \param[in] min_screen_size Minimum projected size of visible objects
+    /// \param[out] result Visibility mask per BVH leaf (bit i for camera i)
+    auto CullCameras(const Camera* const* cameras, size_t num_cameras,
+                     float min_screen_size, MultiViewVisibility& result) const
+        -> void;
+
+    /// Culls the objects of this scene against all given cameras in a single
+    /// traversal of the BVH (at most MAX_CULLING_VIEWS cameras)
+    auto CullCameras(const std::vector<Camera::ptr>& cameras,
+                     float min_screen_size, MultiViewVisibility& result) const
+        -> void;
+
+    /// Finds the closest mesh hit by the given ray. Objects are found through
+    /// the scene BVH, and then their triangles through the BVH of their
+    /// geometry (built on first use)
+    /// \param[in] origin The origin of the ray in world space
+    /// \param[in] direction The direction of the ray (normalized internally)
+    /// \param[in] max_distance The maximum distance along the ray
+    auto Raycast(const Vec3& origin, const Vec3& direction,
+                 float max_distance = std::numeric_limits<float>::max()) const
+        -> RaycastHit;
+
+    /// Finds the closest mesh hit by the given ray (with normalized direction)
+    auto Raycast(const Ray& ray,
+                 float max_distance = std::numeric_limits<float>::max()) const
+        -> RaycastHit;
+
+    /// Casts many rays at once, optionally splitting them across threads
+    /// \param[in] rays Pointer to the first ray (with normalized directions)
+    /// \param[in] num_rays The number of rays
+    /// \param[out] hits Buffer for the results (one per ray)
+    /// \param[in] max_distance The maximum distance along the rays
+    /// \param[in] pool Optional pool used to split the work across threads
+    auto RaycastBatch(const Ray* rays, size_t num_rays, RaycastHit* hits,
+                      float max_distance = std::numeric_limits<float>::max(),
+                      ThreadPool* pool = nullptr) const -> void;
 
     /// Returns a reference to the object requested by name
-    auto operator[](const char* name) -> Object3D::ptr;
+    auto operator[](std::string_view name) -> Object3D::ptr;
+
+    /// Returns the journal of the changes made to the objects of this scene.
+    /// Objects with bounds record a POSE_CHANGED entry whenever their world
+    /// transform (or bounds) is updated
+    RENDERER_NODISCARD auto journal() const -> const ChangeJournal& {
+        return m_ChangeJournal;
+    }
+
+    /// Returns a mutable reference to the journal (e.g. to trim it)
+    RENDERER_NODISCARD auto journal() -> ChangeJournal& {
+        return m_ChangeJournal;
+    }
+
+    /// Returns the buffer used to hand snapshots over from a simulation thread.
+    /// The simulation fills and publishes its back buffer at its own pace,
+    /// while the render thread applies the front one at frame boundaries
+    RENDERER_NODISCARD auto snapshots() -> SnapshotBuffer& {
+        return m_Snapshots;
+    }
+
+    /// Returns the bounding volume hierarchy over the objects with bounds
+    RENDERER_NODISCARD auto bvh() const -> const BVH& { return m_Bvh; }
+
+    /// Returns the world bounds of the objects in the BVH, stored contiguously
+    /// and indexed by the BVH leaf id of each object
+    RENDERER_NODISCARD auto bounds_array() const -> const BoundsArray& {
+        return m_BoundsArray;
+    }
+
+    /// Returns the light sources of this scene, in the order they were added
+    RENDERER_NODISCARD auto lights() const -> const std::vector<Light::ptr>& {
+        return m_Lights;
+    }
+
+    /// Returns the number of objects directly owned by this scene
+    RENDERER_NODISCARD auto num_objects() const -> size_t {
+        return m_Objects.size();
+    }
 
     /// Returns a string representation of this scene
     RENDERER_NODISCARD auto ToString() const -> std::string override;
 
  private:
-    /// Map used for storing object names and link to index in storage
-    std::unordered_map<std::string, size_t> m_Name2Id;
+    /// Casts a single ray, using the given storage for the traversal stack
+    auto _Raycast(const Ray& ray, float max_distance,
+                  std::vector<uint32_t>& stack) const -> RaycastHit;
+
+    /// Moves the bounds changes collected by the last transforms update into
+    /// the BVH, and commits them
+    auto _SyncBvh() -> void;
+
+    /// Drops the objects of the given subtree from the BVH
+    auto _RemoveFromBvh(Object3D& obj) -> void;
+
+ private:
+    /// Handle-based storage for the objects of this scene. Kept in lockstep
+    /// with the children container, such that both have the same ordering
+    SlotMap<Object3D::ptr> m_Objects;
+
+    /// Pooled storage used for objects created by the scene
+    ObjectPool::ptr m_ObjectsPool{nullptr};
+
+    /// Secondary index used for lookups by name (keyed by interned name id)
+    std::unordered_map<NameId, ObjectHandle> m_Name2Handle;
+
+    /// Spatial index over the world bounds of the objects in the scene
+    BVH m_Bvh;
+
+    /// World bounds of the objects in the BVH, indexed by leaf id
+    BoundsArray m_BoundsArray;
+
+    /// Objects whose bounds changed during the last transforms update
+    BoundsChangeList m_BoundsChanges;
+
+    /// Log of the changes made to the objects of this scene
+    ChangeJournal m_ChangeJournal;
+
+    /// Snapshots handed over by a simulation thread
+    SnapshotBuffer m_Snapshots;
+
+    /// Light sources of this scene
+    std::vector<Light::ptr> m_Lights;
 };
 
 }  // namespace renderer
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/draw_list_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+
+namespace renderer {
+
+/// Maximum number of cascades of the shadow maps of a directional light
+static constexpr size_t MAX_SHADOW_CASCADES = 4;
+
+/// Settings of the cascaded shadow maps of the directional light
+struct RENDERER_API ShadowSettings {
+    /// Whether or not the directional light casts shadows at all
+    bool enabled{false};
+    /// Number of cascades the view gets split into (at most
+    /// MAX_SHADOW_CASCADES)
+    uint32_t num_cascades{4};
+    /// Size (in texels) of the side of the shadow map of each cascade
+    uint32_t resolution{2048};
+    /// Distance from the camera up to which shadows are drawn (clamped to the
+    /// far plane of the camera)
+    float max_distance{100.0F};
+    /// Blend between uniform (0) and logarithmic (1) splits of the view
+    float split_lambda{0.75F};
+    /// Distance towards the light, beyond the volume of a cascade, within
+    /// which objects still cast shadows into it
+    float caster_distance{100.0F};
+    /// Constant offset of the depth of the casters (in units of the depth
+    /// buffer, as in glPolygonOffset)
+    float depth_bias{1.0F};
+    /// Offset of the depth of the casters that grows with their slope (as in
+    /// glPolygonOffset)
+    float slope_bias{2.0F};
+    /// Whether or not the static casters get drawn into a cached layer, which
+    /// is only redrawn when one of them changes or the cascade moves
+    bool cache_static{true};
+    /// Step (in texels) the cascades snap to when caching. Cascades are padded
+    /// by a step, so these follow the camera by whole steps and the cached
+    /// layers survive the moves of the camera in between
+    uint32_t cache_snap_texels{64};
+
+    /// Returns the string representation of these settings
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+};
+
+/// Volume of the view covered by a shadow map, as seen from the light
+struct RENDERER_API ShadowCascade {
+    /// View matrix of the light (looking along the light direction)
+    Mat4 view{Mat4::Identity()};
+    /// Orthographic projection of the volume of the cascade
+    Mat4 proj{Mat4::Identity()};
+    /// Distance from the camera at which the cascade starts
+    float split_near{0.0F};
+    /// Distance from the camera at which the cascade ends
+    float split_far{0.0F};
+    /// Size (in world units) of a texel of the shadow map
+    float texel_size{0.0F};
+    /// Half of the side of the volume, across the light direction
+    float half_size{0.0F};
+    /// Depth of the volume along the light direction, from its center to the
+    /// side away from the light (the side towards it spans this plus the
+    /// caster distance)
+    float half_depth{0.0F};
+    /// Distance towards the light within which objects cast shadows
+    float caster_distance{0.0F};
+    /// Center of the volume in world space
+    Vec3 center{0.0F, 0.0F, 0.0F};
+    /// Axes of the light space (x, y and the opposite of the light direction)
+    Vec3 right{1.0F, 0.0F, 0.0F};
+    Vec3 up{0.0F, 1.0F, 0.0F};
+    Vec3 front{0.0F, 0.0F, 1.0F};
+    /// Center of the volume, in light space, in units of the snapping step.
+    /// Cascades with the same cell, axes and sizes cover the same volume
+    std::array<int64_t, 3> cell{};
+
+    /// Returns the transform from world space into the clip space of the map
+    RENDERER_NODISCARD auto view_proj() const -> Mat4 { return proj * view; }
+
+    /// Returns whether or not an object with the given bounds might cast
+    /// shadows into this cascade
+    RENDERER_NODISCARD auto Overlaps(const AABB& bounds) const -> bool;
+
+    /// Returns whether or not this cascade covers the same volume as the given
+    /// one, as seen from the same light
+    RENDERER_NODISCARD auto SameVolume(const ShadowCascade& other) const
+        -> bool;
+};
+
+/// Returns the distances at which the view of the camera gets split into
+/// cascades, blending uniform and logarithmic splits (the "practical split
+/// scheme"). The first entry is the near distance, and the entry after the
+/// last cascade is the far one
+RENDERER_API auto ComputeCascadeSplits(float near, float far,
+                                       uint32_t num_cascades, float lambda)
+    -> std::array<float, MAX_SHADOW_CASCADES + 1>;
+
+/// Computes the cascade that covers the view of the camera between the given
+/// distances, for a directional light with the given direction.
+///
+/// The volume is fit to a sphere around the slice of the view, so its size
+/// doesn't change as the camera rotates, and its center snaps to whole texels
+/// (or whole caching steps) of the light space, so the texels of the map don't
+/// swim as the camera moves
+RENDERER_API auto ComputeShadowCascade(const Camera& camera,
+                                       const Vec3& light_direction,
+                                       float split_near, float split_far,
+                                       const ShadowSettings& settings)
+    -> ShadowCascade;
+
+/// Returns whether or not the given item of a draw list is a static caster:
+/// a visible static mesh whose material casts shadows
+RENDERER_API auto IsStaticCaster(const DrawItem& item) -> bool;
+
+/// Returns whether or not the given item of a draw list casts shadows at all
+RENDERER_API auto IsShadowCaster(const DrawItem& item) -> bool;
+
+/// Tracks which cascades of the cached layer of static casters are still up
+/// to date. A layer is invalidated when its cascade covers a different volume
+/// (the camera moved by a caching step, or the light changed), or when a
+/// static caster overlapping its volume was added, removed, moved, hidden or
+/// restated. Changes of the static casters are read from the draw list, so
+/// keeping the cache up to date costs in proportion to what changed. Writes to
+/// the castShadows flag of a material aren't recorded by the scene, so the
+/// cache keeps the flag of each material in use and checks them every frame.
+///
+/// The cache also keeps the list of the dynamic casters, which get drawn on
+/// top of the cached layers every frame
+class RENDERER_API ShadowCache {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(ShadowCache)
+
+    DEFINE_SMART_POINTERS(ShadowCache)
+
+ public:
+    ShadowCache() = default;
+
+    ~ShadowCache() = default;
+
+    /// Sets the cascades of the current frame, invalidating the layers whose
+    /// cascade covers a different volume than the one they were drawn for
+    auto SetCascades(const std::vector<ShadowCascade>& cascades) -> void;
+
+    /// Brings the static casters up to date with the given draw list (synced
+    /// for this frame), invalidating the layers their changes overlap
+    auto SyncCasters(const DrawList& draw_list) -> void;
+
+    /// Invalidates the layers that an object with the given bounds might cast
+    /// shadows into
+    auto Invalidate(const AABB& bounds) -> void;
+
+    /// Invalidates all layers
+    auto InvalidateAll() -> void;
+
+    /// Flags the layer of the given cascade as drawn for its current volume
+    auto MarkValid(size_t cascade) -> void;
+
+    /// Returns whether or not the layer of the given cascade is up to date
+    RENDERER_NODISCARD auto valid(size_t cascade) const -> bool {
+        return cascade < m_Valid.size() && m_Valid[cascade] != 0;
+    }
+
+    /// Returns the cascades of the current frame
+    RENDERER_NODISCARD auto cascades() const
+        -> const std::vector<ShadowCascade>& {
+        return m_Cascades;
+    }
+
+    /// Returns the items of the draw list that cast shadows but aren't static
+    RENDERER_NODISCARD auto dynamic_casters() const
+        -> const std::vector<const DrawItem*>& {
+        return m_DynamicCasters;
+    }
+
+    /// Returns the number of static casters tracked
+    RENDERER_NODISCARD auto num_static_casters() const -> size_t {
+        return m_NumStaticCasters;
+    }
+
+    /// Returns the number of times a valid layer got invalidated so far
+    RENDERER_NODISCARD auto num_invalidations() const -> size_t {
+        return m_NumInvalidations;
+    }
+
+    /// Returns a string representation of this cache
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// State of a slot of the draw list, as last seen by the cache
+    struct Caster {
+        /// Object in the slot (nullptr for free slots)
+        const Object3D* object{nullptr};
+        /// World bounds of the object
+        AABB bounds;
+        /// Whether or not the object was a static caster
+        bool is_static{false};
+        /// Whether or not the object was a caster, but not a static one
+        bool is_dynamic{false};
+        /// Material of the object (nullptr for the default material)
+        const Material* material{nullptr};
+        /// Whether or not the material cast shadows
+        bool cast_shadows{true};
+    };
+
+    /// Compares the given slot with the given item (nullptr if the slot is
+    /// free), invalidating the layers the changes of a static caster overlap
+    auto _UpdateSlot(size_t slot, const DrawItem* item) -> void;
+
+    /// Compares the castShadows flag of the materials in use with the one
+    /// they were last seen with, comparing every slot again if any changed
+    auto _CheckMaterials() -> void;
+
+ private:
+    /// Cascades of the current frame
+    std::vector<ShadowCascade> m_Cascades;
+
+    /// Whether or not the layer of each cascade is up to date
+    std::vector<uint8_t> m_Valid;
+
+    /// State of each slot of the draw list
+    std::vector<Caster> m_Casters;
+
+    /// Item of the draw list in each slot (nullptr for free slots), valid
+    /// while the version of its items stays the same
+    std::vector<const DrawItem*> m_SlotItems;
+
+    /// Items of the draw list that cast shadows but aren't static
+    std::vector<const DrawItem*> m_DynamicCasters;
+
+    /// Whether or not the list of dynamic casters has to be rebuilt
+    bool m_DynamicCastersDirty{true};
+
+    /// Materials of the slots, along with the castShadows flag they were last
+    /// seen with (each material listed once)
+    std::vector<std::pair<const Material*, bool>> m_Materials;
+
+    /// Whether or not the list of materials has to be rebuilt
+    bool m_MaterialsDirty{true};
+
+    /// Version of the items of the draw list the slots were read from
+    uint64_t m_ItemsVersion{0};
+
+    /// Whether or not the slots were read from a draw list at all
+    bool m_Synced{false};
+
+    /// Number of static casters tracked
+    size_t m_NumStaticCasters{0};
+
+    /// Number of times a valid layer got invalidated so far
+    size_t m_NumInvalidations{0};
+};
+
+}  // namespace renderer
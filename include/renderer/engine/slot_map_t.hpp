@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Stable reference to an element stored in a SlotMap. The generation is used
+/// to detect handles to elements that have already been removed
+struct SlotHandle {
+    /// Index value used by handles that don't reference any element
+    static constexpr uint32_t INVALID_INDEX =
+        std::numeric_limits<uint32_t>::max();
+
+    /// Index of the slot this handle points to
+    uint32_t index{INVALID_INDEX};
+    /// Generation of the slot at the moment this handle was created
+    uint32_t generation{0};
+
+    /// Returns whether or not this handle could point to an element
+    RENDERER_NODISCARD auto valid() const -> bool {
+        return index != INVALID_INDEX;
+    }
+
+    /// Packs this handle into a single 64-bit integer (e.g. for numpy arrays)
+    RENDERER_NODISCARD auto ToUint64() const -> uint64_t {
+        return (static_cast<uint64_t>(generation) << 32U) |
+               static_cast<uint64_t>(index);
+    }
+
+    /// Unpacks a handle previously packed with ToUint64
+    static auto FromUint64(uint64_t packed) -> SlotHandle {
+        constexpr uint64_t LOWER_MASK = 0xffffffffULL;
+        return {static_cast<uint32_t>(packed & LOWER_MASK),
+                static_cast<uint32_t>(packed >> 32U)};
+    }
+
+    /// Returns a string representation of this handle
+    RENDERER_NODISCARD auto ToString() const -> std::string {
+        return "<Handle index=" + std::to_string(index) +
+               " generation=" + std::to_string(generation) + ">";
+    }
+};
+
+inline auto operator==(const SlotHandle& lhs, const SlotHandle& rhs) -> bool {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+inline auto operator!=(const SlotHandle& lhs, const SlotHandle& rhs) -> bool {
+    return !(lhs == rhs);
+}
+
+/// Generational slot map, with O(1) insertion, removal and lookup by handle.
+/// Elements are kept packed in a dense array, so iterating over all of them is
+/// cache friendly. Removal moves the last element into the freed position
+template <typename T>
+class SlotMap {
+ public:
+    SlotMap() = default;
+
+    /// Stores the given value, and returns the handle used to reference it
+    auto Insert(T value) -> SlotHandle {
+        uint32_t slot_idx = 0;
+        if (m_FreeHead != SlotHandle::INVALID_INDEX) {
+            slot_idx = m_FreeHead;
+            m_FreeHead = m_Slots[slot_idx].dense_index;
+        } else {
+            slot_idx = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.push_back({0, 0});
+        }
+
+        auto& slot = m_Slots[slot_idx];
+        slot.dense_index = static_cast<uint32_t>(m_Values.size());
+        m_Values.push_back(std::move(value));
+        m_DenseToSlot.push_back(slot_idx);
+        return {slot_idx, slot.generation};
+    }
+
+    /// Removes the element referenced by the given handle, if still alive
+    auto Remove(SlotHandle handle) -> bool {
+        if (!Contains(handle)) {
+            return false;
+        }
+
+        auto& slot = m_Slots[handle.index];
+        const auto DENSE_IDX = slot.dense_index;
+        const auto LAST_IDX = static_cast<uint32_t>(m_Values.size() - 1);
+        if (DENSE_IDX != LAST_IDX) {
+            m_Values[DENSE_IDX] = std::move(m_Values[LAST_IDX]);
+            m_DenseToSlot[DENSE_IDX] = m_DenseToSlot[LAST_IDX];
+            m_Slots[m_DenseToSlot[DENSE_IDX]].dense_index = DENSE_IDX;
+        }
+        m_Values.pop_back();
+        m_DenseToSlot.pop_back();
+
+        // Bumping the generation invalidates all handles to this slot
+        slot.generation++;
+        slot.dense_index = m_FreeHead;
+        m_FreeHead = handle.index;
+        return true;
+    }
+
+    /// Returns whether or not the given handle references a live element
+    RENDERER_NODISCARD auto Contains(SlotHandle handle) const -> bool {
+        return handle.index < m_Slots.size() &&
+               m_Slots[handle.index].generation == handle.generation;
+    }
+
+    /// Returns a pointer to the element for the given handle (or nullptr)
+    RENDERER_NODISCARD auto Get(SlotHandle handle) -> T* {
+        return Contains(handle) ? &m_Values[m_Slots[handle.index].dense_index]
+                                : nullptr;
+    }
+
+    /// Returns a pointer to the element for the given handle (or nullptr)
+    RENDERER_NODISCARD auto Get(SlotHandle handle) const -> const T* {
+        return Contains(handle) ? &m_Values[m_Slots[handle.index].dense_index]
+                                : nullptr;
+    }
+
+    /// Returns the position in the dense array of the given (live) handle
+    RENDERER_NODISCARD auto dense_index(SlotHandle handle) const -> size_t {
+        return m_Slots[handle.index].dense_index;
+    }
+
+    /// Returns the handle of the element at the given dense position
+    RENDERER_NODISCARD auto handle_at(size_t dense_index) const -> SlotHandle {
+        const auto SLOT_IDX = m_DenseToSlot[dense_index];
+        return {SLOT_IDX, m_Slots[SLOT_IDX].generation};
+    }
+
+    /// Removes all elements. Handles given out so far become invalid
+    auto Clear() -> void {
+        while (!m_Values.empty()) {
+            Remove(handle_at(m_Values.size() - 1));
+        }
+    }
+
+    /// Returns the packed array of values stored in this container
+    RENDERER_NODISCARD auto values() const -> const std::vector<T>& {
+        return m_Values;
+    }
+
+    /// Returns the number of elements stored in this container
+    RENDERER_NODISCARD auto size() const -> size_t { return m_Values.size(); }
+
+    /// Returns whether or not this container is empty
+    RENDERER_NODISCARD auto empty() const -> bool { return m_Values.empty(); }
+
+ private:
+    /// Indirection entry, stable for the lifetime of the container
+    struct Slot {
+        /// Index in the dense array (or next free slot, if not in use)
+        uint32_t dense_index;
+        /// Current generation of this slot
+        uint32_t generation;
+    };
+
+    /// Packed storage of the elements
+    std::vector<T> m_Values;
+
+    /// Map from dense positions back to their slots
+    std::vector<uint32_t> m_DenseToSlot;
+
+    /// Indirection table used to resolve handles
+    std::vector<Slot> m_Slots;
+
+    /// Head of the intrusive list of free slots
+    uint32_t m_FreeHead{SlotHandle::INVALID_INDEX};
+};
+
+}  // namespace renderer
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Pool of worker threads with work-stealing task queues. Each worker owns a
+/// queue; tasks submitted from a worker go to its own queue, and idle workers
+/// steal from the others. Threads waiting for their tasks to complete help
+/// executing pending tasks, so parallel loops can be nested safely
+class RENDERER_API ThreadPool {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(ThreadPool)
+
+    DEFINE_SMART_POINTERS(ThreadPool)
+
+ public:
+    /// Signature of the tasks handled by the pool
+    using Task = std::function<void()>;
+
+    /// Signature of the body of a parallel loop, run over [begin, end)
+    using RangeTask = std::function<void(size_t begin, size_t end)>;
+
+    /// Creates a pool with the given number of worker threads. The thread
+    /// that waits for the work also takes part, so a pool with zero workers
+    /// runs everything in the calling thread
+    /// \param[in] num_workers The number of threads to spawn
+    explicit ThreadPool(size_t num_workers);
+
+    /// Waits for the pending tasks and joins all worker threads
+    ~ThreadPool();
+
+    /// Submits a task to the pool, to be run by any of the workers
+    auto Submit(Task task) -> void;
+
+    /// Runs the given body over the range [0, count), split in chunks of the
+    /// given size, and waits (while helping) until all chunks are completed
+    /// \param[in] count The number of elements in the range
+    /// \param[in] grain The number of elements handled by each task
+    /// \param[in] body The body of the loop, called with each chunk range
+    auto ParallelFor(size_t count, size_t grain, const RangeTask& body)
+        -> void;
+
+    /// Waits (while helping) until all submitted tasks are completed
+    auto WaitIdle() -> void;
+
+    /// Returns the number of worker threads of this pool
+    RENDERER_NODISCARD auto num_workers() const -> size_t {
+        return m_Workers.size();
+    }
+
+    /// Returns the index of the calling thread within this pool: the index of
+    /// its worker, or num_workers() for any thread that isn't a worker
+    RENDERER_NODISCARD auto current_thread_index() const -> size_t;
+
+    /// Returns a string representation of this pool
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Task queue owned by a single worker (or by external threads)
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// Main loop run by each worker thread
+    auto _WorkerLoop(size_t worker_index) -> void;
+
+    /// Tries to run a single pending task. Returns whether one was run
+    auto _RunPendingTask(size_t queue_hint) -> bool;
+
+    /// Pops a task from the back of the given queue (owner side)
+    static auto _PopLocal(TaskQueue& queue, Task& task) -> bool;
+
+    /// Steals a task from the front of the given queue (thief side)
+    static auto _Steal(TaskQueue& queue, Task& task) -> bool;
+
+ private:
+    /// Queues of the workers, plus an extra one for external threads
+    std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+
+    /// The worker threads of this pool
+    std::vector<std::thread> m_Workers;
+
+    /// Number of tasks submitted but not yet completed
+    std::atomic<size_t> m_NumPending{0};
+
+    /// Number of tasks waiting in the queues (not yet picked by any thread)
+    std::atomic<size_t> m_NumQueued{0};
+
+    /// Whether or not the workers should stop
+    std::atomic<bool> m_Stop{false};
+
+    /// Used to put idle workers to sleep until new tasks arrive
+    std::mutex m_SleepMutex;
+
+    /// Used to wake up idle workers when new tasks arrive
+    std::condition_variable m_SleepCondition;
+};
+
+}  // namespace renderer
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Lock-free triple buffer, used to hand data over from a single writer
+/// thread to a single reader thread. The writer fills the back buffer and
+/// publishes it, while the reader works on the front buffer and picks up the
+/// latest published one when it's ready (e.g. at a frame boundary). Neither
+/// of them ever waits for the other: publishing and acquiring just swap the
+/// index of their buffer with the one in the middle
+template <typename T>
+class TripleBuffer {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(TripleBuffer)
+
+ public:
+    TripleBuffer() = default;
+
+    ~TripleBuffer() = default;
+
+    /// Returns the buffer owned by the writer, to be filled before publishing
+    auto back() -> T& { return m_Buffers[m_Back]; }
+
+    /// Makes the back buffer available to the reader (writer thread only)
+    auto Publish() -> void {
+        const auto FRESH_BACK = static_cast<uint8_t>(m_Back | FRESH_BIT);
+        const auto PREVIOUS =
+            m_Middle.exchange(FRESH_BACK, std::memory_order_acq_rel);
+        m_Back = static_cast<uint8_t>(PREVIOUS & INDEX_MASK);
+    }
+
+    /// Swaps in the latest published buffer as the front one, if there's a
+    /// new one since the last call (reader thread only)
+    /// \returns Whether or not the front buffer changed
+    auto Acquire() -> bool {
+        if ((m_Middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+            return false;
+        }
+        const auto PREVIOUS =
+            m_Middle.exchange(m_Front, std::memory_order_acq_rel);
+        m_Front = static_cast<uint8_t>(PREVIOUS & INDEX_MASK);
+        return true;
+    }
+
+    /// Returns the buffer owned by the reader (the latest one it acquired)
+    auto front() -> T& { return m_Buffers[m_Front]; }
+
+    /// Returns the buffer owned by the reader (the latest one it acquired)
+    RENDERER_NODISCARD auto front() const -> const T& {
+        return m_Buffers[m_Front];
+    }
+
+ private:
+    /// Bits of the middle state used for the index of the buffer
+    static constexpr uint8_t INDEX_MASK = 0x3;
+
+    /// Bit of the middle state set when the writer published a new buffer
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    /// Storage for the three buffers
+    std::array<T, 3> m_Buffers{};
+
+    /// Index of the buffer in the middle, along with the fresh bit
+    std::atomic<uint8_t> m_Middle{1};
+
+    /// Index of the buffer owned by the writer
+    uint8_t m_Back{0};
+
+    /// Index of the buffer owned by the reader
+    uint8_t m_Front{2};
+};
+
+}  // namespace renderer
@@ -18,9 +18,14 @@ from renderer_bindings import (  # type: ignore
     TextureFilter,
     TextureIntFormat,
     ObjectType,
+    ObjectPose,
     Object3D,
     Scene,
     InputManager,
+    FramePhase,
+    FramePass,
+    FrameStats,
+    FrameStatsHistory,
 )
 
 __all__ = [
@@ -41,8 +46,13 @@ __all__ = [
     "TextureFilter",
     "TextureIntFormat",
     "ObjectType",
+    "ObjectPose",
     "Object3D",
     "Scene",
     "InputManager",
+    "FramePhase",
+    "FramePass",
+    "FrameStats",
+    "FrameStatsHistory",
 ]
 # fmt: on
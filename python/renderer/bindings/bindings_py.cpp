@@ -22,6 +22,7 @@ extern auto bindings_resources_manager(py::module m) -> void;
 
 extern auto bindings_object3d(py::module m) -> void;
 extern auto bindings_scene(py::module m) -> void;
+extern auto bindings_frame_stats(py::module m) -> void;
 
 }  // namespace renderer
 
@@ -50,4 +51,5 @@ PYBIND11_MODULE(renderer_bindings, m) {
 
     ::renderer::bindings_object3d(m);
     ::renderer::bindings_scene(m);
+    ::renderer::bindings_frame_stats(m);
 }
@@ -43,12 +43,14 @@ void bindings_buffers(py::module m) {
         py::class_<Class>(m, ClassName)
             .def(py::init<>())
             .def(py::init<const char*, const eElementType&, bool>())
+            .def(py::init<const char*, const eElementType&, bool, uint32_t>())
             .def_readwrite("name", &Class::name)
             .def_readwrite("type", &Class::type)
             .def_readwrite("count", &Class::count)
             .def_readwrite("nbytes", &Class::nbytes)
             .def_readwrite("offset", &Class::offset)
             .def_readwrite("normalized", &Class::normalized)
+            .def_readwrite("divisor", &Class::divisor)
             .def("__repr__", &Class::ToString);
     }
 
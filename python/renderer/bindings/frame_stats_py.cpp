@@ -0,0 +1,139 @@
+#include <string>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <renderer/engine/frame_stats_t.hpp>
+
+namespace py = pybind11;
+
+namespace renderer {
+
+namespace {
+using NumpyFloatArray = py::array_t<float, py::array::c_style>;
+
+// Packs the given times of every frame of the history into an (N, M) array,
+// where M is the number of phases or passes (oldest frame first)
+template <size_t M, typename Getter>
+auto TimesToNumpy(const FrameStatsHistory& history, Getter getter)
+    -> NumpyFloatArray {
+    NumpyFloatArray np_times({static_cast<py::ssize_t>(history.size()),
+                              static_cast<py::ssize_t>(M)});
+    auto* data = np_times.mutable_data();
+    for (size_t i = 0; i < history.size(); ++i) {
+        const auto& times = getter(history[i]);
+        for (size_t j = 0; j < M; ++j) {
+            data[i * M + j] = times[j];
+        }
+    }
+    return np_times;
+}
+}  // namespace
+
+// NOLINTNEXTLINE
+auto bindings_frame_stats(py::module m) -> void {
+    {
+        using Enum = ::renderer::eFramePhase;
+        py::enum_<Enum>(m, "FramePhase")
+            .value("SYNC", Enum::SYNC)
+            .value("CULL", Enum::CULL)
+            .value("QUEUE", Enum::QUEUE)
+            .value("BATCH", Enum::BATCH)
+            .value("SUBMIT", Enum::SUBMIT)
+            .value("DEBUG", Enum::DEBUG)
+            .value("SHADOW", Enum::SHADOW)
+            .value("LIGHTS", Enum::LIGHTS);
+    }
+
+    {
+        using Enum = ::renderer::eFramePass;
+        py::enum_<Enum>(m, "FramePass")
+            .value("DEPTH_PREPASS", Enum::DEPTH_PREPASS)
+            .value("SCENE", Enum::SCENE)
+            .value("DEBUG", Enum::DEBUG)
+            .value("SHADOW", Enum::SHADOW);
+    }
+
+    {
+        using Class = ::renderer::FrameStats;
+        constexpr auto* ClassName = "FrameStats";  // NOLINT
+        py::class_<Class>(m, ClassName)
+            .def(py::init<>())
+            .def_readonly("frame_index", &Class::frame_index)
+            .def_readonly("num_objects", &Class::num_objects)
+            .def_readonly("num_visible", &Class::num_visible)
+            .def_readonly("num_frustum_culled", &Class::num_frustum_culled)
+            .def_readonly("num_size_culled", &Class::num_size_culled)
+            .def_readonly("num_occluders", &Class::num_occluders)
+            .def_readonly("num_occlusion_culled",
+                          &Class::num_occlusion_culled)
+            .def_readonly("num_draw_items", &Class::num_draw_items)
+            .def_readonly("num_changes_applied", &Class::num_changes_applied)
+            .def_readonly("num_transforms_patched",
+                          &Class::num_transforms_patched)
+            .def_readonly("num_draw_calls", &Class::num_draw_calls)
+            .def_readonly("num_instances", &Class::num_instances)
+            .def_readonly("num_triangles", &Class::num_triangles)
+            .def_readonly("num_program_changes", &Class::num_program_changes)
+            .def_readonly("num_material_changes",
+                          &Class::num_material_changes)
+            .def_readonly("num_texture_changes", &Class::num_texture_changes)
+            .def_readonly("num_vao_changes", &Class::num_vao_changes)
+            .def_readonly("num_state_changes", &Class::num_state_changes)
+            .def_readonly("num_elided_state_changes",
+                          &Class::num_elided_state_changes)
+            .def_readonly("num_bytes_uploaded", &Class::num_bytes_uploaded)
+            .def_readonly("num_shadow_casters", &Class::num_shadow_casters)
+            .def_readonly("num_shadow_layers_redrawn",
+                          &Class::num_shadow_layers_redrawn)
+            .def_readonly("num_clustered_lights",
+                          &Class::num_clustered_lights)
+            .def_readonly("num_light_assignments",
+                          &Class::num_light_assignments)
+            .def_readonly("cpu_time_ms", &Class::cpu_time_ms)
+            .def_readonly("gpu_time_ms", &Class::gpu_time_ms)
+            .def_readonly("gpu_frame_index", &Class::gpu_frame_index)
+            .def("cpu_time", &Class::cpu_time)
+            .def("gpu_time", &Class::gpu_time)
+            .def_property_readonly("cpu_total_ms", &Class::cpu_total_ms)
+            .def_property_readonly("gpu_total_ms", &Class::gpu_total_ms)
+            .def("__repr__", &Class::ToString);
+    }
+
+    {
+        using Class = ::renderer::FrameStatsHistory;
+        constexpr auto* ClassName = "FrameStatsHistory";  // NOLINT
+        py::class_<Class>(m, ClassName)
+            .def(py::init<size_t>(),
+                 py::arg("capacity") = DEFAULT_FRAME_STATS_HISTORY)
+            .def("Push", &Class::Push)
+            .def("Clear", &Class::Clear)
+            .def("SetCapacity", &Class::SetCapacity)
+            .def("ComputeMeanCpuTime", &Class::ComputeMeanCpuTime)
+            .def("ComputeMeanGpuTime", &Class::ComputeMeanGpuTime)
+            .def("ComputeMeanCpuTotal", &Class::ComputeMeanCpuTotal)
+            .def("ComputeMaxCpuTotal", &Class::ComputeMaxCpuTotal)
+            .def("CpuTimes",
+                 [](const Class& self) -> NumpyFloatArray {
+                     return TimesToNumpy<NUM_FRAME_PHASES>(
+                         self, [](const FrameStats& stats) {
+                             return stats.cpu_time_ms;
+                         });
+                 })
+            .def("GpuTimes",
+                 [](const Class& self) -> NumpyFloatArray {
+                     return TimesToNumpy<NUM_FRAME_PASSES>(
+                         self, [](const FrameStats& stats) {
+                             return stats.gpu_time_ms;
+                         });
+                 })
+            .def_property_readonly("latest", &Class::latest)
+            .def_property_readonly("capacity", &Class::capacity)
+            .def("__len__", &Class::size)
+            .def("__getitem__", &Class::operator[])
+            .def("__repr__", &Class::ToString);
+    }
+}
+
+}  // namespace renderer
@@ -10,6 +10,13 @@ namespace py = pybind11;
 
 namespace renderer {
 
+// View of the pose of an object, whose setters go through the object such
+// that its world transform gets updated (the pose itself isn't exposed by
+// reference, as changing it in place would skip the dirty flags)
+struct ObjectPose {
+    Object3D::ptr object;
+};
+
 // NOLINTNEXTLINE
 auto bindings_object3d(py::module m) -> void {
     {
@@ -22,6 +29,39 @@ auto bindings_object3d(py::module m) -> void {
             .value("LIGHT", Enum::LIGHT);
     }
 
+    m.def("InternName", [](const std::string& name) {
+        return ::renderer::NameTable::Intern(name);
+    });
+    m.def("FindName", [](const std::string& name) {
+        return ::renderer::NameTable::Find(name);
+    });
+    m.def("GetNameString", &::renderer::NameTable::GetString);
+    m.attr("INVALID_NAME_ID") = ::renderer::INVALID_NAME_ID;
+
+    {
+        using Class = ::renderer::ObjectPose;
+        constexpr auto* ClassName = "ObjectPose";  // NOLINT
+        py::class_<Class>(m, ClassName)            // NOLINT
+            .def_property(
+                "position",
+                [](const Class& self) -> Vec3 {
+                    return self.object->pose().position;
+                },
+                [](Class& self, const Vec3& position) {
+                    self.object->SetPosition(position);
+                })
+            .def_property(
+                "orientation",
+                [](const Class& self) -> Quat {
+                    return self.object->pose().orientation;
+                },
+                [](Class& self, const Quat& orientation) {
+                    self.object->SetOrientation(orientation);
+                })
+            .def("ToPose",
+                 [](const Class& self) -> Pose { return self.object->pose(); });
+    }
+
     {
         using Class = ::renderer::Object3D;
         constexpr auto* ClassName = "Object3D";      // NOLINT
@@ -30,7 +70,19 @@ auto bindings_object3d(py::module m) -> void {
             .def(py::init<const char*, Pose>())
             .def(py::init<const char*, Vec3>())
             .def("AddChild", &Class::AddChild)
-            .def_readwrite("pose", &Class::pose)
+            .def_property(
+                "pose",
+                [](const Class::ptr& self) -> ObjectPose { return {self}; },
+                &Class::SetPose)
+            .def("SetPose", &Class::SetPose)
+            .def("SetPosition", &Class::SetPosition)
+            .def("SetOrientation", &Class::SetOrientation)
+            .def("MarkTransformDirty", &Class::MarkTransformDirty)
+            .def_property("visible", &Class::visible, &Class::SetVisible)
+            .def_property_readonly("world_transform",
+                                   &Class::world_transform)
+            .def_property_readonly("transform_dirty",
+                                   &Class::transform_dirty)
             // TODO(wilbert): Use return value policies
             .def_property(
                 "parent",
@@ -44,9 +96,10 @@ auto bindings_object3d(py::module m) -> void {
                 [](Class& self, Class::ptr parent_obj) {
                     self.parent = parent_obj;
                 })
-            .def_readwrite("children", &Class::children)
+            .def_property_readonly("children", &Class::children)
             .def_property_readonly("type", &Class::type)
             .def_property_readonly("name", &Class::name)
+            .def_property_readonly("name_id", &Class::name_id)
             .def("__repr__", &Class::ToString);
     }
 }
@@ -20,6 +20,7 @@ void bindings_program(py::module m) {
             .def("Build", &Class::Build)
             .def("Bind", &Class::Bind)
             .def("Unbind", &Class::Unbind)
+            .def("BindUniformBlock", &Class::BindUniformBlock)
             .def("SetInt", &Class::SetInt)
             .def("SetFloat", &Class::SetFloat)
             .def("SetVec2",
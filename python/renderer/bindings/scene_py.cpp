@@ -1,4 +1,13 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/operators.h>
 
 #include <renderer/engine/scene_t.hpp>
 
@@ -6,8 +15,87 @@ namespace py = pybind11;
 
 namespace renderer {
 
+namespace {
+// Arrays are converted (if needed) to contiguous arrays of the right dtype
+using NumpyFloatArray =
+    py::array_t<float, py::array::c_style | py::array::forcecast>;
+using NumpyHandleArray =
+    py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+// Unpacks handles given as an (N,) array of packed uint64 values
+auto ToHandles(const NumpyHandleArray& np_handles)
+    -> std::vector<ObjectHandle> {
+    if (np_handles.ndim() != 1) {
+        throw std::runtime_error("Scene >>> handles must be an (N,) array");
+    }
+    std::vector<ObjectHandle> handles(static_cast<size_t>(np_handles.size()));
+    const auto* packed = np_handles.data();
+    for (size_t i = 0; i < handles.size(); ++i) {
+        handles[i] = ObjectHandle::FromUint64(packed[i]);
+    }
+    return handles;
+}
+
+// Packs the given handles into an (N,) array of uint64 values
+auto ToNumpy(const std::vector<ObjectHandle>& handles) -> NumpyHandleArray {
+    NumpyHandleArray np_handles(static_cast<py::ssize_t>(handles.size()));
+    auto* packed = np_handles.mutable_data();
+    for (size_t i = 0; i < handles.size(); ++i) {
+        packed[i] = handles[i].ToUint64();
+    }
+    return np_handles;
+}
+
+// Checks that the given array has shape (num_rows, num_cols)
+auto CheckShape(const NumpyFloatArray& array, size_t num_rows,
+                size_t num_cols, const char* name) -> void {
+    if (array.ndim() != 2 || static_cast<size_t>(array.shape(0)) != num_rows ||
+        static_cast<size_t>(array.shape(1)) != num_cols) {
+        throw std::runtime_error("Scene >>> " + std::string(name) +
+                                 " must be an (" + std::to_string(num_rows) +
+                                 "," + std::to_string(num_cols) + ") array");
+    }
+}
+}  // namespace
+
 // NOLINTNEXTLINE
 auto bindings_scene(py::module m) -> void {
+    {
+        using Class = ::renderer::ObjectHandle;
+        constexpr auto* ClassName = "ObjectHandle";  // NOLINT
+        py::class_<Class>(m, ClassName)
+            .def(py::init<>())
+            .def_readonly("index", &Class::index)
+            .def_readonly("generation", &Class::generation)
+            .def("valid", &Class::valid)
+            .def("ToUint64", &Class::ToUint64)
+            .def_static("FromUint64", &Class::FromUint64)
+            .def(py::self == py::self)   // NOLINT
+            .def(py::self != py::self)   // NOLINT
+            .def("__hash__", &Class::ToUint64)
+            .def("__repr__", &Class::ToString);
+    }
+
+    {
+        using Class = ::renderer::RaycastHit;
+        constexpr auto* ClassName = "RaycastHit";  // NOLINT
+        py::class_<Class>(m, ClassName)
+            .def(py::init<>())
+            .def_property_readonly(
+                "object",
+                [](const Class& self) -> Object3D::ptr {
+                    return (self.object != nullptr)
+                               ? self.object->shared_from_this()
+                               : nullptr;
+                })
+            .def_readonly("distance", &Class::distance)
+            .def_readonly("triangle", &Class::triangle)
+            .def_readonly("point", &Class::point)
+            .def("hit", &Class::hit)
+            .def("__bool__", &Class::hit)
+            .def("__repr__", &Class::ToString);
+    }
+
     {
         using Class = ::renderer::Scene;
         using ParentClass = ::renderer::Object3D;
@@ -15,11 +103,96 @@ auto bindings_scene(py::module m) -> void {
         py::class_<Class, ParentClass, Class::ptr>(m, ClassName)  // NOLINT
             .def(py::init<>())
             .def("AddChild", &Class::AddChild)
-            .def("ExistsChild", &Class::ExistsChild)
-            .def("RemoveChild", &Class::RemoveChild)
-            .def("GetChild", &Class::GetChild)
+            .def("AddObject", &Class::AddObject)
+            .def("CreateObject",
+                 [](Class& self, const char* name) {
+                     return self.CreateObject<Object3D>(name);
+                 })
+            .def("CreateObject",
+                 [](Class& self, const char* name, Pose pose) {
+                     return self.CreateObject<Object3D>(name, pose);
+                 })
+            .def("ExistsChild", py::overload_cast<std::string_view>(
+                                    &Class::ExistsChild, py::const_))
+            .def("ExistsChild", py::overload_cast<NameId>(&Class::ExistsChild,
+                                                          py::const_))
+            .def("ExistsChild", py::overload_cast<ObjectHandle>(
+                                    &Class::ExistsChild, py::const_))
+            .def("RemoveChild",
+                 py::overload_cast<std::string_view>(&Class::RemoveChild))
+            .def("RemoveChild",
+                 py::overload_cast<ObjectHandle>(&Class::RemoveChild))
+            .def("GetChild",
+                 py::overload_cast<std::string_view>(&Class::GetChild))
+            .def("GetChild", py::overload_cast<NameId>(&Class::GetChild))
+            .def("GetChild", py::overload_cast<ObjectHandle>(&Class::GetChild))
+            .def("GetHandle", py::overload_cast<std::string_view>(
+                                  &Class::GetHandle, py::const_))
+            .def("GetHandle",
+                 py::overload_cast<NameId>(&Class::GetHandle, py::const_))
+            .def("UpdateWorldTransforms",
+                 py::overload_cast<>(&Class::UpdateWorldTransforms))
+            .def(
+                "CreateObjects",
+                [](Class& self, const std::string& prefix,
+                   const NumpyFloatArray& positions,
+                   const NumpyFloatArray& quats) -> NumpyHandleArray {
+                    const auto NUM_OBJECTS =
+                        static_cast<size_t>(positions.shape(0));
+                    CheckShape(positions, NUM_OBJECTS, 3, "positions");
+                    CheckShape(quats, NUM_OBJECTS, 4, "quats");
+                    return ToNumpy(self.CreateObjects(
+                        prefix, NUM_OBJECTS, positions.data(), quats.data()));
+                },
+                py::arg("prefix"), py::arg("positions"), py::arg("quats"))
+            .def(
+                "SetPoses",
+                [](Class& self, const NumpyHandleArray& np_handles,
+                   const NumpyFloatArray& positions,
+                   const NumpyFloatArray& quats) -> size_t {
+                    const auto HANDLES = ToHandles(np_handles);
+                    CheckShape(positions, HANDLES.size(), 3, "positions");
+                    CheckShape(quats, HANDLES.size(), 4, "quats");
+                    return self.SetPoses(HANDLES.data(), HANDLES.size(),
+                                         positions.data(), quats.data());
+                },
+                py::arg("handles"), py::arg("positions"), py::arg("quats"))
+            .def("GetPoses",
+                 [](const Class& self, const NumpyHandleArray& np_handles)
+                     -> py::tuple {
+                     const auto HANDLES = ToHandles(np_handles);
+                     const auto NUM_OBJECTS =
+                         static_cast<py::ssize_t>(HANDLES.size());
+                     NumpyFloatArray positions({NUM_OBJECTS, py::ssize_t{3}});
+                     NumpyFloatArray quats({NUM_OBJECTS, py::ssize_t{4}});
+                     // Entries of stale handles are left as zeros
+                     std::fill_n(positions.mutable_data(), positions.size(),
+                                 0.0F);
+                     std::fill_n(quats.mutable_data(), quats.size(), 0.0F);
+                     self.GetPoses(HANDLES.data(), HANDLES.size(),
+                                   positions.mutable_data(),
+                                   quats.mutable_data());
+                     return py::make_tuple(positions, quats);
+                 })
+            .def("Raycast",
+                 py::overload_cast<const Vec3&, const Vec3&, float>(
+                     &Class::Raycast, py::const_),
+                 py::arg("origin"), py::arg("direction"),
+                 py::arg("max_distance") = std::numeric_limits<float>::max())
+            .def_property_readonly("num_objects", &Class::num_objects)
+            // Bound with std::string (not const char*), so None raises
+            .def("__getitem__",
+                 [](Class& self, const std::string& name) {
+                     return self[name];
+                 })
+            .def("__getitem__",
+                 [](Class& self, NameId name_id) {
+                     return self.GetChild(name_id);
+                 })
             .def("__getitem__",
-                 [](Class& self, const char* name) { return self[name]; })
+                 [](Class& self, ObjectHandle handle) {
+                     return self.GetChild(handle);
+                 })
             .def("__repr__", &Class::ToString);
     }
 }
@@ -1,7 +1,6 @@
 #include <array>
 #include <memory>
 #include <string>
-#include <utility>
 
 #include <glad/gl.h>
 
@@ -12,19 +11,15 @@
 namespace renderer {
 namespace opengl {
 
+// The version and the per-frame block get prepended by WithFrameUniforms
 constexpr const char* DD_VERT_SHADER_WIREFRAME_MODE_SRC = R"(
-#version 330 core
-
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 color;
 
-uniform mat4 u_proj_matrix;
-uniform mat4 u_view_matrix;
-
 out vec3 f_color;
 
 void main() {
-    gl_Position = u_proj_matrix * u_view_matrix * vec4(position, 1.0);
+    gl_Position = u_view_proj_matrix * vec4(position, 1.0);
     f_color = color;
 }
 )";
@@ -41,19 +36,20 @@ void main() {
 )";
 
 OpenGLDebugDrawer::OpenGLDebugDrawer() {
+    const auto LINES_VERT_SRC =
+        WithFrameUniforms(DD_VERT_SHADER_WIREFRAME_MODE_SRC);
     m_LinesProgram = std::make_unique<OpenGLProgram>(
-        DD_VERT_SHADER_WIREFRAME_MODE_SRC, DD_FRAG_SHADER_WIREFRAME_MODE_SRC);
+        LINES_VERT_SRC.c_str(), DD_FRAG_SHADER_WIREFRAME_MODE_SRC);
     m_LinesProgram->Build();
+    m_LinesProgram->BindUniformBlock(FRAME_UNIFORMS_BLOCK,
+                                     FRAME_UNIFORMS_BINDING);
 
-    OpenGLBufferLayout buff_layout = {
-        {"position", eElementType::FLOAT_3, false},
-        {"color", eElementType::FLOAT_3, false}};
-
-    auto lines_vbo = std::make_unique<OpenGLVertexBuffer>(
-        buff_layout, eBufferUsage::DYNAMIC, LINES_VBO_SIZE, nullptr);
+    m_LinesLayout = {{"position", eElementType::FLOAT_3, false},
+                     {"color", eElementType::FLOAT_3, false}};
+    m_LinesStream = std::make_unique<OpenGLStreamingBuffer>(LINES_VBO_SIZE);
 
     m_LinesVAO = std::make_unique<OpenGLVertexArray>();
-    m_LinesVAO->AddVertexBuffer(std::move(lines_vbo));
+    m_LinesVAO->AddStreamedAttributes(m_LinesLayout);
 }
 
 auto OpenGLDebugDrawer::DrawLine(Vec3 start, Vec3 end, Vec3 color) -> void {
@@ -220,78 +216,60 @@ auto OpenGLDebugDrawer::DrawCylinder(float radius, float height, Pose pose,
 }
 
 auto OpenGLDebugDrawer::Render(const Camera& camera) -> void {
+    if (m_FrameUniforms == nullptr) {
+        m_FrameUniforms = std::make_unique<OpenGLFrameUniforms>();
+    }
+    m_FrameUniforms->Update(camera, {});
+    Render();
+}
+
+auto OpenGLDebugDrawer::Render() -> void {
     // Render all lines first --------------------------------------------------
     if (!m_LinesContainer.empty()) {
-        m_LinesProgram->Bind();
-        m_LinesProgram->SetMat4("u_proj_matrix",
-                                camera.ComputeProjectionMatrix());
-        m_LinesProgram->SetMat4("u_view_matrix", camera.ComputeViewMatrix());
-
-        const auto NUM_FULL_BATCHES =
-            m_LinesContainer.size() / LINES_BATCH_SIZE;
-        const auto NUM_REMAINING_LINES =
-            m_LinesContainer.size() % LINES_BATCH_SIZE;
-
-        std::array<float, LINES_BATCH_SIZE * FLOATS_PER_LINE> lines_batch{};
-        for (uint32_t batch_idx = 0; batch_idx < NUM_FULL_BATCHES;
-             ++batch_idx) {
-            for (uint32_t line_idx = 0; line_idx < LINES_BATCH_SIZE;
-                 ++line_idx) {
-                const auto& line =
-                    m_LinesContainer[batch_idx * LINES_BATCH_SIZE + line_idx];
-                const auto VERTEX_START_IDX = FLOATS_PER_LINE * line_idx;
-
-                // First vertex has position and color attributes
-                lines_batch.at(VERTEX_START_IDX + 0) = line.start.x();
-                lines_batch.at(VERTEX_START_IDX + 1) = line.start.y();
-                lines_batch.at(VERTEX_START_IDX + 2) = line.start.z();
-
-                lines_batch.at(VERTEX_START_IDX + 3) = line.color.x();
-                lines_batch.at(VERTEX_START_IDX + 4) = line.color.y();
-                lines_batch.at(VERTEX_START_IDX + 5) = line.color.z();
-
-                // Second vertex has also position and color attributes
-                lines_batch.at(VERTEX_START_IDX + 6) = line.end.x();
-                lines_batch.at(VERTEX_START_IDX + 7) = line.end.y();
-                lines_batch.at(VERTEX_START_IDX + 8) = line.end.z();
-
-                lines_batch.at(VERTEX_START_IDX + 9) = line.color.x();
-                lines_batch.at(VERTEX_START_IDX + 10) = line.color.y();
-                lines_batch.at(VERTEX_START_IDX + 11) = line.color.z();
-            }
-            _RenderBatchOfLines(LINES_BATCH_SIZE, lines_batch.data());
+        // Write the vertices of all lines straight into the stream
+        const auto NUM_BYTES = static_cast<uint32_t>(
+            m_LinesContainer.size() * FLOATS_PER_LINE * sizeof(float32_t));
+        m_LinesStream->BeginSegment(NUM_BYTES);
+        auto allocation = m_LinesStream->Allocate(NUM_BYTES);
+        auto* lines_data = static_cast<float32_t*>(allocation.data);
+        for (size_t i = 0; lines_data != nullptr && i < m_LinesContainer.size();
+             ++i) {
+            const auto& line = m_LinesContainer[i];
+            auto* vertex = lines_data + FLOATS_PER_LINE * i;
+
+            // First vertex has position and color attributes
+            vertex[0] = line.start.x();
+            vertex[1] = line.start.y();
+            vertex[2] = line.start.z();
+
+            vertex[3] = line.color.x();
+            vertex[4] = line.color.y();
+            vertex[5] = line.color.z();
+
+            // Second vertex has also position and color attributes
+            vertex[6] = line.end.x();
+            vertex[7] = line.end.y();
+            vertex[8] = line.end.z();
+
+            vertex[9] = line.color.x();
+            vertex[10] = line.color.y();
+            vertex[11] = line.color.z();
         }
-
-        if (NUM_REMAINING_LINES > 0) {
-            for (uint32_t line_idx = 0; line_idx < NUM_REMAINING_LINES;
-                 ++line_idx) {
-                const auto& line =
-                    m_LinesContainer[NUM_FULL_BATCHES * LINES_BATCH_SIZE +
-                                     line_idx];
-                const auto VERTEX_START_IDX = FLOATS_PER_LINE * line_idx;
-
-                // First vertex has position and color attributes
-                lines_batch.at(VERTEX_START_IDX + 0) = line.start.x();
-                lines_batch.at(VERTEX_START_IDX + 1) = line.start.y();
-                lines_batch.at(VERTEX_START_IDX + 2) = line.start.z();
-
-                lines_batch.at(VERTEX_START_IDX + 3) = line.color.x();
-                lines_batch.at(VERTEX_START_IDX + 4) = line.color.y();
-                lines_batch.at(VERTEX_START_IDX + 5) = line.color.z();
-
-                // Second vertex has also position and color attributes
-                lines_batch.at(VERTEX_START_IDX + 6) = line.end.x();
-                lines_batch.at(VERTEX_START_IDX + 7) = line.end.y();
-                lines_batch.at(VERTEX_START_IDX + 8) = line.end.z();
-
-                lines_batch.at(VERTEX_START_IDX + 9) = line.color.x();
-                lines_batch.at(VERTEX_START_IDX + 10) = line.color.y();
-                lines_batch.at(VERTEX_START_IDX + 11) = line.color.z();
-            }
-            _RenderBatchOfLines(NUM_REMAINING_LINES, lines_batch.data());
+        m_LinesStream->EndSegment();
+
+        if (lines_data != nullptr) {
+            m_LinesProgram->Bind();
+            m_LinesVAO->Bind();
+            SetVertexAttributes(0, m_LinesLayout, m_LinesStream->opengl_id(),
+                                allocation.offset);
+            glDrawArrays(GL_LINES, 0,
+                         static_cast<GLsizei>(m_LinesContainer.size() * 2));
+            m_NumDrawCalls++;
+            m_NumBytesUploaded += allocation.size;
+            m_LinesVAO->Unbind();
+
+            m_LinesProgram->Unbind();
         }
-
-        m_LinesProgram->Unbind();
         m_LinesContainer.clear();
     }
     // -------------------------------------------------------------------------
@@ -299,22 +277,10 @@ auto OpenGLDebugDrawer::Render(const Camera& camera) -> void {
     // TODO(wilbert): render other debug primitives
 }
 
-auto OpenGLDebugDrawer::_RenderBatchOfLines(
-    size_t lines_number, const float32_t* lines_data) -> void {
-    auto& lines_vbo = m_LinesVAO->GetVertexBuffer(0);
-    const auto VBO_SUBSIZE = (POSITIONS_PER_LINE + COLORS_PER_LINE) *
-                             m_LinesContainer.size() * sizeof(Vec3);
-
-    m_LinesVAO->Bind();
-    lines_vbo.UpdateData(static_cast<uint32_t>(VBO_SUBSIZE), lines_data);
-    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(lines_number * 2));
-    m_NumDrawCalls++;
-    m_LinesVAO->Unbind();
-}
-
 auto OpenGLDebugDrawer::ClearCounters() -> void {
     m_NumDrawCalls = 0;
     m_NumLinesDrawn = 0;
+    m_NumBytesUploaded = 0;
 }
 
 auto OpenGLDebugDrawer::ToString() const -> std::string {
@@ -0,0 +1,121 @@
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/backend/graphics/opengl/frame_uniforms_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+// Light types match the values of eLightType
+constexpr const char* FRAME_UNIFORMS_SRC = R"(
+#define LIGHT_DIRECTIONAL 0
+#define LIGHT_POINT 1
+#define LIGHT_SPOT 2
+
+struct Light {
+    vec3 position;
+    int type;
+    vec3 direction;
+    float intensity;
+    vec3 color;
+    float attn_constant;
+    float attn_linear;
+    float attn_quadratic;
+    float cos_inner_cutoff;
+    float cos_outer_cutoff;
+};
+
+layout (std140) uniform FrameUniforms {
+    mat4 u_view_matrix;
+    mat4 u_proj_matrix;
+    mat4 u_view_proj_matrix;
+    vec3 u_camera_position;
+    int u_num_lights;
+    Light u_lights[MAX_FRAME_LIGHTS];
+};
+)";
+
+namespace {
+// Packs a light following the declaration of the Light struct in the shaders
+auto WriteLight(const Light& light, Std140Writer& writer) -> void {
+    writer.BeginStruct();
+    writer.Write(light.position);
+    writer.Write(static_cast<int32_t>(light.type));
+    writer.Write(light.direction);
+    writer.Write(light.intensity);
+    writer.Write(light.color);
+    writer.Write(light.attnConstant);
+    writer.Write(light.attnLinear);
+    writer.Write(light.attnQuadratic);
+    writer.Write(std::cos(light.innerCutoffAngle));
+    writer.Write(std::cos(light.outerCutoffAngle));
+    writer.EndStruct();
+}
+}  // namespace
+
+auto WithFrameUniforms(const char* shader_src) -> std::string {
+    return std::string("#version 330 core\n") + "#define MAX_FRAME_LIGHTS " +
+           std::to_string(MAX_FRAME_LIGHTS) + "\n" + FRAME_UNIFORMS_SRC +
+           shader_src;
+}
+
+OpenGLFrameUniforms::OpenGLFrameUniforms() {
+    // Header (3 matrices, camera position and light count) plus the lights
+    constexpr uint32_t BLOCK_SIZE = 3 * 64 + 16 + MAX_FRAME_LIGHTS * 64;
+    m_Buffer = std::make_unique<OpenGLUniformBuffer>(FRAME_UNIFORMS_BINDING,
+                                                     BLOCK_SIZE);
+}
+
+auto OpenGLFrameUniforms::Update(const Camera& camera,
+                                 const std::vector<Light::ptr>& lights)
+    -> void {
+    const auto VIEW_MATRIX = camera.ComputeViewMatrix();
+    const auto PROJ_MATRIX = camera.ComputeProjectionMatrix();
+
+    m_NumLights = 0;
+    for (const auto& light : lights) {
+        if (light != nullptr && m_NumLights < MAX_FRAME_LIGHTS) {
+            ++m_NumLights;
+        }
+    }
+
+    m_Writer.Clear();
+    m_Writer.Write(VIEW_MATRIX);
+    m_Writer.Write(PROJ_MATRIX);
+    m_Writer.Write(PROJ_MATRIX * VIEW_MATRIX);
+    m_Writer.Write(camera.pose().position);
+    m_Writer.Write(static_cast<int32_t>(m_NumLights));
+    uint32_t num_written = 0;
+    for (const auto& light : lights) {
+        if (light != nullptr && num_written < m_NumLights) {
+            WriteLight(*light, m_Writer);
+            ++num_written;
+        }
+    }
+    // The whole array is always uploaded, as the block is bound in full
+    const Light UNUSED_LIGHT;
+    for (; num_written < MAX_FRAME_LIGHTS; ++num_written) {
+        WriteLight(UNUSED_LIGHT, m_Writer);
+    }
+
+    m_Buffer->Update(m_Writer);
+    m_Buffer->Bind();
+}
+
+auto OpenGLFrameUniforms::Bind() const -> void { m_Buffer->Bind(); }
+
+auto OpenGLFrameUniforms::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLFrameUniforms\n"
+        "  binding: {0}\n"
+        "  size: {1}\n"
+        "  numLights: {2}\n"
+        ">\n",
+        m_Buffer->binding(), m_Buffer->size(), m_NumLights);
+}
+
+}  // namespace opengl
+}  // namespace renderer
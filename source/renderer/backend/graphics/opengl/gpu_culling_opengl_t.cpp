@@ -0,0 +1,561 @@
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/backend/graphics/opengl/gpu_culling_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+static_assert(sizeof(OpenGLCullObject) == 112,
+              "OpenGLCullObject must match the std430 layout of the shader");
+
+constexpr const char* CULL_COMP_SHADER_SRC = R"(
+#version 430 core
+
+layout (local_size_x = 64) in;
+
+struct CullObject {
+    mat4 model;
+    vec3 color;
+    uint flags;
+    vec3 center;
+    uint command;
+    vec3 extent;
+    uint layers;
+};
+
+const uint FLAG_VISIBLE = 1u;
+const uint LODS_SHIFT = 8u;
+const uint LODS_MASK = 255u;
+
+struct DrawCommand {
+    uint count;
+    uint instance_count;
+    uint first_index;
+    int base_vertex;
+    uint base_instance;
+};
+
+layout (std430, binding = 0) readonly buffer Objects {
+    CullObject objects[];
+};
+
+layout (std430, binding = 1) buffer Commands {
+    DrawCommand commands[];
+};
+
+// Packed as the per-instance attributes of the mesh programs
+layout (std430, binding = 2) writeonly buffer Instances {
+    float instances[];
+};
+
+// Geometric error of the level of detail drawn by each command
+layout (std430, binding = 3) readonly buffer LodErrors {
+    float lod_errors[];
+};
+
+// Level of detail each object was drawn with last
+layout (std430, binding = 4) buffer Levels {
+    uint levels[];
+};
+
+const uint FLOATS_PER_INSTANCE = 19u;
+
+uniform int u_num_objects;
+uniform mat4 u_view_proj;
+uniform int u_reverse_z;
+uniform uint u_culling_mask;
+
+uniform int u_lod_enabled;
+uniform vec3 u_lod_eye;
+uniform float u_lod_pixels_per_unit;
+uniform int u_lod_perspective;
+uniform float u_lod_max_error;
+uniform float u_lod_coarsen_error;
+
+uniform int u_use_hiz;
+uniform mat4 u_hiz_view_proj;
+uniform vec2 u_hiz_size;
+uniform int u_hiz_levels;
+uniform int u_hiz_reverse_z;
+uniform int u_hiz_zero_to_one;
+uniform sampler2D u_hiz;
+
+vec4 Corner(mat4 view_proj, vec3 center, vec3 extent, int i) {
+    vec3 signs = vec3(((i & 1) != 0) ? 1.0 : -1.0,
+                      ((i & 2) != 0) ? 1.0 : -1.0,
+                      ((i & 4) != 0) ? 1.0 : -1.0);
+    return view_proj * vec4(center + signs * extent, 1.0);
+}
+
+// Boxes are culled only if all their corners are outside of the same plane.
+// The planes are linear in clip space, so corners behind the eye work too
+bool InFrustum(vec3 center, vec3 extent) {
+    int outside = 63;
+    for (int i = 0; i < 8; ++i) {
+        vec4 p = Corner(u_view_proj, center, extent, i);
+        float z_min = (u_reverse_z != 0) ? 0.0 : -p.w;
+        int planes = 0;
+        planes |= (p.x < -p.w) ? 1 : 0;
+        planes |= (p.x > p.w) ? 2 : 0;
+        planes |= (p.y < -p.w) ? 4 : 0;
+        planes |= (p.y > p.w) ? 8 : 0;
+        planes |= (p.z < z_min) ? 16 : 0;
+        planes |= (p.z > p.w) ? 32 : 0;
+        outside &= planes;
+    }
+    return outside == 0;
+}
+
+// Whether the box was hidden behind the depth of the last frame
+bool HiddenInHiZ(vec3 center, vec3 extent) {
+    bool reverse_z = (u_hiz_reverse_z != 0);
+    vec2 ndc_min = vec2(1.0);
+    vec2 ndc_max = vec2(-1.0);
+    float nearest = reverse_z ? 0.0 : 1.0;
+    for (int i = 0; i < 8; ++i) {
+        vec4 p = Corner(u_hiz_view_proj, center, extent, i);
+        if (p.w <= 1e-5) {
+            return false;  // crossing the near plane
+        }
+        vec3 ndc = p.xyz / p.w;
+        ndc_min = min(ndc_min, ndc.xy);
+        ndc_max = max(ndc_max, ndc.xy);
+        float depth = (u_hiz_zero_to_one != 0) ? ndc.z : 0.5 * ndc.z + 0.5;
+        nearest = reverse_z ? max(nearest, depth) : min(nearest, depth);
+    }
+    // Parts out of the last view have no depth to be tested against
+    if (any(lessThan(ndc_min, vec2(-1.0))) ||
+        any(greaterThan(ndc_max, vec2(1.0)))) {
+        return false;
+    }
+
+    // Coarsest level where the pixels of the box span at most 2x2 texels.
+    // Level i of the texture holds the level i + 1 of the pyramid
+    ivec2 size = ivec2(u_hiz_size);
+    ivec2 p_min = min(ivec2((0.5 * ndc_min + 0.5) * u_hiz_size), size - 1);
+    ivec2 p_max = min(ivec2((0.5 * ndc_max + 0.5) * u_hiz_size), size - 1);
+    ivec2 span = p_max - p_min + 1;
+    int level = int(ceil(log2(float(max(span.x, span.y)))));
+    level = clamp(level, 1, u_hiz_levels);
+    ivec2 level_size = textureSize(u_hiz, level - 1);
+    ivec2 t_min = min(p_min >> level, level_size - 1);
+    ivec2 t_max = min(p_max >> level, level_size - 1);
+    float d0 = texelFetch(u_hiz, t_min, level - 1).r;
+    float d1 = texelFetch(u_hiz, ivec2(t_max.x, t_min.y), level - 1).r;
+    float d2 = texelFetch(u_hiz, ivec2(t_min.x, t_max.y), level - 1).r;
+    float d3 = texelFetch(u_hiz, t_max, level - 1).r;
+    if (reverse_z) {
+        return nearest < min(min(d0, d1), min(d2, d3));
+    }
+    return nearest > max(max(d0, d1), max(d2, d3));
+}
+
+// Size on screen of a geometric error, at the point of the box closest to the
+// eye (same as LodView::ScreenError)
+float ScreenError(float error, vec3 center, vec3 extent) {
+    if (u_lod_perspective == 0) {
+        return error * u_lod_pixels_per_unit;
+    }
+    vec3 delta = max(abs(u_lod_eye - center) - extent, vec3(0.0));
+    float dist2 = dot(delta, delta);
+    if (dist2 <= 0.0) {
+        return 3.4e38;
+    }
+    return error * u_lod_pixels_per_unit / sqrt(dist2);
+}
+
+// Level of detail of the object, with hysteresis w.r.t. the level it was
+// drawn with last (same as SelectLod)
+uint SelectLod(int index, uint command, vec3 center, vec3 extent) {
+    uint num_lods = max((objects[index].flags >> LODS_SHIFT) & LODS_MASK, 1u);
+    if (u_lod_enabled == 0 || num_lods == 1u) {
+        return 0u;
+    }
+    uint level = min(levels[index], num_lods - 1u);
+    while (level > 0u &&
+           ScreenError(lod_errors[command + level], center, extent) >
+               u_lod_max_error) {
+        --level;
+    }
+    while (level + 1u < num_lods &&
+           ScreenError(lod_errors[command + level + 1u], center, extent) <=
+               u_lod_coarsen_error) {
+        ++level;
+    }
+    levels[index] = level;
+    return level;
+}
+
+void main() {
+    int index = int(gl_GlobalInvocationID.x);
+    if (index >= u_num_objects) {
+        return;
+    }
+    if ((objects[index].flags & FLAG_VISIBLE) == 0u ||
+        (objects[index].layers & u_culling_mask) == 0u) {
+        return;
+    }
+    vec3 center = objects[index].center;
+    vec3 extent = objects[index].extent;
+    if (!InFrustum(center, extent)) {
+        return;
+    }
+    if (u_use_hiz != 0 && HiddenInHiZ(center, extent)) {
+        return;
+    }
+
+    // Survivors get compacted right after the base instance of their command
+    uint command = objects[index].command;
+    command += SelectLod(index, command, center, extent);
+    uint slot = atomicAdd(commands[command].instance_count, 1u);
+    uint instance = commands[command].base_instance + slot;
+    uint first = instance * FLOATS_PER_INSTANCE;
+    mat4 model = objects[index].model;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            instances[first + uint(4 * col + row)] = model[col][row];
+        }
+    }
+    vec3 color = objects[index].color;
+    instances[first + 16u] = color.r;
+    instances[first + 17u] = color.g;
+    instances[first + 18u] = color.b;
+}
+)";
+
+// Each texel takes the farthest depth of the (up to) 2x2 texels below it. The
+// last texel of a row or column also takes the one left over by odd sizes
+constexpr const char* REDUCE_COMP_SHADER_SRC = R"(
+#version 430 core
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+layout (r32f, binding = 0) writeonly uniform image2D u_target;
+
+uniform sampler2D u_source;
+uniform int u_source_level;
+uniform int u_reverse_z;
+
+void main() {
+    ivec2 dst = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 dst_size = imageSize(u_target);
+    if (any(greaterThanEqual(dst, dst_size))) {
+        return;
+    }
+    ivec2 src_size = textureSize(u_source, u_source_level);
+    ivec2 first = 2 * dst;
+    ivec2 last = 2 * dst + 1;
+    if (dst.x == dst_size.x - 1) {
+        last.x = src_size.x - 1;
+    }
+    if (dst.y == dst_size.y - 1) {
+        last.y = src_size.y - 1;
+    }
+    first = min(first, src_size - 1);
+    last = min(last, src_size - 1);
+
+    bool reverse_z = (u_reverse_z != 0);
+    float farthest = reverse_z ? 1.0 : 0.0;
+    for (int y = first.y; y <= last.y; ++y) {
+        for (int x = first.x; x <= last.x; ++x) {
+            float depth = texelFetch(u_source, ivec2(x, y), u_source_level).r;
+            farthest = reverse_z ? min(farthest, depth) : max(farthest, depth);
+        }
+    }
+    imageStore(u_target, dst, vec4(farthest));
+}
+)";
+
+/// Number of pixels (per axis) built by each work group of the reduction
+constexpr int32_t REDUCE_GROUP_SIZE = 8;
+
+namespace {
+// Grows the storage of the given buffer to fit the given size, dropping its
+// contents (they get rewritten right after)
+auto ReserveBuffer(uint32_t buffer, uint32_t& capacity, uint32_t size)
+    -> void {
+    if (size <= capacity) {
+        return;
+    }
+    capacity = std::max(size, 2 * capacity);
+    OpenGLStateCache::Current().BufferData(buffer, capacity, nullptr,
+                                           GL_DYNAMIC_DRAW);
+}
+
+auto CreateTexture(uint32_t internal_format, int32_t width, int32_t height,
+                   int32_t levels) -> uint32_t {
+    uint32_t texture = 0;
+    glGenTextures(1, &texture);
+    auto& state = OpenGLStateCache::Current();
+    state.BindTexture(GPU_CULLING_TEXTURE_UNIT, GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, levels, internal_format, width, height);
+    // Only read with texelFetch, but the filters still gate completeness
+    state.TextureParameter(GL_TEXTURE_2D, texture, GL_TEXTURE_MIN_FILTER,
+                           GL_NEAREST_MIPMAP_NEAREST);
+    state.TextureParameter(GL_TEXTURE_2D, texture, GL_TEXTURE_MAG_FILTER,
+                           GL_NEAREST);
+    return texture;
+}
+}  // namespace
+
+OpenGLGpuCuller::OpenGLGpuCuller() {
+    m_CullProgram = std::make_unique<OpenGLProgram>(CULL_COMP_SHADER_SRC);
+    m_CullProgram->Build();
+    m_ReduceProgram = std::make_unique<OpenGLProgram>(REDUCE_COMP_SHADER_SRC);
+    m_ReduceProgram->Build();
+
+    auto& state = OpenGLStateCache::Current();
+    m_ObjectBuffer = state.CreateBuffer();
+    m_CommandBuffer = state.CreateBuffer();
+    m_CommandTemplateBuffer = state.CreateBuffer();
+    m_InstanceBuffer = state.CreateBuffer();
+    m_LodErrorBuffer = state.CreateBuffer();
+    m_LevelBuffer = state.CreateBuffer();
+}
+
+OpenGLGpuCuller::~OpenGLGpuCuller() {
+    auto& state = OpenGLStateCache::Current();
+    for (auto buffer :
+         {m_ObjectBuffer, m_CommandBuffer, m_CommandTemplateBuffer,
+          m_InstanceBuffer, m_LodErrorBuffer, m_LevelBuffer}) {
+        state.DeleteBuffer(buffer);
+    }
+    _ReleaseHiZ();
+}
+
+auto OpenGLGpuCuller::SetObjects(
+    const std::vector<OpenGLCullObject>& objects,
+    const std::vector<DrawElementsIndirectCommand>& commands,
+    const std::vector<float32_t>& lod_errors, uint32_t num_instances)
+    -> void {
+    m_NumObjects = static_cast<uint32_t>(objects.size());
+    m_NumCommands = static_cast<uint32_t>(commands.size());
+    if (m_NumObjects == 0 || m_NumCommands == 0) {
+        return;
+    }
+    auto& state = OpenGLStateCache::Current();
+    const auto OBJECT_BYTES =
+        m_NumObjects * static_cast<uint32_t>(sizeof(OpenGLCullObject));
+    ReserveBuffer(m_ObjectBuffer, m_ObjectBufferSize, OBJECT_BYTES);
+    state.BufferSubData(m_ObjectBuffer, 0, OBJECT_BYTES, objects.data());
+    // All the objects start from their full levels of detail
+    const std::vector<uint32_t> levels(m_NumObjects, 0);
+    const auto LEVEL_BYTES =
+        m_NumObjects * static_cast<uint32_t>(sizeof(uint32_t));
+    ReserveBuffer(m_LevelBuffer, m_LevelBufferSize, LEVEL_BYTES);
+    state.BufferSubData(m_LevelBuffer, 0, LEVEL_BYTES, levels.data());
+
+    const auto COMMAND_BYTES =
+        m_NumCommands *
+        static_cast<uint32_t>(sizeof(DrawElementsIndirectCommand));
+    ReserveBuffer(m_CommandBuffer, m_CommandBufferSize, COMMAND_BYTES);
+    ReserveBuffer(m_CommandTemplateBuffer, m_CommandTemplateBufferSize,
+                  COMMAND_BYTES);
+    std::vector<DrawElementsIndirectCommand> zeroed(commands);
+    for (auto& command : zeroed) {
+        command.instance_count = 0;
+    }
+    state.BufferSubData(m_CommandTemplateBuffer, 0, COMMAND_BYTES,
+                        zeroed.data());
+    std::vector<float32_t> errors(lod_errors);
+    errors.resize(m_NumCommands, 0.0F);
+    const auto ERROR_BYTES =
+        m_NumCommands * static_cast<uint32_t>(sizeof(float32_t));
+    ReserveBuffer(m_LodErrorBuffer, m_LodErrorBufferSize, ERROR_BYTES);
+    state.BufferSubData(m_LodErrorBuffer, 0, ERROR_BYTES, errors.data());
+
+    // Room for every object to survive
+    constexpr auto INSTANCE_BYTES =
+        FLOATS_PER_CULLED_INSTANCE * static_cast<uint32_t>(sizeof(float32_t));
+    ReserveBuffer(m_InstanceBuffer, m_InstanceBufferSize,
+                  std::max(num_instances, m_NumObjects) * INSTANCE_BYTES);
+}
+
+auto OpenGLGpuCuller::UpdateObjects(uint32_t first, uint32_t count,
+                                    const OpenGLCullObject* objects) -> void {
+    if (count == 0 || first + count > m_NumObjects) {
+        return;
+    }
+    constexpr auto OBJECT_BYTES =
+        static_cast<uint32_t>(sizeof(OpenGLCullObject));
+    OpenGLStateCache::Current().BufferSubData(
+        m_ObjectBuffer, first * OBJECT_BYTES, count * OBJECT_BYTES, objects);
+}
+
+auto OpenGLGpuCuller::Cull(const Mat4& view_proj, bool reverse_z,
+                           uint32_t culling_mask) -> void {
+    m_ViewProj = view_proj;
+    m_ReverseZ = reverse_z;
+    if (m_NumObjects == 0 || m_NumCommands == 0 ||
+        !m_CullProgram->IsValid()) {
+        return;
+    }
+    auto& state = OpenGLStateCache::Current();
+    // Instance counts start from zero every frame
+    state.CopyBufferSubData(
+        m_CommandTemplateBuffer, m_CommandBuffer, 0, 0,
+        m_NumCommands *
+            static_cast<uint32_t>(sizeof(DrawElementsIndirectCommand)));
+
+    m_CullProgram->Bind();
+    m_CullProgram->SetInt("u_num_objects", static_cast<int32_t>(m_NumObjects));
+    m_CullProgram->SetMat4("u_view_proj", view_proj);
+    m_CullProgram->SetInt("u_reverse_z", reverse_z ? 1 : 0);
+    m_CullProgram->SetUint("u_culling_mask", culling_mask);
+    m_CullProgram->SetInt("u_lod_enabled", m_LodSettings.enabled ? 1 : 0);
+    m_CullProgram->SetVec3("u_lod_eye", m_LodView.eye);
+    m_CullProgram->SetFloat("u_lod_pixels_per_unit",
+                            m_LodView.pixels_per_unit);
+    m_CullProgram->SetInt("u_lod_perspective", m_LodView.perspective ? 1 : 0);
+    m_CullProgram->SetFloat("u_lod_max_error", m_LodSettings.max_screen_error);
+    m_CullProgram->SetFloat(
+        "u_lod_coarsen_error",
+        m_LodSettings.max_screen_error * (1.0F - m_LodSettings.hysteresis));
+    // The depth of the last frame is used only if it's comparable
+    const bool USE_HIZ = m_HiZValid && (m_HiZReverseZ == reverse_z);
+    m_CullProgram->SetInt("u_use_hiz", USE_HIZ ? 1 : 0);
+    if (USE_HIZ) {
+        m_CullProgram->SetMat4("u_hiz_view_proj", m_HiZViewProj);
+        m_CullProgram->SetVec2("u_hiz_size",
+                               Vec2(static_cast<float>(m_HiZWidth),
+                                    static_cast<float>(m_HiZHeight)));
+        m_CullProgram->SetInt("u_hiz_levels", m_HiZLevels);
+        m_CullProgram->SetInt("u_hiz_reverse_z", m_HiZReverseZ ? 1 : 0);
+        m_CullProgram->SetInt("u_hiz_zero_to_one", m_HiZZeroToOne ? 1 : 0);
+        m_CullProgram->SetInt("u_hiz", GPU_CULLING_TEXTURE_UNIT);
+        state.BindTexture(GPU_CULLING_TEXTURE_UNIT, GL_TEXTURE_2D,
+                          m_HiZTexture);
+    }
+    state.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_ObjectBuffer);
+    state.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_CommandBuffer);
+    state.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_InstanceBuffer);
+    state.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_LodErrorBuffer);
+    state.BindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, m_LevelBuffer);
+    glDispatchCompute(
+        (m_NumObjects + GPU_CULLING_GROUP_SIZE - 1) / GPU_CULLING_GROUP_SIZE,
+        1, 1);
+    // The draws that follow read the commands and the instances just written
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT |
+                    GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+auto OpenGLGpuCuller::UpdateHiZ(int32_t width, int32_t height) -> void {
+    if (width != m_HiZWidth || height != m_HiZHeight) {
+        _CreateHiZ(width, height);
+    }
+    if (m_HiZTexture == 0 || !m_ReduceProgram->IsValid()) {
+        m_HiZValid = false;
+        return;
+    }
+
+    // The depth buffer of the window can't be sampled, so it gets copied
+    auto& state = OpenGLStateCache::Current();
+    state.BindTexture(GPU_CULLING_TEXTURE_UNIT, GL_TEXTURE_2D, m_DepthTexture);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+
+    m_ReduceProgram->Bind();
+    m_ReduceProgram->SetInt("u_source", GPU_CULLING_TEXTURE_UNIT);
+    m_ReduceProgram->SetInt("u_reverse_z", m_ReverseZ ? 1 : 0);
+    for (int32_t level = 0; level < m_HiZLevels; ++level) {
+        // The first level is built from the copy of the depth buffer
+        state.BindTexture(GPU_CULLING_TEXTURE_UNIT, GL_TEXTURE_2D,
+                          (level == 0) ? m_DepthTexture : m_HiZTexture);
+        m_ReduceProgram->SetInt("u_source_level", std::max(level - 1, 0));
+        glBindImageTexture(0, m_HiZTexture, level, GL_FALSE, 0, GL_WRITE_ONLY,
+                           GL_R32F);
+        const auto NUM_GROUPS_X =
+            (std::max(width >> (level + 1), 1) + REDUCE_GROUP_SIZE - 1) /
+            REDUCE_GROUP_SIZE;
+        const auto NUM_GROUPS_Y =
+            (std::max(height >> (level + 1), 1) + REDUCE_GROUP_SIZE - 1) /
+            REDUCE_GROUP_SIZE;
+        glDispatchCompute(static_cast<GLuint>(NUM_GROUPS_X),
+                          static_cast<GLuint>(NUM_GROUPS_Y), 1);
+        // Each level is read by the next one, and all of them by the culling
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
+
+    m_HiZViewProj = m_ViewProj;
+    m_HiZReverseZ = m_ReverseZ;
+    m_HiZZeroToOne = m_ReverseZ && state.clip_control();
+    m_HiZValid = true;
+}
+
+auto OpenGLGpuCuller::MultiDraw(size_t first, size_t count) const -> void {
+    OpenGLStateCache::Current().BindBuffer(GL_DRAW_INDIRECT_BUFFER,
+                                           m_CommandBuffer);
+    glMultiDrawElementsIndirect(
+        GL_TRIANGLES, GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(  // NOLINT
+            first * sizeof(DrawElementsIndirectCommand)),
+        static_cast<GLsizei>(count), 0);
+}
+
+auto OpenGLGpuCuller::IsSupported() -> bool {
+    return GLAD_GL_VERSION_4_3 != 0;
+}
+
+auto OpenGLGpuCuller::_CreateHiZ(int32_t width, int32_t height) -> void {
+    _ReleaseHiZ();
+    m_HiZWidth = width;
+    m_HiZHeight = height;
+    if (width < 2 || height < 2) {
+        return;
+    }
+    // Multisampled depth buffers can't be copied into a texture
+    int32_t sample_buffers = 0;
+    glGetIntegerv(GL_SAMPLE_BUFFERS, &sample_buffers);
+    if (sample_buffers != 0) {
+        LOG_CORE_WARN(
+            "OpenGLGpuCuller::_CreateHiZ >>> multisampled framebuffers aren't "
+            "supported, culling against the frustum only");
+        return;
+    }
+
+    const auto BASE_SIZE = std::max(width >> 1, height >> 1);
+    m_HiZLevels = 1;
+    while ((BASE_SIZE >> m_HiZLevels) > 0) {
+        ++m_HiZLevels;
+    }
+    m_DepthTexture = CreateTexture(GL_DEPTH_COMPONENT32F, width, height, 1);
+    m_HiZTexture = CreateTexture(GL_R32F, std::max(width >> 1, 1),
+                                 std::max(height >> 1, 1), m_HiZLevels);
+}
+
+auto OpenGLGpuCuller::_ReleaseHiZ() -> void {
+    auto& state = OpenGLStateCache::Current();
+    state.DeleteTexture(m_DepthTexture);
+    state.DeleteTexture(m_HiZTexture);
+    m_DepthTexture = 0;
+    m_HiZTexture = 0;
+    m_HiZLevels = 0;
+    m_HiZValid = false;
+}
+
+auto OpenGLGpuCuller::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLGpuCuller\n"
+        "  numObjects: {0}\n"
+        "  numCommands: {1}\n"
+        "  hizWidth: {2}\n"
+        "  hizHeight: {3}\n"
+        "  hizLevels: {4}\n"
+        "  hizValid: {5}\n"
+        ">\n",
+        m_NumObjects, m_NumCommands, m_HiZWidth, m_HiZHeight, m_HiZLevels,
+        m_HiZValid);
+}
+
+}  // namespace opengl
+}  // namespace renderer
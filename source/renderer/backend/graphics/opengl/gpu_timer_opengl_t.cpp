@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/backend/graphics/opengl/gpu_timer_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+/// Number of nanoseconds (as reported by the queries) per millisecond
+constexpr double NANOSECONDS_PER_MS = 1e6;
+}  // namespace
+
+OpenGLGpuTimer::OpenGLGpuTimer(uint32_t num_passes)
+    : m_NumPasses(std::max(num_passes, 1U)) {
+    const auto NUM_QUERIES = m_NumPasses * GPU_TIMER_LATENCY;
+    m_Queries.resize(NUM_QUERIES, 0);
+    m_Issued.resize(NUM_QUERIES, 0);
+    m_SetFrames.resize(GPU_TIMER_LATENCY, 0);
+    m_ElapsedMs.resize(m_NumPasses, 0.0F);
+    glGenQueries(static_cast<GLsizei>(NUM_QUERIES), m_Queries.data());
+}
+
+OpenGLGpuTimer::~OpenGLGpuTimer() {
+    if (m_Active) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+    glDeleteQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data());
+}
+
+auto OpenGLGpuTimer::BeginFrame(uint64_t frame_index) -> void {
+    if (m_Active) {
+        End();
+    }
+    m_Set = (m_Set + 1) % GPU_TIMER_LATENCY;
+    _CollectResults();
+    m_SetFrames[m_Set] = frame_index;
+}
+
+auto OpenGLGpuTimer::Begin(uint32_t pass) -> void {
+    if (pass >= m_NumPasses) {
+        LOG_CORE_WARN(
+            "OpenGLGpuTimer::Begin >>> pass {0} out of range [0, {1})", pass,
+            m_NumPasses);
+        return;
+    }
+    if (m_Active) {
+        End();
+    }
+    const auto QUERY = m_Set * m_NumPasses + pass;
+    glBeginQuery(GL_TIME_ELAPSED, m_Queries[QUERY]);
+    m_Issued[QUERY] = 1;
+    m_ActivePass = pass;
+    m_Active = true;
+}
+
+auto OpenGLGpuTimer::End() -> void {
+    if (!m_Active) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    m_Active = false;
+}
+
+auto OpenGLGpuTimer::elapsed_ms(uint32_t pass) const -> float {
+    return (pass < m_NumPasses) ? m_ElapsedMs[pass] : 0.0F;
+}
+
+auto OpenGLGpuTimer::_CollectResults() -> void {
+    const auto FIRST = m_Set * m_NumPasses;
+    bool any_issued = false;
+    bool all_available = true;
+    for (uint32_t pass = 0; pass < m_NumPasses; ++pass) {
+        if (m_Issued[FIRST + pass] == 0) {
+            continue;
+        }
+        any_issued = true;
+        GLint available = 0;
+        glGetQueryObjectiv(m_Queries[FIRST + pass],
+                           GL_QUERY_RESULT_AVAILABLE, &available);
+        all_available = all_available && (available != 0);
+    }
+
+    if (any_issued && all_available) {
+        for (uint32_t pass = 0; pass < m_NumPasses; ++pass) {
+            GLuint64 elapsed_ns = 0;
+            if (m_Issued[FIRST + pass] != 0) {
+                glGetQueryObjectui64v(m_Queries[FIRST + pass],
+                                      GL_QUERY_RESULT, &elapsed_ns);
+            }
+            m_ElapsedMs[pass] = static_cast<float>(
+                static_cast<double>(elapsed_ns) / NANOSECONDS_PER_MS);
+        }
+        m_ResultFrame = m_SetFrames[m_Set];
+    } else if (any_issued) {
+        // Reissuing the queries discards their pending results
+        ++m_NumDropped;
+    }
+    std::fill_n(m_Issued.begin() + FIRST, m_NumPasses, 0);
+}
+
+auto OpenGLGpuTimer::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLGpuTimer\n"
+        "  numPasses: {0}\n"
+        "  latency: {1}\n"
+        "  resultFrame: {2}\n"
+        "  numDropped: {3}\n"
+        ">\n",
+        m_NumPasses, GPU_TIMER_LATENCY, m_ResultFrame, m_NumDropped);
+}
+
+}  // namespace opengl
+}  // namespace renderer
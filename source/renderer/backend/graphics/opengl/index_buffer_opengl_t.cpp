@@ -5,6 +5,7 @@
 #include <spdlog/fmt/bundled/format.h>
 
 #include <renderer/backend/graphics/opengl/index_buffer_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 #include "renderer/backend/graphics/opengl/vertex_buffer_opengl_t.hpp"
 
 namespace renderer {
@@ -14,26 +15,27 @@ OpenGLIndexBuffer::OpenGLIndexBuffer(eBufferUsage usage, uint32_t count,
                                      const uint32_t* data)
     : m_Usage(usage), m_Count(count) {
     const uint32_t SIZE = m_Count * sizeof(uint32_t);
-    glGenBuffers(1, &m_OpenGLId);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OpenGLId);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, SIZE, data, ToOpenGLEnum(m_Usage));
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    // Uploaded without touching the element array binding, which belongs to
+    // whichever vertex array is currently bound
+    auto& state = OpenGLStateCache::Current();
+    m_OpenGLId = state.CreateBuffer();
+    state.BufferData(m_OpenGLId, SIZE, data, ToOpenGLEnum(m_Usage));
 }
 
 OpenGLIndexBuffer::~OpenGLIndexBuffer() {
     if (m_OpenGLId != 0) {
-        glDeleteBuffers(1, &m_OpenGLId);
+        OpenGLStateCache::Current().DeleteBuffer(m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
 
 auto OpenGLIndexBuffer::Bind() const -> void {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OpenGLId);
+    OpenGLStateCache::Current().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OpenGLId);
 }
 
 // NOLINTNEXTLINE
 auto OpenGLIndexBuffer::Unbind() const -> void {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    OpenGLStateCache::Current().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 auto OpenGLIndexBuffer::ToString() const -> std::string {
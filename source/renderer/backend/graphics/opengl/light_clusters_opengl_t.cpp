@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/backend/graphics/opengl/light_clusters_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+// Texture units and formats of the lights, the grid and the lists of lights
+constexpr std::array<uint32_t, 3> TEXTURE_UNITS = {
+    CLUSTER_LIGHTS_TEXTURE_UNIT, CLUSTER_GRID_TEXTURE_UNIT,
+    CLUSTER_INDICES_TEXTURE_UNIT};
+constexpr std::array<uint32_t, 3> TEXTURE_FORMATS = {GL_RGBA32F, GL_RG32UI,
+                                                     GL_R32UI};
+
+// Writes the size of the given data into the given buffer (orphaning its
+// previous storage), leaving room for at least a texel
+template <typename T>
+auto Upload(uint32_t buffer, const std::vector<T>& data) -> size_t {
+    const auto SIZE = data.size() * sizeof(T);
+    OpenGLStateCache::Current().BufferData(
+        buffer, static_cast<uint32_t>(std::max<size_t>(SIZE, 16)),
+        data.empty() ? nullptr : data.data(), GL_STREAM_DRAW);
+    return SIZE;
+}
+}  // namespace
+
+OpenGLLightClusters::OpenGLLightClusters() {
+    auto& state = OpenGLStateCache::Current();
+    for (size_t i = 0; i < m_Buffers.size(); ++i) {
+        m_Buffers.at(i) = state.CreateBuffer();
+        // Buffers get their storage before being attached to a texture
+        state.BufferData(m_Buffers.at(i), 16, nullptr, GL_STREAM_DRAW);
+        glGenTextures(1, &m_Textures.at(i));
+        state.BindTexture(TEXTURE_UNITS.at(i), GL_TEXTURE_BUFFER,
+                          m_Textures.at(i));
+        glTexBuffer(GL_TEXTURE_BUFFER, TEXTURE_FORMATS.at(i),
+                    m_Buffers.at(i));
+    }
+}
+
+OpenGLLightClusters::~OpenGLLightClusters() {
+    auto& state = OpenGLStateCache::Current();
+    for (size_t i = 0; i < m_Buffers.size(); ++i) {
+        state.DeleteTexture(m_Textures.at(i));
+        state.DeleteBuffer(m_Buffers.at(i));
+    }
+}
+
+auto OpenGLLightClusters::Update(const LightClusters& clusters) -> size_t {
+    // Same layout as the texelFetch calls of the lit program
+    const auto& lights = clusters.lights();
+    const auto& ranges = clusters.ranges();
+    m_LightData.resize(lights.size() * TEXELS_PER_CLUSTER_LIGHT * 4);
+    auto* data = m_LightData.data();
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const auto& light = *lights[i];
+        const auto RADIANCE = light.intensity * light.color;
+        const std::array<float32_t, TEXELS_PER_CLUSTER_LIGHT * 4> DATA = {
+            light.position.x(), light.position.y(), light.position.z(),
+            static_cast<float32_t>(light.type),
+            light.direction.x(), light.direction.y(), light.direction.z(),
+            std::cos(light.outerCutoffAngle),
+            RADIANCE.x(), RADIANCE.y(), RADIANCE.z(), ranges[i],
+            light.attnConstant, light.attnLinear, light.attnQuadratic,
+            std::cos(light.innerCutoffAngle)};
+        std::copy(DATA.begin(), DATA.end(), data);
+        data += DATA.size();
+    }
+
+    const auto& offsets = clusters.offsets();
+    const auto& counts = clusters.counts();
+    m_GridData.resize(2 * offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        m_GridData[2 * i] = offsets[i];
+        m_GridData[2 * i + 1] = counts[i];
+    }
+
+    m_NumLights = lights.size();
+    m_NumClusters = offsets.size();
+    return Upload(m_Buffers[0], m_LightData) +
+           Upload(m_Buffers[1], m_GridData) +
+           Upload(m_Buffers[2], clusters.indices());
+}
+
+auto OpenGLLightClusters::Bind() const -> void {
+    auto& state = OpenGLStateCache::Current();
+    for (size_t i = 0; i < m_Textures.size(); ++i) {
+        state.BindTexture(TEXTURE_UNITS.at(i), GL_TEXTURE_BUFFER,
+                          m_Textures.at(i));
+    }
+}
+
+auto OpenGLLightClusters::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLLightClusters\n"
+        "  numLights: {0}\n"
+        "  numClusters: {1}\n"
+        ">\n",
+        m_NumLights, m_NumClusters);
+}
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/backend/graphics/opengl/mesh_pool_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+auto CreatePoolVertexBuffer(uint32_t num_vertices) -> OpenGLVertexBuffer::ptr {
+    OpenGLBufferLayout layout = {{"position", eElementType::FLOAT_3, false},
+                                 {"normal", eElementType::FLOAT_3, true},
+                                 {"texcoord", eElementType::FLOAT_2, false}};
+    return std::make_shared<OpenGLVertexBuffer>(
+        layout, eBufferUsage::DYNAMIC,
+        num_vertices * FLOATS_PER_POOL_VERTEX *
+            static_cast<uint32_t>(sizeof(float32_t)),
+        nullptr);
+}
+
+// Copies between buffers without touching the element array target, which is
+// part of the state of the bound vertex array
+auto CopyBuffer(uint32_t src_id, uint32_t dst_id, uint32_t size) -> void {
+    OpenGLStateCache::Current().CopyBufferSubData(src_id, dst_id, 0, 0, size);
+}
+
+auto UploadBuffer(uint32_t dst_id, uint32_t offset, uint32_t size,
+                  const void* data) -> void {
+    OpenGLStateCache::Current().BufferSubData(dst_id, offset, size, data);
+}
+}  // namespace
+
+OpenGLMeshPool::OpenGLMeshPool(OpenGLBufferLayout instance_layout,
+                               uint32_t vertex_capacity,
+                               uint32_t index_capacity)
+    : m_InstanceLayout(std::move(instance_layout)),
+      m_Vertices(vertex_capacity),
+      m_Indices(index_capacity) {
+    m_VertexBuffer = CreatePoolVertexBuffer(vertex_capacity);
+    m_IndexBuffer = std::make_shared<OpenGLIndexBuffer>(
+        eBufferUsage::DYNAMIC, index_capacity, nullptr);
+    _CreateVertexArray();
+    m_IndirectBufferId = OpenGLStateCache::Current().CreateBuffer();
+}
+
+OpenGLMeshPool::~OpenGLMeshPool() {
+    if (m_IndirectBufferId != 0) {
+        OpenGLStateCache::Current().DeleteBuffer(m_IndirectBufferId);
+        m_IndirectBufferId = 0;
+    }
+}
+
+auto OpenGLMeshPool::Add(const Geometry& geometry) -> OpenGLMeshRange {
+    const auto NUM_VERTICES = static_cast<uint32_t>(geometry.num_vertices());
+    const auto NUM_INDICES =
+        (geometry.indices != nullptr)
+            ? static_cast<uint32_t>(geometry.indices->num_indices())
+            : NUM_VERTICES;
+
+    OpenGLMeshRange range;
+    if (NUM_VERTICES == 0 || NUM_INDICES == 0) {
+        return range;  // nothing to draw
+    }
+    const auto& lod_indices = geometry.lod_indices();
+    const auto NUM_LOD_INDICES = static_cast<uint32_t>(lod_indices.size());
+    const auto NUM_ALL_INDICES = NUM_INDICES + NUM_LOD_INDICES;
+    range.num_vertices = NUM_VERTICES;
+    range.num_indices = NUM_INDICES;
+    range.num_lod_indices = NUM_LOD_INDICES;
+    range.base_vertex = m_Vertices.Allocate(NUM_VERTICES);
+    range.first_index = m_Indices.Allocate(NUM_ALL_INDICES);
+    if (!range.valid()) {
+        Remove(range);
+        _Grow(NUM_VERTICES, NUM_ALL_INDICES);
+        range.base_vertex = m_Vertices.Allocate(NUM_VERTICES);
+        range.first_index = m_Indices.Allocate(NUM_ALL_INDICES);
+    }
+
+    // Interleave the attributes, leaving zeros for the missing ones
+    std::vector<float32_t> vertices(
+        static_cast<size_t>(NUM_VERTICES) * FLOATS_PER_POOL_VERTEX, 0.0F);
+    struct AttributeInfo {
+        const char* name;
+        uint32_t num_floats;
+    };
+    constexpr std::array<AttributeInfo, 3> ATTRIBUTES = {
+        {{"position", 3}, {"normal", 3}, {"texcoord", 2}}};
+    uint32_t attrib_offset = 0;
+    for (const auto& attrib : ATTRIBUTES) {
+        const auto* data = geometry.HasAttribute(attrib.name)
+                               ? geometry.GetAttribute(attrib.name).data()
+                               : nullptr;
+        for (uint32_t v = 0; data != nullptr && v < NUM_VERTICES; ++v) {
+            const auto* src = data + v * attrib.num_floats;
+            std::copy(src, src + attrib.num_floats,
+                      vertices.data() + v * FLOATS_PER_POOL_VERTEX +
+                          attrib_offset);
+        }
+        attrib_offset += attrib.num_floats;
+    }
+    constexpr auto VERTEX_BYTES =
+        FLOATS_PER_POOL_VERTEX * static_cast<uint32_t>(sizeof(float32_t));
+    UploadBuffer(m_VertexBuffer->opengl_id(), range.base_vertex * VERTEX_BYTES,
+                 NUM_VERTICES * VERTEX_BYTES, vertices.data());
+
+    constexpr auto INDEX_BYTES = static_cast<uint32_t>(sizeof(uint32_t));
+    if (geometry.indices != nullptr) {
+        UploadBuffer(m_IndexBuffer->opengl_id(),
+                     range.first_index * INDEX_BYTES, NUM_INDICES * INDEX_BYTES,
+                     geometry.indices->data());
+    } else {
+        std::vector<uint32_t> indices(NUM_INDICES);
+        for (uint32_t i = 0; i < NUM_INDICES; ++i) {
+            indices[i] = i;
+        }
+        UploadBuffer(m_IndexBuffer->opengl_id(),
+                     range.first_index * INDEX_BYTES, NUM_INDICES * INDEX_BYTES,
+                     indices.data());
+    }
+    if (NUM_LOD_INDICES > 0) {
+        UploadBuffer(m_IndexBuffer->opengl_id(),
+                     (range.first_index + NUM_INDICES) * INDEX_BYTES,
+                     NUM_LOD_INDICES * INDEX_BYTES, lod_indices.data());
+    }
+    return range;
+}
+
+auto OpenGLMeshPool::Remove(const OpenGLMeshRange& range) -> void {
+    if (range.base_vertex != INVALID_RANGE) {
+        m_Vertices.Free(range.base_vertex, range.num_vertices);
+    }
+    if (range.first_index != INVALID_RANGE) {
+        m_Indices.Free(range.first_index,
+                       range.num_indices + range.num_lod_indices);
+    }
+}
+
+auto OpenGLMeshPool::SetCommands(
+    const std::vector<DrawElementsIndirectCommand>& commands) -> void {
+    if (commands.empty() || !SupportsMultiDrawIndirect()) {
+        return;
+    }
+    const auto SIZE = static_cast<uint32_t>(
+        commands.size() * sizeof(DrawElementsIndirectCommand));
+    auto& state = OpenGLStateCache::Current();
+    if (SIZE > m_IndirectBufferSize) {
+        m_IndirectBufferSize = std::max(SIZE, 2 * m_IndirectBufferSize);
+        state.BufferData(m_IndirectBufferId, m_IndirectBufferSize, nullptr,
+                         GL_DYNAMIC_DRAW);
+    }
+    state.BufferSubData(m_IndirectBufferId, 0, SIZE, commands.data());
+}
+
+auto OpenGLMeshPool::MultiDraw(size_t first, size_t count) const -> void {
+    OpenGLStateCache::Current().BindBuffer(GL_DRAW_INDIRECT_BUFFER,
+                                           m_IndirectBufferId);
+    glMultiDrawElementsIndirect(
+        GL_TRIANGLES, GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(  // NOLINT
+            first * sizeof(DrawElementsIndirectCommand)),
+        static_cast<GLsizei>(count), 0);
+}
+
+auto OpenGLMeshPool::Bind() const -> void { m_VertexArray->Bind(); }
+
+auto OpenGLMeshPool::Unbind() const -> void { m_VertexArray->Unbind(); }
+
+auto OpenGLMeshPool::SupportsMultiDrawIndirect() -> bool {
+    return GLAD_GL_VERSION_4_3 != 0;
+}
+
+auto OpenGLMeshPool::_Grow(uint32_t min_vertices, uint32_t min_indices)
+    -> void {
+    // Make room for at least one more allocation of the requested size, even
+    // when the free room is fragmented
+    const auto NEW_NUM_VERTICES =
+        std::max(2 * m_Vertices.size(), m_Vertices.size() + min_vertices);
+    const auto NEW_NUM_INDICES =
+        std::max(2 * m_Indices.size(), m_Indices.size() + min_indices);
+
+    constexpr auto VERTEX_BYTES =
+        FLOATS_PER_POOL_VERTEX * static_cast<uint32_t>(sizeof(float32_t));
+    auto vertex_buffer = CreatePoolVertexBuffer(NEW_NUM_VERTICES);
+    CopyBuffer(m_VertexBuffer->opengl_id(), vertex_buffer->opengl_id(),
+               m_Vertices.size() * VERTEX_BYTES);
+
+    auto index_buffer = std::make_shared<OpenGLIndexBuffer>(
+        eBufferUsage::DYNAMIC, NEW_NUM_INDICES, nullptr);
+    CopyBuffer(m_IndexBuffer->opengl_id(), index_buffer->opengl_id(),
+               m_Indices.size() * static_cast<uint32_t>(sizeof(uint32_t)));
+
+    m_VertexBuffer = std::move(vertex_buffer);
+    m_IndexBuffer = std::move(index_buffer);
+    m_Vertices.Grow(NEW_NUM_VERTICES);
+    m_Indices.Grow(NEW_NUM_INDICES);
+    _CreateVertexArray();
+}
+
+auto OpenGLMeshPool::_CreateVertexArray() -> void {
+    m_VertexArray = std::make_unique<OpenGLVertexArray>();
+    m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+    m_VertexArray->AddStreamedAttributes(m_InstanceLayout);
+    m_VertexArray->SetIndexBuffer(m_IndexBuffer);
+}
+
+auto OpenGLMeshPool::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLMeshPool\n"
+        "  numVertices: {0}\n"
+        "  numFreeVertices: {1}\n"
+        "  numIndices: {2}\n"
+        "  numFreeIndices: {3}\n"
+        ">\n",
+        m_Vertices.size(), m_Vertices.num_free(), m_Indices.size(),
+        m_Indices.num_free());
+}
+
+}  // namespace opengl
+}  // namespace renderer
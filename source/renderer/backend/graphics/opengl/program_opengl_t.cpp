@@ -4,6 +4,7 @@
 #include <spdlog/fmt/bundled/format.h>
 
 #include <renderer/backend/graphics/opengl/program_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 
 namespace renderer {
 namespace opengl {
@@ -50,14 +51,25 @@ auto CompileShader(const char* source, eShaderType type) -> uint32_t {
 OpenGLProgram::OpenGLProgram(const char* vert_src, const char* frag_src)
     : m_VertSource(vert_src), m_FragSource(frag_src) {}
 
+OpenGLProgram::OpenGLProgram(const char* comp_src) : m_CompSource(comp_src) {}
+
 OpenGLProgram::~OpenGLProgram() {
     if (m_OpenGLId != 0) {
-        glDeleteProgram(m_OpenGLId);
+        OpenGLStateCache::Current().DeleteProgram(m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
 
 auto OpenGLProgram::Build() -> void {
+    if (!m_CompSource.empty()) {
+        auto comp_opengl_id =
+            CompileShader(m_CompSource.c_str(), eShaderType::COMPUTE);
+        if (comp_opengl_id != 0) {
+            _Link({comp_opengl_id});
+        }
+        return;
+    }
+
     // Compile shaders first
     const char* shader_vert_src = m_VertSource.c_str();
     const char* shader_frag_src = m_FragSource.c_str();
@@ -72,17 +84,20 @@ auto OpenGLProgram::Build() -> void {
         return;
     }
 
+    _Link({vert_opengl_id, frag_opengl_id});
+}
+
+auto OpenGLProgram::_Link(std::initializer_list<uint32_t> shaders) -> void {
     // Link shaders into a single program
     m_OpenGLId = glCreateProgram();
-    glAttachShader(m_OpenGLId, vert_opengl_id);
-    glAttachShader(m_OpenGLId, frag_opengl_id);
+    for (const auto SHADER : shaders) {
+        glAttachShader(m_OpenGLId, SHADER);
+    }
     glLinkProgram(m_OpenGLId);
-    glDetachShader(m_OpenGLId, vert_opengl_id);
-    glDeleteShader(vert_opengl_id);
-    vert_opengl_id = 0;
-    glDetachShader(m_OpenGLId, frag_opengl_id);
-    glDeleteShader(frag_opengl_id);
-    frag_opengl_id = 0;
+    for (const auto SHADER : shaders) {
+        glDetachShader(m_OpenGLId, SHADER);
+        glDeleteShader(SHADER);
+    }
 
     int32_t linking_success = 0;
     glGetProgramiv(m_OpenGLId, GL_LINK_STATUS, &linking_success);
@@ -100,10 +115,14 @@ auto OpenGLProgram::Build() -> void {
     m_IsValid = true;
 }
 
-auto OpenGLProgram::Bind() const -> void { glUseProgram(m_OpenGLId); }
+auto OpenGLProgram::Bind() const -> void {
+    OpenGLStateCache::Current().UseProgram(m_OpenGLId);
+}
 
 // NOLINTNEXTLINE
-auto OpenGLProgram::Unbind() const -> void { glUseProgram(0); }
+auto OpenGLProgram::Unbind() const -> void {
+    OpenGLStateCache::Current().UseProgram(0);
+}
 
 auto OpenGLProgram::_GetUniformLocation(const char* uname) -> int32_t {
     if (m_UniformLocationsCache.find(uname) == m_UniformLocationsCache.end()) {
@@ -120,10 +139,27 @@ auto OpenGLProgram::_GetUniformLocation(const char* uname) -> int32_t {
     return m_UniformLocationsCache[uname];
 }
 
+auto OpenGLProgram::BindUniformBlock(const char* block_name, uint32_t binding)
+    -> bool {
+    if (!m_IsValid) {
+        return false;
+    }
+    const auto BLOCK_INDEX = glGetUniformBlockIndex(m_OpenGLId, block_name);
+    if (BLOCK_INDEX == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(m_OpenGLId, BLOCK_INDEX, binding);
+    return true;
+}
+
 auto OpenGLProgram::SetInt(const char* uname, int32_t uvalue) -> void {
     glUniform1i(_GetUniformLocation(uname), uvalue);
 }
 
+auto OpenGLProgram::SetUint(const char* uname, uint32_t uvalue) -> void {
+    glUniform1ui(_GetUniformLocation(uname), uvalue);
+}
+
 auto OpenGLProgram::SetFloat(const char* uname, float uvalue) -> void {
     glUniform1f(_GetUniformLocation(uname), uvalue);
 }
@@ -1,18 +1,434 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <utility>
+
+#include <glad/gl.h>
 
 #include <utils/logging.hpp>
 
 #include <spdlog/fmt/bundled/format.h>
 
+#include <renderer/engine/mesh_t.hpp>
 #include <renderer/backend/graphics/opengl/renderer_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 
 namespace renderer {
 namespace opengl {
 
+// The version and the per-frame block get prepended by WithFrameUniforms
+constexpr const char* MESH_VERT_SHADER_SRC = R"(
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 texcoord;
+layout (location = 3) in mat4 instance_model;
+layout (location = 7) in vec3 instance_color;
+
+invariant gl_Position;
+
+out vec3 f_position;
+out vec3 f_normal;
+out vec2 f_texcoord;
+out vec3 f_tint;
+
+void main() {
+    vec4 world_position = instance_model * vec4(position, 1.0);
+    gl_Position = u_view_proj_matrix * world_position;
+    f_position = world_position.xyz;
+    // Objects are only rotated and translated, so no inverse-transpose needed
+    f_normal = mat3(instance_model) * normal;
+    f_texcoord = texcoord;
+    f_tint = instance_color;
+}
+)";
+
+// Depth-only version of the mesh vertex shader. The depth it writes has to
+// match the one of the scene pass exactly, hence the invariant positions
+constexpr const char* DEPTH_VERT_SHADER_SRC = R"(
+layout (location = 0) in vec3 position;
+layout (location = 3) in mat4 instance_model;
+
+invariant gl_Position;
+
+void main() {
+    vec4 world_position = instance_model * vec4(position, 1.0);
+    gl_Position = u_view_proj_matrix * world_position;
+}
+)";
+
+// Draws the casters from the point of view of the light, into a shadow map
+constexpr const char* SHADOW_VERT_SHADER_SRC = R"(
+#version 330 core
+
+layout (location = 0) in vec3 position;
+layout (location = 3) in mat4 instance_model;
+
+uniform mat4 u_light_view_proj;
+
+void main() {
+    gl_Position = u_light_view_proj * instance_model * vec4(position, 1.0);
+}
+)";
+
+constexpr const char* DEPTH_FRAG_SHADER_SRC = R"(
+#version 330 core
+
+void main() {}
+)";
+
+constexpr const char* MESH_FRAG_SHADER_UNLIT_SRC = R"(
+#version 330 core
+
+in vec3 f_position;
+in vec3 f_normal;
+in vec2 f_texcoord;
+in vec3 f_tint;
+
+uniform vec3 u_color;
+uniform float u_opacity;
+uniform int u_use_albedo_map;
+uniform sampler2D u_albedo_map;
+
+out vec4 color;
+
+void main() {
+    vec3 albedo = u_color * f_tint;
+    if (u_use_albedo_map != 0) {
+        albedo *= texture(u_albedo_map, f_texcoord).rgb;
+    }
+    color = vec4(albedo, u_opacity);
+}
+)";
+
+constexpr const char* MESH_FRAG_SHADER_LIT_SRC = R"(
+in vec3 f_position;
+in vec3 f_normal;
+in vec2 f_texcoord;
+in vec3 f_tint;
+
+uniform vec3 u_ambient;
+uniform vec3 u_color;
+uniform vec3 u_specular;
+uniform float u_shininess;
+uniform float u_opacity;
+uniform int u_use_albedo_map;
+uniform sampler2D u_albedo_map;
+uniform int u_receive_shadows;
+
+// Index of the light casting shadows (-1 if none)
+uniform int u_shadow_light;
+uniform int u_num_cascades;
+// Distances from the camera at which each cascade ends
+uniform vec4 u_cascade_splits;
+// Offsets along the normal (in world units) of the lookups into each cascade
+uniform vec4 u_shadow_normal_offsets;
+uniform mat4 u_shadow_matrices[4];
+uniform sampler2DArrayShadow u_shadow_map;
+
+// Point and spot lights assigned to the clusters of the view (when enabled)
+uniform int u_clustered;
+uniform int u_num_clustered_lights;
+uniform int u_cluster_tiles_x;
+uniform int u_cluster_tiles_y;
+uniform int u_cluster_slices;
+uniform float u_cluster_near;
+uniform float u_cluster_slice_scale;
+// 4 texels per light: (position, type), (direction, cos_outer_cutoff),
+// (color * intensity, range), (attenuation, cos_inner_cutoff)
+uniform samplerBuffer u_cluster_lights;
+// Offset and count of the list of lights of each cluster
+uniform usamplerBuffer u_cluster_grid;
+uniform usamplerBuffer u_cluster_indices;
+
+out vec4 color;
+
+// Fraction of the light that reaches the fragment (3x3 PCF)
+float ShadowFactor(vec3 normal_dir) {
+    float view_depth = -(u_view_matrix * vec4(f_position, 1.0)).z;
+    if (view_depth > u_cascade_splits[u_num_cascades - 1]) {
+        return 1.0;
+    }
+    int cascade = 0;
+    while (cascade < u_num_cascades - 1 &&
+           view_depth > u_cascade_splits[cascade]) {
+        ++cascade;
+    }
+    // Moving the lookup off the surface keeps it from shadowing itself
+    vec3 position = f_position +
+                    u_shadow_normal_offsets[cascade] * normal_dir;
+    vec4 coords = u_shadow_matrices[cascade] * vec4(position, 1.0);
+    coords.xyz = 0.5 * (coords.xyz / coords.w) + 0.5;
+    if (coords.z > 1.0) {
+        return 1.0;
+    }
+    vec2 texel = 1.0 / vec2(textureSize(u_shadow_map, 0).xy);
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            lit += texture(u_shadow_map,
+                           vec4(coords.xy + vec2(x, y) * texel,
+                                float(cascade), coords.z));
+        }
+    }
+    return lit / 9.0;
+}
+
+float Attenuation(vec3 attn, float dist) {
+    return 1.0 / (attn.x + attn.y * dist + attn.z * dist * dist);
+}
+
+// Falloff from the inner to the outer cone of a spot light
+float SpotCone(vec3 light_dir, vec3 direction, float cos_inner_cutoff,
+               float cos_outer_cutoff) {
+    float cos_theta = dot(light_dir, normalize(-direction));
+    float cone = max(cos_inner_cutoff - cos_outer_cutoff, 1e-4);
+    return clamp((cos_theta - cos_outer_cutoff) / cone, 0.0, 1.0);
+}
+
+// Cluster of the fragment, mapped the same way as LightClusters::ClusterAt
+int ClusterIndex() {
+    vec4 clip = u_view_proj_matrix * vec4(f_position, 1.0);
+    vec2 ndc = clip.xy / clip.w;
+    ivec2 tiles = ivec2(u_cluster_tiles_x, u_cluster_tiles_y);
+    ivec2 tile = clamp(ivec2(floor((0.5 * ndc + 0.5) * vec2(tiles))),
+                       ivec2(0), tiles - 1);
+    float view_depth = -(u_view_matrix * vec4(f_position, 1.0)).z;
+    float slice = floor(log(max(view_depth, u_cluster_near) / u_cluster_near) *
+                        u_cluster_slice_scale);
+    int z = clamp(int(slice), 0, u_cluster_slices - 1);
+    return tile.x + tiles.x * (tile.y + tiles.y * z);
+}
+
+vec3 Shade(vec3 light_dir, vec3 radiance, vec3 albedo, vec3 normal_dir,
+           vec3 view_dir) {
+    vec3 half_dir = normalize(light_dir + view_dir);
+    float diffuse = max(dot(normal_dir, light_dir), 0.0);
+    float specular = pow(max(dot(normal_dir, half_dir), 0.0), u_shininess);
+    return radiance * (diffuse * albedo + specular * u_specular);
+}
+
+void main() {
+    vec3 albedo = u_color * f_tint;
+    if (u_use_albedo_map != 0) {
+        albedo *= texture(u_albedo_map, f_texcoord).rgb;
+    }
+    vec3 normal_dir = normalize(f_normal);
+    vec3 view_dir = normalize(u_camera_position - f_position);
+
+    vec3 shade = 0.2 * u_ambient * albedo;
+    if (u_num_lights == 0 && u_num_clustered_lights == 0) {
+        // Without lights, the camera acts as a headlight
+        shade += Shade(view_dir, vec3(1.0), albedo, normal_dir, view_dir);
+    }
+    for (int i = 0; i < u_num_lights; ++i) {
+        Light light = u_lights[i];
+        vec3 light_dir = normalize(-light.direction);
+        float attenuation = 1.0;
+        if (light.type != LIGHT_DIRECTIONAL) {
+            vec3 to_light = light.position - f_position;
+            float dist = length(to_light);
+            light_dir = to_light / max(dist, 1e-6);
+            attenuation = Attenuation(vec3(light.attn_constant,
+                                           light.attn_linear,
+                                           light.attn_quadratic),
+                                      dist);
+        }
+        if (light.type == LIGHT_SPOT) {
+            attenuation *= SpotCone(light_dir, light.direction,
+                                    light.cos_inner_cutoff,
+                                    light.cos_outer_cutoff);
+        }
+        vec3 radiance = light.intensity * attenuation * light.color;
+        if (i == u_shadow_light && u_receive_shadows != 0) {
+            radiance *= ShadowFactor(normal_dir);
+        }
+        shade += Shade(light_dir, radiance, albedo, normal_dir, view_dir);
+    }
+    if (u_clustered != 0) {
+        uvec2 cluster = texelFetch(u_cluster_grid, ClusterIndex()).xy;
+        for (uint i = 0u; i < cluster.y; ++i) {
+            int light = 4 * int(texelFetch(u_cluster_indices,
+                                           int(cluster.x + i)).r);
+            vec4 position_type = texelFetch(u_cluster_lights, light);
+            vec4 radiance_range = texelFetch(u_cluster_lights, light + 2);
+            vec3 to_light = position_type.xyz - f_position;
+            float dist = length(to_light);
+            if (dist >= radiance_range.w) {
+                continue;
+            }
+            vec4 attn_inner = texelFetch(u_cluster_lights, light + 3);
+            vec3 light_dir = to_light / max(dist, 1e-6);
+            // Fades out to nothing at the range, instead of cutting off
+            float window = clamp(1.0 - pow(dist / radiance_range.w, 4.0),
+                                 0.0, 1.0);
+            float attenuation =
+                Attenuation(attn_inner.xyz, dist) * window * window;
+            if (int(position_type.w) == LIGHT_SPOT) {
+                vec4 direction_outer = texelFetch(u_cluster_lights, light + 1);
+                attenuation *= SpotCone(light_dir, direction_outer.xyz,
+                                        attn_inner.w, direction_outer.w);
+            }
+            shade += Shade(light_dir, attenuation * radiance_range.rgb, albedo,
+                           normal_dir, view_dir);
+        }
+    }
+    color = vec4(shade, u_opacity);
+}
+)";
+
+/// Number of frames between sweeps over the GPU caches for released entries
+constexpr uint64_t GARBAGE_COLLECTION_PERIOD = 64;
+
+/// Offset of the shadow lookups along the normal, in texels of the cascade
+constexpr float SHADOW_NORMAL_OFFSET_TEXELS = 1.5F;
+
+/// Names of the entries of the array of shadow matrices of the lit program
+constexpr std::array<const char*, MAX_SHADOW_CASCADES> SHADOW_MATRIX_NAMES = {
+    "u_shadow_matrices[0]", "u_shadow_matrices[1]", "u_shadow_matrices[2]",
+    "u_shadow_matrices[3]"};
+
+// The splits and offsets of the cascades are packed into a vec4 each
+static_assert(MAX_SHADOW_CASCADES == 4,
+              "The lit shader expects up to 4 shadow cascades");
+
+// The culling shader writes the instances the mesh programs read
+static_assert(FLOATS_PER_INSTANCE == FLOATS_PER_CULLED_INSTANCE,
+              "Culled instances must match the per-instance attributes");
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Records the time spent on a phase since the given start, and restarts it
+auto EndPhase(FrameStats& stats, eFramePhase phase, Clock::time_point& start)
+    -> void {
+    const auto NOW = Clock::now();
+    stats.cpu_time_ms.at(static_cast<size_t>(phase)) =
+        std::chrono::duration<float, std::milli>(NOW - start).count();
+    start = NOW;
+}
+
+auto MeshProgramOf(const Material& material) -> eMeshProgram {
+    return (material.type == eMaterialType::BASIC) ? eMeshProgram::UNLIT
+                                                    : eMeshProgram::LIT;
+}
+
+// Packs the transform (from the draw list), tint and bounds of the given item
+auto MakeCullObject(const DrawItem& item, const std::vector<float>& transforms,
+                    uint32_t command, uint32_t num_lods) -> OpenGLCullObject {
+    OpenGLCullObject object;
+    const auto* transform =
+        transforms.data() + item.slot * DrawList::FLOATS_PER_TRANSFORM;
+    std::copy(transform, transform + object.model.size(),
+              object.model.begin());
+    const auto& tint = static_cast<const Mesh*>(item.object)->color();
+    object.color = {tint.x(), tint.y(), tint.z()};
+    object.flags = item.object->visible() ? GPU_CULLING_FLAG_VISIBLE : 0U;
+    object.flags |= std::min(num_lods, GPU_CULLING_MAX_LODS)
+                    << GPU_CULLING_LODS_SHIFT;
+    object.layers = item.object->layers();
+    const auto& bounds = item.object->world_bounds();
+    const auto CENTER = bounds.center();
+    const auto EXTENTS = bounds.extents();
+    object.center = {CENTER.x(), CENTER.y(), CENTER.z()};
+    object.extent = {EXTENTS.x(), EXTENTS.y(), EXTENTS.z()};
+    object.command = command;
+    return object;
+}
+
+// Levels of detail of a geometry whose own indices (if any) are followed by
+// the ones of its coarser levels
+auto MakeMeshLods(const Geometry& geometry, uint32_t num_indices)
+    -> std::vector<OpenGLMeshLod> {
+    std::vector<OpenGLMeshLod> lods = {{0, num_indices}};
+    for (const auto& lod : geometry.lods()) {
+        lods.push_back({num_indices + static_cast<uint32_t>(lod.first_index),
+                        static_cast<uint32_t>(lod.num_indices)});
+    }
+    return lods;
+}
+
+// Number of vertices drawn for the given level of detail of a mesh
+auto NumElements(const OpenGLMesh& mesh, uint32_t lod) -> uint32_t {
+    const auto& level = mesh.lods[lod];
+    return (level.num_indices > 0) ? level.num_indices : mesh.num_vertices;
+}
+
+// View the levels of detail get selected for, on a viewport of the given
+// height (in pixels)
+auto MakeLodView(const Camera& camera, int32_t height) -> LodView {
+    if (height <= 0) {
+        // Nothing to project onto, so keep the full levels
+        LodView view;
+        view.pixels_per_unit = std::numeric_limits<float>::max();
+        view.perspective = false;
+        return view;
+    }
+    return LodView::FromCamera(camera, static_cast<float>(height));
+}
+}  // namespace
+
 OpenGLRenderer::OpenGLRenderer() {
     m_ResourcesManager = std::make_unique<ResourcesManager>();
     m_DebugDrawer = std::make_unique<OpenGLDebugDrawer>();
+
+    const auto MESH_VERT_SRC = WithFrameUniforms(MESH_VERT_SHADER_SRC);
+    const auto MESH_FRAG_LIT_SRC = WithFrameUniforms(MESH_FRAG_SHADER_LIT_SRC);
+    m_MeshPrograms[static_cast<size_t>(eMeshProgram::UNLIT)] =
+        std::make_unique<OpenGLProgram>(MESH_VERT_SRC.c_str(),
+                                        MESH_FRAG_SHADER_UNLIT_SRC);
+    m_MeshPrograms[static_cast<size_t>(eMeshProgram::LIT)] =
+        std::make_unique<OpenGLProgram>(MESH_VERT_SRC.c_str(),
+                                        MESH_FRAG_LIT_SRC.c_str());
+    for (auto& program : m_MeshPrograms) {
+        program->Build();
+        program->BindUniformBlock(FRAME_UNIFORMS_BLOCK,
+                                  FRAME_UNIFORMS_BINDING);
+    }
+    const auto DEPTH_VERT_SRC = WithFrameUniforms(DEPTH_VERT_SHADER_SRC);
+    m_DepthProgram = std::make_unique<OpenGLProgram>(DEPTH_VERT_SRC.c_str(),
+                                                     DEPTH_FRAG_SHADER_SRC);
+    m_DepthProgram->Build();
+    m_DepthProgram->BindUniformBlock(FRAME_UNIFORMS_BLOCK,
+                                     FRAME_UNIFORMS_BINDING);
+    m_ShadowProgram = std::make_unique<OpenGLProgram>(SHADOW_VERT_SHADER_SRC,
+                                                      DEPTH_FRAG_SHADER_SRC);
+    m_ShadowProgram->Build();
+    // The shadow map and the clusters keep their own units, as samplers of
+    // different types can't share one, and start turned off
+    auto& lit_program = *m_MeshPrograms[static_cast<size_t>(eMeshProgram::LIT)];
+    lit_program.Bind();
+    lit_program.SetInt("u_shadow_map", SHADOW_MAP_TEXTURE_UNIT);
+    lit_program.SetInt("u_shadow_light", -1);
+    lit_program.SetInt("u_cluster_lights", CLUSTER_LIGHTS_TEXTURE_UNIT);
+    lit_program.SetInt("u_cluster_grid", CLUSTER_GRID_TEXTURE_UNIT);
+    lit_program.SetInt("u_cluster_indices", CLUSTER_INDICES_TEXTURE_UNIT);
+    lit_program.SetInt("u_clustered", 0);
+    lit_program.SetInt("u_num_clustered_lights", 0);
+    m_FrameUniforms = std::make_unique<OpenGLFrameUniforms>();
+    m_GpuTimer = std::make_unique<OpenGLGpuTimer>(
+        static_cast<uint32_t>(NUM_FRAME_PASSES));
+
+    // The data of the instances is rewritten every frame into its own segment
+    // of the stream, which the vertex arrays of the meshes get pointed to
+    m_InstanceLayout = {{"model_col0", eElementType::FLOAT_4, false, 1},
+                        {"model_col1", eElementType::FLOAT_4, false, 1},
+                        {"model_col2", eElementType::FLOAT_4, false, 1},
+                        {"model_col3", eElementType::FLOAT_4, false, 1},
+                        {"color", eElementType::FLOAT_3, false, 1}};
+    m_InstanceStream = std::make_unique<OpenGLStreamingBuffer>(
+        INITIAL_INSTANCE_CAPACITY * FLOATS_PER_INSTANCE *
+            static_cast<uint32_t>(sizeof(float32_t)));
+    m_ShadowInstanceStream = std::make_unique<OpenGLStreamingBuffer>(
+        INITIAL_INSTANCE_CAPACITY * FLOATS_PER_INSTANCE *
+            static_cast<uint32_t>(sizeof(float32_t)));
+
+    m_DefaultMaterial = std::make_shared<Material>();
+    m_DefaultMaterial->type = eMaterialType::PHONG;
 }
 
 auto OpenGLRenderer::DrawLine(Vec3 start, Vec3 end, Vec3 color) -> void {
@@ -22,18 +438,1124 @@ auto OpenGLRenderer::DrawLine(Vec3 start, Vec3 end, Vec3 color) -> void {
 }
 
 auto OpenGLRenderer::Render(const Scene& scene, const Camera& camera) -> void {
+    ++m_FrameIndex;
+    m_Stats = FrameStats{};
+    m_Stats.frame_index = m_FrameIndex;
+    auto& state = OpenGLStateCache::Current();
+    state.ResetCounters();
+    m_GpuTimer->BeginFrame(m_FrameIndex);
+    glGetIntegerv(GL_VIEWPORT, m_Viewport.data());
+
+    // With reverse-z, the far plane is at a depth of 0 and the closest
+    // fragments are the ones with the greatest depth
+    m_ReverseZ = camera.data.reverse_z;
+    state.SetClipDepthZeroToOne(m_ReverseZ);
+    state.SetDepthFunc(m_ReverseZ ? GL_GREATER : GL_LESS);
+    if (m_ReverseZ) {
+        // The window clears the depth buffer to 1, the near plane in this case
+        state.SetDepthMask(true);
+        glClearDepth(0.0);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        glClearDepth(1.0);
+    }
+
+    // Uploaded once for all programs, including the ones of the debug drawer.
+    // With clustered lighting, the point and spot lights get shaded from the
+    // clusters, so only the directional ones go into the per-frame block
+    const bool CLUSTERED = m_Enabled && m_LightClusterSettings.enabled;
+    m_FrameLights.clear();
+    if (CLUSTERED) {
+        for (const auto& light : scene.lights()) {
+            if (light != nullptr && light->type == eLightType::DIRECTIONAL) {
+                m_FrameLights.push_back(light);
+            }
+        }
+    }
+    const auto& frame_lights = CLUSTERED ? m_FrameLights : scene.lights();
+    m_FrameUniforms->Update(camera, frame_lights);
+    m_Stats.num_bytes_uploaded += m_FrameUniforms->buffer().size();
+    auto phase_start = Clock::now();
+    if (m_Enabled) {
+        _SyncDrawList(scene);
+        EndPhase(m_Stats, eFramePhase::SYNC, phase_start);
+        const auto* shadow_light = _UpdateShadowCascades(scene, camera);
+        if (shadow_light != nullptr) {
+            m_GpuTimer->Begin(static_cast<uint32_t>(eFramePass::SHADOW));
+            _DrawShadows();
+            m_GpuTimer->End();
+        }
+        _SetShadowUniforms(frame_lights, shadow_light);
+        EndPhase(m_Stats, eFramePhase::SHADOW, phase_start);
+        _UpdateLightClusters(scene, camera);
+        _SetLightClusterUniforms();
+        EndPhase(m_Stats, eFramePhase::LIGHTS, phase_start);
+        const bool GPU_CULLING = (m_GpuCuller != nullptr);
+        if (GPU_CULLING) {
+            _SyncGpuCulling(camera);
+            m_GpuCuller->Cull(
+                camera.ComputeProjectionMatrix() * camera.ComputeViewMatrix(),
+                m_ReverseZ, camera.culling_mask);
+        }
+        // With GPU culling, only the translucent draws are culled here
+        if (!GPU_CULLING || m_NumCpuDraws > 0) {
+            _CullScene(scene, camera);
+        }
+        EndPhase(m_Stats, eFramePhase::CULL, phase_start);
+        _BuildRenderQueue(camera);
+        EndPhase(m_Stats, eFramePhase::QUEUE, phase_start);
+        _BuildDrawBatches();
+        EndPhase(m_Stats, eFramePhase::BATCH, phase_start);
+        if (m_DepthPrepass) {
+            m_GpuTimer->Begin(static_cast<uint32_t>(eFramePass::DEPTH_PREPASS));
+            if (GPU_CULLING) {
+                _DrawGpuCulled(true);
+            }
+            _DrawDepthPrepass();
+        }
+        m_GpuTimer->Begin(static_cast<uint32_t>(eFramePass::SCENE));
+        if (GPU_CULLING) {
+            _DrawGpuCulled(false);
+        }
+        _DrawRenderQueue();
+        m_GpuTimer->End();
+        if (GPU_CULLING) {
+            // The opaque meshes are the occluders of the next frame. The size
+            // of the viewport comes from the context, so that the copy never
+            // reads past the drawable area after a resize
+            m_GpuCuller->UpdateHiZ(m_Viewport[2], m_Viewport[3]);
+        }
+        if (m_FrameIndex % GARBAGE_COLLECTION_PERIOD == 0) {
+            _CollectGarbage();
+        }
+        EndPhase(m_Stats, eFramePhase::SUBMIT, phase_start);
+    }
+
     // Render debug primitives on top of everything else
     if (m_DebugDrawer) {
-        m_DebugDrawer->Render(camera);
+        const auto NUM_DRAW_CALLS = m_DebugDrawer->num_drawcalls();
+        const auto NUM_BYTES = m_DebugDrawer->num_bytes_uploaded();
+        m_GpuTimer->Begin(static_cast<uint32_t>(eFramePass::DEBUG));
+        m_DebugDrawer->Render();
+        m_GpuTimer->End();
+        m_Stats.num_draw_calls +=
+            m_DebugDrawer->num_drawcalls() - NUM_DRAW_CALLS;
+        m_Stats.num_bytes_uploaded +=
+            m_DebugDrawer->num_bytes_uploaded() - NUM_BYTES;
+        EndPhase(m_Stats, eFramePhase::DEBUG, phase_start);
+    }
+
+    m_Stats.num_state_changes = state.num_issued_calls();
+    m_Stats.num_elided_state_changes = state.num_elided_calls();
+    // Timings of the GPU are from a few frames ago, as they're never waited on
+    for (size_t pass = 0; pass < NUM_FRAME_PASSES; ++pass) {
+        m_Stats.gpu_time_ms.at(pass) =
+            m_GpuTimer->elapsed_ms(static_cast<uint32_t>(pass));
+    }
+    m_Stats.gpu_frame_index = m_GpuTimer->result_frame();
+    m_StatsHistory.Push(m_Stats);
+}
+
+auto OpenGLRenderer::SetMeshPoolEnabled(bool enable) -> void {
+    if (enable == (m_MeshPool != nullptr)) {
+        return;
+    }
+    if (!enable) {
+        // The commands of the GPU culler are drawn from the mesh pool
+        m_GpuCuller = nullptr;
+    }
+    // Geometries get uploaded again, the next time they're drawn
+    _ClearMeshes();
+    m_MeshPool = enable ? std::make_unique<OpenGLMeshPool>(
+                              m_InstanceLayout, INITIAL_POOL_VERTICES,
+                              INITIAL_POOL_INDICES)
+                        : nullptr;
+}
+
+auto OpenGLRenderer::SetGpuCullingEnabled(bool enable) -> void {
+    if (enable == (m_GpuCuller != nullptr)) {
+        return;
+    }
+    if (enable && !OpenGLGpuCuller::IsSupported()) {
+        LOG_CORE_WARN(
+            "OpenGLRenderer::SetGpuCullingEnabled >>> requires OpenGL 4.3, "
+            "culling stays on the CPU");
+        return;
+    }
+    if (enable) {
+        SetMeshPoolEnabled(true);
+        m_GpuCuller = std::make_unique<OpenGLGpuCuller>();
+        m_GpuCullingDirty = true;
+    } else {
+        m_GpuCuller = nullptr;
+        m_GpuSlotObjects.clear();
+    }
+}
+
+auto OpenGLRenderer::_SyncGpuCulling(const Camera& camera) -> void {
+    const auto& items = m_DrawList.items();
+    const auto& transforms = m_DrawList.transforms();
+    // The levels of detail get selected by the culling shader
+    m_GpuCuller->SetLodView(MakeLodView(camera, m_Viewport[3]),
+                            m_LodSettings);
+    if (!m_GpuCullingDirty &&
+        m_GpuItemsVersion == m_DrawList.items_version()) {
+        // Geometries whose levels of detail changed get copied again (once
+        // per group of commands), which rebuilds the culler
+        for (const auto& draw : m_GpuDraws) {
+            if (draw.lod == 0) {
+                const auto* mesh = static_cast<const Mesh*>(draw.item->object);
+                _GetMesh(mesh->geometry());
+            }
+        }
+    }
+    if (!m_GpuCullingDirty &&
+        m_GpuItemsVersion == m_DrawList.items_version()) {
+        // Same items, so only the objects of the slots written this frame get
+        // patched (as a single range)
+        size_t first = m_GpuObjects.size();
+        size_t last = 0;
+        for (const auto SLOT : m_DrawList.dirty_slots()) {
+            const auto INDEX = (SLOT < m_GpuSlotObjects.size())
+                                   ? m_GpuSlotObjects[SLOT]
+                                   : INVALID_DRAW_SLOT;
+            if (INDEX == INVALID_DRAW_SLOT) {
+                continue;
+            }
+            auto& object = m_GpuObjects[INDEX];
+            object = MakeCullObject(*m_GpuObjectItems[INDEX], transforms,
+                                    object.command,
+                                    object.flags >> GPU_CULLING_LODS_SHIFT);
+            first = std::min<size_t>(first, INDEX);
+            last = std::max<size_t>(last, INDEX + 1);
+        }
+        if (first < last) {
+            m_GpuCuller->UpdateObjects(static_cast<uint32_t>(first),
+                                       static_cast<uint32_t>(last - first),
+                                       m_GpuObjects.data() + first);
+            m_Stats.num_bytes_uploaded +=
+                (last - first) * sizeof(OpenGLCullObject);
+        }
+        return;
+    }
+
+    m_GpuItemsVersion = m_DrawList.items_version();
+    m_GpuDraws.clear();
+    m_GpuCommands.clear();
+    m_GpuObjects.clear();
+    m_GpuObjectItems.clear();
+    m_GpuSlotObjects.assign(m_DrawList.num_slots(), INVALID_DRAW_SLOT);
+    std::vector<float32_t> lod_errors;
+    m_NumCpuDraws = 0;
+
+    // Items are sorted by material and geometry, so the objects of a group of
+    // commands (one per level of detail) are contiguous. Each command gets
+    // room for all the objects of its group, after the ones of the previous
+    size_t group_command = 0;
+    size_t group_object = 0;
+    uint32_t num_instances = 0;
+    auto close_group = [&]() {
+        const auto NUM_OBJECTS =
+            static_cast<uint32_t>(m_GpuObjects.size() - group_object);
+        for (size_t c = group_command; c < m_GpuCommands.size(); ++c) {
+            m_GpuCommands[c].base_instance = num_instances;
+            num_instances += NUM_OBJECTS;
+        }
+    };
+    for (const auto& item : items) {
+        const auto* mesh = static_cast<const Mesh*>(item.object);
+        const auto& material = (mesh->material() != nullptr)
+                                   ? *mesh->material()
+                                   : *m_DefaultMaterial;
+        if (material.transparent) {
+            // Sorted back to front every frame, so left to the CPU
+            ++m_NumCpuDraws;
+            continue;
+        }
+        auto& gpu_mesh = _GetMesh(mesh->geometry());
+        if (!gpu_mesh.range.valid()) {
+            continue;  // empty geometry
+        }
+        auto& gpu_material = _GetMaterial(mesh->material());
+        if (m_GpuDraws.empty() || m_GpuDraws.back().mesh != &gpu_mesh ||
+            m_GpuDraws.back().material != &gpu_material) {
+            close_group();
+            group_command = m_GpuCommands.size();
+            group_object = m_GpuObjects.size();
+            const auto NUM_LODS = static_cast<uint32_t>(gpu_mesh.lods.size());
+            for (uint32_t lod = 0; lod < NUM_LODS; ++lod) {
+                DrawElementsIndirectCommand command;
+                command.count = NumElements(gpu_mesh, lod);
+                command.first_index =
+                    gpu_mesh.range.first_index + gpu_mesh.lods[lod].first_index;
+                command.base_vertex =
+                    static_cast<int32_t>(gpu_mesh.range.base_vertex);
+                m_GpuCommands.push_back(command);
+                m_GpuDraws.push_back({&item, &gpu_mesh, &gpu_material, lod});
+                lod_errors.push_back(mesh->geometry()->lod_error(lod));
+            }
+        }
+        const auto INDEX = static_cast<uint32_t>(m_GpuObjects.size());
+        const auto NUM_LODS =
+            static_cast<uint32_t>(m_GpuCommands.size() - group_command);
+        m_GpuSlotObjects[item.slot] = INDEX;
+        m_GpuObjects.push_back(MakeCullObject(
+            item, transforms, static_cast<uint32_t>(group_command), NUM_LODS));
+        m_GpuObjectItems.push_back(&item);
+    }
+    close_group();
+    // Meshes copied again above already got their new commands
+    m_GpuCullingDirty = false;
+    m_GpuCuller->SetObjects(m_GpuObjects, m_GpuCommands, lod_errors,
+                            num_instances);
+    m_Stats.num_bytes_uploaded +=
+        m_GpuObjects.size() * (sizeof(OpenGLCullObject) + sizeof(uint32_t)) +
+        m_GpuCommands.size() *
+            (sizeof(DrawElementsIndirectCommand) + sizeof(float32_t));
+}
+
+auto OpenGLRenderer::_DrawGpuCulled(bool depth_only) -> void {
+    if (m_GpuDraws.empty()) {
+        return;
+    }
+    auto& state = OpenGLStateCache::Current();
+    m_MeshPool->Bind();
+    // The culled instances are packed as the ones of the stream, from the
+    // base instances of their commands
+    SetVertexAttributes(INSTANCE_ATTRIB_LOCATION, m_InstanceLayout,
+                        m_GpuCuller->instance_buffer(), 0);
+    ++m_Stats.num_vao_changes;
+    state.SetDepthTest(true);
+    if (depth_only) {
+        state.SetDepthMask(true);
+        state.SetColorMask(false);
+        m_DepthProgram->Bind();
+        ++m_Stats.num_program_changes;
+        m_GpuCuller->MultiDraw(0, m_GpuDraws.size());
+        ++m_Stats.num_draw_calls;
+        state.SetColorMask(true);
+        return;
+    }
+
+    const auto DEPTH_FUNC = m_ReverseZ ? GL_GREATER : GL_LESS;
+    if (m_DepthPrepass) {
+        state.SetDepthFunc(m_ReverseZ ? GL_GEQUAL : GL_LEQUAL);
+        state.SetDepthMask(false);
+    } else {
+        state.SetDepthFunc(DEPTH_FUNC);
+        state.SetDepthMask(true);
     }
+    OpenGLProgram* bound_program = nullptr;
+    const OpenGLMaterial* bound_material = nullptr;
+    const OpenGLTexture* bound_texture = nullptr;
+    size_t pending = 0;
+    for (size_t c = 0; c < m_GpuDraws.size(); ++c) {
+        const auto& draw = m_GpuDraws[c];
+        const auto* mesh = static_cast<const Mesh*>(draw.item->object);
+        const auto& material = (mesh->material() != nullptr)
+                                   ? *mesh->material()
+                                   : *m_DefaultMaterial;
+        auto* program =
+            m_MeshPrograms[static_cast<size_t>(MeshProgramOf(material))].get();
+        if (program == bound_program && draw.material == bound_material) {
+            continue;
+        }
+        // Commands are submitted together, until the state changes
+        if (c > pending) {
+            m_GpuCuller->MultiDraw(pending, c - pending);
+            ++m_Stats.num_draw_calls;
+        }
+        pending = c;
+        if (program != bound_program) {
+            program->Bind();
+            program->SetInt("u_albedo_map", 0);
+            bound_program = program;
+            ++m_Stats.num_program_changes;
+        }
+        _SetMaterialUniforms(*program, *draw.material, material,
+                             bound_texture);
+        bound_material = draw.material;
+    }
+    m_GpuCuller->MultiDraw(pending, m_GpuDraws.size() - pending);
+    ++m_Stats.num_draw_calls;
+    state.SetDepthMask(true);
+    state.SetDepthFunc(DEPTH_FUNC);
+}
+
+auto OpenGLRenderer::_SetMaterialUniforms(OpenGLProgram& program,
+                                          const OpenGLMaterial& gpu_material,
+                                          const Material& material,
+                                          const OpenGLTexture*& bound_texture)
+    -> void {
+    program.SetVec3("u_ambient", material.ambient);
+    program.SetVec3("u_color", material.diffuse);
+    program.SetVec3("u_specular", material.specular);
+    program.SetFloat("u_shininess", material.shininess);
+    program.SetFloat("u_opacity", material.opacity);
+    program.SetInt("u_use_albedo_map",
+                   (gpu_material.albedo != nullptr) ? 1 : 0);
+    program.SetInt("u_receive_shadows", material.receiveShadows ? 1 : 0);
+    const auto* texture = gpu_material.albedo.get();
+    if (texture != nullptr && texture != bound_texture) {
+        texture->Bind();
+        bound_texture = texture;
+        ++m_Stats.num_texture_changes;
+    }
+    ++m_Stats.num_material_changes;
+}
+
+auto OpenGLRenderer::_DrawShadows() -> void {
+    const auto& cascades = m_ShadowCache.cascades();
+    const auto NUM_CASCADES = static_cast<uint32_t>(cascades.size());
+    // Same lower bound as the one the cascades were fit with
+    const auto RESOLUTION = std::max(m_ShadowSettings.resolution, 16U);
+    const bool CACHED = m_ShadowSettings.cache_static;
+    if (m_ShadowMaps == nullptr ||
+        !m_ShadowMaps->Matches(RESOLUTION, NUM_CASCADES, CACHED)) {
+        m_ShadowMaps = std::make_unique<OpenGLShadowMaps>(
+            RESOLUTION, NUM_CASCADES, CACHED);
+        m_ShadowCache.InvalidateAll();
+    }
+    if (!m_ShadowMaps->IsValid()) {
+        return;
+    }
+
+    // Collects the casters of each layer drawn this frame: the static ones
+    // of the cached layers that got invalidated, then the dynamic ones (or
+    // all of them, when not caching)
+    m_ShadowDraws.clear();
+    std::array<OpenGLDrawBatch, MAX_SHADOW_CASCADES> static_runs{};
+    std::array<OpenGLDrawBatch, MAX_SHADOW_CASCADES> dynamic_runs{};
+    auto push_caster = [&](const DrawItem& item) {
+        const auto* mesh = static_cast<const Mesh*>(item.object);
+        auto& gpu_mesh = _GetMesh(mesh->geometry());
+        if (m_MeshPool != nullptr && !gpu_mesh.range.valid()) {
+            return;  // empty geometry
+        }
+        m_ShadowDraws.push_back({&item, &gpu_mesh, nullptr, 0});
+    };
+    auto close_run = [&](OpenGLDrawBatch& run) {
+        const auto END = static_cast<uint32_t>(m_ShadowDraws.size());
+        run.count = END - run.first;
+        // Draws of the same mesh get submitted as a single instanced draw
+        std::sort(m_ShadowDraws.begin() + run.first, m_ShadowDraws.end(),
+                  [](const OpenGLQueuedDraw& lhs, const OpenGLQueuedDraw& rhs) {
+                      return lhs.mesh->id < rhs.mesh->id;
+                  });
+    };
+    for (uint32_t c = 0; c < NUM_CASCADES; ++c) {
+        const auto& cascade = cascades[c];
+        static_runs.at(c).first = static_cast<uint32_t>(m_ShadowDraws.size());
+        if (!CACHED || !m_ShadowCache.valid(c)) {
+            for (const auto& item : m_DrawList.items()) {
+                const bool CASTER =
+                    CACHED ? IsStaticCaster(item) : IsShadowCaster(item);
+                if (CASTER && cascade.Overlaps(item.object->world_bounds())) {
+                    push_caster(item);
+                }
+            }
+        }
+        close_run(static_runs.at(c));
+        dynamic_runs.at(c).first = static_cast<uint32_t>(m_ShadowDraws.size());
+        if (CACHED) {
+            for (const auto* item : m_ShadowCache.dynamic_casters()) {
+                if (cascade.Overlaps(item->object->world_bounds())) {
+                    push_caster(*item);
+                }
+            }
+        }
+        close_run(dynamic_runs.at(c));
+    }
+
+    const auto NUM_BYTES = static_cast<uint32_t>(
+        m_ShadowDraws.size() * FLOATS_PER_INSTANCE * sizeof(float32_t));
+    m_ShadowInstanceStream->BeginSegment(NUM_BYTES);
+    auto allocation = m_ShadowInstanceStream->Allocate(NUM_BYTES);
+    m_ShadowInstanceOffset = allocation.offset;
+    auto* instances = static_cast<float32_t*>(allocation.data);
+    if (instances == nullptr) {
+        m_ShadowInstanceStream->EndSegment();
+        return;
+    }
+    const auto& transforms = m_DrawList.transforms();
+    for (size_t i = 0; i < m_ShadowDraws.size(); ++i) {
+        // Only the transforms are read, the colors are left as they are
+        constexpr auto STRIDE = DrawList::FLOATS_PER_TRANSFORM;
+        const auto* transform =
+            transforms.data() + m_ShadowDraws[i].item->slot * STRIDE;
+        std::copy(transform, transform + STRIDE,
+                  instances + i * FLOATS_PER_INSTANCE);
+    }
+    m_ShadowInstanceStream->EndSegment();
+    m_Stats.num_bytes_uploaded += NUM_BYTES;
+    m_Stats.num_shadow_casters = m_ShadowDraws.size();
+
+    // The maps use the default depth range, whatever the camera uses, and the
+    // casters get pushed away from the light by the biases
+    auto& state = OpenGLStateCache::Current();
+    state.SetClipDepthZeroToOne(false);
+    state.SetDepthTest(true);
+    state.SetDepthFunc(GL_LESS);
+    state.SetDepthMask(true);
+    state.SetColorMask(false);
+    state.SetPolygonOffsetFill(true);
+    state.SetPolygonOffset(m_ShadowSettings.slope_bias,
+                           m_ShadowSettings.depth_bias);
+    m_ShadowProgram->Bind();
+    ++m_Stats.num_program_changes;
+    m_ShadowMaps->BeginPass();
+    for (uint32_t c = 0; c < NUM_CASCADES; ++c) {
+        m_ShadowProgram->SetMat4("u_light_view_proj", cascades[c].view_proj());
+        if (CACHED && !m_ShadowCache.valid(c)) {
+            m_ShadowMaps->BeginStaticLayer(c);
+            const auto& run = static_runs.at(c);
+            _DrawShadowCasters(run.first, run.first + run.count);
+            m_ShadowCache.MarkValid(c);
+            ++m_Stats.num_shadow_layers_redrawn;
+        }
+        m_ShadowMaps->BeginLayer(c);
+        if (!CACHED) {
+            const auto& run = static_runs.at(c);
+            _DrawShadowCasters(run.first, run.first + run.count);
+            ++m_Stats.num_shadow_layers_redrawn;
+        }
+        const auto& run = dynamic_runs.at(c);
+        _DrawShadowCasters(run.first, run.first + run.count);
+    }
+    m_ShadowMaps->EndPass();
+    state.SetPolygonOffsetFill(false);
+    state.SetColorMask(true);
+    state.SetClipDepthZeroToOne(m_ReverseZ);
+    state.SetDepthFunc(m_ReverseZ ? GL_GREATER : GL_LESS);
+}
+
+auto OpenGLRenderer::_DrawShadowCasters(size_t first, size_t last) -> void {
+    constexpr auto STRIDE = FLOATS_PER_INSTANCE * sizeof(float32_t);
+    const OpenGLVertexArray* bound_vao = nullptr;
+    size_t begin = first;
+    while (begin < last) {
+        auto* gpu_mesh = m_ShadowDraws[begin].mesh;
+        size_t end = begin + 1;
+        while (end < last && m_ShadowDraws[end].mesh == gpu_mesh) {
+            ++end;
+        }
+        const auto* vao = (m_MeshPool != nullptr) ? &m_MeshPool->vertex_array()
+                                                  : gpu_mesh->vao.get();
+        if (vao != bound_vao) {
+            vao->Bind();
+            bound_vao = vao;
+            ++m_Stats.num_vao_changes;
+        }
+        SetVertexAttributes(
+            INSTANCE_ATTRIB_LOCATION, m_InstanceLayout,
+            m_ShadowInstanceStream->opengl_id(),
+            m_ShadowInstanceOffset + static_cast<uintptr_t>(begin) * STRIDE);
+        // Shadows are drawn with the full levels of detail
+        const auto NUM_INSTANCES = static_cast<GLsizei>(end - begin);
+        const auto& lod = gpu_mesh->lods[0];
+        if (m_MeshPool != nullptr) {
+            glDrawElementsInstancedBaseVertex(
+                GL_TRIANGLES, static_cast<GLsizei>(NumElements(*gpu_mesh, 0)),
+                GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(  // NOLINT
+                    static_cast<uintptr_t>(gpu_mesh->range.first_index +
+                                           lod.first_index) *
+                    sizeof(uint32_t)),
+                NUM_INSTANCES,
+                static_cast<GLint>(gpu_mesh->range.base_vertex));
+        } else if (lod.num_indices > 0) {
+            glDrawElementsInstanced(
+                GL_TRIANGLES, static_cast<GLsizei>(lod.num_indices),
+                GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(  // NOLINT
+                    static_cast<uintptr_t>(lod.first_index) *
+                    sizeof(uint32_t)),
+                NUM_INSTANCES);
+        } else {
+            glDrawArraysInstanced(GL_TRIANGLES, 0,
+                                  static_cast<GLsizei>(gpu_mesh->num_vertices),
+                                  NUM_INSTANCES);
+        }
+        ++m_Stats.num_draw_calls;
+        begin = end;
+    }
+}
+
+auto OpenGLRenderer::_SetShadowUniforms(const std::vector<Light::ptr>& lights,
+                                        const Light* light) -> void {
+    // Index of the light within the lights of the per-frame block
+    int32_t index = -1;
+    if (light != nullptr && m_ShadowMaps != nullptr &&
+        m_ShadowMaps->IsValid()) {
+        int32_t num_lights = 0;
+        for (const auto& candidate : lights) {
+            if (candidate == nullptr) {
+                continue;
+            }
+            if (num_lights >= static_cast<int32_t>(MAX_FRAME_LIGHTS)) {
+                break;
+            }
+            if (candidate.get() == light) {
+                index = num_lights;
+                break;
+            }
+            ++num_lights;
+        }
+    }
+    if (index < 0 && !m_ShadowUniformsSet) {
+        return;  // already turned off
+    }
+
+    auto& program = *m_MeshPrograms[static_cast<size_t>(eMeshProgram::LIT)];
+    program.Bind();
+    ++m_Stats.num_program_changes;
+    program.SetInt("u_shadow_light", index);
+    m_ShadowUniformsSet = (index >= 0);
+    if (index < 0) {
+        return;
+    }
+    const auto& cascades = m_ShadowCache.cascades();
+    std::array<float32_t, MAX_SHADOW_CASCADES> splits{};
+    std::array<float32_t, MAX_SHADOW_CASCADES> offsets{};
+    for (size_t c = 0; c < cascades.size(); ++c) {
+        splits.at(c) = cascades[c].split_far;
+        offsets.at(c) = SHADOW_NORMAL_OFFSET_TEXELS * cascades[c].texel_size;
+        program.SetMat4(SHADOW_MATRIX_NAMES.at(c), cascades[c].view_proj());
+    }
+    program.SetInt("u_num_cascades", static_cast<int32_t>(cascades.size()));
+    program.SetVec4("u_cascade_splits",
+                    Vec4(splits[0], splits[1], splits[2], splits[3]));
+    program.SetVec4("u_shadow_normal_offsets",
+                    Vec4(offsets[0], offsets[1], offsets[2], offsets[3]));
+    m_ShadowMaps->Bind();
+    ++m_Stats.num_texture_changes;
+}
+
+auto OpenGLRenderer::_SetLightClusterUniforms() -> void {
+    if (!m_LightClusterSettings.enabled) {
+        if (!m_LightClusterUniformsSet) {
+            return;  // already turned off
+        }
+        auto& program =
+            *m_MeshPrograms[static_cast<size_t>(eMeshProgram::LIT)];
+        program.Bind();
+        ++m_Stats.num_program_changes;
+        program.SetInt("u_clustered", 0);
+        program.SetInt("u_num_clustered_lights", 0);
+        m_LightClusterUniformsSet = false;
+        return;
+    }
+
+    if (m_GpuLightClusters == nullptr) {
+        m_GpuLightClusters = std::make_unique<OpenGLLightClusters>();
+    }
+    m_Stats.num_bytes_uploaded += m_GpuLightClusters->Update(m_LightClusters);
+
+    auto& program = *m_MeshPrograms[static_cast<size_t>(eMeshProgram::LIT)];
+    program.Bind();
+    ++m_Stats.num_program_changes;
+    program.SetInt("u_clustered", 1);
+    program.SetInt("u_num_clustered_lights",
+                   static_cast<int32_t>(m_LightClusters.lights().size()));
+    program.SetInt("u_cluster_tiles_x",
+                   static_cast<int32_t>(m_LightClusters.tiles_x()));
+    program.SetInt("u_cluster_tiles_y",
+                   static_cast<int32_t>(m_LightClusters.tiles_y()));
+    program.SetInt("u_cluster_slices",
+                   static_cast<int32_t>(m_LightClusters.num_slices()));
+    program.SetFloat("u_cluster_near", m_LightClusters.near());
+    program.SetFloat("u_cluster_slice_scale", m_LightClusters.slice_scale());
+    m_LightClusterUniformsSet = true;
+    m_GpuLightClusters->Bind();
+    m_Stats.num_texture_changes += 3;
+}
+
+auto OpenGLRenderer::_BuildRenderQueue(const Camera& camera) -> void {
+    m_RenderQueue.Clear();
+    m_QueuedDraws.clear();
+
+    const auto& eye = camera.pose().position;
+    const auto& items = m_DrawList.items();
+    const bool GPU_CULLING = (m_GpuCuller != nullptr);
+    if (GPU_CULLING && m_NumCpuDraws == 0) {
+        return;  // everything is drawn from the GPU culler
+    }
+    const auto LOD_VIEW = MakeLodView(camera, m_Viewport[3]);
+    m_RenderQueue.Reserve(items.size());
+    for (const auto& item : items) {
+        if (GPU_CULLING && m_GpuSlotObjects[item.slot] != INVALID_DRAW_SLOT) {
+            continue;
+        }
+        const auto LEAF = item.object->bvh_leaf();
+        if (LEAF >= m_Visibility.size() || m_Visibility[LEAF] == 0) {
+            continue;
+        }
+        const auto* mesh = static_cast<const Mesh*>(item.object);
+        auto& gpu_mesh = _GetMesh(mesh->geometry());
+        if (m_MeshPool != nullptr && !gpu_mesh.range.valid()) {
+            continue;  // empty geometry
+        }
+        auto& gpu_material = _GetMaterial(mesh->material());
+        const auto& material = (mesh->material() != nullptr)
+                                   ? *mesh->material()
+                                   : *m_DefaultMaterial;
+
+        // The camera looks down its -front axis
+        const auto DEPTH = ::math::dot<float>(
+            eye - item.object->world_bounds().center(), camera.v_front);
+
+        RenderKeyFields fields;
+        fields.pass = eRenderPass::MAIN;
+        fields.translucent = material.transparent;
+        fields.program = static_cast<uint32_t>(MeshProgramOf(material));
+        fields.material = gpu_material.id;
+        fields.vao = gpu_mesh.id;
+        fields.depth =
+            ComputeDepthBucket(DEPTH, camera.data.near, camera.data.far);
+
+        m_RenderQueue.Push(MakeRenderKey(fields),
+                           static_cast<uint32_t>(m_QueuedDraws.size()));
+        const auto LOD = std::min<uint32_t>(
+            _SelectLod(item, LOD_VIEW),
+            static_cast<uint32_t>(gpu_mesh.lods.size() - 1));
+        m_QueuedDraws.push_back({&item, &gpu_mesh, &gpu_material, LOD});
+    }
+    m_RenderQueue.Sort();
+}
+
+auto OpenGLRenderer::_BuildDrawBatches() -> void {
+    m_DrawBatches.clear();
+    m_NumOpaqueBatches = 0;
+    m_IndirectCommands.clear();
+    const auto& entries = m_RenderQueue.entries();
+
+    // Instances are written straight into the mapped memory of the stream
+    const auto NUM_BYTES = static_cast<uint32_t>(
+        entries.size() * FLOATS_PER_INSTANCE * sizeof(float32_t));
+    m_InstanceStream->BeginSegment(NUM_BYTES);
+    m_Stats.num_bytes_uploaded += NUM_BYTES;
+    auto allocation = m_InstanceStream->Allocate(NUM_BYTES);
+    m_InstanceOffset = allocation.offset;
+    auto* instances = static_cast<float32_t*>(allocation.data);
+    if (instances == nullptr) {
+        m_InstanceStream->EndSegment();
+        return;
+    }
+
+    const auto& transforms = m_DrawList.transforms();
+    const OpenGLQueuedDraw* previous = nullptr;
+    uint64_t previous_state = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& draw = m_QueuedDraws[entries[i].index];
+        const auto* mesh = static_cast<const Mesh*>(draw.item->object);
+
+        auto* dst = instances + i * FLOATS_PER_INSTANCE;
+        constexpr auto STRIDE = DrawList::FLOATS_PER_TRANSFORM;
+        const auto* transform = transforms.data() + draw.item->slot * STRIDE;
+        std::copy(transform, transform + STRIDE, dst);
+        dst[16] = mesh->color().x();
+        dst[17] = mesh->color().y();
+        dst[18] = mesh->color().z();
+
+        // Draws with the same mesh and material only differ in their depth
+        // bucket, so the rest of their keys match too
+        auto fields = DecodeRenderKey(entries[i].key);
+        fields.depth = 0;
+        const auto STATE = MakeRenderKey(fields);
+        // Levels of detail follow the depth, so these mostly come in runs too
+        if (previous != nullptr && draw.mesh == previous->mesh &&
+            draw.lod == previous->lod && draw.material == previous->material &&
+            STATE == previous_state) {
+            ++m_DrawBatches.back().count;
+        } else {
+            m_DrawBatches.push_back({static_cast<uint32_t>(i), 1});
+            if (!fields.translucent) {
+                m_NumOpaqueBatches = m_DrawBatches.size();
+            }
+        }
+        previous = &draw;
+        previous_state = STATE;
+    }
+    m_InstanceStream->EndSegment();
+
+    if (m_MeshPool != nullptr) {
+        // One indirect command per batch, shared by the depth pre-pass and the
+        // scene pass. Each selects its instances through its base instance
+        for (const auto& batch : m_DrawBatches) {
+            const auto& draw = m_QueuedDraws[entries[batch.first].index];
+            const auto& range = draw.mesh->range;
+            m_IndirectCommands.push_back(
+                {NumElements(*draw.mesh, draw.lod), batch.count,
+                 range.first_index + draw.mesh->lods[draw.lod].first_index,
+                 static_cast<int32_t>(range.base_vertex), batch.first});
+        }
+        m_MeshPool->SetCommands(m_IndirectCommands);
+        if (OpenGLMeshPool::SupportsMultiDrawIndirect()) {
+            m_Stats.num_bytes_uploaded += m_IndirectCommands.size() *
+                                          sizeof(DrawElementsIndirectCommand);
+        }
+    }
+}
+
+auto OpenGLRenderer::_DrawPooledBatches(size_t first, size_t last) -> void {
+    if (first >= last) {
+        return;
+    }
+    if (OpenGLMeshPool::SupportsMultiDrawIndirect()) {
+        m_MeshPool->MultiDraw(first, last - first);
+        ++m_Stats.num_draw_calls;
+        return;
+    }
+    // Without base instances, the instanced attributes are moved per batch
+    for (size_t i = first; i < last; ++i) {
+        const auto& command = m_IndirectCommands[i];
+        _BindInstances(command.base_instance);
+        glDrawElementsInstancedBaseVertex(
+            GL_TRIANGLES, static_cast<GLsizei>(command.count),
+            GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(  // NOLINT
+                static_cast<uintptr_t>(command.first_index) *
+                sizeof(uint32_t)),
+            static_cast<GLsizei>(command.instance_count),
+            command.base_vertex);
+        ++m_Stats.num_draw_calls;
+    }
+}
+
+auto OpenGLRenderer::_BindInstances(uint32_t first_instance) -> void {
+    constexpr auto STRIDE = FLOATS_PER_INSTANCE * sizeof(float32_t);
+    SetVertexAttributes(
+        INSTANCE_ATTRIB_LOCATION, m_InstanceLayout,
+        m_InstanceStream->opengl_id(),
+        m_InstanceOffset + static_cast<uintptr_t>(first_instance) * STRIDE);
+}
+
+auto OpenGLRenderer::_DrawDepthPrepass() -> void {
+    if (m_NumOpaqueBatches == 0) {
+        return;
+    }
+    auto& state = OpenGLStateCache::Current();
+    state.SetDepthTest(true);
+    state.SetDepthMask(true);
+    state.SetColorMask(false);
+    m_DepthProgram->Bind();
+    ++m_Stats.num_program_changes;
+    if (m_MeshPool != nullptr) {
+        // Materials don't matter here, so all opaque batches go together
+        m_MeshPool->Bind();
+        _BindInstances(0);
+        ++m_Stats.num_vao_changes;
+        _DrawPooledBatches(0, m_NumOpaqueBatches);
+    } else {
+        const OpenGLVertexArray* bound_vao = nullptr;
+        for (size_t b = 0; b < m_NumOpaqueBatches; ++b) {
+            _DrawBatch(m_DrawBatches[b], bound_vao);
+        }
+    }
+    state.SetColorMask(true);
+}
+
+auto OpenGLRenderer::_DrawRenderQueue() -> void {
+    OpenGLProgram* bound_program = nullptr;
+    const OpenGLMaterial* bound_material = nullptr;
+    const OpenGLTexture* bound_texture = nullptr;
+    const OpenGLVertexArray* bound_vao = nullptr;
+    bool blending = false;
+
+    auto& state = OpenGLStateCache::Current();
+    const auto DEPTH_FUNC = m_ReverseZ ? GL_GREATER : GL_LESS;
+    state.SetDepthTest(true);
+    if (m_DepthPrepass && m_NumOpaqueBatches > 0) {
+        // The depth of the opaque draws is already there, so only the closest
+        // fragment of each pixel passes, and nothing gets written again
+        state.SetDepthFunc(m_ReverseZ ? GL_GEQUAL : GL_LEQUAL);
+        state.SetDepthMask(false);
+    } else {
+        state.SetDepthFunc(DEPTH_FUNC);
+        state.SetDepthMask(true);
+    }
+    const bool USE_POOL = (m_MeshPool != nullptr);
+    if (USE_POOL) {
+        // A single vertex array for all draws
+        m_MeshPool->Bind();
+        _BindInstances(0);
+        bound_vao = &m_MeshPool->vertex_array();
+        ++m_Stats.num_vao_changes;
+    }
+
+    const auto& entries = m_RenderQueue.entries();
+    size_t pending_batch = 0;
+    for (size_t b = 0; b < m_DrawBatches.size(); ++b) {
+        const auto& batch = m_DrawBatches[b];
+        const auto& entry = entries[batch.first];
+        const auto FIELDS = DecodeRenderKey(entry.key);
+        const auto& draw = m_QueuedDraws[entry.index];
+        auto* gpu_mesh = draw.mesh;
+        auto* gpu_material = draw.material;
+        const auto* mesh = static_cast<const Mesh*>(draw.item->object);
+        const auto& material = (mesh->material() != nullptr)
+                                   ? *mesh->material()
+                                   : *m_DefaultMaterial;
+
+        auto* program = m_MeshPrograms[FIELDS.program].get();
+        if (USE_POOL &&
+            (FIELDS.translucent != blending || program != bound_program ||
+             gpu_material != bound_material)) {
+            // Pooled batches are submitted together, until the state changes
+            _DrawPooledBatches(pending_batch, b);
+            pending_batch = b;
+        }
+
+        if (FIELDS.translucent != blending) {
+            // Translucent draws come last, so this switches only once
+            blending = FIELDS.translucent;
+            state.SetBlend(true);
+            state.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            state.SetDepthMask(false);
+        }
+
+        if (program != bound_program) {
+            program->Bind();
+            program->SetInt("u_albedo_map", 0);
+            bound_program = program;
+            bound_material = nullptr;
+            ++m_Stats.num_program_changes;
+        }
+
+        if (gpu_material != bound_material) {
+            _SetMaterialUniforms(*program, *gpu_material, material,
+                                 bound_texture);
+            bound_material = gpu_material;
+        }
+
+        m_Stats.num_instances += batch.count;
+        const auto NUM_ELEMENTS = NumElements(*gpu_mesh, draw.lod);
+        m_Stats.num_triangles += static_cast<size_t>(NUM_ELEMENTS / 3) *
+                                 batch.count;
+        if (!USE_POOL) {
+            _DrawBatch(batch, bound_vao);
+        }
+    }
+    if (USE_POOL) {
+        _DrawPooledBatches(pending_batch, m_DrawBatches.size());
+    }
+
+    // The program and vertex array stay bound, the next frame (or the debug
+    // drawer) rebinds only what differs. Depth writes are left enabled, as
+    // they also gate the clears of the depth buffer
+    if (blending) {
+        state.SetBlend(false);
+    }
+    state.SetDepthMask(true);
+    state.SetDepthFunc(DEPTH_FUNC);
+}
+
+auto OpenGLRenderer::_DrawBatch(const OpenGLDrawBatch& batch,
+                                const OpenGLVertexArray*& bound_vao) -> void {
+    const auto& entry = m_RenderQueue.entries()[batch.first];
+    const auto& draw = m_QueuedDraws[entry.index];
+    const auto* gpu_mesh = draw.mesh;
+    if (gpu_mesh->vao.get() != bound_vao) {
+        gpu_mesh->vao->Bind();
+        bound_vao = gpu_mesh->vao.get();
+        ++m_Stats.num_vao_changes;
+    }
+
+    // Instances are written in queue order, so the batch starts at the
+    // instance of its first entry
+    _BindInstances(batch.first);
+    const auto NUM_INSTANCES = static_cast<GLsizei>(batch.count);
+    const auto& lod = gpu_mesh->lods[draw.lod];
+    if (lod.num_indices > 0) {
+        glDrawElementsInstanced(
+            GL_TRIANGLES, static_cast<GLsizei>(lod.num_indices),
+            GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(  // NOLINT
+                static_cast<uintptr_t>(lod.first_index) * sizeof(uint32_t)),
+            NUM_INSTANCES);
+    } else {
+        glDrawArraysInstanced(GL_TRIANGLES, 0,
+                              static_cast<GLsizei>(gpu_mesh->num_vertices),
+                              NUM_INSTANCES);
+    }
+    ++m_Stats.num_draw_calls;
+}
+
+auto OpenGLRenderer::_GetMesh(const Geometry::ptr& geometry) -> OpenGLMesh& {
+    auto result = m_Meshes.try_emplace(geometry.get());
+    auto& gpu_mesh = result.first->second;
+    gpu_mesh.last_frame = m_FrameIndex;
+    if (result.second) {
+        gpu_mesh.id = _AllocateId(m_FreeMeshIds, m_NextMeshId);
+    } else if (gpu_mesh.geometry.lock() == geometry &&
+               gpu_mesh.lod_version == geometry->lod_version()) {
+        return gpu_mesh;
+    } else {
+        // The commands of the GPU culler may point into the old copy
+        m_GpuCullingDirty = true;
+    }
+    // Entries of geometries that are gone (whose address got reused by this
+    // one), or whose levels of detail changed, are rebuilt in place, keeping
+    // their id
+    gpu_mesh.geometry = geometry;
+    gpu_mesh.lod_version = geometry->lod_version();
+    if (m_MeshPool != nullptr) {
+        m_MeshPool->Remove(gpu_mesh.range);
+        gpu_mesh.range = m_MeshPool->Add(*geometry);
+        gpu_mesh.num_vertices = gpu_mesh.range.num_vertices;
+        gpu_mesh.num_indices = gpu_mesh.range.num_indices;
+        gpu_mesh.lods = MakeMeshLods(*geometry, gpu_mesh.num_indices);
+        m_Stats.num_bytes_uploaded +=
+            gpu_mesh.num_vertices * FLOATS_PER_POOL_VERTEX * sizeof(float32_t) +
+            (gpu_mesh.num_indices + gpu_mesh.range.num_lod_indices) *
+                sizeof(uint32_t);
+        return gpu_mesh;
+    }
+
+    struct AttributeInfo {
+        const char* name;
+        eElementType type;
+        uint32_t num_floats;
+    };
+    constexpr std::array<AttributeInfo, 3> ATTRIBUTES = {{
+        {"position", eElementType::FLOAT_3, 3},
+        {"normal", eElementType::FLOAT_3, 3},
+        {"texcoord", eElementType::FLOAT_2, 2},
+    }};
+
+    const auto NUM_VERTICES = static_cast<uint32_t>(geometry->num_vertices());
+    auto vao = std::make_unique<OpenGLVertexArray>();
+    for (const auto& attrib : ATTRIBUTES) {
+        // Missing attributes get uninitialized buffers, to keep the locations
+        const float32_t* data = geometry->HasAttribute(attrib.name)
+                                    ? geometry->GetAttribute(attrib.name).data()
+                                    : nullptr;
+        OpenGLBufferLayout layout = {{attrib.name, attrib.type, false}};
+        const auto NUM_BYTES = static_cast<uint32_t>(sizeof(float32_t)) *
+                               attrib.num_floats * NUM_VERTICES;
+        auto vbo = std::make_unique<OpenGLVertexBuffer>(
+            layout, eBufferUsage::STATIC, NUM_BYTES, data);
+        m_Stats.num_bytes_uploaded += (data != nullptr) ? NUM_BYTES : 0;
+        vao->AddVertexBuffer(std::move(vbo));
+    }
+    vao->AddStreamedAttributes(m_InstanceLayout);
+
+    gpu_mesh.num_indices = 0;
+    const auto& lod_indices = geometry->lod_indices();
+    if (!lod_indices.empty()) {
+        // The levels of detail go right after the indices of the geometry (a
+        // trivial list of indices if it has none)
+        std::vector<uint32_t> indices(NUM_VERTICES);
+        if (geometry->indices != nullptr) {
+            indices.assign(
+                geometry->indices->data(),
+                geometry->indices->data() + geometry->indices->num_indices());
+        } else {
+            std::iota(indices.begin(), indices.end(), 0U);
+        }
+        gpu_mesh.num_indices = static_cast<uint32_t>(indices.size());
+        indices.insert(indices.end(), lod_indices.begin(), lod_indices.end());
+        vao->SetIndexBuffer(std::make_unique<OpenGLIndexBuffer>(
+            eBufferUsage::STATIC, static_cast<uint32_t>(indices.size()),
+            indices.data()));
+        m_Stats.num_bytes_uploaded += indices.size() * sizeof(uint32_t);
+    } else if (geometry->indices != nullptr) {
+        gpu_mesh.num_indices =
+            static_cast<uint32_t>(geometry->indices->num_indices());
+        vao->SetIndexBuffer(std::make_unique<OpenGLIndexBuffer>(
+            eBufferUsage::STATIC, gpu_mesh.num_indices,
+            geometry->indices->data()));
+        m_Stats.num_bytes_uploaded += gpu_mesh.num_indices * sizeof(uint32_t);
+    }
+    gpu_mesh.lods = MakeMeshLods(*geometry, gpu_mesh.num_indices);
+    gpu_mesh.num_vertices = NUM_VERTICES;
+    gpu_mesh.vao = std::move(vao);
+    return gpu_mesh;
+}
+
+auto OpenGLRenderer::_GetMaterial(const Material::ptr& material)
+    -> OpenGLMaterial& {
+    const auto& source = (material != nullptr) ? material : m_DefaultMaterial;
+    auto result = m_Materials.try_emplace(source.get());
+    auto& gpu_material = result.first->second;
+    gpu_material.last_frame = m_FrameIndex;
+    if (result.second) {
+        gpu_material.id = _AllocateId(m_FreeMaterialIds, m_NextMaterialId);
+    }
+    if (gpu_material.material.lock() != source) {
+        gpu_material.material = source;
+        gpu_material.albedo_name.clear();
+        gpu_material.albedo = nullptr;
+    }
+    // Textures are looked up again only when the name of the map changes
+    if (gpu_material.albedo_name != source->albedoMap) {
+        gpu_material.albedo_name = source->albedoMap;
+        gpu_material.albedo =
+            source->albedoMap.empty()
+                ? nullptr
+                : m_ResourcesManager->GetTexture(source->albedoMap);
+    }
+    return gpu_material;
+}
+
+auto OpenGLRenderer::_AllocateId(std::vector<uint32_t>& free_ids,
+                                 uint32_t& next_id) -> uint32_t {
+    if (free_ids.empty()) {
+        return next_id++;
+    }
+    const auto ID = free_ids.back();
+    free_ids.pop_back();
+    return ID;
+}
+
+auto OpenGLRenderer::_CollectGarbage() -> void {
+    for (auto it = m_Meshes.begin(); it != m_Meshes.end();) {
+        if (it->second.geometry.expired()) {
+            if (m_MeshPool != nullptr) {
+                m_MeshPool->Remove(it->second.range);
+            }
+            m_FreeMeshIds.push_back(it->second.id);
+            it = m_Meshes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_Materials.begin(); it != m_Materials.end();) {
+        if (it->second.material.expired()) {
+            m_FreeMaterialIds.push_back(it->second.id);
+            it = m_Materials.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+auto OpenGLRenderer::_ClearMeshes() -> void {
+    m_Meshes.clear();
+    m_FreeMeshIds.clear();
+    m_NextMeshId = 0;
+    // The commands of the GPU culler point into the cleared ranges
+    m_GpuCullingDirty = true;
 }
 
 auto OpenGLRenderer::ToString() const -> std::string {
     return fmt::format(
         "<OpenGLRenderer\n"
         "  numDrawcalls: {0}\n"
+        "  numMeshes: {1}\n"
+        "  numMaterials: {2}\n"
+        "  depthPrepass: {3}\n"
+        "  gpuCulling: {4}\n"
+        "  stats: {5}\n"
+        "  gpuTimer: {6}\n"
+        "  shadowCache: {7}\n"
+        "  shadowMaps: {8}\n"
+        "  lightClusters: {9}\n"
         ">\n",
-        m_NumDrawcalls);
+        m_Stats.num_draw_calls, m_Meshes.size(), m_Materials.size(),
+        m_DepthPrepass, m_GpuCuller != nullptr, m_Stats.ToString(),
+        m_GpuTimer->ToString(), m_ShadowCache.ToString(),
+        (m_ShadowMaps != nullptr) ? m_ShadowMaps->ToString() : "none",
+        m_LightClusters.ToString());
 }
 
 }  // namespace opengl
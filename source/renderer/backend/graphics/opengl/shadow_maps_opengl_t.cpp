@@ -0,0 +1,177 @@
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/backend/graphics/opengl/shadow_maps_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+// Creates a depth texture array with a layer per cascade. The layers read by
+// the lit program compare the depth in hardware, with bilinear filtering of
+// the results, while the cached ones are only ever copied
+auto CreateDepthArray(uint32_t resolution, uint32_t num_layers, bool compare)
+    -> uint32_t {
+    uint32_t texture = 0;
+    glGenTextures(1, &texture);
+    auto& state = OpenGLStateCache::Current();
+    state.BindTexture(SHADOW_MAP_TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F,
+                 static_cast<GLsizei>(resolution),
+                 static_cast<GLsizei>(resolution),
+                 static_cast<GLsizei>(num_layers), 0, GL_DEPTH_COMPONENT,
+                 GL_FLOAT, nullptr);
+    const auto FILTER = compare ? GL_LINEAR : GL_NEAREST;
+    state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_MIN_FILTER,
+                           FILTER);
+    state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_MAG_FILTER,
+                           FILTER);
+    // Anything out of the map is lit
+    state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_WRAP_S,
+                           GL_CLAMP_TO_BORDER);
+    state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_WRAP_T,
+                           GL_CLAMP_TO_BORDER);
+    const std::array<float32_t, 4> BORDER = {1.0F, 1.0F, 1.0F, 1.0F};
+    state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture,
+                           GL_TEXTURE_BORDER_COLOR, BORDER.data());
+    if (compare) {
+        state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture,
+                               GL_TEXTURE_COMPARE_MODE,
+                               GL_COMPARE_REF_TO_TEXTURE);
+        state.TextureParameter(GL_TEXTURE_2D_ARRAY, texture,
+                               GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    }
+    return texture;
+}
+}  // namespace
+
+OpenGLShadowMaps::OpenGLShadowMaps(uint32_t resolution, uint32_t num_cascades,
+                                   bool cached)
+    : m_Resolution(resolution), m_NumCascades(num_cascades), m_Cached(cached) {
+    m_DepthTexture = CreateDepthArray(m_Resolution, m_NumCascades, true);
+    if (m_Cached) {
+        m_StaticTexture = CreateDepthArray(m_Resolution, m_NumCascades, false);
+    }
+
+    // Depth-only framebuffers, with a layer attached at a time
+    GLint draw_framebuffer = 0;
+    GLint read_framebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_framebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+    glGenFramebuffers(1, &m_DrawFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_DrawFramebuffer);
+    glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                              m_DepthTexture, 0, 0);
+    glDrawBuffer(GL_NONE);
+    m_Valid = (glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) ==
+               GL_FRAMEBUFFER_COMPLETE);
+    if (m_Cached) {
+        glGenFramebuffers(1, &m_ReadFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_ReadFramebuffer);
+        glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                                  m_StaticTexture, 0, 0);
+        glReadBuffer(GL_NONE);
+        m_Valid = m_Valid && (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) ==
+                              GL_FRAMEBUFFER_COMPLETE);
+    }
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER,
+                      static_cast<GLuint>(draw_framebuffer));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                      static_cast<GLuint>(read_framebuffer));
+    if (!m_Valid) {
+        LOG_CORE_WARN(
+            "OpenGLShadowMaps >>> incomplete framebuffer for {0} maps of "
+            "{1}x{1}, shadows are disabled",
+            m_NumCascades, m_Resolution);
+    }
+}
+
+OpenGLShadowMaps::~OpenGLShadowMaps() {
+    glDeleteFramebuffers(1, &m_DrawFramebuffer);
+    if (m_ReadFramebuffer != 0) {
+        glDeleteFramebuffers(1, &m_ReadFramebuffer);
+    }
+    auto& state = OpenGLStateCache::Current();
+    state.DeleteTexture(m_DepthTexture);
+    state.DeleteTexture(m_StaticTexture);
+}
+
+auto OpenGLShadowMaps::BeginPass() -> void {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_SavedFramebuffers[0]);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_SavedFramebuffers[1]);
+    // Queried from the context, as the viewport of the state cache may not
+    // follow the size of the window
+    glGetIntegerv(GL_VIEWPORT, m_SavedViewport.data());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_DrawFramebuffer);
+    if (m_Cached) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_ReadFramebuffer);
+    }
+}
+
+auto OpenGLShadowMaps::BeginStaticLayer(uint32_t cascade) -> void {
+    if (!m_Cached) {
+        return;
+    }
+    _AttachLayer(m_StaticTexture, cascade);
+    OpenGLStateCache::Current().SetDepthMask(true);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+auto OpenGLShadowMaps::BeginLayer(uint32_t cascade) -> void {
+    _AttachLayer(m_DepthTexture, cascade);
+    if (!m_Cached) {
+        OpenGLStateCache::Current().SetDepthMask(true);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        return;
+    }
+    glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                              m_StaticTexture, 0,
+                              static_cast<GLint>(cascade));
+    const auto SIZE = static_cast<GLint>(m_Resolution);
+    glBlitFramebuffer(0, 0, SIZE, SIZE, 0, 0, SIZE, SIZE,
+                      GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+}
+
+auto OpenGLShadowMaps::EndPass() -> void {
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER,
+                      static_cast<GLuint>(m_SavedFramebuffers[0]));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                      static_cast<GLuint>(m_SavedFramebuffers[1]));
+    OpenGLStateCache::Current().SetViewport(
+        m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2],
+        m_SavedViewport[3]);
+}
+
+auto OpenGLShadowMaps::Bind() const -> void {
+    OpenGLStateCache::Current().BindTexture(
+        SHADOW_MAP_TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, m_DepthTexture);
+}
+
+auto OpenGLShadowMaps::_AttachLayer(uint32_t texture, uint32_t cascade)
+    -> void {
+    glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                              texture, 0, static_cast<GLint>(cascade));
+    const auto SIZE = static_cast<int32_t>(m_Resolution);
+    OpenGLStateCache::Current().SetViewport(0, 0, SIZE, SIZE);
+}
+
+auto OpenGLShadowMaps::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLShadowMaps\n"
+        "  resolution: {0}\n"
+        "  numCascades: {1}\n"
+        "  cached: {2}\n"
+        "  valid: {3}\n"
+        ">\n",
+        m_Resolution, m_NumCascades, m_Cached, m_Valid);
+}
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,456 @@
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+/// Value of the tracked state that isn't known (never matches a real value)
+constexpr uint32_t UNKNOWN_STATE = 0xFFFFFFFF;
+
+/// Value used for targets that aren't tracked by the cache
+constexpr uint32_t UNTRACKED_TARGET = 0xFFFFFFFF;
+
+auto BufferTargetSlot(uint32_t target) -> uint32_t {
+    switch (target) {
+        case GL_ARRAY_BUFFER:
+            return 0;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            return 1;
+        case GL_COPY_READ_BUFFER:
+            return 2;
+        case GL_COPY_WRITE_BUFFER:
+            return 3;
+        case GL_UNIFORM_BUFFER:
+            return 4;
+        case GL_DRAW_INDIRECT_BUFFER:
+            return 5;
+        case GL_PIXEL_UNPACK_BUFFER:
+            return 6;
+        case GL_SHADER_STORAGE_BUFFER:
+            return 7;
+        default:
+            return UNTRACKED_TARGET;
+    }
+}
+
+auto TextureTargetSlot(uint32_t target) -> uint32_t {
+    switch (target) {
+        case GL_TEXTURE_2D:
+            return 0;
+        case GL_TEXTURE_CUBE_MAP:
+            return 1;
+        case GL_TEXTURE_2D_ARRAY:
+            return 2;
+        case GL_TEXTURE_BUFFER:
+            return 3;
+        default:
+            return UNTRACKED_TARGET;
+    }
+}
+
+auto ElementArraySlot() -> uint32_t {
+    return BufferTargetSlot(GL_ELEMENT_ARRAY_BUFFER);
+}
+}  // namespace
+
+OpenGLStateCache::OpenGLStateCache() { Invalidate(); }
+
+auto OpenGLStateCache::Current() -> OpenGLStateCache& {
+    static thread_local OpenGLStateCache s_Cache;
+    return s_Cache;
+}
+
+auto OpenGLStateCache::Invalidate() -> void {
+    m_DirectStateAccess = (GLAD_GL_VERSION_4_5 != 0);
+    m_ClipControl = (GLAD_GL_VERSION_4_5 != 0);
+    m_Program = UNKNOWN_STATE;
+    m_VertexArray = UNKNOWN_STATE;
+    m_Buffers.fill(UNKNOWN_STATE);
+    m_UniformBuffers.fill(UNKNOWN_STATE);
+    m_ActiveUnit = UNKNOWN_STATE;
+    for (auto& unit : m_Textures) {
+        unit.fill(UNKNOWN_STATE);
+    }
+    m_Blend = UNKNOWN_STATE;
+    m_BlendFunc.fill(UNKNOWN_STATE);
+    m_DepthTest = UNKNOWN_STATE;
+    m_DepthMask = UNKNOWN_STATE;
+    m_DepthFunc = UNKNOWN_STATE;
+    m_PolygonOffsetFill = UNKNOWN_STATE;
+    m_PolygonOffsetKnown = false;
+    m_ColorMask = UNKNOWN_STATE;
+    m_ClipDepthZeroToOne = UNKNOWN_STATE;
+    // Drops the last viewport too, so nothing reads a size that's outdated
+    m_Viewport.fill(0);
+    m_ViewportKnown = false;
+}
+
+auto OpenGLStateCache::UseProgram(uint32_t program) -> void {
+    if (_Update(m_Program, program)) {
+        glUseProgram(program);
+    }
+}
+
+auto OpenGLStateCache::BindVertexArray(uint32_t vertex_array) -> void {
+    if (_Update(m_VertexArray, vertex_array)) {
+        glBindVertexArray(vertex_array);
+        // The element array binding is part of the state of the vertex array
+        m_Buffers[ElementArraySlot()] = UNKNOWN_STATE;
+    }
+}
+
+auto OpenGLStateCache::BindBuffer(uint32_t target, uint32_t buffer) -> void {
+    const auto SLOT = BufferTargetSlot(target);
+    if (SLOT == UNTRACKED_TARGET) {
+        ++m_NumIssuedCalls;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (_Update(m_Buffers[SLOT], buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+auto OpenGLStateCache::BindBufferBase(uint32_t target, uint32_t index,
+                                      uint32_t buffer) -> void {
+    const auto SLOT = BufferTargetSlot(target);
+    if (target == GL_UNIFORM_BUFFER && index < MAX_CACHED_UNIFORM_BINDINGS) {
+        if (!_Update(m_UniformBuffers[index], buffer)) {
+            return;
+        }
+    } else {
+        ++m_NumIssuedCalls;
+    }
+    glBindBufferBase(target, index, buffer);
+    // Binding an indexed binding point binds the generic one too
+    if (SLOT != UNTRACKED_TARGET) {
+        m_Buffers[SLOT] = buffer;
+    }
+}
+
+auto OpenGLStateCache::BindTexture(uint32_t unit, uint32_t target,
+                                   uint32_t texture) -> void {
+    const auto SLOT = TextureTargetSlot(target);
+    if (unit >= MAX_CACHED_TEXTURE_UNITS || SLOT == UNTRACKED_TARGET) {
+        if (_Update(m_ActiveUnit, unit)) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+        ++m_NumIssuedCalls;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (m_Textures[unit][SLOT] == texture) {
+        ++m_NumElidedCalls;
+        return;
+    }
+    if (_Update(m_ActiveUnit, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    _Update(m_Textures[unit][SLOT], texture);
+    glBindTexture(target, texture);
+}
+
+auto OpenGLStateCache::SetBlend(bool enabled) -> void {
+    if (_Update(m_Blend, enabled ? 1 : 0)) {
+        if (enabled) {
+            glEnable(GL_BLEND);
+        } else {
+            glDisable(GL_BLEND);
+        }
+    }
+}
+
+auto OpenGLStateCache::SetBlendFunc(uint32_t src_factor, uint32_t dst_factor)
+    -> void {
+    if (m_BlendFunc[0] == src_factor && m_BlendFunc[1] == dst_factor) {
+        ++m_NumElidedCalls;
+        return;
+    }
+    ++m_NumIssuedCalls;
+    m_BlendFunc = {src_factor, dst_factor};
+    glBlendFunc(src_factor, dst_factor);
+}
+
+auto OpenGLStateCache::SetDepthTest(bool enabled) -> void {
+    if (_Update(m_DepthTest, enabled ? 1 : 0)) {
+        if (enabled) {
+            glEnable(GL_DEPTH_TEST);
+        } else {
+            glDisable(GL_DEPTH_TEST);
+        }
+    }
+}
+
+auto OpenGLStateCache::SetDepthMask(bool enabled) -> void {
+    if (_Update(m_DepthMask, enabled ? 1 : 0)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+auto OpenGLStateCache::SetDepthFunc(uint32_t func) -> void {
+    if (_Update(m_DepthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+auto OpenGLStateCache::SetPolygonOffsetFill(bool enabled) -> void {
+    if (_Update(m_PolygonOffsetFill, enabled ? 1 : 0)) {
+        if (enabled) {
+            glEnable(GL_POLYGON_OFFSET_FILL);
+        } else {
+            glDisable(GL_POLYGON_OFFSET_FILL);
+        }
+    }
+}
+
+auto OpenGLStateCache::SetPolygonOffset(float32_t factor, float32_t units)
+    -> void {
+    const std::array<float32_t, 2> OFFSET = {factor, units};
+    if (m_PolygonOffsetKnown && m_PolygonOffset == OFFSET) {
+        ++m_NumElidedCalls;
+        return;
+    }
+    ++m_NumIssuedCalls;
+    m_PolygonOffset = OFFSET;
+    m_PolygonOffsetKnown = true;
+    glPolygonOffset(factor, units);
+}
+
+auto OpenGLStateCache::SetColorMask(bool enabled) -> void {
+    if (_Update(m_ColorMask, enabled ? 1 : 0)) {
+        const auto MASK = enabled ? GL_TRUE : GL_FALSE;
+        glColorMask(MASK, MASK, MASK, MASK);
+    }
+}
+
+auto OpenGLStateCache::SetClipDepthZeroToOne(bool zero_to_one) -> void {
+    if (!m_ClipControl) {
+        return;
+    }
+    if (_Update(m_ClipDepthZeroToOne, zero_to_one ? 1 : 0)) {
+        glClipControl(GL_LOWER_LEFT,
+                      zero_to_one ? GL_ZERO_TO_ONE : GL_NEGATIVE_ONE_TO_ONE);
+    }
+}
+
+auto OpenGLStateCache::SetViewport(int32_t x, int32_t y, int32_t width,
+                                   int32_t height) -> void {
+    const std::array<int32_t, 4> VIEWPORT = {x, y, width, height};
+    if (m_ViewportKnown && m_Viewport == VIEWPORT) {
+        ++m_NumElidedCalls;
+        return;
+    }
+    ++m_NumIssuedCalls;
+    m_Viewport = VIEWPORT;
+    m_ViewportKnown = true;
+    glViewport(x, y, width, height);
+}
+
+auto OpenGLStateCache::CreateBuffer() -> uint32_t {
+    uint32_t buffer = 0;
+    if (m_DirectStateAccess) {
+        glCreateBuffers(1, &buffer);
+    } else {
+        glGenBuffers(1, &buffer);
+    }
+    return buffer;
+}
+
+auto OpenGLStateCache::DeleteBuffer(uint32_t buffer) -> void {
+    if (buffer == 0) {
+        return;
+    }
+    glDeleteBuffers(1, &buffer);
+    // Deleted buffers are unbound from every binding point of the context
+    for (auto& bound : m_Buffers) {
+        bound = (bound == buffer) ? 0 : bound;
+    }
+    for (auto& bound : m_UniformBuffers) {
+        bound = (bound == buffer) ? 0 : bound;
+    }
+}
+
+auto OpenGLStateCache::BufferData(uint32_t buffer, uint32_t size,
+                                  const void* data, uint32_t usage) -> void {
+    if (m_DirectStateAccess) {
+        glNamedBufferData(buffer, static_cast<GLsizeiptr>(size), data, usage);
+        return;
+    }
+    _BindForEdit(buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), data,
+                 usage);
+}
+
+auto OpenGLStateCache::BufferStorage(uint32_t buffer, uint32_t size,
+                                     const void* data, uint32_t flags)
+    -> void {
+    if (m_DirectStateAccess) {
+        glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(size), data,
+                             flags);
+        return;
+    }
+    _BindForEdit(buffer);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), data,
+                    flags);
+}
+
+auto OpenGLStateCache::BufferSubData(uint32_t buffer, uint32_t offset,
+                                     uint32_t size, const void* data) -> void {
+    if (m_DirectStateAccess) {
+        glNamedBufferSubData(buffer, static_cast<GLintptr>(offset),
+                             static_cast<GLsizeiptr>(size), data);
+        return;
+    }
+    _BindForEdit(buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset),
+                    static_cast<GLsizeiptr>(size), data);
+}
+
+auto OpenGLStateCache::MapBufferRange(uint32_t buffer, uint32_t offset,
+                                      uint32_t size, uint32_t access)
+    -> void* {
+    if (m_DirectStateAccess) {
+        return glMapNamedBufferRange(buffer, static_cast<GLintptr>(offset),
+                                     static_cast<GLsizeiptr>(size), access);
+    }
+    _BindForEdit(buffer);
+    return glMapBufferRange(GL_COPY_WRITE_BUFFER,
+                            static_cast<GLintptr>(offset),
+                            static_cast<GLsizeiptr>(size), access);
+}
+
+auto OpenGLStateCache::UnmapBuffer(uint32_t buffer) -> void {
+    if (m_DirectStateAccess) {
+        glUnmapNamedBuffer(buffer);
+        return;
+    }
+    _BindForEdit(buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+}
+
+auto OpenGLStateCache::CopyBufferSubData(uint32_t src_buffer,
+                                         uint32_t dst_buffer,
+                                         uint32_t src_offset,
+                                         uint32_t dst_offset, uint32_t size)
+    -> void {
+    if (m_DirectStateAccess) {
+        glCopyNamedBufferSubData(src_buffer, dst_buffer,
+                                 static_cast<GLintptr>(src_offset),
+                                 static_cast<GLintptr>(dst_offset),
+                                 static_cast<GLsizeiptr>(size));
+        return;
+    }
+    BindBuffer(GL_COPY_READ_BUFFER, src_buffer);
+    _BindForEdit(dst_buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                        static_cast<GLintptr>(src_offset),
+                        static_cast<GLintptr>(dst_offset),
+                        static_cast<GLsizeiptr>(size));
+}
+
+auto OpenGLStateCache::TextureParameter(uint32_t target, uint32_t texture,
+                                        uint32_t pname, int32_t value)
+    -> void {
+    if (m_DirectStateAccess) {
+        glTextureParameteri(texture, pname, value);
+        return;
+    }
+    _BindTextureForEdit(target, texture);
+    glTexParameteri(target, pname, value);
+}
+
+auto OpenGLStateCache::TextureParameter(uint32_t target, uint32_t texture,
+                                        uint32_t pname,
+                                        const float32_t* values) -> void {
+    if (m_DirectStateAccess) {
+        glTextureParameterfv(texture, pname, values);
+        return;
+    }
+    _BindTextureForEdit(target, texture);
+    glTexParameterfv(target, pname, values);
+}
+
+auto OpenGLStateCache::DeleteTexture(uint32_t texture) -> void {
+    if (texture == 0) {
+        return;
+    }
+    glDeleteTextures(1, &texture);
+    // Deleted textures are unbound from every texture unit
+    for (auto& unit : m_Textures) {
+        for (auto& bound : unit) {
+            bound = (bound == texture) ? 0 : bound;
+        }
+    }
+}
+
+auto OpenGLStateCache::DeleteVertexArray(uint32_t vertex_array) -> void {
+    if (vertex_array == 0) {
+        return;
+    }
+    glDeleteVertexArrays(1, &vertex_array);
+    if (m_VertexArray == vertex_array) {
+        // Reverts to the default vertex array, and its element array binding
+        m_VertexArray = 0;
+        m_Buffers[ElementArraySlot()] = UNKNOWN_STATE;
+    }
+}
+
+auto OpenGLStateCache::DeleteProgram(uint32_t program) -> void {
+    if (program == 0) {
+        return;
+    }
+    glDeleteProgram(program);
+    // The current program stays in use until another one is, so its name
+    // can't be reused by a new program until then
+    if (m_Program == program) {
+        m_Program = UNKNOWN_STATE;
+    }
+}
+
+auto OpenGLStateCache::ResetCounters() -> void {
+    m_NumIssuedCalls = 0;
+    m_NumElidedCalls = 0;
+}
+
+auto OpenGLStateCache::_Update(uint32_t& tracked, uint32_t value) -> bool {
+    if (tracked == value) {
+        ++m_NumElidedCalls;
+        return false;
+    }
+    ++m_NumIssuedCalls;
+    tracked = value;
+    return true;
+}
+
+auto OpenGLStateCache::_BindForEdit(uint32_t buffer) -> void {
+    BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+}
+
+auto OpenGLStateCache::_BindTextureForEdit(uint32_t target, uint32_t texture)
+    -> void {
+    const auto UNIT = (m_ActiveUnit == UNKNOWN_STATE) ? 0 : m_ActiveUnit;
+    BindTexture(UNIT, target, texture);
+}
+
+auto OpenGLStateCache::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLStateCache\n"
+        "  directStateAccess: {0}\n"
+        "  clipControl: {1}\n"
+        "  numIssuedCalls: {2}\n"
+        "  numElidedCalls: {3}\n"
+        ">\n",
+        m_DirectStateAccess, m_ClipControl, m_NumIssuedCalls,
+        m_NumElidedCalls);
+}
+
+}  // namespace opengl
+}  // namespace renderer
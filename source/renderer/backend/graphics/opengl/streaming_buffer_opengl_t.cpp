@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/streaming_buffer_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+/// Timeout (in nanoseconds) of each wait on a fence, between flushes
+constexpr GLuint64 FENCE_WAIT_TIMEOUT = 1000000;
+
+auto IsSignaled(GLenum status) -> bool {
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+}  // namespace
+
+OpenGLStreamingBuffer::OpenGLStreamingBuffer(uint32_t segment_size,
+                                             uint32_t num_segments)
+    : m_NumSegments(std::max(num_segments, 1U)) {
+    _Create(segment_size);
+}
+
+OpenGLStreamingBuffer::~OpenGLStreamingBuffer() { _Destroy(); }
+
+auto OpenGLStreamingBuffer::BeginSegment(uint32_t min_size) -> void {
+    if (!m_Persistent && m_Mapped != nullptr) {
+        EndSegment();
+    }
+    if (m_Started) {
+        // Guards the segment of the previous frame, whose draws were issued
+        m_Fences[m_Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    m_Started = true;
+    m_Cursor = 0;
+
+    if (min_size > m_SegmentSize) {
+        // OpenGL keeps the old storage alive until the GPU is done with it
+        _Destroy();
+        _Create(std::max(min_size, 2 * m_SegmentSize));
+        m_Started = true;
+        m_Segment = 0;
+    } else {
+        m_Segment = (m_Segment + 1) % m_NumSegments;
+        _WaitForSegment(m_Segment);
+    }
+
+    if (!m_Persistent) {
+        m_Mapped = static_cast<uint8_t*>(
+            OpenGLStateCache::Current().MapBufferRange(
+                m_OpenGLId, m_Segment * m_SegmentSize, m_SegmentSize,
+                GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                    GL_MAP_INVALIDATE_RANGE_BIT));
+    }
+}
+
+auto OpenGLStreamingBuffer::Allocate(uint32_t size, uint32_t alignment)
+    -> OpenGLStreamingAllocation {
+    OpenGLStreamingAllocation allocation;
+    alignment = std::max(alignment, 1U);
+    const auto START = (m_Cursor + alignment - 1) / alignment * alignment;
+    if (m_Mapped == nullptr || START + size > m_SegmentSize) {
+        LOG_CORE_WARN(
+            "OpenGLStreamingBuffer::Allocate >>> can't fit {0} bytes in the "
+            "current segment ({1}/{2} bytes used)",
+            size, m_Cursor, m_SegmentSize);
+        return allocation;
+    }
+
+    const auto SEGMENT_OFFSET = m_Segment * m_SegmentSize;
+    allocation.data =
+        m_Persistent ? m_Mapped + SEGMENT_OFFSET + START : m_Mapped + START;
+    allocation.offset = SEGMENT_OFFSET + START;
+    allocation.size = size;
+    m_Cursor = START + size;
+    return allocation;
+}
+
+auto OpenGLStreamingBuffer::EndSegment() -> void {
+    // Persistent mappings are coherent, so writes are visible as they are
+    if (m_Persistent || m_Mapped == nullptr) {
+        return;
+    }
+    OpenGLStateCache::Current().UnmapBuffer(m_OpenGLId);
+    m_Mapped = nullptr;
+}
+
+auto OpenGLStreamingBuffer::_Create(uint32_t segment_size) -> void {
+    m_SegmentSize = segment_size;
+    m_Segment = 0;
+    m_Cursor = 0;
+    m_Started = false;
+    m_Fences.assign(m_NumSegments, nullptr);
+
+    const auto TOTAL_SIZE = m_SegmentSize * m_NumSegments;
+    auto& state = OpenGLStateCache::Current();
+    m_OpenGLId = state.CreateBuffer();
+    m_Persistent = (GLAD_GL_VERSION_4_4 != 0);
+    if (m_Persistent) {
+        constexpr GLbitfield FLAGS =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        state.BufferStorage(m_OpenGLId, TOTAL_SIZE, nullptr, FLAGS);
+        m_Mapped = static_cast<uint8_t*>(
+            state.MapBufferRange(m_OpenGLId, 0, TOTAL_SIZE, FLAGS));
+    } else {
+        state.BufferData(m_OpenGLId, TOTAL_SIZE, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+auto OpenGLStreamingBuffer::_Destroy() -> void {
+    for (auto& fence : m_Fences) {
+        if (fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+    if (m_OpenGLId == 0) {
+        return;
+    }
+    auto& state = OpenGLStateCache::Current();
+    if (m_Mapped != nullptr) {
+        state.UnmapBuffer(m_OpenGLId);
+        m_Mapped = nullptr;
+    }
+    state.DeleteBuffer(m_OpenGLId);
+    m_OpenGLId = 0;
+}
+
+auto OpenGLStreamingBuffer::_WaitForSegment(uint32_t segment) -> void {
+    auto fence = static_cast<GLsync>(m_Fences[segment]);
+    if (fence == nullptr) {
+        return;
+    }
+    m_Fences[segment] = nullptr;
+    if (IsSignaled(glClientWaitSync(fence, 0, 0))) {
+        glDeleteSync(fence);
+        return;
+    }
+
+    if (!m_Persistent) {
+        // Hand the old storage over to the driver and start on a fresh one,
+        // so none of the segments are in use anymore
+        glDeleteSync(fence);
+        for (auto& other : m_Fences) {
+            if (other != nullptr) {
+                glDeleteSync(static_cast<GLsync>(other));
+                other = nullptr;
+            }
+        }
+        OpenGLStateCache::Current().BufferData(
+            m_OpenGLId, m_SegmentSize * m_NumSegments, nullptr,
+            GL_STREAM_DRAW);
+        ++m_NumOrphans;
+        return;
+    }
+
+    // Immutable storage can't be orphaned, so wait for the GPU to catch up
+    ++m_NumWaits;
+    while (true) {
+        const auto STATUS = glClientWaitSync(
+            fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIMEOUT);
+        if (IsSignaled(STATUS) || STATUS == GL_WAIT_FAILED) {
+            break;
+        }
+    }
+    glDeleteSync(fence);
+}
+
+auto OpenGLStreamingBuffer::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLStreamingBuffer\n"
+        "  segmentSize: {0}\n"
+        "  numSegments: {1}\n"
+        "  persistent: {2}\n"
+        "  numWaits: {3}\n"
+        "  numOrphans: {4}\n"
+        "  opengl-id: {5}\n"
+        ">\n",
+        m_SegmentSize, m_NumSegments, m_Persistent, m_NumWaits, m_NumOrphans,
+        m_OpenGLId);
+}
+
+}  // namespace opengl
+}  // namespace renderer
@@ -8,6 +8,7 @@
 
 #include <utils/logging.hpp>
 
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/texture_opengl_t.hpp>
 
 // References:
@@ -96,21 +97,27 @@ OpenGLTexture::OpenGLTexture(OpenGLTextureData::ptr tex_data) {
 }
 
 auto OpenGLTexture::_InitializeTexture() -> void {
+    // The first bind creates the texture object, so that it can be edited
+    // through direct state access afterwards. The image is uploaded into the
+    // texture bound to the first unit
+    auto& state = OpenGLStateCache::Current();
     glGenTextures(1, &m_OpenGLId);
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
+    state.BindTexture(0, GL_TEXTURE_2D, m_OpenGLId);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
+    state.TextureParameter(GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_WRAP_S,
+                           static_cast<int32_t>(ToOpenGLEnum(m_WrapU)));
+    state.TextureParameter(GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_WRAP_T,
+                           static_cast<int32_t>(ToOpenGLEnum(m_WrapV)));
     if (m_WrapU == eTextureWrap::CLAMP_TO_BORDER ||
         m_WrapV == eTextureWrap::CLAMP_TO_BORDER) {
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR,
-                         m_BorderColor.data());
+        state.TextureParameter(GL_TEXTURE_2D, m_OpenGLId,
+                               GL_TEXTURE_BORDER_COLOR, m_BorderColor.data());
     }
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    ToOpenGLEnum(m_MinFilter));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    ToOpenGLEnum(m_MagFilter));
+    state.TextureParameter(GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_MIN_FILTER,
+                           static_cast<int32_t>(ToOpenGLEnum(m_MinFilter)));
+    state.TextureParameter(GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_MAG_FILTER,
+                           static_cast<int32_t>(ToOpenGLEnum(m_MagFilter)));
 
     if (m_TextureData->data() != nullptr) {
         // --------------------------------
@@ -131,28 +138,25 @@ auto OpenGLTexture::_InitializeTexture() -> void {
             ToOpenGLEnum(m_TextureData->storage()), m_TextureData->data());
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 OpenGLTexture::~OpenGLTexture() {
     m_TextureData = nullptr;
     if (m_OpenGLId != 0) {
-        glDeleteTextures(1, &m_OpenGLId);
+        OpenGLStateCache::Current().DeleteTexture(m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
 
 auto OpenGLTexture::Bind() const -> void {
     // This bind method assumes we're only dealing with a single texture unit
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
+    OpenGLStateCache::Current().BindTexture(0, GL_TEXTURE_2D, m_OpenGLId);
 }
 
 // NOLINTNEXTLINE
 auto OpenGLTexture::Unbind() const -> void {
     // This unbind method assumes we're only dealing with a single texture unit
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OpenGLStateCache::Current().BindTexture(0, GL_TEXTURE_2D, 0);
 }
 
 auto OpenGLTexture::ToString() const -> std::string {
@@ -178,40 +182,37 @@ auto OpenGLTexture::ToString() const -> std::string {
 
 auto OpenGLTexture::SetBorderColor(const Vec4& color) -> void {
     m_BorderColor = color;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR,
-                     m_BorderColor.data());
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OpenGLStateCache::Current().TextureParameter(
+        GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_BORDER_COLOR,
+        m_BorderColor.data());
 }
 
 auto OpenGLTexture::SetMinFilter(const eTextureFilter& tex_filter) -> void {
     m_MinFilter = tex_filter;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    ToOpenGLEnum(m_MinFilter));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OpenGLStateCache::Current().TextureParameter(
+        GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_MIN_FILTER,
+        static_cast<int32_t>(ToOpenGLEnum(m_MinFilter)));
 }
 
 auto OpenGLTexture::SetMagFilter(const eTextureFilter& tex_filter) -> void {
     m_MagFilter = tex_filter;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    ToOpenGLEnum(m_MagFilter));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OpenGLStateCache::Current().TextureParameter(
+        GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_MAG_FILTER,
+        static_cast<int32_t>(ToOpenGLEnum(m_MagFilter)));
 }
 
 auto OpenGLTexture::SetWrapModeU(const eTextureWrap& tex_wrap) -> void {
     m_WrapU = tex_wrap;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OpenGLStateCache::Current().TextureParameter(
+        GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_WRAP_S,
+        static_cast<int32_t>(ToOpenGLEnum(m_WrapU)));
 }
 
 auto OpenGLTexture::SetWrapModeV(const eTextureWrap& tex_wrap) -> void {
     m_WrapV = tex_wrap;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    OpenGLStateCache::Current().TextureParameter(
+        GL_TEXTURE_2D, m_OpenGLId, GL_TEXTURE_WRAP_T,
+        static_cast<int32_t>(ToOpenGLEnum(m_WrapV)));
 }
 
 }  // namespace opengl
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/uniform_buffer_opengl_t.hpp>
+
+namespace renderer {
+namespace opengl {
+
+OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t binding, uint32_t size)
+    : m_Binding(binding), m_Size(size) {
+    auto& state = OpenGLStateCache::Current();
+    m_OpenGLId = state.CreateBuffer();
+    state.BufferData(m_OpenGLId, m_Size, nullptr, GL_DYNAMIC_DRAW);
+}
+
+OpenGLUniformBuffer::~OpenGLUniformBuffer() {
+    if (m_OpenGLId != 0) {
+        OpenGLStateCache::Current().DeleteBuffer(m_OpenGLId);
+        m_OpenGLId = 0;
+    }
+}
+
+auto OpenGLUniformBuffer::Update(const void* data, uint32_t size) -> void {
+    m_Size = std::max(m_Size, size);
+    auto& state = OpenGLStateCache::Current();
+    state.BufferData(m_OpenGLId, m_Size, nullptr, GL_DYNAMIC_DRAW);
+    state.BufferSubData(m_OpenGLId, 0, size, data);
+}
+
+auto OpenGLUniformBuffer::Update(const Std140Writer& writer) -> void {
+    Update(writer.data(), writer.size());
+}
+
+auto OpenGLUniformBuffer::Bind() const -> void {
+    OpenGLStateCache::Current().BindBufferBase(GL_UNIFORM_BUFFER, m_Binding,
+                                               m_OpenGLId);
+}
+
+auto OpenGLUniformBuffer::ToString() const -> std::string {
+    return fmt::format(
+        "<OpenGLUniformBuffer\n"
+        "  binding: {0}\n"
+        "  size: {1}\n"
+        "  opengl-id: {2}\n"
+        ">\n",
+        m_Binding, m_Size, m_OpenGLId);
+}
+
+}  // namespace opengl
+}  // namespace renderer
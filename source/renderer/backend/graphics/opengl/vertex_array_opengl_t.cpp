@@ -8,6 +8,7 @@
 #include <spdlog/fmt/bundled/format.h>
 
 #include <renderer/engine/graphics/enums.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_array_opengl_t.hpp>
 
 #if defined(__clang__)
@@ -38,12 +39,29 @@ auto ToOpenGLEnum(eElementType etype) -> uint32_t {
     }
 }
 
+auto SetVertexAttributes(uint32_t first_location,
+                         const OpenGLBufferLayout& layout, uint32_t buffer_id,
+                         uintptr_t offset) -> void {
+    const auto STRIDE = static_cast<int>(layout.stride());
+    OpenGLStateCache::Current().BindBuffer(GL_ARRAY_BUFFER, buffer_id);
+    for (size_t i = 0; i < layout.size(); ++i) {
+        const auto& element = layout[i];
+        const auto ELEMENT_OFFSET = offset + element.offset;
+        glVertexAttribPointer(first_location + static_cast<uint32_t>(i),
+                              static_cast<int>(element.count),
+                              ToOpenGLEnum(element.type),
+                              element.normalized ? GL_TRUE : GL_FALSE, STRIDE,
+                              // cppcheck-suppress cstyleCast
+                              (const void*)ELEMENT_OFFSET);  // NOLINT
+    }
+}
+
 OpenGLVertexArray::OpenGLVertexArray() { glGenVertexArrays(1, &m_OpenGLId); }
 
 OpenGLVertexArray::~OpenGLVertexArray() {
     m_Buffers.clear();
     if (m_OpenGLId != 0) {
-        glDeleteVertexArrays(1, &m_OpenGLId);
+        OpenGLStateCache::Current().DeleteVertexArray(m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
@@ -54,8 +72,9 @@ auto OpenGLVertexArray::AddVertexBuffer(OpenGLVertexBuffer::ptr buffer)
 
     const auto STRIDE = buffer_layout.stride();
 
-    glBindVertexArray(m_OpenGLId);
-    glBindBuffer(GL_ARRAY_BUFFER, buffer->opengl_id());
+    auto& state = OpenGLStateCache::Current();
+    state.BindVertexArray(m_OpenGLId);
+    state.BindBuffer(GL_ARRAY_BUFFER, buffer->opengl_id());
 
     for (size_t i = 0; i < buffer_layout.size(); ++i) {
         const auto& element = buffer_layout[i];
@@ -66,28 +85,44 @@ auto OpenGLVertexArray::AddVertexBuffer(OpenGLVertexBuffer::ptr buffer)
                               static_cast<int>(STRIDE),
                               // cppcheck-suppress cstyleCast
                               (const void*)(intptr_t)element.offset);  // NOLINT
+        if (element.divisor != 0) {
+            glVertexAttribDivisor(m_NumAttribIndx, element.divisor);
+        }
         m_NumAttribIndx++;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
     m_Buffers.push_back(std::move(buffer));
 }
 
+auto OpenGLVertexArray::AddStreamedAttributes(const OpenGLBufferLayout& layout)
+    -> void {
+    OpenGLStateCache::Current().BindVertexArray(m_OpenGLId);
+    for (size_t i = 0; i < layout.size(); ++i) {
+        const auto& element = layout[i];
+        glEnableVertexAttribArray(m_NumAttribIndx);
+        if (element.divisor != 0) {
+            glVertexAttribDivisor(m_NumAttribIndx, element.divisor);
+        }
+        m_NumAttribIndx++;
+    }
+}
+
 auto OpenGLVertexArray::SetIndexBuffer(OpenGLIndexBuffer::ptr ibuffer) -> void {
-    glBindVertexArray(m_OpenGLId);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibuffer->opengl_id());
-    glBindVertexArray(0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    auto& state = OpenGLStateCache::Current();
+    state.BindVertexArray(m_OpenGLId);
+    state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibuffer->opengl_id());
 
     m_IndexBuffer = std::move(ibuffer);
 }
 
-auto OpenGLVertexArray::Bind() const -> void { glBindVertexArray(m_OpenGLId); }
+auto OpenGLVertexArray::Bind() const -> void {
+    OpenGLStateCache::Current().BindVertexArray(m_OpenGLId);
+}
 
 // NOLINTNEXTLINE
-auto OpenGLVertexArray::Unbind() const -> void { glBindVertexArray(0); }
+auto OpenGLVertexArray::Unbind() const -> void {
+    OpenGLStateCache::Current().BindVertexArray(0);
+}
 
 auto OpenGLVertexArray::GetVertexBuffer(uint32_t vbo_index) const
     -> const OpenGLVertexBuffer& {
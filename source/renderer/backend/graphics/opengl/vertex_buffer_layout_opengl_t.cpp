@@ -19,8 +19,10 @@ auto OpenGLBufferElement::ToString() const -> std::string {
         "  nbytes: {3}\n"
         "  offset: {4}\n"
         "  normalized: {5}\n"
+        "  divisor: {6}\n"
         ">\n",
-        name, ::renderer::ToString(type), count, nbytes, offset, normalized);
+        name, ::renderer::ToString(type), count, nbytes, offset, normalized,
+        divisor);
 }
 
 OpenGLBufferLayout::OpenGLBufferLayout(
@@ -4,7 +4,9 @@
 #include <glad/gl.h>
 
 #include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
 
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 #include <renderer/backend/graphics/opengl/vertex_buffer_opengl_t.hpp>
 
 namespace renderer {
@@ -25,15 +27,14 @@ OpenGLVertexBuffer::OpenGLVertexBuffer(OpenGLBufferLayout layout,
                                        eBufferUsage usage, uint32_t size,
                                        const float32_t* data)
     : m_Layout(std::move(layout)), m_Usage(usage), m_Size(size) {
-    glGenBuffers(1, &m_OpenGLId);
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
-    glBufferData(GL_ARRAY_BUFFER, m_Size, data, ToOpenGLEnum(m_Usage));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    auto& state = OpenGLStateCache::Current();
+    m_OpenGLId = state.CreateBuffer();
+    state.BufferData(m_OpenGLId, m_Size, data, ToOpenGLEnum(m_Usage));
 }
 
 OpenGLVertexBuffer::~OpenGLVertexBuffer() {
     if (m_OpenGLId != 0) {
-        glDeleteBuffers(1, &m_OpenGLId);
+        OpenGLStateCache::Current().DeleteBuffer(m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
@@ -44,9 +45,8 @@ auto OpenGLVertexBuffer::Resize(uint32_t size) -> void {
     }
 
     m_Size = size;
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
-    glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, ToOpenGLEnum(m_Usage));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    OpenGLStateCache::Current().BufferData(m_OpenGLId, m_Size, nullptr,
+                                           ToOpenGLEnum(m_Usage));
 }
 
 auto OpenGLVertexBuffer::UpdateData(uint32_t size, const float32_t* data)
@@ -55,18 +55,29 @@ auto OpenGLVertexBuffer::UpdateData(uint32_t size, const float32_t* data)
         Resize(size);
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, m_Size, data);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    OpenGLStateCache::Current().BufferSubData(m_OpenGLId, 0, m_Size, data);
+}
+
+auto OpenGLVertexBuffer::UpdateRange(uint32_t offset, uint32_t size,
+                                     const float32_t* data) -> void {
+    if (offset + size > m_Size) {
+        LOG_CORE_WARN(
+            "OpenGLVertexBuffer::UpdateRange >>> range [{0}, {1}) doesn't fit "
+            "in a buffer of {2} bytes",
+            offset, offset + size, m_Size);
+        return;
+    }
+
+    OpenGLStateCache::Current().BufferSubData(m_OpenGLId, offset, size, data);
 }
 
 auto OpenGLVertexBuffer::Bind() const -> void {
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
+    OpenGLStateCache::Current().BindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
 }
 
 // NOLINTNEXTLINE
 auto OpenGLVertexBuffer::Unbind() const -> void {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    OpenGLStateCache::Current().BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 auto OpenGLVertexBuffer::ToString() const -> std::string {
@@ -4,6 +4,7 @@
 #include <utils/logging.hpp>
 
 #include <renderer/backend/window/window_adapter_egl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 
 namespace renderer {
 
@@ -75,8 +76,11 @@ WindowAdapterEGL::WindowAdapterEGL(WindowConfig config)
     LOG_CORE_INFO("\tVersion    : {0}", fmt::ptr(glGetString(GL_VERSION)));
 
     // Setup some general GL options
-    glViewport(0, 0, m_Config.width, m_Config.height);
-    glEnable(GL_DEPTH_TEST);
+    // Start tracking the state of the new context from scratch
+    auto& state = opengl::OpenGLStateCache::Current();
+    state.Invalidate();
+    state.SetViewport(0, 0, m_Config.width, m_Config.height);
+    state.SetDepthTest(true);
     glClearColor(m_Config.clear_color.x(), m_Config.clear_color.y(),
                  m_Config.clear_color.z(), m_Config.clear_color.w());
 }
@@ -4,6 +4,7 @@
 #include <utils/logging.hpp>
 
 #include <renderer/backend/window/window_adapter_glfw.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
 
 #if defined(RENDERER_IMGUI)
 #include <imgui.h>
@@ -66,8 +67,11 @@ WindowAdapterGLFW::WindowAdapterGLFW(WindowConfig config)
     int fbuffer_height = 0;
     glfwGetFramebufferSize(glfw_window, &fbuffer_width, &fbuffer_height);
 
-    glViewport(0, 0, fbuffer_width, fbuffer_height);
-    glEnable(GL_DEPTH_TEST);
+    // Start tracking the state of the new context from scratch
+    auto& state = opengl::OpenGLStateCache::Current();
+    state.Invalidate();
+    state.SetViewport(0, 0, fbuffer_width, fbuffer_height);
+    state.SetDepthTest(true);
     glClearColor(m_Config.clear_color.x(), m_Config.clear_color.y(),
                  m_Config.clear_color.z(), m_Config.clear_color.w());
 
@@ -137,6 +141,10 @@ WindowAdapterGLFW::WindowAdapterGLFW(WindowConfig config)
 
     glfwSetFramebufferSizeCallback(
         glfw_window, [](GLFWwindow* window_ptr, int width, int height) {
+            // Goes through the cache first, so the user callbacks (and the
+            // renderer) see the new size of the framebuffer
+            opengl::OpenGLStateCache::Current().SetViewport(0, 0, width,
+                                                            height);
             auto* adapter = static_cast<WindowAdapterGLFW*>(
                 glfwGetWindowUserPointer(window_ptr));
             size_t num_callbacks = adapter->m_ArrResizeCallbacksCount;
@@ -237,6 +245,8 @@ auto WindowAdapterGLFW::End() -> void {
         ImGui::Render();
         // Render all ui-elements
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // ImGui issues its GL calls directly, without going through the cache
+        opengl::OpenGLStateCache::Current().Invalidate();
 #endif  // RENDERER_IMGUI
         glfwSwapBuffers(m_GlfwWindow.get());
     }
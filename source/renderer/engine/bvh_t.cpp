@@ -0,0 +1,401 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/engine/bvh_t.hpp>
+
+namespace renderer {
+
+auto BVH::Insert(Object3D* object, const AABB& bounds) -> BvhLeafId {
+    BvhLeafId leaf_id = INVALID_BVH_LEAF;
+    if (!m_FreeLeaves.empty()) {
+        leaf_id = m_FreeLeaves.back();
+        m_FreeLeaves.pop_back();
+    } else {
+        leaf_id = static_cast<BvhLeafId>(m_Leaves.size());
+        m_Leaves.emplace_back();
+    }
+
+    auto& leaf = m_Leaves[leaf_id];
+    // A reused leaf might still have the node it was removed from
+    if (leaf.node != INVALID_BVH_NODE && !m_NeedsRebuild) {
+        _DetachLeaf(leaf.node);
+        m_NumDeadNodes--;
+    }
+    leaf.object = object;
+    leaf.bounds = bounds;
+    leaf.node = INVALID_BVH_NODE;
+    // The first objects get a full build, which makes a better tree than
+    // inserting them one by one
+    if (m_Root == INVALID_BVH_NODE || m_NeedsRebuild) {
+        m_NeedsRebuild = true;
+    } else {
+        _InsertLeaf(leaf_id);
+    }
+    return leaf_id;
+}
+
+auto BVH::Update(BvhLeafId leaf_id, const AABB& bounds) -> void {
+    if (leaf_id >= m_Leaves.size() || m_Leaves[leaf_id].object == nullptr) {
+        LOG_CORE_WARN("BVH::Update >>> leaf {0} isn't stored in this tree",
+                      leaf_id);
+        return;
+    }
+
+    auto& leaf = m_Leaves[leaf_id];
+    leaf.bounds = bounds;
+    if (!leaf.changed) {
+        leaf.changed = true;
+        m_ChangedLeaves.push_back(leaf_id);
+    }
+}
+
+auto BVH::Remove(BvhLeafId leaf_id) -> void {
+    if (leaf_id >= m_Leaves.size() || m_Leaves[leaf_id].object == nullptr) {
+        LOG_CORE_WARN("BVH::Remove >>> leaf {0} isn't stored in this tree",
+                      leaf_id);
+        return;
+    }
+
+    // The node stays in place with empty bounds (so refits skip it) until the
+    // next rebuild drops it from the tree
+    Update(leaf_id, AABB());
+    m_Leaves[leaf_id].object = nullptr;
+    m_FreeLeaves.push_back(leaf_id);
+    if (m_Leaves[leaf_id].node != INVALID_BVH_NODE) {
+        m_NumDeadNodes++;
+    }
+}
+
+auto BVH::Commit() -> void {
+    if (m_NeedsRebuild || m_NumDeadNodes > num_objects()) {
+        Build();
+        return;
+    }
+
+    _Refit();
+    if (quality() > m_RebuildThreshold) {
+        Build();
+    }
+}
+
+auto BVH::Build() -> void {
+    m_Nodes.clear();
+    m_FreeNodes.clear();
+    m_Root = INVALID_BVH_NODE;
+    m_InternalArea = 0.0F;
+    m_BuiltCost = 0.0F;
+    m_NeedsRebuild = false;
+    m_NumDeadNodes = 0;
+    m_NumRebuilds++;
+
+    for (auto leaf_id : m_ChangedLeaves) {
+        m_Leaves[leaf_id].changed = false;
+    }
+    m_ChangedLeaves.clear();
+
+    std::vector<BvhLeafId> leaf_ids;
+    std::vector<Vec3> centroids(m_Leaves.size());
+    leaf_ids.reserve(m_Leaves.size());
+    for (size_t i = 0; i < m_Leaves.size(); ++i) {
+        auto& leaf = m_Leaves[i];
+        leaf.node = INVALID_BVH_NODE;
+        if (leaf.object == nullptr) {
+            continue;
+        }
+        leaf_ids.push_back(static_cast<BvhLeafId>(i));
+        centroids[i] =
+            leaf.bounds.empty() ? Vec3(0.0F, 0.0F, 0.0F) : leaf.bounds.center();
+    }
+
+    if (leaf_ids.empty()) {
+        return;
+    }
+
+    // A binary tree with one object per leaf has exactly 2n - 1 nodes
+    m_Nodes.reserve(2 * leaf_ids.size() - 1);
+    m_Root = _BuildRecursive(leaf_ids.data(), leaf_ids.size(),
+                             INVALID_BVH_NODE, centroids);
+    m_BuiltCost = _Cost();
+}
+
+auto BVH::Clear() -> void {
+    m_Nodes.clear();
+    m_Leaves.clear();
+    m_FreeLeaves.clear();
+    m_FreeNodes.clear();
+    m_ChangedLeaves.clear();
+    m_Root = INVALID_BVH_NODE;
+    m_NeedsRebuild = false;
+    m_InternalArea = 0.0F;
+    m_BuiltCost = 0.0F;
+    m_NumDeadNodes = 0;
+}
+
+auto BVH::quality() const -> float {
+    if (m_BuiltCost <= 0.0F) {
+        return 1.0F;
+    }
+    return _Cost() / m_BuiltCost;
+}
+
+auto BVH::_Refit() -> void {
+    m_NumRefitNodes = 0;
+    for (auto leaf_id : m_ChangedLeaves) {
+        auto& leaf = m_Leaves[leaf_id];
+        leaf.changed = false;
+        if (leaf.node == INVALID_BVH_NODE) {
+            continue;
+        }
+
+        m_Nodes[leaf.node].bounds = leaf.bounds;
+        m_NumRefitNodes++;
+        m_NumRefitNodes += _RefitAncestors(m_Nodes[leaf.node].parent);
+    }
+    m_ChangedLeaves.clear();
+}
+
+auto BVH::_InsertLeaf(BvhLeafId leaf_id) -> void {
+    const auto BOUNDS = m_Leaves[leaf_id].bounds;
+    // Walk down towards the cheapest sibling. Pairing with a node costs the
+    // area of the new parent, plus the growth of the ancestors of the node,
+    // which going further down pays for as well
+    auto sibling = m_Root;
+    while (!m_Nodes[sibling].is_leaf()) {
+        const auto& node = m_Nodes[sibling];
+        const auto AREA = node.bounds.surface_area();
+        const auto COMBINED_AREA =
+            AABB::Union(node.bounds, BOUNDS).surface_area();
+        const auto COST = 2.0F * COMBINED_AREA;
+        const auto INHERITED_COST = 2.0F * (COMBINED_AREA - AREA);
+        auto descend_cost = [&](uint32_t child_idx) -> float {
+            const auto& child = m_Nodes[child_idx];
+            const auto GROWN_AREA =
+                AABB::Union(child.bounds, BOUNDS).surface_area();
+            return INHERITED_COST +
+                   (child.is_leaf() ? GROWN_AREA
+                                    : GROWN_AREA - child.bounds.surface_area());
+        };
+        const auto LEFT_COST = descend_cost(node.left);
+        const auto RIGHT_COST = descend_cost(node.right);
+        if (COST < LEFT_COST && COST < RIGHT_COST) {
+            break;
+        }
+        sibling = (LEFT_COST < RIGHT_COST) ? node.left : node.right;
+    }
+
+    // Note: allocating nodes might reallocate the storage, so no references
+    // to nodes are kept across these calls
+    const auto NODE_IDX = _AllocateNode();
+    const auto PARENT_IDX = _AllocateNode();
+    const auto OLD_PARENT = m_Nodes[sibling].parent;
+    m_Nodes[NODE_IDX].bounds = BOUNDS;
+    m_Nodes[NODE_IDX].leaf = leaf_id;
+    m_Nodes[NODE_IDX].parent = PARENT_IDX;
+    m_Leaves[leaf_id].node = NODE_IDX;
+
+    auto& parent = m_Nodes[PARENT_IDX];
+    parent.bounds = AABB::Union(m_Nodes[sibling].bounds, BOUNDS);
+    parent.left = sibling;
+    parent.right = NODE_IDX;
+    parent.parent = OLD_PARENT;
+    m_Nodes[sibling].parent = PARENT_IDX;
+    m_InternalArea += parent.bounds.surface_area();
+
+    if (OLD_PARENT == INVALID_BVH_NODE) {
+        m_Root = PARENT_IDX;
+        return;
+    }
+    auto& old_parent = m_Nodes[OLD_PARENT];
+    (old_parent.left == sibling ? old_parent.left : old_parent.right) =
+        PARENT_IDX;
+    _RefitAncestors(OLD_PARENT);
+}
+
+auto BVH::_DetachLeaf(uint32_t node_idx) -> void {
+    const auto PARENT_IDX = m_Nodes[node_idx].parent;
+    m_Nodes[node_idx].leaf = INVALID_BVH_LEAF;
+    m_FreeNodes.push_back(node_idx);
+    if (PARENT_IDX == INVALID_BVH_NODE) {
+        m_Root = INVALID_BVH_NODE;
+        return;
+    }
+
+    const auto& parent = m_Nodes[PARENT_IDX];
+    const auto SIBLING =
+        (parent.left == node_idx) ? parent.right : parent.left;
+    const auto GRANDPARENT = parent.parent;
+    m_InternalArea -= parent.bounds.surface_area();
+    m_FreeNodes.push_back(PARENT_IDX);
+    m_Nodes[SIBLING].parent = GRANDPARENT;
+    if (GRANDPARENT == INVALID_BVH_NODE) {
+        m_Root = SIBLING;
+        return;
+    }
+    auto& grandparent = m_Nodes[GRANDPARENT];
+    (grandparent.left == PARENT_IDX ? grandparent.left : grandparent.right) =
+        SIBLING;
+    _RefitAncestors(GRANDPARENT);
+}
+
+auto BVH::_RefitAncestors(uint32_t node_idx) -> size_t {
+    // Walk up while the bounds keep changing. Once an ancestor ends up with
+    // the same bounds, the rest of the path is already up to date
+    size_t num_visited = 0;
+    while (node_idx != INVALID_BVH_NODE) {
+        auto& node = m_Nodes[node_idx];
+        const auto NEW_BOUNDS = AABB::Union(m_Nodes[node.left].bounds,
+                                            m_Nodes[node.right].bounds);
+        num_visited++;
+        if (NEW_BOUNDS == node.bounds) {
+            break;
+        }
+        m_InternalArea +=
+            NEW_BOUNDS.surface_area() - node.bounds.surface_area();
+        node.bounds = NEW_BOUNDS;
+        node_idx = node.parent;
+    }
+    return num_visited;
+}
+
+auto BVH::_AllocateNode() -> uint32_t {
+    if (!m_FreeNodes.empty()) {
+        const auto NODE_IDX = m_FreeNodes.back();
+        m_FreeNodes.pop_back();
+        m_Nodes[NODE_IDX] = Node();
+        return NODE_IDX;
+    }
+    m_Nodes.emplace_back();
+    return static_cast<uint32_t>(m_Nodes.size() - 1);
+}
+
+auto BVH::_BuildRecursive(BvhLeafId* leaf_ids, size_t count, uint32_t parent,
+                          const std::vector<Vec3>& centroids) -> uint32_t {
+    // Note: don't keep references to nodes across the recursive calls, as the
+    // storage might get reallocated
+    const auto NODE_IDX = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.emplace_back();
+    m_Nodes[NODE_IDX].parent = parent;
+
+    AABB bounds;
+    AABB centroid_bounds;
+    for (size_t i = 0; i < count; ++i) {
+        bounds.Expand(m_Leaves[leaf_ids[i]].bounds);
+        centroid_bounds.Expand(centroids[leaf_ids[i]]);
+    }
+    m_Nodes[NODE_IDX].bounds = bounds;
+
+    if (count == 1) {
+        m_Nodes[NODE_IDX].leaf = leaf_ids[0];
+        m_Leaves[leaf_ids[0]].node = NODE_IDX;
+        return NODE_IDX;
+    }
+    m_InternalArea += bounds.surface_area();
+
+    // Evaluate the SAH cost of the splits between bins along each axis, and
+    // keep the cheapest one
+    struct Bin {
+        AABB bounds;
+        size_t count{0};
+    };
+    auto bin_of = [&](const Vec3& centroid, uint32_t axis) -> uint32_t {
+        const auto EXTENT =
+            centroid_bounds.max[axis] - centroid_bounds.min[axis];
+        const auto BIN = static_cast<uint32_t>(
+            (centroid[axis] - centroid_bounds.min[axis]) * NUM_SAH_BINS /
+            EXTENT);
+        return std::min(BIN, NUM_SAH_BINS - 1);
+    };
+
+    float best_cost = std::numeric_limits<float>::max();
+    uint32_t best_axis = 3;
+    uint32_t best_split = 0;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        if (centroid_bounds.max[axis] <= centroid_bounds.min[axis]) {
+            continue;
+        }
+
+        std::array<Bin, NUM_SAH_BINS> bins{};
+        for (size_t i = 0; i < count; ++i) {
+            auto& bin = bins[bin_of(centroids[leaf_ids[i]], axis)];
+            bin.bounds.Expand(m_Leaves[leaf_ids[i]].bounds);
+            bin.count++;
+        }
+
+        std::array<float, NUM_SAH_BINS - 1> left_area{};
+        std::array<size_t, NUM_SAH_BINS - 1> left_count{};
+        AABB accum;
+        size_t accum_count = 0;
+        for (uint32_t s = 0; s < NUM_SAH_BINS - 1; ++s) {
+            accum.Expand(bins[s].bounds);
+            accum_count += bins[s].count;
+            left_area[s] = accum.surface_area();
+            left_count[s] = accum_count;
+        }
+
+        accum = AABB();
+        accum_count = 0;
+        for (uint32_t s = NUM_SAH_BINS - 1; s > 0; --s) {
+            accum.Expand(bins[s].bounds);
+            accum_count += bins[s].count;
+            if (left_count[s - 1] == 0 || accum_count == 0) {
+                continue;
+            }
+            const auto COST =
+                left_area[s - 1] * static_cast<float>(left_count[s - 1]) +
+                accum.surface_area() * static_cast<float>(accum_count);
+            if (COST < best_cost) {
+                best_cost = COST;
+                best_axis = axis;
+                best_split = s;
+            }
+        }
+    }
+
+    size_t mid = 0;
+    if (best_axis < 3) {
+        auto* it_mid = std::partition(
+            leaf_ids, leaf_ids + count, [&](BvhLeafId leaf_id) {
+                return bin_of(centroids[leaf_id], best_axis) < best_split;
+            });
+        mid = static_cast<size_t>(it_mid - leaf_ids);
+    }
+    if (mid == 0 || mid == count) {
+        // All centroids are (nearly) coincident, so just split by count
+        mid = count / 2;
+    }
+
+    const auto LEFT = _BuildRecursive(leaf_ids, mid, NODE_IDX, centroids);
+    const auto RIGHT =
+        _BuildRecursive(leaf_ids + mid, count - mid, NODE_IDX, centroids);
+    m_Nodes[NODE_IDX].left = LEFT;
+    m_Nodes[NODE_IDX].right = RIGHT;
+    return NODE_IDX;
+}
+
+auto BVH::_Cost() const -> float {
+    if (m_Root == INVALID_BVH_NODE) {
+        return 0.0F;
+    }
+    const auto ROOT_AREA = m_Nodes[m_Root].bounds.surface_area();
+    return (ROOT_AREA > 0.0F) ? m_InternalArea / ROOT_AREA : 0.0F;
+}
+
+auto BVH::ToString() const -> std::string {
+    return fmt::format(
+        "<BVH\n"
+        "  numObjects: {0}\n"
+        "  numNodes: {1}\n"
+        "  quality: {2}\n"
+        "  numRebuilds: {3}\n"
+        ">\n",
+        num_objects(), m_Nodes.size() - m_FreeNodes.size(), quality(),
+        m_NumRebuilds);
+}
+
+}  // namespace renderer
@@ -17,9 +17,10 @@ auto CameraData::ToString() const -> std::string {
         "  height={4}\n"
         "  near={5}\n"
         "  far={6}\n"
+        "  reverse_z={7}\n"
         ">\n",
         ::renderer::ToString(projection), fov, aspect, width, height, near,
-        far);
+        far, reverse_z);
 }
 
 Camera::Camera(const char* name) : Object3D(name) {}
@@ -51,37 +52,108 @@ auto Camera::ComputeViewMatrix() const -> Mat4 {
     view_mat(2, 2) = this->v_front.z();
     view_mat(3, 2) = 0.0F;
 
-    view_mat(0, 3) = -::math::dot<float>(this->v_right, this->pose.position);
-    view_mat(1, 3) = -::math::dot<float>(this->v_up, this->pose.position);
-    view_mat(2, 3) = -::math::dot<float>(this->v_front, this->pose.position);
+    view_mat(0, 3) = -::math::dot<float>(this->v_right, m_Pose.position);
+    view_mat(1, 3) = -::math::dot<float>(this->v_up, m_Pose.position);
+    view_mat(2, 3) = -::math::dot<float>(this->v_front, m_Pose.position);
     view_mat(3, 3) = 1.0F;
 
     return view_mat;
 }
 
 auto Camera::ComputeProjectionMatrix() const -> Mat4 {
+    return _ComputeProjectionMatrix(this->data.reverse_z);
+}
+
+auto Camera::_ComputeProjectionMatrix(bool reverse_z) const -> Mat4 {
+    const auto Z_NEAR = this->data.near;
+    const auto Z_FAR = this->data.far;
     switch (this->data.projection) {
         case eProjectionType::PERSPECTIVE: {
             // Based on ThreeJS implementation
-            auto top = this->data.near *
+            auto top = Z_NEAR *
                        std::tan((this->data.fov * 0.5F) * PI / 180.0F) /
                        this->zoom;
             auto height = 2.0F * top;
             auto width = this->data.aspect * height;
             auto left = -0.5F * width;
 
-            return Mat4::Perspective(left, left + width, top, top - height,
-                                     this->data.near, this->data.far);
+            auto proj = Mat4::Perspective(left, left + width, top,
+                                          top - height, Z_NEAR, Z_FAR);
+            if (reverse_z) {
+                // z_ndc = n (f + z_eye) / (-z_eye (f - n)), 1 at the near
+                // plane and 0 at the far one (w = -z_eye is left unchanged)
+                proj(2, 2) = Z_NEAR / (Z_FAR - Z_NEAR);
+                proj(2, 3) = Z_FAR * Z_NEAR / (Z_FAR - Z_NEAR);
+            }
+            return proj;
         }
         case eProjectionType::ORTHOGRAPHIC: {
-            return Mat4::Ortho(this->data.width / this->zoom,
-                               this->data.height / this->zoom, this->data.near,
-                               this->data.far);
+            auto proj =
+                Mat4::Ortho(this->data.width / this->zoom,
+                            this->data.height / this->zoom, Z_NEAR, Z_FAR);
+            if (reverse_z) {
+                // z_ndc = (f + z_eye) / (f - n), linear from 1 to 0
+                proj(2, 2) = 1.0F / (Z_FAR - Z_NEAR);
+                proj(2, 3) = Z_FAR / (Z_FAR - Z_NEAR);
+            }
+            return proj;
         }
     }
     return Mat4::Identity();
 }
 
+auto Camera::ComputeFrustum() const -> Frustum {
+    // The planes are the same regardless of the depth range, but extracting
+    // them assumes the standard one
+    return Frustum::FromMatrix(_ComputeProjectionMatrix(false) *
+                               ComputeViewMatrix());
+}
+
+auto Camera::ComputeCullingParams(float min_screen_size) const
+    -> CullingParams {
+    const auto PROJ_MATRIX = _ComputeProjectionMatrix(false);
+    CullingParams params;
+    params.frustum = Frustum::FromMatrix(PROJ_MATRIX * ComputeViewMatrix());
+    params.eye = m_Pose.position;
+    params.projection_scale = PROJ_MATRIX(1, 1);
+    params.perspective =
+        (this->data.projection == eProjectionType::PERSPECTIVE);
+    params.min_screen_size = min_screen_size;
+    params.culling_mask = this->culling_mask;
+    return params;
+}
+
+auto Camera::ScreenPointToRay(float x, float y) const -> Ray {
+    // Point in normalized device coordinates (y pointing up). Note that the
+    // camera looks along -front, as in the view matrix
+    const float NDC_X = 2.0F * x - 1.0F;
+    const float NDC_Y = 1.0F - 2.0F * y;
+
+    Ray ray;
+    switch (this->data.projection) {
+        case eProjectionType::PERSPECTIVE: {
+            const float HALF_HEIGHT =
+                std::tan((this->data.fov * 0.5F) * PI / 180.0F) / this->zoom;
+            const float HALF_WIDTH = this->data.aspect * HALF_HEIGHT;
+            ray.origin = m_Pose.position;
+            ray.direction = ::math::normalize<float>(
+                (NDC_X * HALF_WIDTH) * this->v_right +
+                (NDC_Y * HALF_HEIGHT) * this->v_up - this->v_front);
+            break;
+        }
+        case eProjectionType::ORTHOGRAPHIC: {
+            const float HALF_WIDTH = 0.5F * this->data.width / this->zoom;
+            const float HALF_HEIGHT = 0.5F * this->data.height / this->zoom;
+            ray.origin = m_Pose.position +
+                         (NDC_X * HALF_WIDTH) * this->v_right +
+                         (NDC_Y * HALF_HEIGHT) * this->v_up;
+            ray.direction = -this->v_front;
+            break;
+        }
+    }
+    return ray;
+}
+
 auto Camera::LookAt(Vec3 point) -> void {
     this->target = point;
     // Adapted the look-at function from [0]. Handles corners cases in which the
@@ -90,7 +162,7 @@ auto Camera::LookAt(Vec3 point) -> void {
     // Cache front vector, in case the update cant be applied
     auto old_front = this->v_front;
     this->v_front =
-        ::math::normalize<float>(this->pose.position - this->target);
+        ::math::normalize<float>(m_Pose.position - this->target);
     const bool FRONT_ALIGNS_WORLDUP =
         (this->v_front == this->worldUp) || (this->v_front == -this->worldUp);
 
@@ -107,7 +179,7 @@ auto Camera::LookAt(Vec3 point) -> void {
 
     // Get the orientation from the basis vectors (rot-matrix)
     Mat3 rotmat(this->v_right, this->v_up, v_front);
-    this->pose.orientation = Quat(rotmat);
+    SetOrientation(Quat(rotmat));
 }
 
 auto Camera::LookAt(Quat orientation) -> void {
@@ -117,9 +189,9 @@ auto Camera::LookAt(Quat orientation) -> void {
     this->v_front = ::math::normalize(rot_matrix[2]);
     // Recompute the target point, making sure we are at the same distance we
     // were previous to this update
-    auto length = ::math::norm(this->pose.position - this->target);
+    auto length = ::math::norm(m_Pose.position - this->target);
     this->target =
-        this->pose.position - static_cast<double>(length) * this->v_front;
+        m_Pose.position - static_cast<double>(length) * this->v_front;
 }
 
 auto Camera::ToString() const -> std::string {
@@ -134,8 +206,8 @@ auto Camera::ToString() const -> std::string {
         "  right={6}\n"
         "  up={7}\n"
         ">\n",
-        m_Name, this->pose.position.toString(),
-        this->pose.orientation.toString(), this->target.toString(), this->zoom,
+        name(), m_Pose.position.toString(),
+        m_Pose.orientation.toString(), this->target.toString(), this->zoom,
         this->v_front.toString(), this->v_right.toString(),
         this->v_up.toString());
 }
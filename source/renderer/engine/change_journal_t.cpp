@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/change_journal_t.hpp>
+#include <renderer/engine/object_t.hpp>
+
+namespace renderer {
+
+ChangeJournal::ChangeJournal(size_t capacity)
+    : m_Capacity(std::max<size_t>(capacity, 2)) {}
+
+auto ChangeJournal::Record(eSceneChange type, Object3D& object) -> void {
+    if (m_Changes.size() >= m_Capacity) {
+        // Dropping half of the entries at once keeps recording O(1) amortized
+        Trim(m_FirstSequence + m_Capacity / 2);
+    }
+    m_Changes.push_back({type, object.shared_from_this(), &object});
+}
+
+auto ChangeJournal::Trim(uint64_t sequence) -> void {
+    if (sequence <= m_FirstSequence) {
+        return;
+    }
+    const auto NUM_DROPPED = static_cast<size_t>(
+        std::min<uint64_t>(sequence - m_FirstSequence, m_Changes.size()));
+    m_Changes.erase(m_Changes.begin(),
+                    m_Changes.begin() + static_cast<ptrdiff_t>(NUM_DROPPED));
+    m_FirstSequence += NUM_DROPPED;
+}
+
+auto ChangeJournal::ToString() const -> std::string {
+    return fmt::format(
+        "<ChangeJournal\n"
+        "  firstSequence: {0}\n"
+        "  endSequence: {1}\n"
+        "  capacity: {2}\n"
+        ">\n",
+        m_FirstSequence, end_sequence(), m_Capacity);
+}
+
+}  // namespace renderer
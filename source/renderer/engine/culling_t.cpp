@@ -0,0 +1,564 @@
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/engine/culling_t.hpp>
+#include <renderer/engine/object_t.hpp>
+
+// clang-format off
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define RENDERER_CULLING_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RENDERER_CULLING_SSE2
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+// clang-format on
+
+namespace renderer {
+
+auto Frustum::FromMatrix(const Mat4& view_proj) -> Frustum {
+    // Each plane is a sum/difference of the last row of the matrix with one
+    // of the others, e.g. a point is at the right of the left plane iff its
+    // clip coords satisfy -w <= x, i.e. dot(row_3 + row_0, p) >= 0
+    auto combine = [&view_proj](uint32_t row, float sign) -> Plane {
+        const float A = view_proj(3, 0) + sign * view_proj(row, 0);
+        const float B = view_proj(3, 1) + sign * view_proj(row, 1);
+        const float C = view_proj(3, 2) + sign * view_proj(row, 2);
+        const float D = view_proj(3, 3) + sign * view_proj(row, 3);
+        const float LENGTH = std::sqrt(A * A + B * B + C * C);
+        const float INV_LENGTH = (LENGTH > 0.0F) ? 1.0F / LENGTH : 0.0F;
+        return {Vec3(A * INV_LENGTH, B * INV_LENGTH, C * INV_LENGTH),
+                D * INV_LENGTH};
+    };
+
+    Frustum frustum;
+    frustum.planes[static_cast<size_t>(eFrustumPlane::LEFT)] = combine(0, 1.0F);
+    frustum.planes[static_cast<size_t>(eFrustumPlane::RIGHT)] =
+        combine(0, -1.0F);
+    frustum.planes[static_cast<size_t>(eFrustumPlane::BOTTOM)] =
+        combine(1, 1.0F);
+    frustum.planes[static_cast<size_t>(eFrustumPlane::TOP)] = combine(1, -1.0F);
+    frustum.planes[static_cast<size_t>(eFrustumPlane::ZNEAR)] =
+        combine(2, 1.0F);
+    frustum.planes[static_cast<size_t>(eFrustumPlane::ZFAR)] =
+        combine(2, -1.0F);
+    return frustum;
+}
+
+auto Frustum::Intersects(const AABB& box) const -> bool {
+    if (box.empty()) {
+        return false;
+    }
+    const auto CENTER = box.center();
+    const auto EXTENTS = box.extents();
+    for (const auto& plane : this->planes) {
+        // Projected radius of the box onto the plane normal
+        const float RADIUS = std::abs(plane.normal.x()) * EXTENTS.x() +
+                             std::abs(plane.normal.y()) * EXTENTS.y() +
+                             std::abs(plane.normal.z()) * EXTENTS.z();
+        if (plane.Distance(CENTER) + RADIUS < 0.0F) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto Frustum::Classify(const AABB& box) const -> eFrustumTest {
+    if (box.empty()) {
+        return eFrustumTest::OUTSIDE;
+    }
+    const auto CENTER = box.center();
+    const auto EXTENTS = box.extents();
+    auto result = eFrustumTest::INSIDE;
+    for (const auto& plane : this->planes) {
+        const float RADIUS = std::abs(plane.normal.x()) * EXTENTS.x() +
+                             std::abs(plane.normal.y()) * EXTENTS.y() +
+                             std::abs(plane.normal.z()) * EXTENTS.z();
+        const float DIST = plane.Distance(CENTER);
+        if (DIST + RADIUS < 0.0F) {
+            return eFrustumTest::OUTSIDE;
+        }
+        if (DIST - RADIUS < 0.0F) {
+            result = eFrustumTest::INTERSECTS;
+        }
+    }
+    return result;
+}
+
+auto Frustum::ToString() const -> std::string {
+    std::string planes_str;
+    for (const auto& plane : this->planes) {
+        planes_str += fmt::format("    ({0}, {1})\n", plane.normal.toString(),
+                                  plane.d);
+    }
+    return fmt::format(
+        "<Frustum\n"
+        "  planes:\n"
+        "{0}"
+        ">\n",
+        planes_str);
+}
+
+auto CullingParams::PassesScreenSize(const AABB& box) const -> bool {
+    if (this->min_screen_size <= 0.0F) {
+        return true;
+    }
+    const auto EXTENTS = box.extents();
+    const float RADIUS2 = EXTENTS.x() * EXTENTS.x() +
+                          EXTENTS.y() * EXTENTS.y() +
+                          EXTENTS.z() * EXTENTS.z();
+    float depth2 = 1.0F;
+    if (this->perspective) {
+        const auto DELTA = box.center() - this->eye;
+        depth2 = DELTA.x() * DELTA.x() + DELTA.y() * DELTA.y() +
+                 DELTA.z() * DELTA.z();
+    }
+    return RADIUS2 * this->projection_scale * this->projection_scale >=
+           this->min_screen_size * this->min_screen_size * depth2;
+}
+
+auto BoundsArray::Resize(size_t count) -> void {
+    constexpr float UNUSED_EXTENT = -1.0F;
+    this->center_x.resize(count, 0.0F);
+    this->center_y.resize(count, 0.0F);
+    this->center_z.resize(count, 0.0F);
+    this->extent_x.resize(count, UNUSED_EXTENT);
+    this->extent_y.resize(count, UNUSED_EXTENT);
+    this->extent_z.resize(count, UNUSED_EXTENT);
+}
+
+auto BoundsArray::Set(size_t index, const AABB& box) -> void {
+    if (index >= size()) {
+        Resize(index + 1);
+    }
+    if (box.empty()) {
+        this->center_x[index] = 0.0F;
+        this->center_y[index] = 0.0F;
+        this->center_z[index] = 0.0F;
+        this->extent_x[index] = -1.0F;
+        this->extent_y[index] = -1.0F;
+        this->extent_z[index] = -1.0F;
+        return;
+    }
+    const auto CENTER = box.center();
+    const auto EXTENTS = box.extents();
+    this->center_x[index] = CENTER.x();
+    this->center_y[index] = CENTER.y();
+    this->center_z[index] = CENTER.z();
+    this->extent_x[index] = EXTENTS.x();
+    this->extent_y[index] = EXTENTS.y();
+    this->extent_z[index] = EXTENTS.z();
+}
+
+auto BoundsArray::Clear() -> void {
+    this->center_x.clear();
+    this->center_y.clear();
+    this->center_z.clear();
+    this->extent_x.clear();
+    this->extent_y.clear();
+    this->extent_z.clear();
+}
+
+namespace {
+
+/// Returns the index of the lowest set bit of the given (non-zero) mask
+auto LowestBitIndex(uint64_t mask) -> size_t {
+#if defined(_MSC_VER)
+    unsigned long index = 0;  // NOLINT
+    _BitScanForward64(&index, mask);
+    return static_cast<size_t>(index);
+#else
+    return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+}
+
+/// Outcome of the culling tests for a single entry
+enum class eCullResult : uint8_t {
+    VISIBLE,
+    FRUSTUM_CULLED,
+    SIZE_CULLED,
+    UNUSED,
+};
+
+/// Culling parameters rearranged for the inner loops
+struct CullingConstants {
+    std::array<float, 6> nx{};
+    std::array<float, 6> ny{};
+    std::array<float, 6> nz{};
+    std::array<float, 6> d{};
+    Vec3 eye;
+    /// Squared projection scale (compared against squared radius)
+    float scale2{1.0F};
+    /// Squared screen size threshold
+    float threshold2{0.0F};
+    /// 1 for perspective (threshold scales with squared distance), else 0
+    float perspective{1.0F};
+    /// Whether or not the screen size test is enabled at all
+    bool test_size{false};
+};
+
+auto MakeConstants(const CullingParams& params) -> CullingConstants {
+    CullingConstants consts;
+    for (size_t p = 0; p < 6; ++p) {
+        const auto& plane = params.frustum.planes[p];
+        consts.nx[p] = plane.normal.x();
+        consts.ny[p] = plane.normal.y();
+        consts.nz[p] = plane.normal.z();
+        consts.d[p] = plane.d;
+    }
+    consts.eye = params.eye;
+    consts.scale2 = params.projection_scale * params.projection_scale;
+    consts.threshold2 = params.min_screen_size * params.min_screen_size;
+    consts.perspective = params.perspective ? 1.0F : 0.0F;
+    consts.test_size = params.min_screen_size > 0.0F;
+    return consts;
+}
+
+auto CullSingle(const CullingConstants& consts, const BoundsArray& bounds,
+                size_t i) -> eCullResult {
+    const float CX = bounds.center_x[i];
+    const float CY = bounds.center_y[i];
+    const float CZ = bounds.center_z[i];
+    const float EX = bounds.extent_x[i];
+    const float EY = bounds.extent_y[i];
+    const float EZ = bounds.extent_z[i];
+    if (EX < 0.0F) {
+        return eCullResult::UNUSED;
+    }
+
+    for (size_t p = 0; p < 6; ++p) {
+        const float DIST =
+            consts.nx[p] * CX + consts.ny[p] * CY + consts.nz[p] * CZ +
+            consts.d[p];
+        const float RADIUS = std::abs(consts.nx[p]) * EX +
+                             std::abs(consts.ny[p]) * EY +
+                             std::abs(consts.nz[p]) * EZ;
+        if (DIST + RADIUS < 0.0F) {
+            return eCullResult::FRUSTUM_CULLED;
+        }
+    }
+
+    if (consts.test_size) {
+        // Projected size of the bounding sphere: r * scale / distance (just
+        // r * scale for orthographic views), compared in squared form
+        const float DX = CX - consts.eye.x();
+        const float DY = CY - consts.eye.y();
+        const float DZ = CZ - consts.eye.z();
+        const float DIST2 = DX * DX + DY * DY + DZ * DZ;
+        const float DEPTH2 =
+            consts.perspective * DIST2 + (1.0F - consts.perspective);
+        const float RADIUS2 = EX * EX + EY * EY + EZ * EZ;
+        if (RADIUS2 * consts.scale2 < consts.threshold2 * DEPTH2) {
+            return eCullResult::SIZE_CULLED;
+        }
+    }
+    return eCullResult::VISIBLE;
+}
+
+/// Culls the entries in [begin, end) one at a time
+auto CullRangeScalar(const CullingConstants& consts, const BoundsArray& bounds,
+                     size_t begin, size_t end, uint8_t* visible,
+                     CullingStats& stats) -> void {
+    for (size_t i = begin; i < end; ++i) {
+        const auto RESULT = CullSingle(consts, bounds, i);
+        visible[i] = (RESULT == eCullResult::VISIBLE) ? 1 : 0;
+        switch (RESULT) {
+            case eCullResult::VISIBLE:
+                stats.num_visible++;
+                break;
+            case eCullResult::FRUSTUM_CULLED:
+                stats.num_frustum_culled++;
+                break;
+            case eCullResult::SIZE_CULLED:
+                stats.num_size_culled++;
+                break;
+            case eCullResult::UNUSED:
+                break;
+        }
+    }
+}
+
+/// Accumulates the per-lane masks of a SIMD batch into the outputs
+auto StoreBatch(uint32_t num_lanes, uint32_t outside_bits, uint32_t small_bits,
+                uint32_t unused_bits, size_t offset, uint8_t* visible,
+                CullingStats& stats) -> void {
+    const uint32_t ALL = (1U << num_lanes) - 1U;
+    const uint32_t VISIBLE_BITS = ~(outside_bits | small_bits) & ALL;
+    for (uint32_t lane = 0; lane < num_lanes; ++lane) {
+        visible[offset + lane] =
+            static_cast<uint8_t>((VISIBLE_BITS >> lane) & 1U);
+    }
+    stats.num_visible += std::bitset<32>(VISIBLE_BITS).count();
+    stats.num_frustum_culled +=
+        std::bitset<32>(outside_bits & ~unused_bits).count();
+    stats.num_size_culled +=
+        std::bitset<32>(small_bits & ~outside_bits & ALL).count();
+}
+
+#if defined(RENDERER_CULLING_AVX2)
+
+/// Culls batches of 8 entries, returns the index of the first unprocessed one
+auto CullRangeSimd(const CullingConstants& consts, const BoundsArray& bounds,
+                   uint8_t* visible, CullingStats& stats) -> size_t {
+    constexpr size_t WIDTH = 8;
+    const auto COUNT = bounds.size();
+    const __m256 ZERO = _mm256_setzero_ps();
+    const __m256 ABS_MASK =
+        _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 EYE_X = _mm256_set1_ps(consts.eye.x());
+    const __m256 EYE_Y = _mm256_set1_ps(consts.eye.y());
+    const __m256 EYE_Z = _mm256_set1_ps(consts.eye.z());
+    const __m256 SCALE2 = _mm256_set1_ps(consts.scale2);
+    const __m256 THRESHOLD2 = _mm256_set1_ps(consts.threshold2);
+    const __m256 PERSPECTIVE = _mm256_set1_ps(consts.perspective);
+    const __m256 ORTHO = _mm256_set1_ps(1.0F - consts.perspective);
+
+    size_t i = 0;
+    for (; i + WIDTH <= COUNT; i += WIDTH) {
+        const __m256 CX = _mm256_loadu_ps(&bounds.center_x[i]);
+        const __m256 CY = _mm256_loadu_ps(&bounds.center_y[i]);
+        const __m256 CZ = _mm256_loadu_ps(&bounds.center_z[i]);
+        const __m256 EX = _mm256_loadu_ps(&bounds.extent_x[i]);
+        const __m256 EY = _mm256_loadu_ps(&bounds.extent_y[i]);
+        const __m256 EZ = _mm256_loadu_ps(&bounds.extent_z[i]);
+
+        __m256 outside = _mm256_cmp_ps(EX, ZERO, _CMP_LT_OQ);
+        const auto UNUSED_BITS =
+            static_cast<uint32_t>(_mm256_movemask_ps(outside));
+        for (size_t p = 0; p < 6; ++p) {
+            const __m256 NX = _mm256_set1_ps(consts.nx[p]);
+            const __m256 NY = _mm256_set1_ps(consts.ny[p]);
+            const __m256 NZ = _mm256_set1_ps(consts.nz[p]);
+            const __m256 DIST = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(NX, CX), _mm256_mul_ps(NY, CY)),
+                _mm256_add_ps(_mm256_mul_ps(NZ, CZ),
+                              _mm256_set1_ps(consts.d[p])));
+            const __m256 RADIUS = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(NX, ABS_MASK), EX),
+                              _mm256_mul_ps(_mm256_and_ps(NY, ABS_MASK), EY)),
+                _mm256_mul_ps(_mm256_and_ps(NZ, ABS_MASK), EZ));
+            outside = _mm256_or_ps(
+                outside,
+                _mm256_cmp_ps(_mm256_add_ps(DIST, RADIUS), ZERO, _CMP_LT_OQ));
+        }
+
+        uint32_t small_bits = 0;
+        if (consts.test_size) {
+            const __m256 DX = _mm256_sub_ps(CX, EYE_X);
+            const __m256 DY = _mm256_sub_ps(CY, EYE_Y);
+            const __m256 DZ = _mm256_sub_ps(CZ, EYE_Z);
+            const __m256 DIST2 = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(DX, DX), _mm256_mul_ps(DY, DY)),
+                _mm256_mul_ps(DZ, DZ));
+            const __m256 DEPTH2 =
+                _mm256_add_ps(_mm256_mul_ps(PERSPECTIVE, DIST2), ORTHO);
+            const __m256 RADIUS2 = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(EX, EX), _mm256_mul_ps(EY, EY)),
+                _mm256_mul_ps(EZ, EZ));
+            small_bits = static_cast<uint32_t>(_mm256_movemask_ps(
+                _mm256_cmp_ps(_mm256_mul_ps(RADIUS2, SCALE2),
+                              _mm256_mul_ps(THRESHOLD2, DEPTH2), _CMP_LT_OQ)));
+        }
+
+        StoreBatch(WIDTH, static_cast<uint32_t>(_mm256_movemask_ps(outside)),
+                   small_bits, UNUSED_BITS, i, visible, stats);
+    }
+    return i;
+}
+
+#elif defined(RENDERER_CULLING_SSE2)
+
+/// Culls batches of 4 entries, returns the index of the first unprocessed one
+auto CullRangeSimd(const CullingConstants& consts, const BoundsArray& bounds,
+                   uint8_t* visible, CullingStats& stats) -> size_t {
+    constexpr size_t WIDTH = 4;
+    const auto COUNT = bounds.size();
+    const __m128 ZERO = _mm_setzero_ps();
+    const __m128 ABS_MASK = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 EYE_X = _mm_set1_ps(consts.eye.x());
+    const __m128 EYE_Y = _mm_set1_ps(consts.eye.y());
+    const __m128 EYE_Z = _mm_set1_ps(consts.eye.z());
+    const __m128 SCALE2 = _mm_set1_ps(consts.scale2);
+    const __m128 THRESHOLD2 = _mm_set1_ps(consts.threshold2);
+    const __m128 PERSPECTIVE = _mm_set1_ps(consts.perspective);
+    const __m128 ORTHO = _mm_set1_ps(1.0F - consts.perspective);
+
+    size_t i = 0;
+    for (; i + WIDTH <= COUNT; i += WIDTH) {
+        const __m128 CX = _mm_loadu_ps(&bounds.center_x[i]);
+        const __m128 CY = _mm_loadu_ps(&bounds.center_y[i]);
+        const __m128 CZ = _mm_loadu_ps(&bounds.center_z[i]);
+        const __m128 EX = _mm_loadu_ps(&bounds.extent_x[i]);
+        const __m128 EY = _mm_loadu_ps(&bounds.extent_y[i]);
+        const __m128 EZ = _mm_loadu_ps(&bounds.extent_z[i]);
+
+        __m128 outside = _mm_cmplt_ps(EX, ZERO);
+        const auto UNUSED_BITS =
+            static_cast<uint32_t>(_mm_movemask_ps(outside));
+        for (size_t p = 0; p < 6; ++p) {
+            const __m128 NX = _mm_set1_ps(consts.nx[p]);
+            const __m128 NY = _mm_set1_ps(consts.ny[p]);
+            const __m128 NZ = _mm_set1_ps(consts.nz[p]);
+            const __m128 DIST = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(NX, CX), _mm_mul_ps(NY, CY)),
+                _mm_add_ps(_mm_mul_ps(NZ, CZ), _mm_set1_ps(consts.d[p])));
+            const __m128 RADIUS = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_and_ps(NX, ABS_MASK), EX),
+                           _mm_mul_ps(_mm_and_ps(NY, ABS_MASK), EY)),
+                _mm_mul_ps(_mm_and_ps(NZ, ABS_MASK), EZ));
+            outside = _mm_or_ps(outside,
+                                _mm_cmplt_ps(_mm_add_ps(DIST, RADIUS), ZERO));
+        }
+
+        uint32_t small_bits = 0;
+        if (consts.test_size) {
+            const __m128 DX = _mm_sub_ps(CX, EYE_X);
+            const __m128 DY = _mm_sub_ps(CY, EYE_Y);
+            const __m128 DZ = _mm_sub_ps(CZ, EYE_Z);
+            const __m128 DIST2 = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(DX, DX), _mm_mul_ps(DY, DY)),
+                _mm_mul_ps(DZ, DZ));
+            const __m128 DEPTH2 =
+                _mm_add_ps(_mm_mul_ps(PERSPECTIVE, DIST2), ORTHO);
+            const __m128 RADIUS2 = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(EX, EX), _mm_mul_ps(EY, EY)),
+                _mm_mul_ps(EZ, EZ));
+            small_bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(
+                _mm_mul_ps(RADIUS2, SCALE2), _mm_mul_ps(THRESHOLD2, DEPTH2))));
+        }
+
+        StoreBatch(WIDTH, static_cast<uint32_t>(_mm_movemask_ps(outside)),
+                   small_bits, UNUSED_BITS, i, visible, stats);
+    }
+    return i;
+}
+
+#else
+
+/// No SIMD support for this target, so everything goes to the scalar path
+auto CullRangeSimd(const CullingConstants& /*consts*/,
+                   const BoundsArray& /*bounds*/, uint8_t* /*visible*/,
+                   CullingStats& /*stats*/) -> size_t {
+    return 0;
+}
+
+#endif
+
+}  // namespace
+
+auto CullBvhMultiView(const BVH& bvh, const CullingParams* views,
+                      size_t num_views, MultiViewVisibility& result) -> void {
+    if (num_views > MAX_CULLING_VIEWS) {
+        LOG_CORE_WARN(
+            "CullBvhMultiView >>> got {0} views, but at most {1} are "
+            "supported. Only the first {1} views are used",
+            num_views, MAX_CULLING_VIEWS);
+        num_views = MAX_CULLING_VIEWS;
+    }
+
+    const auto& nodes = bvh.nodes();
+    const auto& leaves = bvh.leaves();
+    result.masks.assign(leaves.size(), 0);
+    result.num_visible.assign(num_views, 0);
+    result.num_nodes_visited = 0;
+    if (bvh.root() == INVALID_BVH_NODE || num_views == 0) {
+        return;
+    }
+
+    // Each entry carries the views that still have to test the node (those
+    // for which the parent crosses the frustum boundary), and the views that
+    // already contain the whole branch
+    struct Entry {
+        uint32_t node;
+        uint64_t partial;
+        uint64_t inside;
+    };
+    const uint64_t ALL_VIEWS = (num_views == MAX_CULLING_VIEWS)
+                                   ? ~uint64_t{0}
+                                   : (uint64_t{1} << num_views) - 1;
+    std::vector<Entry> stack;
+    stack.push_back({bvh.root(), ALL_VIEWS, 0});
+    while (!stack.empty()) {
+        const auto ENTRY = stack.back();
+        stack.pop_back();
+        const auto& node = nodes[ENTRY.node];
+        result.num_nodes_visited++;
+
+        uint64_t partial = ENTRY.partial;
+        uint64_t inside = ENTRY.inside;
+        for (uint64_t pending = ENTRY.partial; pending != 0;
+             pending &= pending - 1) {
+            const auto VIEW = LowestBitIndex(pending);
+            const auto BIT = uint64_t{1} << VIEW;
+            switch (views[VIEW].frustum.Classify(node.bounds)) {
+                case eFrustumTest::OUTSIDE:
+                    partial &= ~BIT;
+                    break;
+                case eFrustumTest::INSIDE:
+                    partial &= ~BIT;
+                    inside |= BIT;
+                    break;
+                case eFrustumTest::INTERSECTS:
+                    break;
+            }
+        }
+        if ((partial | inside) == 0) {
+            continue;
+        }
+
+        if (!node.is_leaf()) {
+            stack.push_back({node.left, partial, inside});
+            stack.push_back({node.right, partial, inside});
+            continue;
+        }
+
+        const auto& leaf = leaves[node.leaf];
+        if (leaf.object == nullptr || leaf.bounds.empty() ||
+            !leaf.object->visible()) {
+            continue;
+        }
+        const auto LAYERS = leaf.object->layers();
+        uint64_t visible = 0;
+        for (uint64_t candidates = partial | inside; candidates != 0;
+             candidates &= candidates - 1) {
+            const auto VIEW = LowestBitIndex(candidates);
+            const auto& view = views[VIEW];
+            if ((view.culling_mask & LAYERS) != 0 &&
+                view.PassesScreenSize(leaf.bounds)) {
+                visible |= uint64_t{1} << VIEW;
+                result.num_visible[VIEW]++;
+            }
+        }
+        result.masks[node.leaf] = visible;
+    }
+}
+
+auto CullBounds(const CullingParams& params, const BoundsArray& bounds,
+                uint8_t* visible) -> CullingStats {
+    CullingStats stats;
+    const auto CONSTS = MakeConstants(params);
+    const auto TAIL_BEGIN = CullRangeSimd(CONSTS, bounds, visible, stats);
+    CullRangeScalar(CONSTS, bounds, TAIL_BEGIN, bounds.size(), visible, stats);
+    return stats;
+}
+
+auto CullBoundsScalar(const CullingParams& params, const BoundsArray& bounds,
+                      uint8_t* visible) -> CullingStats {
+    CullingStats stats;
+    CullRangeScalar(MakeConstants(params), bounds, 0, bounds.size(), visible,
+                    stats);
+    return stats;
+}
+
+}  // namespace renderer
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/draw_list_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+
+namespace renderer {
+
+auto ComputeDrawSortKey(const Material* material, const Geometry* geometry)
+    -> uint64_t {
+    // | translucent (1) | material (31) | geometry (32) |, where the material
+    // and geometry bits come from their addresses (only their grouping matters)
+    constexpr uint64_t LOW_31_BITS = (1ULL << 31) - 1;
+    constexpr uint64_t LOW_32_BITS = (1ULL << 32) - 1;
+    const bool TRANSLUCENT = (material != nullptr) && material->transparent;
+    const auto MATERIAL_BITS =
+        (reinterpret_cast<uintptr_t>(material) >> 4) & LOW_31_BITS;
+    const auto GEOMETRY_BITS =
+        (reinterpret_cast<uintptr_t>(geometry) >> 4) & LOW_32_BITS;
+    return (static_cast<uint64_t>(TRANSLUCENT ? 1 : 0) << 63) |
+           (MATERIAL_BITS << 32) | GEOMETRY_BITS;
+}
+
+auto DrawList::Sync(const Scene& scene) -> void {
+    const auto& journal = scene.journal();
+    if (m_Scene != &scene || !journal.IsAvailable(m_Sequence)) {
+        Rebuild(scene);
+        return;
+    }
+
+    m_Rebuilt = false;
+    m_DirtySlots.clear();
+    ++m_SyncCount;
+    m_NumChangesApplied = 0;
+    m_Sequence =
+        journal.ForEachSince(m_Sequence, [this](const SceneChange& change) {
+            ++m_NumChangesApplied;
+            if (change.type == eSceneChange::REMOVED) {
+                _Remove(change.id);
+                return;
+            }
+            // Objects destroyed since have their REMOVED entry later on
+            auto object = change.object.lock();
+            if (object == nullptr) {
+                return;
+            }
+            switch (change.type) {
+                case eSceneChange::ADDED:
+                    _Add(object.get());
+                    break;
+                case eSceneChange::POSE_CHANGED:
+                case eSceneChange::MATERIAL_CHANGED:
+                case eSceneChange::VISIBILITY_CHANGED:
+                    _Refresh(object.get());
+                    break;
+                default:
+                    break;
+            }
+        });
+    _SortItems();
+}
+
+auto DrawList::Rebuild(const Scene& scene) -> void {
+    Clear();
+    m_Scene = &scene;
+    m_Rebuilt = true;
+    ++m_SyncCount;
+
+    std::vector<Object3D*> stack;
+    for (const auto& child : scene.children()) {
+        stack.push_back(child.get());
+    }
+    while (!stack.empty()) {
+        auto* object = stack.back();
+        stack.pop_back();
+        _Add(object);
+        for (const auto& child : object->children()) {
+            stack.push_back(child.get());
+        }
+    }
+    m_Sequence = scene.journal().end_sequence();
+    _SortItems();
+}
+
+auto DrawList::Clear() -> void {
+    m_Scene = nullptr;
+    m_Sequence = 0;
+    m_Items.clear();
+    m_SlotItems.clear();
+    m_Object2Slot.clear();
+    m_FreeSlots.clear();
+    m_Transforms.clear();
+    m_DirtySlots.clear();
+    m_SlotDirtyStamp.clear();
+    m_ItemsDirty = false;
+    m_NumChangesApplied = 0;
+    ++m_ItemsVersion;
+}
+
+auto DrawList::_Add(Object3D* object) -> void {
+    if (object->type() != eObjectType::MESH) {
+        return;
+    }
+    auto* mesh = static_cast<Mesh*>(object);
+    if (mesh->geometry() == nullptr) {
+        return;  // added later on, once it has something to draw
+    }
+    if (m_Object2Slot.find(object) != m_Object2Slot.end()) {
+        _Refresh(object);
+        return;
+    }
+
+    uint32_t slot = INVALID_DRAW_SLOT;
+    if (!m_FreeSlots.empty()) {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_SlotItems.size());
+        m_SlotItems.emplace_back();
+        m_SlotDirtyStamp.push_back(0);
+        m_Transforms.resize(m_Transforms.size() + FLOATS_PER_TRANSFORM);
+    }
+    m_Object2Slot[object] = slot;
+
+    auto& item = m_SlotItems[slot];
+    item.object = object;
+    item.geometry = mesh->geometry().get();
+    item.material = mesh->material().get();
+    item.sort_key = ComputeDrawSortKey(item.material, item.geometry);
+    item.slot = slot;
+    _WriteTransform(*object, slot);
+    m_ItemsDirty = true;
+}
+
+auto DrawList::_Remove(const Object3D* object) -> void {
+    auto it_slot = m_Object2Slot.find(object);
+    if (it_slot == m_Object2Slot.end()) {
+        return;
+    }
+    m_SlotItems[it_slot->second] = DrawItem();
+    m_FreeSlots.push_back(it_slot->second);
+    m_Object2Slot.erase(it_slot);
+    m_ItemsDirty = true;
+}
+
+auto DrawList::_Refresh(Object3D* object) -> void {
+    auto it_slot = m_Object2Slot.find(object);
+    if (it_slot == m_Object2Slot.end()) {
+        // Meshes get into the list once they have a geometry, which updates
+        // their bounds (and thus records a pose change)
+        _Add(object);
+        return;
+    }
+
+    auto* mesh = static_cast<Mesh*>(object);
+    if (mesh->geometry() == nullptr) {
+        _Remove(object);
+        return;
+    }
+
+    const auto SLOT = it_slot->second;
+    auto& item = m_SlotItems[SLOT];
+    const auto* geometry = mesh->geometry().get();
+    const auto* material = mesh->material().get();
+    const auto SORT_KEY = ComputeDrawSortKey(material, geometry);
+    if (geometry != item.geometry || material != item.material ||
+        SORT_KEY != item.sort_key) {
+        item.geometry = geometry;
+        item.material = material;
+        item.sort_key = SORT_KEY;
+        m_ItemsDirty = true;
+    }
+    // Material changes rewrite the transform too, to flag the slot as dirty
+    _WriteTransform(*object, SLOT);
+}
+
+auto DrawList::_WriteTransform(const Object3D& object, uint32_t slot) -> void {
+    const auto& transform = object.world_transform();
+    auto* dst = m_Transforms.data() + slot * FLOATS_PER_TRANSFORM;
+    for (uint32_t col = 0; col < 4; ++col) {
+        for (uint32_t row = 0; row < 4; ++row) {
+            dst[4 * col + row] = transform(row, col);
+        }
+    }
+    if (m_SlotDirtyStamp[slot] != m_SyncCount) {
+        m_SlotDirtyStamp[slot] = m_SyncCount;
+        m_DirtySlots.push_back(slot);
+    }
+}
+
+auto DrawList::_SortItems() -> void {
+    if (!m_ItemsDirty) {
+        return;
+    }
+    // Only the frames that add, remove or restate objects pay for the sort.
+    // Pose changes just patch the transforms buffer
+    m_Items.clear();
+    for (const auto& item : m_SlotItems) {
+        if (item.object != nullptr) {
+            m_Items.push_back(item);
+        }
+    }
+    std::sort(m_Items.begin(), m_Items.end(),
+              [](const DrawItem& lhs, const DrawItem& rhs) {
+                  return (lhs.sort_key != rhs.sort_key)
+                             ? (lhs.sort_key < rhs.sort_key)
+                             : (lhs.slot < rhs.slot);
+              });
+    m_ItemsDirty = false;
+    ++m_ItemsVersion;
+}
+
+auto DrawList::ToString() const -> std::string {
+    return fmt::format(
+        "<DrawList\n"
+        "  numItems: {0}\n"
+        "  numSlots: {1}\n"
+        "  numDirtySlots: {2}\n"
+        "  sequence: {3}\n"
+        ">\n",
+        m_Items.size(), m_SlotItems.size(), m_DirtySlots.size(), m_Sequence);
+}
+
+}  // namespace renderer
@@ -55,11 +55,11 @@ auto FpsCameraController::Update(float dt) -> void {
     auto dtotal = dfront + dright;
 
     m_Camera->target = m_Camera->target + dtotal;
-    m_Camera->pose.position = m_Camera->pose.position + dtotal;
+    m_Camera->SetPosition(m_Camera->pose().position + dtotal);
     // Update the orientation (changes in pitch and yaw)
     // TODO(wilbert): implement remaining updates
 
-    LOG_CORE_TRACE("position: {0}", m_Camera->pose.position.toString());
+    LOG_CORE_TRACE("position: {0}", m_Camera->pose().position.toString());
 
     m_Camera->LookAt(m_Camera->target);
 }
@@ -145,7 +145,7 @@ auto FpsCameraController::OnMouseMoveCallback(double x, double y) -> void {
     Euler euler;
     euler.order = ::math::euler::Order::ZXY;
     euler.convention = ::math::euler::Convention::INTRINSIC;
-    euler.setFromQuaternion(m_Camera->pose.orientation);
+    euler.setFromQuaternion(m_Camera->pose().orientation);
 
     euler.x -= dy * 0.002F * this->pointerSpeed;
     euler.y -= dx * 0.002F * this->pointerSpeed;
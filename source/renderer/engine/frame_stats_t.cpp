@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/frame_stats_t.hpp>
+
+namespace renderer {
+
+namespace {
+// Formats the given times as "name: time" pairs, using the names of the enum
+template <typename Enum, size_t N>
+auto TimesToString(const std::array<float, N>& times) -> std::string {
+    std::string str;
+    for (size_t i = 0; i < N; ++i) {
+        str += fmt::format("{0}{1}: {2:.3f}", (i == 0) ? "" : ", ",
+                           ::renderer::ToString(static_cast<Enum>(i)),
+                           times[i]);
+    }
+    return str;
+}
+}  // namespace
+
+auto ToString(eFramePhase phase) -> std::string {
+    switch (phase) {
+        case eFramePhase::SYNC:
+            return "sync";
+        case eFramePhase::CULL:
+            return "cull";
+        case eFramePhase::QUEUE:
+            return "queue";
+        case eFramePhase::BATCH:
+            return "batch";
+        case eFramePhase::SUBMIT:
+            return "submit";
+        case eFramePhase::DEBUG:
+            return "debug";
+        case eFramePhase::SHADOW:
+            return "shadow";
+        case eFramePhase::LIGHTS:
+            return "lights";
+        default:
+            return "undefined";
+    }
+}
+
+auto ToString(eFramePass pass) -> std::string {
+    switch (pass) {
+        case eFramePass::DEPTH_PREPASS:
+            return "depth_prepass";
+        case eFramePass::SCENE:
+            return "scene";
+        case eFramePass::DEBUG:
+            return "debug";
+        case eFramePass::SHADOW:
+            return "shadow";
+        default:
+            return "undefined";
+    }
+}
+
+auto FrameStats::cpu_total_ms() const -> float {
+    return std::accumulate(cpu_time_ms.begin(), cpu_time_ms.end(), 0.0F);
+}
+
+auto FrameStats::gpu_total_ms() const -> float {
+    return std::accumulate(gpu_time_ms.begin(), gpu_time_ms.end(), 0.0F);
+}
+
+auto FrameStats::ToString() const -> std::string {
+    return fmt::format(
+        "<FrameStats\n"
+        "  frameIndex: {0}\n"
+        "  numObjects: {1}\n"
+        "  numVisible: {2}\n"
+        "  numFrustumCulled: {3}\n"
+        "  numSizeCulled: {4}\n"
+        "  numOccluders: {5}\n"
+        "  numOcclusionCulled: {6}\n"
+        "  numDrawItems: {7}\n"
+        "  numChangesApplied: {8}\n"
+        "  numTransformsPatched: {9}\n"
+        "  numDrawCalls: {10}\n"
+        "  numInstances: {11}\n"
+        "  numTriangles: {12}\n"
+        "  numProgramChanges: {13}\n"
+        "  numMaterialChanges: {14}\n"
+        "  numTextureChanges: {15}\n"
+        "  numVaoChanges: {16}\n"
+        "  numStateChanges: {17}\n"
+        "  numElidedStateChanges: {18}\n"
+        "  numBytesUploaded: {19}\n"
+        "  numShadowCasters: {20}\n"
+        "  numShadowLayersRedrawn: {21}\n"
+        "  numClusteredLights: {22}\n"
+        "  numLightAssignments: {23}\n"
+        "  cpuTimeMs: {24}\n"
+        "  gpuTimeMs: {25}\n"
+        "  gpuFrameIndex: {26}\n"
+        ">\n",
+        frame_index, num_objects, num_visible, num_frustum_culled,
+        num_size_culled, num_occluders, num_occlusion_culled, num_draw_items,
+        num_changes_applied, num_transforms_patched, num_draw_calls,
+        num_instances, num_triangles, num_program_changes,
+        num_material_changes, num_texture_changes, num_vao_changes,
+        num_state_changes, num_elided_state_changes, num_bytes_uploaded,
+        num_shadow_casters, num_shadow_layers_redrawn, num_clustered_lights,
+        num_light_assignments,
+        TimesToString<eFramePhase>(cpu_time_ms),
+        TimesToString<eFramePass>(gpu_time_ms), gpu_frame_index);
+}
+
+FrameStatsHistory::FrameStatsHistory(size_t capacity)
+    : m_Capacity(std::max(capacity, size_t{1})) {
+    m_Frames.reserve(m_Capacity);
+}
+
+auto FrameStatsHistory::Push(const FrameStats& stats) -> void {
+    if (m_Frames.size() < m_Capacity) {
+        m_Frames.push_back(stats);
+        return;
+    }
+    // Once full, the oldest frame gets overwritten in place
+    m_Frames[m_Head] = stats;
+    m_Head = (m_Head + 1) % m_Capacity;
+}
+
+auto FrameStatsHistory::Clear() -> void {
+    m_Frames.clear();
+    m_Head = 0;
+}
+
+auto FrameStatsHistory::SetCapacity(size_t capacity) -> void {
+    capacity = std::max(capacity, size_t{1});
+    std::vector<FrameStats> frames;
+    frames.reserve(capacity);
+    const auto NUM_KEPT = std::min(m_Frames.size(), capacity);
+    for (size_t i = m_Frames.size() - NUM_KEPT; i < m_Frames.size(); ++i) {
+        frames.push_back((*this)[i]);
+    }
+    m_Frames = std::move(frames);
+    m_Head = 0;
+    m_Capacity = capacity;
+}
+
+auto FrameStatsHistory::ComputeMeanCpuTime(eFramePhase phase) const -> float {
+    if (m_Frames.empty()) {
+        return 0.0F;
+    }
+    float total = 0.0F;
+    for (const auto& frame : m_Frames) {
+        total += frame.cpu_time(phase);
+    }
+    return total / static_cast<float>(m_Frames.size());
+}
+
+auto FrameStatsHistory::ComputeMeanGpuTime(eFramePass pass) const -> float {
+    float total = 0.0F;
+    size_t num_timed = 0;
+    for (const auto& frame : m_Frames) {
+        if (frame.gpu_frame_index != 0) {
+            total += frame.gpu_time(pass);
+            ++num_timed;
+        }
+    }
+    return (num_timed > 0) ? total / static_cast<float>(num_timed) : 0.0F;
+}
+
+auto FrameStatsHistory::ComputeMeanCpuTotal() const -> float {
+    if (m_Frames.empty()) {
+        return 0.0F;
+    }
+    float total = 0.0F;
+    for (const auto& frame : m_Frames) {
+        total += frame.cpu_total_ms();
+    }
+    return total / static_cast<float>(m_Frames.size());
+}
+
+auto FrameStatsHistory::ComputeMaxCpuTotal() const -> float {
+    float max_total = 0.0F;
+    for (const auto& frame : m_Frames) {
+        max_total = std::max(max_total, frame.cpu_total_ms());
+    }
+    return max_total;
+}
+
+auto FrameStatsHistory::operator[](size_t index) const -> const FrameStats& {
+    if (index >= m_Frames.size()) {
+        throw std::out_of_range(fmt::format(
+            "FrameStatsHistory >>> index {0} out of range [0, {1})", index,
+            m_Frames.size()));
+    }
+    return m_Frames[(m_Head + index) % m_Frames.size()];
+}
+
+auto FrameStatsHistory::latest() const -> const FrameStats& {
+    return (*this)[m_Frames.size() - 1];
+}
+
+auto FrameStatsHistory::ToString() const -> std::string {
+    return fmt::format(
+        "<FrameStatsHistory\n"
+        "  size: {0}\n"
+        "  capacity: {1}\n"
+        "  meanCpuTotalMs: {2:.3f}\n"
+        "  maxCpuTotalMs: {3:.3f}\n"
+        ">\n",
+        m_Frames.size(), m_Capacity, ComputeMeanCpuTotal(),
+        ComputeMaxCpuTotal());
+}
+
+}  // namespace renderer
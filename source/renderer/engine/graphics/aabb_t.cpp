@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/graphics/aabb_t.hpp>
+
+namespace renderer {
+
+auto AABB::Transformed(const Mat4& transform) const -> AABB {
+    if (empty()) {
+        return {};
+    }
+    // Each axis of the new box accumulates the min/max contribution of every
+    // column of the rotation-scale part, starting from the translation
+    Vec3 new_min(transform(0, 3), transform(1, 3), transform(2, 3));
+    Vec3 new_max = new_min;
+    for (uint32_t row = 0; row < 3; ++row) {
+        for (uint32_t col = 0; col < 3; ++col) {
+            const float EA = transform(row, col) * min[col];
+            const float EB = transform(row, col) * max[col];
+            new_min[row] += std::min(EA, EB);
+            new_max[row] += std::max(EA, EB);
+        }
+    }
+    return {new_min, new_max};
+}
+
+auto AABB::ToString() const -> std::string {
+    return fmt::format(
+        "<AABB\n"
+        "  min: {0}\n"
+        "  max: {1}\n"
+        ">\n",
+        min.toString(), max.toString());
+}
+
+}  // namespace renderer
@@ -227,6 +227,22 @@ auto ToString(eObjectType type) -> std::string {
     }
 }
 
+auto ToString(eSceneChange change) -> std::string {
+    switch (change) {
+        case eSceneChange::ADDED:
+            return "added";
+        case eSceneChange::REMOVED:
+            return "removed";
+        case eSceneChange::POSE_CHANGED:
+            return "pose_changed";
+        case eSceneChange::MATERIAL_CHANGED:
+            return "material_changed";
+        case eSceneChange::VISIBILITY_CHANGED:
+            return "visibility_changed";
+    }
+    return "undefined";
+}
+
 auto ToString(eCameraController controller_type) -> std::string {
     switch (controller_type) {
         case eCameraController::NONE:
@@ -18,6 +18,7 @@ Geometry::Geometry(size_t n_vertices, const float32_t* v_positions,
                  v_normals, true);
     AddAttribute("texcoord", ::renderer::eElementType::FLOAT_2, m_NumVertices,
                  v_texcoords, false);
+    ComputeBounds();
 }
 
 Geometry::Geometry(size_t n_vertices, const float32_t* v_positions,
@@ -31,6 +32,7 @@ Geometry::Geometry(size_t n_vertices, const float32_t* v_positions,
     AddAttribute("texcoord", ::renderer::eElementType::FLOAT_2, m_NumVertices,
                  v_texcoords, false);
     SetIndices(n_indices, indices);
+    ComputeBounds();
 }
 
 auto Geometry::AddAttribute(std::string attrib_name, eElementType attrib_type,
@@ -72,6 +74,74 @@ auto Geometry::SetIndices(size_t n_indices, const uint32_t* data) -> void {
     this->indices = std::make_unique<Uint32BufferAttribute>(n_indices, data);
 }
 
+auto Geometry::AddLod(size_t n_indices, const uint32_t* data,
+                      float32_t error) -> void {
+    if (data == nullptr || n_indices == 0 || n_indices % 3 != 0) {
+        LOG_CORE_WARN(
+            "Geometry::AddLod >>> a level of detail must be a non-empty list "
+            "of triangles, got {0} indices",
+            n_indices);
+        return;
+    }
+    if (error < lod_error(m_Lods.size())) {
+        LOG_CORE_WARN(
+            "Geometry::AddLod >>> levels must be added from finest to "
+            "coarsest, but error {0} is below the one of the last level {1}",
+            error, lod_error(m_Lods.size()));
+        return;
+    }
+    for (size_t i = 0; i < n_indices; ++i) {
+        if (data[i] >= m_NumVertices) {
+            LOG_CORE_WARN(
+                "Geometry::AddLod >>> index {0} out of range, the geometry "
+                "has {1} vertices",
+                data[i], m_NumVertices);
+            return;
+        }
+    }
+    m_Lods.push_back({m_LodIndices.size(), n_indices, error});
+    m_LodIndices.insert(m_LodIndices.end(), data, data + n_indices);
+    ++m_LodVersion;
+}
+
+auto Geometry::ClearLods() -> void {
+    if (m_Lods.empty()) {
+        return;
+    }
+    m_Lods.clear();
+    m_LodIndices.clear();
+    ++m_LodVersion;
+}
+
+auto Geometry::ComputeBounds() -> void {
+    {
+        std::lock_guard<std::mutex> lock(m_TriangleBvhMutex);
+        m_TriangleBvh = nullptr;
+        m_TriangleBvhReady = false;
+    }
+
+    m_Bounds = AABB();
+    if (!HasAttribute("position")) {
+        return;
+    }
+    const auto* data = this->attributes.at("position")->data();
+    for (size_t i = 0; i < m_NumVertices; ++i) {
+        m_Bounds.Expand(
+            Vec3(data[3 * i + 0], data[3 * i + 1], data[3 * i + 2]));
+    }
+}
+
+auto Geometry::triangle_bvh() const -> const TriangleBVH& {
+    if (!m_TriangleBvhReady.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_TriangleBvhMutex);
+        if (m_TriangleBvh == nullptr) {
+            m_TriangleBvh = std::make_unique<TriangleBVH>(*this);
+            m_TriangleBvhReady.store(true, std::memory_order_release);
+        }
+    }
+    return *m_TriangleBvh;
+}
+
 auto Geometry::HasAttribute(const std::string& name) const -> bool {
     return this->attributes.find(name) != this->attributes.end();
 }
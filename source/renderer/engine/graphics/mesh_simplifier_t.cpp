@@ -0,0 +1,603 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/graphics/mesh_simplifier_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace renderer {
+
+namespace {
+/// Number of floats of the attributes compared by the collapses (normal, UV)
+constexpr size_t NUM_ATTRIBUTES = 3 + 2;
+
+/// Weight of the planes that keep the open borders in place, when unlocked
+constexpr double BORDER_WEIGHT = 10.0;
+
+/// Smallest cosine between the normals of a triangle before and after a
+/// collapse, such that triangles don't fold over their neighbors
+constexpr double MIN_FLIP_COSINE = 0.25;
+
+using Vec3d = std::array<double, 3>;
+
+auto Sub(const Vec3d& a, const Vec3d& b) -> Vec3d {
+    return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+auto Cross(const Vec3d& a, const Vec3d& b) -> Vec3d {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+            a[0] * b[1] - a[1] * b[0]};
+}
+
+auto Dot(const Vec3d& a, const Vec3d& b) -> double {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Symmetric 4x4 matrix of a quadric error, stored as its 10 unique entries
+struct Quadric {
+    std::array<double, 10> m{};
+
+    // Adds the squared distance to the plane dot(n, p) + d = 0 (unit normal)
+    auto AddPlane(const Vec3d& n, double d, double weight) -> void {
+        const std::array<double, 4> PLANE = {n[0], n[1], n[2], d};
+        size_t k = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = i; j < 4; ++j) {
+                m[k++] += weight * PLANE[i] * PLANE[j];
+            }
+        }
+    }
+
+    auto Add(const Quadric& other) -> void {
+        for (size_t k = 0; k < m.size(); ++k) {
+            m[k] += other.m[k];
+        }
+    }
+
+    // Evaluates (p, 1)^T Q (p, 1)
+    RENDERER_NODISCARD auto Error(const Vec3d& p) const -> double {
+        const std::array<double, 4> V = {p[0], p[1], p[2], 1.0};
+        double error = 0.0;
+        size_t k = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = i; j < 4; ++j) {
+                error += ((i == j) ? 1.0 : 2.0) * m[k++] * V[i] * V[j];
+            }
+        }
+        return std::max(error, 0.0);
+    }
+};
+
+// Bits of a position, used to weld the vertices at the same place
+struct PositionKey {
+    std::array<uint32_t, 3> bits{};
+
+    auto operator==(const PositionKey& other) const -> bool {
+        return bits == other.bits;
+    }
+};
+
+struct PositionKeyHash {
+    auto operator()(const PositionKey& key) const -> size_t {
+        return (static_cast<size_t>(key.bits[0]) * 73856093U) ^
+               (static_cast<size_t>(key.bits[1]) * 19349663U) ^
+               (static_cast<size_t>(key.bits[2]) * 83492791U);
+    }
+};
+
+// Collapse of all the vertices at a position into the ones at another
+struct Collapse {
+    double cost{0.0};
+    uint32_t from{0};
+    uint32_t to{0};
+
+    // Ties are broken by the ids, so runs are deterministic
+    auto operator>(const Collapse& other) const -> bool {
+        if (cost != other.cost) {
+            return cost > other.cost;
+        }
+        return (from != other.from) ? (from > other.from) : (to > other.to);
+    }
+};
+
+// Edge-collapse simplification of the triangles of a geometry. Collapses work
+// on welded positions ("groups"), while the triangles keep referencing the
+// vertices of the geometry ("wedges"), so seams of the attributes survive
+class Simplifier {
+ public:
+    Simplifier(const Geometry& geometry, const SimplifyOptions& options)
+        : m_Options(options) {
+        if (!geometry.HasAttribute("position")) {
+            return;
+        }
+        const auto NUM_VERTICES = geometry.num_vertices();
+        const auto& bounds = geometry.bounds();
+        const auto SIZE = bounds.max - bounds.min;
+        m_Scale = std::max({static_cast<double>(SIZE.x()),
+                            static_cast<double>(SIZE.y()),
+                            static_cast<double>(SIZE.z())});
+        if (!(m_Scale > 0.0)) {
+            m_Scale = 1.0;
+        }
+        _Weld(geometry);
+        _ReadAttributes(geometry);
+
+        const bool INDEXED = (geometry.indices != nullptr);
+        const auto NUM_INDICES =
+            INDEXED ? geometry.indices->num_indices() : NUM_VERTICES;
+        for (size_t i = 0; i + 2 < NUM_INDICES; i += 3) {
+            std::array<uint32_t, 3> tri = {static_cast<uint32_t>(i),
+                                           static_cast<uint32_t>(i + 1),
+                                           static_cast<uint32_t>(i + 2)};
+            if (INDEXED) {
+                const auto* indices = geometry.indices->data() + i;
+                tri = {indices[0], indices[1], indices[2]};
+            }
+            if (tri[0] >= NUM_VERTICES || tri[1] >= NUM_VERTICES ||
+                tri[2] >= NUM_VERTICES) {
+                continue;
+            }
+            const auto G0 = m_VertexGroups[tri[0]];
+            const auto G1 = m_VertexGroups[tri[1]];
+            const auto G2 = m_VertexGroups[tri[2]];
+            if (G0 == G1 || G1 == G2 || G0 == G2) {
+                continue;  // degenerate
+            }
+            m_Triangles.push_back(tri);
+        }
+        m_NumInput = m_Triangles.size();
+        m_NumLive = m_Triangles.size();
+        m_TriangleAlive.assign(m_Triangles.size(), 1);
+        _ComputeQuadrics();
+        _ClassifyEdges();
+
+        for (uint32_t group = 0; group < m_GroupPositions.size(); ++group) {
+            _PushCollapses(group, false);
+        }
+    }
+
+    // Collapses edges until at most the given number of triangles are left,
+    // or no collapse is possible under the largest error
+    auto Run(size_t target) -> void {
+        const double MAX_COST =
+            static_cast<double>(m_Options.max_error) * m_Options.max_error;
+        while (m_NumLive > target && !m_Heap.empty()) {
+            const auto TOP = m_Heap.top();
+            m_Heap.pop();
+            if (m_GroupAlive[TOP.from] == 0 || m_GroupAlive[TOP.to] == 0) {
+                continue;
+            }
+            // Costs change as the quadrics get merged, so entries that got
+            // more expensive since queued are pushed back instead of applied
+            const double GEOMETRIC = _GeometricCost(TOP.from, TOP.to);
+            const double COST = GEOMETRIC + m_Options.attribute_weight *
+                                                _AttributeCost(TOP.from,
+                                                               TOP.to);
+            if (COST > TOP.cost * (1.0 + 1e-9) + 1e-18) {
+                m_Heap.push({COST, TOP.from, TOP.to});
+                continue;
+            }
+            if (GEOMETRIC > MAX_COST || !_IsValid(TOP.from, TOP.to)) {
+                continue;
+            }
+            _Apply(TOP.from, TOP.to);
+            m_MaxCost = std::max(m_MaxCost, GEOMETRIC);
+        }
+    }
+
+    // Returns the indices of the triangles left
+    RENDERER_NODISCARD auto indices() const -> std::vector<uint32_t> {
+        std::vector<uint32_t> indices;
+        indices.reserve(3 * m_NumLive);
+        for (size_t t = 0; t < m_Triangles.size(); ++t) {
+            if (m_TriangleAlive[t] != 0) {
+                indices.insert(indices.end(), m_Triangles[t].begin(),
+                               m_Triangles[t].end());
+            }
+        }
+        return indices;
+    }
+
+    // Returns the largest geometric error so far, in the units of the input
+    RENDERER_NODISCARD auto error() const -> float {
+        return static_cast<float>(std::sqrt(m_MaxCost) * m_Scale);
+    }
+
+    RENDERER_NODISCARD auto num_input() const -> size_t { return m_NumInput; }
+
+    RENDERER_NODISCARD auto num_live() const -> size_t { return m_NumLive; }
+
+ private:
+    // Welds the vertices with the same positions, normalized by the size of
+    // the geometry so costs don't depend on its units
+    auto _Weld(const Geometry& geometry) -> void {
+        const auto* positions = geometry.GetAttribute("position").data();
+        const auto& origin = geometry.bounds().min;
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> groups;
+        m_VertexGroups.resize(geometry.num_vertices());
+        for (size_t v = 0; v < geometry.num_vertices(); ++v) {
+            PositionKey key;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                // Adding zero turns -0 into +0, which compare equal
+                const float VALUE = positions[3 * v + axis] + 0.0F;
+                std::memcpy(&key.bits[axis], &VALUE, sizeof(float));
+            }
+            const auto RESULT = groups.try_emplace(
+                key, static_cast<uint32_t>(m_GroupPositions.size()));
+            if (RESULT.second) {
+                m_GroupPositions.push_back(
+                    {(positions[3 * v + 0] - origin.x()) / m_Scale,
+                     (positions[3 * v + 1] - origin.y()) / m_Scale,
+                     (positions[3 * v + 2] - origin.z()) / m_Scale});
+                m_GroupWedges.emplace_back();
+            }
+            m_VertexGroups[v] = RESULT.first->second;
+            m_GroupWedges[RESULT.first->second].push_back(
+                static_cast<uint32_t>(v));
+        }
+        const auto NUM_GROUPS = m_GroupPositions.size();
+        m_GroupTriangles.resize(NUM_GROUPS);
+        m_Quadrics.resize(NUM_GROUPS);
+        m_Weights.assign(NUM_GROUPS, 0.0);
+        m_Locked.assign(NUM_GROUPS, 0);
+        m_GroupAlive.assign(NUM_GROUPS, 1);
+    }
+
+    // Reads the attributes compared by the collapses (zeros if missing)
+    auto _ReadAttributes(const Geometry& geometry) -> void {
+        m_Attributes.assign(geometry.num_vertices() * NUM_ATTRIBUTES, 0.0F);
+        size_t offset = 0;
+        for (const auto& attrib : {std::make_pair("normal", size_t{3}),
+                                   std::make_pair("texcoord", size_t{2})}) {
+            if (geometry.HasAttribute(attrib.first)) {
+                const auto* data = geometry.GetAttribute(attrib.first).data();
+                for (size_t v = 0; v < geometry.num_vertices(); ++v) {
+                    std::copy(data + v * attrib.second,
+                              data + (v + 1) * attrib.second,
+                              m_Attributes.data() + v * NUM_ATTRIBUTES +
+                                  offset);
+                }
+            }
+            offset += attrib.second;
+        }
+    }
+
+    // Accumulates the planes of the triangles (weighted by their area) into
+    // the quadrics of their corners
+    auto _ComputeQuadrics() -> void {
+        for (uint32_t t = 0; t < m_Triangles.size(); ++t) {
+            const auto GROUPS = _Groups(t);
+            const auto NORMAL = _Normal(GROUPS);
+            const double LENGTH = std::sqrt(Dot(NORMAL, NORMAL));
+            for (const auto GROUP : GROUPS) {
+                m_GroupTriangles[GROUP].push_back(t);
+            }
+            if (LENGTH <= 0.0) {
+                continue;
+            }
+            const Vec3d UNIT = {NORMAL[0] / LENGTH, NORMAL[1] / LENGTH,
+                                NORMAL[2] / LENGTH};
+            const double D = -Dot(UNIT, m_GroupPositions[GROUPS[0]]);
+            const double AREA = 0.5 * LENGTH;
+            for (const auto GROUP : GROUPS) {
+                m_Quadrics[GROUP].AddPlane(UNIT, D, AREA);
+                m_Weights[GROUP] += AREA;
+            }
+        }
+    }
+
+    // Finds the open borders and the non-manifold edges. Borders get locked
+    // or constrained by planes through them, and non-manifold edges locked
+    auto _ClassifyEdges() -> void {
+        struct EdgeUse {
+            uint32_t count{0};
+            uint32_t triangle{0};
+        };
+        std::unordered_map<uint64_t, EdgeUse> edges;
+        for (uint32_t t = 0; t < m_Triangles.size(); ++t) {
+            const auto GROUPS = _Groups(t);
+            for (size_t e = 0; e < 3; ++e) {
+                const auto A = GROUPS[e];
+                const auto B = GROUPS[(e + 1) % 3];
+                const auto KEY = (static_cast<uint64_t>(std::min(A, B)) << 32) |
+                                 std::max(A, B);
+                auto& use = edges[KEY];
+                ++use.count;
+                use.triangle = t;
+            }
+        }
+        for (const auto& entry : edges) {
+            const auto A = static_cast<uint32_t>(entry.first >> 32);
+            const auto B = static_cast<uint32_t>(entry.first & 0xFFFFFFFF);
+            const auto& use = entry.second;
+            if (use.count > 2 || (use.count == 1 && m_Options.lock_borders)) {
+                m_Locked[A] = 1;
+                m_Locked[B] = 1;
+            } else if (use.count == 1) {
+                const auto EDGE =
+                    Sub(m_GroupPositions[B], m_GroupPositions[A]);
+                const auto NORMAL = Cross(EDGE, _Normal(_Groups(use.triangle)));
+                const double LENGTH = std::sqrt(Dot(NORMAL, NORMAL));
+                if (LENGTH <= 0.0) {
+                    continue;
+                }
+                const Vec3d UNIT = {NORMAL[0] / LENGTH, NORMAL[1] / LENGTH,
+                                    NORMAL[2] / LENGTH};
+                const double D = -Dot(UNIT, m_GroupPositions[A]);
+                const double WEIGHT = BORDER_WEIGHT * Dot(EDGE, EDGE);
+                m_Quadrics[A].AddPlane(UNIT, D, WEIGHT);
+                m_Quadrics[B].AddPlane(UNIT, D, WEIGHT);
+            }
+        }
+    }
+
+    RENDERER_NODISCARD auto _Groups(uint32_t triangle) const
+        -> std::array<uint32_t, 3> {
+        const auto& tri = m_Triangles[triangle];
+        return {m_VertexGroups[tri[0]], m_VertexGroups[tri[1]],
+                m_VertexGroups[tri[2]]};
+    }
+
+    // Normal (scaled by twice the area) of the triangle at the given groups
+    RENDERER_NODISCARD auto _Normal(const std::array<uint32_t, 3>& groups) const
+        -> Vec3d {
+        const auto& p0 = m_GroupPositions[groups[0]];
+        return Cross(Sub(m_GroupPositions[groups[1]], p0),
+                     Sub(m_GroupPositions[groups[2]], p0));
+    }
+
+    // Mean squared distance from the target of the collapse to the planes of
+    // both groups
+    RENDERER_NODISCARD auto _GeometricCost(uint32_t from, uint32_t to) const
+        -> double {
+        const double WEIGHT = m_Weights[from] + m_Weights[to];
+        const auto& target = m_GroupPositions[to];
+        const double ERROR =
+            m_Quadrics[from].Error(target) + m_Quadrics[to].Error(target);
+        return (WEIGHT > 0.0) ? ERROR / WEIGHT : ERROR;
+    }
+
+    // Squared differences of the attributes of the wedges of the source and
+    // the ones they get replaced by
+    RENDERER_NODISCARD auto _AttributeCost(uint32_t from, uint32_t to) const
+        -> double {
+        double cost = 0.0;
+        for (const auto WEDGE : m_GroupWedges[from]) {
+            cost += _Distance2(WEDGE, _ClosestWedge(WEDGE, to));
+        }
+        return cost;
+    }
+
+    RENDERER_NODISCARD auto _Distance2(uint32_t a, uint32_t b) const
+        -> double {
+        double dist2 = 0.0;
+        for (size_t i = 0; i < NUM_ATTRIBUTES; ++i) {
+            const double DELTA =
+                static_cast<double>(m_Attributes[a * NUM_ATTRIBUTES + i]) -
+                m_Attributes[b * NUM_ATTRIBUTES + i];
+            dist2 += DELTA * DELTA;
+        }
+        return dist2;
+    }
+
+    // Wedge of the given group with the attributes closest to the given one
+    RENDERER_NODISCARD auto _ClosestWedge(uint32_t wedge, uint32_t group) const
+        -> uint32_t {
+        const auto& wedges = m_GroupWedges[group];
+        uint32_t closest = wedges.front();
+        double closest_dist2 = _Distance2(wedge, closest);
+        for (size_t i = 1; i < wedges.size(); ++i) {
+            const double DIST2 = _Distance2(wedge, wedges[i]);
+            if (DIST2 < closest_dist2) {
+                closest = wedges[i];
+                closest_dist2 = DIST2;
+            }
+        }
+        return closest;
+    }
+
+    // Whether the edge is still there, and collapsing it doesn't fold any of
+    // the triangles around the source
+    RENDERER_NODISCARD auto _IsValid(uint32_t from, uint32_t to) const
+        -> bool {
+        bool connected = false;
+        for (const auto T : m_GroupTriangles[from]) {
+            if (m_TriangleAlive[T] == 0) {
+                continue;
+            }
+            auto groups = _Groups(T);
+            if (std::find(groups.begin(), groups.end(), to) != groups.end()) {
+                connected = true;
+                continue;  // removed by the collapse
+            }
+            const auto BEFORE = _Normal(groups);
+            std::replace(groups.begin(), groups.end(), from, to);
+            const auto AFTER = _Normal(groups);
+            const double LENGTHS =
+                std::sqrt(Dot(BEFORE, BEFORE) * Dot(AFTER, AFTER));
+            if (LENGTHS <= 0.0 ||
+                Dot(BEFORE, AFTER) < MIN_FLIP_COSINE * LENGTHS) {
+                return false;
+            }
+        }
+        return connected;
+    }
+
+    auto _Apply(uint32_t from, uint32_t to) -> void {
+        auto& targets = m_GroupTriangles[to];
+        for (const auto T : m_GroupTriangles[from]) {
+            if (m_TriangleAlive[T] == 0) {
+                continue;
+            }
+            const auto GROUPS = _Groups(T);
+            if (std::find(GROUPS.begin(), GROUPS.end(), to) != GROUPS.end()) {
+                m_TriangleAlive[T] = 0;
+                --m_NumLive;
+                continue;
+            }
+            for (auto& wedge : m_Triangles[T]) {
+                if (m_VertexGroups[wedge] == from) {
+                    wedge = _ClosestWedge(wedge, to);
+                }
+            }
+            targets.push_back(T);
+        }
+        targets.erase(std::remove_if(targets.begin(), targets.end(),
+                                     [this](uint32_t t) {
+                                         return m_TriangleAlive[t] == 0;
+                                     }),
+                      targets.end());
+        m_GroupTriangles[from].clear();
+        m_Quadrics[to].Add(m_Quadrics[from]);
+        m_Weights[to] += m_Weights[from];
+        m_GroupAlive[from] = 0;
+        _PushCollapses(to, true);
+    }
+
+    // Queues the collapses of the edges around the given group, out of it
+    // and (if requested) into it
+    auto _PushCollapses(uint32_t group, bool both_ways) -> void {
+        for (const auto T : m_GroupTriangles[group]) {
+            if (m_TriangleAlive[T] == 0) {
+                continue;
+            }
+            for (const auto OTHER : _Groups(T)) {
+                if (OTHER == group) {
+                    continue;
+                }
+                if (m_Locked[group] == 0) {
+                    _Push(group, OTHER);
+                }
+                if (both_ways && m_Locked[OTHER] == 0) {
+                    _Push(OTHER, group);
+                }
+            }
+        }
+    }
+
+    auto _Push(uint32_t from, uint32_t to) -> void {
+        const double COST =
+            _GeometricCost(from, to) +
+            m_Options.attribute_weight * _AttributeCost(from, to);
+        m_Heap.push({COST, from, to});
+    }
+
+ private:
+    const SimplifyOptions& m_Options;
+
+    /// Size of the geometry, which the positions are normalized by
+    double m_Scale{1.0};
+
+    /// Group (welded position) of each vertex of the geometry
+    std::vector<uint32_t> m_VertexGroups;
+
+    /// Normalized position of each group
+    std::vector<Vec3d> m_GroupPositions;
+
+    /// Vertices of the geometry at each group
+    std::vector<std::vector<uint32_t>> m_GroupWedges;
+
+    /// Triangles around each group (including removed ones, until compacted)
+    std::vector<std::vector<uint32_t>> m_GroupTriangles;
+
+    /// Quadric and total weight of the planes of each group
+    std::vector<Quadric> m_Quadrics;
+    std::vector<double> m_Weights;
+
+    /// Whether each group is locked in place, or still alive
+    std::vector<uint8_t> m_Locked;
+    std::vector<uint8_t> m_GroupAlive;
+
+    /// Attributes of each vertex of the geometry (NUM_ATTRIBUTES each)
+    std::vector<float> m_Attributes;
+
+    /// Triangles (vertices of the geometry), and whether each is still alive
+    std::vector<std::array<uint32_t, 3>> m_Triangles;
+    std::vector<uint8_t> m_TriangleAlive;
+
+    /// Number of triangles of the input, and of the ones still alive
+    size_t m_NumInput{0};
+    size_t m_NumLive{0};
+
+    /// Candidate collapses, cheapest first
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>>
+        m_Heap;
+
+    /// Largest geometric cost of the collapses applied so far
+    double m_MaxCost{0.0};
+};
+}  // namespace
+
+auto SimplifyOptions::ToString() const -> std::string {
+    std::string ratios_str;
+    for (size_t i = 0; i < this->ratios.size(); ++i) {
+        ratios_str +=
+            fmt::format("{0}{1}", (i == 0) ? "" : ", ", this->ratios[i]);
+    }
+    return fmt::format(
+        "<SimplifyOptions\n"
+        "  ratios: [{0}]\n"
+        "  attributeWeight: {1}\n"
+        "  lockBorders: {2}\n"
+        "  maxError: {3}\n"
+        ">\n",
+        ratios_str, this->attribute_weight,
+        this->lock_borders, this->max_error);
+}
+
+auto SimplifyGeometry(const Geometry& geometry, const SimplifyOptions& options)
+    -> std::vector<SimplifiedLod> {
+    std::vector<SimplifiedLod> lods;
+    Simplifier simplifier(geometry, options);
+    auto num_triangles = simplifier.num_input();
+    for (const auto RATIO : options.ratios) {
+        const auto TARGET = static_cast<size_t>(
+            std::max(0.0F, RATIO) * static_cast<float>(simplifier.num_input()));
+        simplifier.Run(TARGET);
+        if (simplifier.num_live() == 0 ||
+            simplifier.num_live() >= num_triangles) {
+            continue;  // no coarser than the previous level
+        }
+        num_triangles = simplifier.num_live();
+        lods.push_back({simplifier.indices(), simplifier.error()});
+    }
+    return lods;
+}
+
+auto GenerateLods(Geometry& geometry, const SimplifyOptions& options)
+    -> size_t {
+    const auto LODS = SimplifyGeometry(geometry, options);
+    geometry.ClearLods();
+    for (const auto& lod : LODS) {
+        geometry.AddLod(lod.indices.size(), lod.indices.data(), lod.error);
+    }
+    return geometry.num_lods() - 1;
+}
+
+auto GenerateLods(const std::vector<Geometry::ptr>& geometries,
+                  const SimplifyOptions& options, ThreadPool* pool) -> void {
+    auto simplify = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (geometries[i] != nullptr) {
+                GenerateLods(*geometries[i], options);
+            }
+        }
+    };
+    if (pool == nullptr) {
+        simplify(0, geometries.size());
+        return;
+    }
+    // Meshes vary a lot in size, so each one is its own task
+    pool->ParallelFor(geometries.size(), 1, simplify);
+}
+
+}  // namespace renderer
@@ -0,0 +1,22 @@
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/graphics/ray_t.hpp>
+#include <renderer/engine/object_t.hpp>
+
+namespace renderer {
+
+auto RaycastHit::ToString() const -> std::string {
+    return fmt::format(
+        "<RaycastHit\n"
+        "  object: {0}\n"
+        "  distance: {1}\n"
+        "  triangle: {2}\n"
+        "  point: {3}\n"
+        ">\n",
+        (object != nullptr ? object->name() : "None"), distance, triangle,
+        point.toString());
+}
+
+}  // namespace renderer
@@ -0,0 +1,75 @@
+#include <array>
+#include <cstring>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/graphics/std140_writer_t.hpp>
+
+namespace renderer {
+
+auto Std140Writer::Clear() -> void { m_Data.clear(); }
+
+auto Std140Writer::Write(float32_t value) -> uint32_t {
+    return _Append(sizeof(float32_t), &value, sizeof(float32_t));
+}
+
+auto Std140Writer::Write(int32_t value) -> uint32_t {
+    return _Append(sizeof(int32_t), &value, sizeof(int32_t));
+}
+
+auto Std140Writer::Write(const Vec2& value) -> uint32_t {
+    const std::array<float32_t, 2> VALUES = {value.x(), value.y()};
+    return _Append(2 * sizeof(float32_t), VALUES.data(),
+                   2 * sizeof(float32_t));
+}
+
+auto Std140Writer::Write(const Vec3& value) -> uint32_t {
+    const std::array<float32_t, 3> VALUES = {value.x(), value.y(), value.z()};
+    return _Append(STD140_VEC4_ALIGNMENT, VALUES.data(),
+                   3 * sizeof(float32_t));
+}
+
+auto Std140Writer::Write(const Vec4& value) -> uint32_t {
+    const std::array<float32_t, 4> VALUES = {value.x(), value.y(), value.z(),
+                                             value.w()};
+    return _Append(STD140_VEC4_ALIGNMENT, VALUES.data(),
+                   4 * sizeof(float32_t));
+}
+
+auto Std140Writer::Write(const Mat4& value) -> uint32_t {
+    // The storage of the matrix is column-major already
+    return _Append(STD140_VEC4_ALIGNMENT, value.data(),
+                   16 * sizeof(float32_t));
+}
+
+auto Std140Writer::BeginStruct() -> uint32_t {
+    return Align(STD140_VEC4_ALIGNMENT);
+}
+
+auto Std140Writer::EndStruct() -> void { Align(STD140_VEC4_ALIGNMENT); }
+
+auto Std140Writer::Align(uint32_t alignment) -> uint32_t {
+    const auto SIZE = static_cast<uint32_t>(m_Data.size());
+    const auto ALIGNED = (SIZE + alignment - 1) / alignment * alignment;
+    m_Data.resize(ALIGNED, 0);
+    return ALIGNED;
+}
+
+auto Std140Writer::_Append(uint32_t alignment, const void* bytes,
+                           uint32_t num_bytes) -> uint32_t {
+    const auto OFFSET = Align(alignment);
+    m_Data.resize(OFFSET + num_bytes);
+    std::memcpy(m_Data.data() + OFFSET, bytes, num_bytes);
+    return OFFSET;
+}
+
+auto Std140Writer::ToString() const -> std::string {
+    return fmt::format(
+        "<Std140Writer\n"
+        "  size: {0}\n"
+        ">\n",
+        m_Data.size());
+}
+
+}  // namespace renderer
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <array>
+#include <string>
+#include <utility>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/graphics/triangle_bvh_t.hpp>
+
+namespace renderer {
+
+TriangleBVH::TriangleBVH(const Geometry& geometry) {
+    if (!geometry.HasAttribute("position")) {
+        return;
+    }
+    const auto* positions = geometry.GetAttribute("position").data();
+    auto vertex = [positions](uint32_t index) -> Vec3 {
+        return {positions[3 * index + 0], positions[3 * index + 1],
+                positions[3 * index + 2]};
+    };
+
+    const bool HAS_INDICES = (geometry.indices != nullptr);
+    const auto NUM_TRIANGLES =
+        static_cast<uint32_t>(HAS_INDICES ? geometry.indices->num_indices() / 3
+                                          : geometry.num_vertices() / 3);
+    m_Triangles.reserve(NUM_TRIANGLES);
+    for (uint32_t i = 0; i < NUM_TRIANGLES; ++i) {
+        std::array<uint32_t, 3> ids = {3 * i, 3 * i + 1, 3 * i + 2};
+        if (HAS_INDICES) {
+            const auto* indices = geometry.indices->data();
+            ids = {indices[3 * i], indices[3 * i + 1], indices[3 * i + 2]};
+        }
+        m_Triangles.push_back(
+            {vertex(ids[0]), vertex(ids[1]), vertex(ids[2]), i});
+    }
+
+    if (m_Triangles.empty()) {
+        return;
+    }
+    m_Nodes.reserve(2 * m_Triangles.size() / MAX_LEAF_TRIANGLES + 1);
+    _BuildRecursive(0, NUM_TRIANGLES);
+}
+
+auto TriangleBVH::Intersect(const Ray& ray, float max_distance,
+                            float& distance, uint32_t& triangle) const
+    -> bool {
+    if (m_Nodes.empty()) {
+        return false;
+    }
+
+    const auto INV_DIR = InverseDirection(ray.direction);
+    float closest = max_distance;
+    bool found = false;
+
+    std::array<uint32_t, 64> stack{};
+    size_t stack_size = 0;
+    if (IntersectRayAABB(ray.origin, INV_DIR, m_Nodes[0].bounds, closest) >=
+        0.0F) {
+        stack[stack_size++] = 0;
+    }
+    while (stack_size > 0) {
+        const auto& node = m_Nodes[stack[--stack_size]];
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+                const auto& tri = m_Triangles[i];
+                const float DIST = IntersectRayTriangle(ray, tri.v0, tri.v1,
+                                                        tri.v2);
+                if (DIST >= 0.0F && DIST < closest) {
+                    closest = DIST;
+                    triangle = tri.index;
+                    found = true;
+                }
+            }
+            continue;
+        }
+
+        // Visit the closest child first, so farther ones get pruned sooner
+        const auto LEFT = static_cast<uint32_t>(&node - m_Nodes.data()) + 1;
+        const auto RIGHT = node.offset;
+        const float T_LEFT = IntersectRayAABB(ray.origin, INV_DIR,
+                                              m_Nodes[LEFT].bounds, closest);
+        const float T_RIGHT = IntersectRayAABB(ray.origin, INV_DIR,
+                                               m_Nodes[RIGHT].bounds, closest);
+        const bool HIT_LEFT = T_LEFT >= 0.0F;
+        const bool HIT_RIGHT = T_RIGHT >= 0.0F;
+        if (HIT_LEFT && HIT_RIGHT) {
+            const bool LEFT_FIRST = T_LEFT <= T_RIGHT;
+            stack[stack_size++] = LEFT_FIRST ? RIGHT : LEFT;
+            stack[stack_size++] = LEFT_FIRST ? LEFT : RIGHT;
+        } else if (HIT_LEFT) {
+            stack[stack_size++] = LEFT;
+        } else if (HIT_RIGHT) {
+            stack[stack_size++] = RIGHT;
+        }
+    }
+
+    if (found) {
+        distance = closest;
+    }
+    return found;
+}
+
+auto TriangleBVH::_BuildRecursive(uint32_t first, uint32_t count) -> uint32_t {
+    const auto NODE_IDX = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.emplace_back();
+
+    AABB bounds;
+    AABB centroid_bounds;
+    for (uint32_t i = first; i < first + count; ++i) {
+        const auto& tri = m_Triangles[i];
+        bounds.Expand(tri.v0);
+        bounds.Expand(tri.v1);
+        bounds.Expand(tri.v2);
+        centroid_bounds.Expand((1.0F / 3.0F) * (tri.v0 + tri.v1 + tri.v2));
+    }
+    m_Nodes[NODE_IDX].bounds = bounds;
+
+    if (count <= MAX_LEAF_TRIANGLES) {
+        m_Nodes[NODE_IDX].offset = first;
+        m_Nodes[NODE_IDX].count = count;
+        return NODE_IDX;
+    }
+
+    // Median split along the axis with the largest spread of centroids, which
+    // keeps the tree balanced (and its depth bounded) for any input
+    const auto SPREAD = centroid_bounds.max - centroid_bounds.min;
+    uint32_t axis = 0;
+    if (SPREAD.y() > SPREAD[axis]) {
+        axis = 1;
+    }
+    if (SPREAD.z() > SPREAD[axis]) {
+        axis = 2;
+    }
+    const auto MID = first + count / 2;
+    std::nth_element(m_Triangles.begin() + first, m_Triangles.begin() + MID,
+                     m_Triangles.begin() + first + count,
+                     [axis](const Triangle& lhs, const Triangle& rhs) {
+                         return (lhs.v0[axis] + lhs.v1[axis] + lhs.v2[axis]) <
+                                (rhs.v0[axis] + rhs.v1[axis] + rhs.v2[axis]);
+                     });
+
+    _BuildRecursive(first, MID - first);
+    const auto RIGHT = _BuildRecursive(MID, first + count - MID);
+    m_Nodes[NODE_IDX].offset = RIGHT;
+    return NODE_IDX;
+}
+
+auto TriangleBVH::ToString() const -> std::string {
+    return fmt::format(
+        "<TriangleBVH\n"
+        "  numTriangles: {0}\n"
+        "  numNodes: {1}\n"
+        ">\n",
+        m_Triangles.size(), m_Nodes.size());
+}
+
+}  // namespace renderer
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/light_clusters_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace renderer {
+
+namespace {
+// Returns the squared distance from the given point to the given box
+auto SquaredDistance(const AABB& box, const Vec3& point) -> float {
+    const auto DX = std::max({box.min.x() - point.x(), 0.0F,
+                              point.x() - box.max.x()});
+    const auto DY = std::max({box.min.y() - point.y(), 0.0F,
+                              point.y() - box.max.y()});
+    const auto DZ = std::max({box.min.z() - point.z(), 0.0F,
+                              point.z() - box.max.z()});
+    return DX * DX + DY * DY + DZ * DZ;
+}
+
+// Returns the tile of the given coordinate in NDC, clamped to the grid
+auto TileOf(float ndc, uint32_t num_tiles) -> uint32_t {
+    const auto TILE = std::floor(0.5F * (ndc + 1.0F) *
+                                 static_cast<float>(num_tiles));
+    return static_cast<uint32_t>(
+        std::clamp(TILE, 0.0F, static_cast<float>(num_tiles - 1)));
+}
+}  // namespace
+
+auto LightClusterSettings::ToString() const -> std::string {
+    return fmt::format(
+        "<LightClusterSettings\n"
+        "  enabled: {0}\n"
+        "  tilesX: {1}\n"
+        "  tilesY: {2}\n"
+        "  numSlices: {3}\n"
+        "  cutoff: {4}\n"
+        "  maxLightsPerCluster: {5}\n"
+        ">\n",
+        this->enabled, this->tiles_x, this->tiles_y, this->num_slices,
+        this->cutoff, this->max_lights_per_cluster);
+}
+
+auto ComputeLightRange(const Light& light, float cutoff) -> float {
+    constexpr auto INFINITE_RANGE = std::numeric_limits<float>::max();
+    const auto MAX_COLOR =
+        std::max({light.color.x(), light.color.y(), light.color.z()});
+    if (light.intensity <= 0.0F || MAX_COLOR <= 0.0F) {
+        return 0.0F;
+    }
+    if (cutoff <= 0.0F) {
+        return INFINITE_RANGE;
+    }
+    // Distance d at which intensity * color / (c + l d + q d^2) = cutoff
+    const auto SCALE = light.intensity * MAX_COLOR / cutoff;
+    const auto C = light.attnConstant - SCALE;
+    if (C >= 0.0F) {
+        return 0.0F;
+    }
+    if (light.attnQuadratic > 0.0F) {
+        const auto B = light.attnLinear;
+        const auto A = light.attnQuadratic;
+        return (-B + std::sqrt(B * B - 4.0F * A * C)) / (2.0F * A);
+    }
+    if (light.attnLinear > 0.0F) {
+        return -C / light.attnLinear;
+    }
+    return INFINITE_RANGE;
+}
+
+auto LightClusters::Build(const Camera& camera,
+                          const std::vector<Light::ptr>& lights,
+                          const LightClusterSettings& settings,
+                          ThreadPool* pool) -> void {
+    m_TilesX = std::max(settings.tiles_x, 1U);
+    m_TilesY = std::max(settings.tiles_y, 1U);
+    m_NumSlices = std::max(settings.num_slices, 1U);
+    // The exponential slices need a near distance above zero
+    m_Near = std::max(camera.data.near, 1e-3F);
+    m_Far = std::max(camera.data.far, 1.001F * m_Near);
+    m_SliceScale =
+        static_cast<float>(m_NumSlices) / std::log(m_Far / m_Near);
+    m_Perspective = (camera.data.projection == eProjectionType::PERSPECTIVE);
+    m_View = camera.ComputeViewMatrix();
+    // Reversing the depth range leaves the x and y rows untouched
+    m_Proj = camera.ComputeProjectionMatrix();
+    _ComputeClusterBounds();
+
+    m_Lights.clear();
+    m_Ranges.clear();
+    m_ViewCenters.clear();
+    for (const auto& light : lights) {
+        if (light == nullptr || light->type == eLightType::DIRECTIONAL) {
+            continue;
+        }
+        const auto RANGE = ComputeLightRange(*light, settings.cutoff);
+        if (RANGE <= 0.0F) {
+            continue;
+        }
+        const auto& p = light->position;
+        const auto CENTER = m_View * Vec4(p.x(), p.y(), p.z(), 1.0F);
+        m_Lights.push_back(light.get());
+        m_Ranges.push_back(RANGE);
+        m_ViewCenters.emplace_back(CENTER.x(), CENTER.y(), CENTER.z());
+    }
+
+    // Lights reaching the depth range of each slice (the camera looks along
+    // -z in view space)
+    m_SliceLights.resize(m_NumSlices);
+    m_SliceIndices.resize(m_NumSlices);
+    m_SliceOverflows.assign(m_NumSlices, 0);
+    for (auto& slice_lights : m_SliceLights) {
+        slice_lights.clear();
+    }
+    for (size_t i = 0; i < m_Lights.size(); ++i) {
+        const auto DEPTH = -m_ViewCenters[i].z();
+        const auto NEAREST = DEPTH - m_Ranges[i];
+        const auto FARTHEST = DEPTH + m_Ranges[i];
+        if (FARTHEST < m_Near || NEAREST > m_Far) {
+            continue;
+        }
+        const auto FIRST = _SliceOf(NEAREST);
+        const auto LAST = _SliceOf(FARTHEST);
+        for (auto slice = FIRST; slice <= LAST; ++slice) {
+            m_SliceLights[slice].push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    const auto NUM_CLUSTERS =
+        static_cast<size_t>(m_TilesX) * m_TilesY * m_NumSlices;
+    m_Offsets.assign(NUM_CLUSTERS, 0);
+    m_Counts.assign(NUM_CLUSTERS, 0);
+    const auto MAX_PER_CLUSTER = std::max(settings.max_lights_per_cluster, 1U);
+    auto assign = [&](size_t begin, size_t end) {
+        for (auto slice = begin; slice < end; ++slice) {
+            _AssignSlice(static_cast<uint32_t>(slice), MAX_PER_CLUSTER);
+        }
+    };
+    if (pool != nullptr) {
+        pool->ParallelFor(m_NumSlices, 1, assign);
+    } else {
+        assign(0, m_NumSlices);
+    }
+
+    // Packs the lists of all slices one after the other (the offsets of the
+    // clusters were left relative to the list of their slice)
+    m_Indices.clear();
+    m_NumOverflows = 0;
+    const auto CLUSTERS_PER_SLICE = static_cast<size_t>(m_TilesX) * m_TilesY;
+    for (uint32_t slice = 0; slice < m_NumSlices; ++slice) {
+        const auto BASE = static_cast<uint32_t>(m_Indices.size());
+        const auto FIRST = slice * CLUSTERS_PER_SLICE;
+        for (size_t i = 0; i < CLUSTERS_PER_SLICE; ++i) {
+            m_Offsets[FIRST + i] += BASE;
+        }
+        const auto& slice_indices = m_SliceIndices[slice];
+        m_Indices.insert(m_Indices.end(), slice_indices.begin(),
+                         slice_indices.end());
+        m_NumOverflows += m_SliceOverflows[slice];
+    }
+}
+
+auto LightClusters::Clear() -> void {
+    m_Lights.clear();
+    m_Ranges.clear();
+    m_ViewCenters.clear();
+    m_SliceLights.clear();
+    m_SliceIndices.clear();
+    m_SliceOverflows.clear();
+    m_ClusterBounds.clear();
+    m_Offsets.clear();
+    m_Counts.clear();
+    m_Indices.clear();
+    m_NumOverflows = 0;
+}
+
+auto LightClusters::ClusterAt(const Vec3& point) const -> uint32_t {
+    if (m_Offsets.empty()) {
+        return INVALID_CLUSTER;
+    }
+    const auto VIEW = m_View * Vec4(point.x(), point.y(), point.z(), 1.0F);
+    const auto DEPTH = -VIEW.z();
+    if (DEPTH <= 0.0F) {
+        return INVALID_CLUSTER;
+    }
+    auto ndc_x = m_Proj(0, 0) * VIEW.x() + m_Proj(0, 2) * VIEW.z() +
+                 m_Proj(0, 3);
+    auto ndc_y = m_Proj(1, 1) * VIEW.y() + m_Proj(1, 2) * VIEW.z() +
+                 m_Proj(1, 3);
+    if (m_Perspective) {
+        ndc_x /= DEPTH;
+        ndc_y /= DEPTH;
+    }
+    const auto TILE_X = TileOf(ndc_x, m_TilesX);
+    const auto TILE_Y = TileOf(ndc_y, m_TilesY);
+    return TILE_X + m_TilesX * (TILE_Y + m_TilesY * _SliceOf(DEPTH));
+}
+
+auto LightClusters::_SliceOf(float depth) const -> uint32_t {
+    if (depth <= m_Near) {
+        return 0;
+    }
+    const auto SLICE = std::floor(std::log(depth / m_Near) * m_SliceScale);
+    return static_cast<uint32_t>(
+        std::min(SLICE, static_cast<float>(m_NumSlices - 1)));
+}
+
+auto LightClusters::_ComputeClusterBounds() -> void {
+    // Edges of the tiles in NDC, and of the slices along the depth
+    auto edges = [](uint32_t num_cells, float first, float last,
+                    std::vector<float>& out) {
+        out.resize(num_cells + 1);
+        for (uint32_t i = 0; i <= num_cells; ++i) {
+            out[i] = first + (last - first) * static_cast<float>(i) /
+                                 static_cast<float>(num_cells);
+        }
+    };
+    std::vector<float> edges_x;
+    std::vector<float> edges_y;
+    std::vector<float> edges_z;
+    edges(m_TilesX, -1.0F, 1.0F, edges_x);
+    edges(m_TilesY, -1.0F, 1.0F, edges_y);
+    edges(m_NumSlices, 0.0F, std::log(m_Far / m_Near), edges_z);
+    for (auto& edge : edges_z) {
+        edge = m_Near * std::exp(edge);
+    }
+
+    // Maps a point in NDC (x and y) at the given depth back to view space
+    auto unproject = [&](float ndc_x, float ndc_y, float depth) -> Vec3 {
+        if (m_Perspective) {
+            return {(ndc_x + m_Proj(0, 2)) * depth / m_Proj(0, 0),
+                    (ndc_y + m_Proj(1, 2)) * depth / m_Proj(1, 1), -depth};
+        }
+        return {(ndc_x - m_Proj(0, 3)) / m_Proj(0, 0),
+                (ndc_y - m_Proj(1, 3)) / m_Proj(1, 1), -depth};
+    };
+    m_ClusterBounds.resize(static_cast<size_t>(m_TilesX) * m_TilesY *
+                           m_NumSlices);
+    for (uint32_t slice = 0; slice < m_NumSlices; ++slice) {
+        for (uint32_t y = 0; y < m_TilesY; ++y) {
+            for (uint32_t x = 0; x < m_TilesX; ++x) {
+                AABB bounds;
+                for (uint32_t corner = 0; corner < 8; ++corner) {
+                    bounds.Expand(unproject(edges_x[x + (corner & 1U)],
+                                            edges_y[y + ((corner >> 1U) & 1U)],
+                                            edges_z[slice + (corner >> 2U)]));
+                }
+                m_ClusterBounds[x + m_TilesX * (y + m_TilesY * slice)] =
+                    bounds;
+            }
+        }
+    }
+}
+
+auto LightClusters::_AssignSlice(uint32_t slice, uint32_t max_per_cluster)
+    -> void {
+    const auto CLUSTERS_PER_SLICE = static_cast<size_t>(m_TilesX) * m_TilesY;
+    const auto FIRST = slice * CLUSTERS_PER_SLICE;
+    const auto& candidates = m_SliceLights[slice];
+    auto& slice_indices = m_SliceIndices[slice];
+    slice_indices.clear();
+    size_t num_overflows = 0;
+    // Clusters are filled one after the other, each one keeping the order of
+    // the lights in the scene
+    for (size_t i = 0; i < CLUSTERS_PER_SLICE; ++i) {
+        const auto& bounds = m_ClusterBounds[FIRST + i];
+        const auto OFFSET = static_cast<uint32_t>(slice_indices.size());
+        uint32_t count = 0;
+        for (const auto LIGHT : candidates) {
+            const auto RANGE = m_Ranges[LIGHT];
+            // Squared ranges past the float limits stand for infinite ones
+            if (SquaredDistance(bounds, m_ViewCenters[LIGHT]) >
+                RANGE * RANGE) {
+                continue;
+            }
+            if (count == max_per_cluster) {
+                ++num_overflows;
+                continue;
+            }
+            slice_indices.push_back(LIGHT);
+            ++count;
+        }
+        m_Offsets[FIRST + i] = OFFSET;
+        m_Counts[FIRST + i] = count;
+    }
+    m_SliceOverflows[slice] = num_overflows;
+}
+
+auto LightClusters::ToString() const -> std::string {
+    return fmt::format(
+        "<LightClusters\n"
+        "  tilesX: {0}\n"
+        "  tilesY: {1}\n"
+        "  numSlices: {2}\n"
+        "  numLights: {3}\n"
+        "  numAssignments: {4}\n"
+        "  numOverflows: {5}\n"
+        ">\n",
+        m_TilesX, m_TilesY, m_NumSlices, m_Lights.size(), m_Indices.size(),
+        m_NumOverflows);
+}
+
+}  // namespace renderer
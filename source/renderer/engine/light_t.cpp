@@ -1,4 +1,6 @@
-#include <renderer/light/light_t.hpp>
+#include <string>
+
+#include <renderer/engine/light_t.hpp>
 
 namespace renderer {
 
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/lod_t.hpp>
+
+namespace renderer {
+
+auto LodSettings::ToString() const -> std::string {
+    return fmt::format(
+        "<LodSettings\n"
+        "  enabled: {0}\n"
+        "  maxScreenError: {1}\n"
+        "  hysteresis: {2}\n"
+        ">\n",
+        this->enabled, this->max_screen_error, this->hysteresis);
+}
+
+auto LodView::FromCamera(const Camera& camera, float viewport_height)
+    -> LodView {
+    LodView view;
+    view.eye = camera.pose().position;
+    // The viewport spans 2 units of the normalized device coordinates
+    view.pixels_per_unit =
+        camera.ComputeProjectionMatrix()(1, 1) * 0.5F * viewport_height;
+    view.perspective =
+        (camera.data.projection == eProjectionType::PERSPECTIVE);
+    return view;
+}
+
+auto LodView::ScreenError(float error, const AABB& bounds) const -> float {
+    if (!this->perspective) {
+        return error * this->pixels_per_unit;
+    }
+    // Distance to the closest point of the bounds (0 from inside of them)
+    float dist2 = 0.0F;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float DELTA =
+            std::max({bounds.min[axis] - this->eye[axis], 0.0F,
+                      this->eye[axis] - bounds.max[axis]});
+        dist2 += DELTA * DELTA;
+    }
+    if (dist2 <= 0.0F) {
+        return std::numeric_limits<float>::max();
+    }
+    return error * this->pixels_per_unit / std::sqrt(dist2);
+}
+
+auto SelectLod(const Geometry& geometry, const AABB& bounds,
+               const LodView& view, uint32_t current,
+               const LodSettings& settings) -> uint32_t {
+    const auto NUM_LODS = static_cast<uint32_t>(geometry.num_lods());
+    if (!settings.enabled || NUM_LODS == 1) {
+        return 0;
+    }
+    auto level = std::min(current, NUM_LODS - 1);
+    auto screen_error = [&](uint32_t lod) {
+        return view.ScreenError(geometry.lod_error(lod), bounds);
+    };
+    // Refine while the current level is too coarse, then coarsen while the
+    // next level stays well under the threshold. Levels in between stick
+    while (level > 0 && screen_error(level) > settings.max_screen_error) {
+        --level;
+    }
+    const float COARSEN_ERROR =
+        settings.max_screen_error * (1.0F - settings.hysteresis);
+    while (level + 1 < NUM_LODS && screen_error(level + 1) <= COARSEN_ERROR) {
+        ++level;
+    }
+    return level;
+}
+
+}  // namespace renderer
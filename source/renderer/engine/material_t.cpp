@@ -1,4 +1,8 @@
-#include <renderer/material/material_t.hpp>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/material_t.hpp>
 
 namespace renderer {
 
@@ -17,6 +21,18 @@ auto ToString(const eMaterialType& mat_type) -> std::string {
     return "Undefined";
 }
 
-auto Material::toString() const -> std::string { return ""; }
+auto Material::ToString() const -> std::string {
+    return fmt::format(
+        "<Material\n"
+        "  type: {0}\n"
+        "  visible: {1}\n"
+        "  transparent: {2}\n"
+        "  opacity: {3}\n"
+        "  diffuse: {4}\n"
+        "  albedoMap: {5}\n"
+        ">\n",
+        ::renderer::ToString(type), visible, transparent, opacity,
+        diffuse.toString(), albedoMap);
+}
 
 }  // namespace renderer
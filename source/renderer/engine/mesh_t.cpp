@@ -0,0 +1,69 @@
+#include <string>
+#include <utility>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/mesh_t.hpp>
+
+namespace renderer {
+
+Mesh::Mesh(const char* name, Geometry::ptr geometry) : Object3D(name) {
+    m_Type = eObjectType::MESH;
+    SetGeometry(std::move(geometry));
+}
+
+Mesh::Mesh(const char* name, Geometry::ptr geometry, Pose init_pose)
+    : Object3D(name, init_pose) {
+    m_Type = eObjectType::MESH;
+    SetGeometry(std::move(geometry));
+}
+
+auto Mesh::SetGeometry(Geometry::ptr geometry) -> void {
+    m_Geometry = std::move(geometry);
+    m_LocalBounds = (m_Geometry != nullptr) ? m_Geometry->bounds() : AABB();
+    // The world bounds are recomputed along with the world transform
+    MarkTransformDirty();
+}
+
+auto Mesh::SetMaterial(Material::ptr material) -> void {
+    m_Material = std::move(material);
+    MarkMaterialDirty();
+}
+
+auto Mesh::SetColor(const Vec3& color) -> void {
+    m_Color = color;
+    // Renderers that keep copies of the tints get to know about the change
+    MarkMaterialDirty();
+}
+
+auto Mesh::SetStatic(bool is_static) -> void {
+    if (is_static == m_Static) {
+        return;
+    }
+    m_Static = is_static;
+    // Renderers move the mesh between their static and dynamic casters
+    MarkMaterialDirty();
+}
+
+auto Mesh::MarkMaterialDirty() -> void {
+    _RecordChange(eSceneChange::MATERIAL_CHANGED);
+}
+
+auto Mesh::ToString() const -> std::string {
+    return fmt::format(
+        "<Mesh\n"
+        "  name: {0}\n"
+        "  position: {1}\n"
+        "  orientation: {2}\n"
+        "  numVertices: {3}\n"
+        "  bounds: {4}\n"
+        "  occluder: {5}\n"
+        "  static: {6}\n"
+        ">\n",
+        name(), this->m_Pose.position.toString(),
+        this->m_Pose.orientation.toString(),
+        (m_Geometry != nullptr) ? m_Geometry->num_vertices() : 0,
+        m_WorldBounds.ToString(), m_Occluder, m_Static);
+}
+
+}  // namespace renderer
@@ -0,0 +1,62 @@
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include <renderer/engine/name_table_t.hpp>
+
+namespace renderer {
+
+auto NameTable::_Instance() -> NameTable& {
+    static NameTable s_Instance;
+    return s_Instance;
+}
+
+auto NameTable::Intern(std::string_view name) -> NameId {
+    auto& table = _Instance();
+    {
+        std::shared_lock<std::shared_mutex> lock(table.m_Mutex);
+        auto it_name = table.m_Lookup.find(name);
+        if (it_name != table.m_Lookup.end()) {
+            return it_name->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(table.m_Mutex);
+    // Some other thread might have interned this name in the meantime
+    auto it_name = table.m_Lookup.find(name);
+    if (it_name != table.m_Lookup.end()) {
+        return it_name->second;
+    }
+
+    const auto NAME_ID = static_cast<NameId>(table.m_Strings.size());
+    const auto& stored_name = table.m_Strings.emplace_back(name);
+    table.m_Lookup.emplace(std::string_view(stored_name), NAME_ID);
+    return NAME_ID;
+}
+
+auto NameTable::Find(std::string_view name) -> NameId {
+    auto& table = _Instance();
+    std::shared_lock<std::shared_mutex> lock(table.m_Mutex);
+    auto it_name = table.m_Lookup.find(name);
+    return (it_name != table.m_Lookup.end()) ? it_name->second
+                                             : INVALID_NAME_ID;
+}
+
+auto NameTable::GetString(NameId name_id) -> const std::string& {
+    static const std::string INVALID_NAME = "<invalid-name>";
+    auto& table = _Instance();
+    std::shared_lock<std::shared_mutex> lock(table.m_Mutex);
+    if (name_id >= table.m_Strings.size()) {
+        return INVALID_NAME;
+    }
+    return table.m_Strings[name_id];
+}
+
+auto NameTable::size() -> size_t {
+    auto& table = _Instance();
+    std::shared_lock<std::shared_mutex> lock(table.m_Mutex);
+    return table.m_Strings.size();
+}
+
+}  // namespace renderer
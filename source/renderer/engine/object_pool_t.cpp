@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/object_pool_t.hpp>
+
+namespace renderer {
+
+auto ObjectPool::Allocate(size_t size, size_t alignment) -> void* {
+    if (!_IsPooled(size, alignment)) {
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+
+    const auto CLASS_IDX = (size + BLOCK_GRANULARITY - 1) / BLOCK_GRANULARITY;
+    const auto BLOCK_SIZE = std::max<size_t>(CLASS_IDX, 1) * BLOCK_GRANULARITY;
+    auto& free_list = m_FreeLists.at(std::max<size_t>(CLASS_IDX, 1) - 1);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (free_list == nullptr) {
+        // Grab a new chunk and thread all of its blocks into the free-list
+        auto chunk = std::make_unique<uint8_t[]>(  // NOLINT
+            BLOCK_SIZE * BLOCKS_PER_CHUNK);
+        for (size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+            auto* block = reinterpret_cast<FreeBlock*>(  // NOLINT
+                chunk.get() + (i - 1) * BLOCK_SIZE);
+            block->next = free_list;
+            free_list = block;
+        }
+        m_Chunks.push_back(std::move(chunk));
+    }
+
+    auto* block = free_list;
+    free_list = block->next;
+    m_NumAllocated++;
+    return block;
+}
+
+auto ObjectPool::Deallocate(void* ptr, size_t size, size_t alignment) -> void {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    if (!_IsPooled(size, alignment)) {
+        ::operator delete(ptr, std::align_val_t(alignment));
+        return;
+    }
+
+    const auto CLASS_IDX = (size + BLOCK_GRANULARITY - 1) / BLOCK_GRANULARITY;
+    auto& free_list = m_FreeLists.at(std::max<size_t>(CLASS_IDX, 1) - 1);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = free_list;
+    free_list = block;
+    m_NumAllocated--;
+}
+
+auto ObjectPool::ToString() const -> std::string {
+    return fmt::format(
+        "<ObjectPool\n"
+        "  numAllocated: {0}\n"
+        "  numChunks: {1}\n"
+        ">\n",
+        m_NumAllocated, m_Chunks.size());
+}
+
+}  // namespace renderer
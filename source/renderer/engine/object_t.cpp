@@ -3,21 +3,154 @@
 
 #include <spdlog/fmt/bundled/format.h>
 
+#include <renderer/engine/change_journal_t.hpp>
 #include <renderer/engine/object_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
 
 namespace renderer {
 
-Object3D::Object3D(const char* name) : m_Name(name) {}
+auto ComputeTransformMatrix(const Pose& pose) -> Mat4 {
+    // | R  p |  where the columns of R are the basis vectors of the frame
+    // | 0  1 |  given by the orientation of the pose
+    const Mat3 ROT_MATRIX(pose.orientation);
+
+    Mat4 transform = Mat4::Identity();
+    for (uint32_t col = 0; col < 3; ++col) {
+        transform(0, col) = ROT_MATRIX[col].x();
+        transform(1, col) = ROT_MATRIX[col].y();
+        transform(2, col) = ROT_MATRIX[col].z();
+    }
+    transform(0, 3) = pose.position.x();
+    transform(1, 3) = pose.position.y();
+    transform(2, 3) = pose.position.z();
+    return transform;
+}
+
+Object3D::Object3D(const char* name) : m_NameId(NameTable::Intern(name)) {}
 
 Object3D::Object3D(const char* name, Pose init_pose)
-    : pose(init_pose), m_Name(name) {}
+    : m_NameId(NameTable::Intern(name)), m_Pose(init_pose) {}
 
 Object3D::Object3D(const char* name, Vec3 init_pos)
-    : pose(Pose(init_pos, Quat())), m_Name(name) {}
+    : m_NameId(NameTable::Intern(name)), m_Pose(Pose(init_pos, Quat())) {}
 
 auto Object3D::AddChild(Object3D::ptr child_obj) -> void {
     child_obj->parent = shared_from_this();
-    this->children.push_back(std::move(child_obj));
+    child_obj->MarkTransformDirty();
+    if (m_Journal != nullptr) {
+        child_obj->_AttachJournal(m_Journal);
+    }
+    m_Children.push_back(std::move(child_obj));
+}
+
+auto Object3D::SetLayers(uint32_t layers) -> void {
+    if (layers == m_Layers) {
+        return;
+    }
+    m_Layers = layers;
+    _RecordChange(eSceneChange::VISIBILITY_CHANGED);
+}
+
+auto Object3D::SetVisible(bool visible) -> void {
+    if (visible == m_Visible) {
+        return;
+    }
+    m_Visible = visible;
+    _RecordChange(eSceneChange::VISIBILITY_CHANGED);
+}
+
+auto Object3D::SetPose(const Pose& pose) -> void {
+    m_Pose = pose;
+    MarkTransformDirty();
+}
+
+auto Object3D::SetPosition(const Vec3& position) -> void {
+    m_Pose.position = position;
+    MarkTransformDirty();
+}
+
+auto Object3D::SetOrientation(const Quat& orientation) -> void {
+    m_Pose.orientation = orientation;
+    MarkTransformDirty();
+}
+
+auto Object3D::MarkTransformDirty() -> void {
+    m_TransformDirty = true;
+    // Let our ancestors know that there's work to do down this branch. Stop
+    // as soon as we find one that already knows, so marking many siblings is
+    // still O(1) amortized per object
+    auto ancestor = this->parent.lock();
+    while (ancestor != nullptr && !ancestor->m_SubtreeDirty) {
+        ancestor->m_SubtreeDirty = true;
+        ancestor = ancestor->parent.lock();
+    }
+}
+
+auto Object3D::UpdateWorldTransform(const Mat4& parent_world,
+                                    bool parent_changed, ThreadPool* pool,
+                                    BoundsChangeList* changes) -> void {
+    const bool WORLD_CHANGED = parent_changed || m_TransformDirty;
+    if (!WORLD_CHANGED && !m_SubtreeDirty) {
+        return;  // nothing changed in this branch, so skip it entirely
+    }
+
+    if (WORLD_CHANGED) {
+        m_WorldTransform = parent_world * ComputeTransformMatrix(m_Pose);
+        m_TransformDirty = false;
+        m_WorldBounds = m_LocalBounds.Transformed(m_WorldTransform);
+        // Objects that were in the BVH are reported even if they have lost
+        // their bounds, so their leaf gets emptied as well
+        if (changes != nullptr &&
+            (!m_LocalBounds.empty() || m_BvhLeaf != INVALID_BVH_LEAF)) {
+            const auto BUCKET =
+                (pool != nullptr) ? pool->current_thread_index() : 0;
+            changes->buckets[BUCKET].push_back(this);
+        }
+    }
+    m_SubtreeDirty = false;
+
+    // A change in our world transform spreads down to all of our children.
+    // Each child owns its whole subtree, so wide branches can be split in
+    // groups of subtrees and updated by different threads
+    if (pool != nullptr &&
+        m_Children.size() >= PARALLEL_TRANSFORMS_MIN_CHILDREN) {
+        pool->ParallelFor(
+            m_Children.size(), PARALLEL_TRANSFORMS_MIN_CHILDREN / 2,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    m_Children[i]->UpdateWorldTransform(
+                        m_WorldTransform, WORLD_CHANGED, pool, changes);
+                }
+            });
+        return;
+    }
+
+    for (auto& child : m_Children) {
+        child->UpdateWorldTransform(m_WorldTransform, WORLD_CHANGED, pool,
+                                    changes);
+    }
+}
+
+auto Object3D::_RecordChange(eSceneChange type) -> void {
+    if (m_Journal != nullptr) {
+        m_Journal->Record(type, *this);
+    }
+}
+
+auto Object3D::_AttachJournal(ChangeJournal* journal) -> void {
+    m_Journal = journal;
+    _RecordChange(eSceneChange::ADDED);
+    for (auto& child : m_Children) {
+        child->_AttachJournal(journal);
+    }
+}
+
+auto Object3D::_DetachJournal() -> void {
+    _RecordChange(eSceneChange::REMOVED);
+    m_Journal = nullptr;
+    for (auto& child : m_Children) {
+        child->_DetachJournal();
+    }
 }
 
 auto Object3D::ToString() const -> std::string {
@@ -29,9 +162,9 @@ auto Object3D::ToString() const -> std::string {
         "  parent: {3}\n"
         "  children: {4}\n"
         ">\n",
-        this->m_Name, this->pose.position.toString(),
-        this->pose.orientation.toString(),
-        (!this->parent.expired() ? "Yes" : "None"), this->children.size());
+        name(), this->m_Pose.position.toString(),
+        this->m_Pose.orientation.toString(),
+        (!this->parent.expired() ? "Yes" : "None"), m_Children.size());
 }
 
 }  // namespace renderer
@@ -0,0 +1,603 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/occlusion_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+// clang-format off
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RENDERER_OCCLUSION_SSE2
+#endif
+// clang-format on
+
+namespace renderer {
+
+namespace {
+/// Coverage masks of the rows of a tile
+using TileMask = std::array<uint32_t, OCCLUSION_TILE_HEIGHT>;
+
+/// Mask of a tile row with all of its pixels covered
+constexpr uint32_t FULL_ROW = 0xFFFFFFFF;
+
+/// Depth of a cleared tile (the far plane)
+constexpr float FAR_DEPTH = 1.0F;
+
+/// Triangles with a smaller area (in squared pixels) are skipped
+constexpr float MIN_TRIANGLE_AREA = 1e-6F;
+
+/// Smallest w of a vertex to be projected, to avoid divisions by zero
+constexpr float MIN_CLIP_W = 1e-7F;
+
+/// Number of boxes tested by each task of a parallel test
+constexpr size_t BOXES_PER_TASK = 256;
+
+// Returns the bits of a tile row for the columns in [first, last]
+auto RowBits(int32_t first, int32_t last) -> uint32_t {
+    const auto COUNT = static_cast<uint32_t>(last - first + 1);
+    return static_cast<uint32_t>(((uint64_t{1} << COUNT) - 1)
+                                 << static_cast<uint32_t>(first));
+}
+
+#if defined(RENDERER_OCCLUSION_SSE2)
+
+// The rows of a tile are handled at once, as the lanes of a 128-bit register
+auto LoadMask(const uint32_t* rows) -> __m128i {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows));  // NOLINT
+}
+
+auto IsEmpty(const uint32_t* rows) -> bool {
+    const auto ZERO = _mm_cmpeq_epi32(LoadMask(rows), _mm_setzero_si128());
+    return _mm_movemask_epi8(ZERO) == 0xFFFF;
+}
+
+auto IsFull(const uint32_t* rows) -> bool {
+    const auto FULL = _mm_cmpeq_epi32(LoadMask(rows), _mm_set1_epi32(-1));
+    return _mm_movemask_epi8(FULL) == 0xFFFF;
+}
+
+auto MergeMask(uint32_t* rows, const TileMask& coverage) -> void {
+    const auto MERGED = _mm_or_si128(LoadMask(rows), LoadMask(coverage.data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rows), MERGED);  // NOLINT
+}
+
+auto ClearMask(uint32_t* rows) -> void {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rows),  // NOLINT
+                     _mm_setzero_si128());
+}
+
+// Returns whether all pixels of the given rect are in the mask of the tile
+auto CoversRect(const uint32_t* rows, const TileMask& rect) -> bool {
+    const auto MISSING =
+        _mm_andnot_si128(LoadMask(rows), LoadMask(rect.data()));
+    const auto ZERO = _mm_cmpeq_epi32(MISSING, _mm_setzero_si128());
+    return _mm_movemask_epi8(ZERO) == 0xFFFF;
+}
+
+#else
+
+auto IsEmpty(const uint32_t* rows) -> bool {
+    return std::all_of(rows, rows + OCCLUSION_TILE_HEIGHT,
+                       [](uint32_t row) { return row == 0; });
+}
+
+auto IsFull(const uint32_t* rows) -> bool {
+    return std::all_of(rows, rows + OCCLUSION_TILE_HEIGHT,
+                       [](uint32_t row) { return row == FULL_ROW; });
+}
+
+auto MergeMask(uint32_t* rows, const TileMask& coverage) -> void {
+    for (size_t r = 0; r < OCCLUSION_TILE_HEIGHT; ++r) {
+        rows[r] |= coverage[r];
+    }
+}
+
+auto ClearMask(uint32_t* rows) -> void {
+    std::fill_n(rows, OCCLUSION_TILE_HEIGHT, 0U);
+}
+
+auto CoversRect(const uint32_t* rows, const TileMask& rect) -> bool {
+    for (size_t r = 0; r < OCCLUSION_TILE_HEIGHT; ++r) {
+        if ((rect[r] & ~rows[r]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif
+
+// Returns the point at the given fraction of the segment between two points
+auto Lerp(const std::array<float, 4>& p, const std::array<float, 4>& q,
+          float t) -> std::array<float, 4> {
+    return {p[0] + t * (q[0] - p[0]), p[1] + t * (q[1] - p[1]),
+            p[2] + t * (q[2] - p[2]), p[3] + t * (q[3] - p[3])};
+}
+
+// Returns the clip coordinates of the given point
+auto Transform(const Mat4& mat, float x, float y, float z)
+    -> std::array<float, 4> {
+    std::array<float, 4> clip{};
+    for (uint32_t row = 0; row < 4; ++row) {
+        clip[row] = mat(row, 0) * x + mat(row, 1) * y + mat(row, 2) * z +
+                    mat(row, 3);
+    }
+    return clip;
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+    : m_TilesX(std::max((width + OCCLUSION_TILE_WIDTH - 1) /
+                            OCCLUSION_TILE_WIDTH,
+                        1U)),
+      m_TilesY(std::max((height + OCCLUSION_TILE_HEIGHT - 1) /
+                            OCCLUSION_TILE_HEIGHT,
+                        1U)) {
+    m_Width = m_TilesX * OCCLUSION_TILE_WIDTH;
+    m_Height = m_TilesY * OCCLUSION_TILE_HEIGHT;
+    const auto NUM_TILES = static_cast<size_t>(m_TilesX) * m_TilesY;
+    m_Masks.resize(NUM_TILES * OCCLUSION_TILE_HEIGHT, 0);
+    m_TileDepths.resize(NUM_TILES, FAR_DEPTH);
+    m_LayerDepths.resize(NUM_TILES, 0.0F);
+}
+
+auto OcclusionBuffer::Begin(const Mat4& view_proj, bool reverse_z) -> void {
+    m_ViewProj = view_proj;
+    m_ReverseZ = reverse_z;
+    std::fill(m_Masks.begin(), m_Masks.end(), 0U);
+    std::fill(m_TileDepths.begin(), m_TileDepths.end(), FAR_DEPTH);
+    std::fill(m_LayerDepths.begin(), m_LayerDepths.end(), 0.0F);
+    m_Triangles.clear();
+    m_Stats = OcclusionStats{};
+}
+
+auto OcclusionBuffer::Begin(const Camera& camera) -> void {
+    Begin(camera.ComputeProjectionMatrix() * camera.ComputeViewMatrix(),
+          camera.data.reverse_z);
+}
+
+auto OcclusionBuffer::AddOccluder(const Mat4& model, const float32_t* positions,
+                                  size_t num_vertices, const uint32_t* indices,
+                                  size_t num_indices) -> void {
+    if (positions == nullptr || num_vertices == 0) {
+        return;
+    }
+    const Mat4 MVP = m_ViewProj * model;
+    m_ClipVertices.resize(num_vertices);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        const auto* p = positions + 3 * i;
+        m_ClipVertices[i] = Transform(MVP, p[0], p[1], p[2]);
+    }
+
+    const auto NUM_TRIANGLES =
+        (indices != nullptr) ? num_indices / 3 : num_vertices / 3;
+    for (size_t t = 0; t < NUM_TRIANGLES; ++t) {
+        std::array<uint32_t, 3> tri = {static_cast<uint32_t>(3 * t),
+                                       static_cast<uint32_t>(3 * t + 1),
+                                       static_cast<uint32_t>(3 * t + 2)};
+        if (indices != nullptr) {
+            tri = {indices[3 * t], indices[3 * t + 1], indices[3 * t + 2]};
+        }
+        if (tri[0] >= num_vertices || tri[1] >= num_vertices ||
+            tri[2] >= num_vertices) {
+            continue;
+        }
+        const auto& p0 = m_ClipVertices[tri[0]];
+        const auto& p1 = m_ClipVertices[tri[1]];
+        const auto& p2 = m_ClipVertices[tri[2]];
+
+        // Triangles fully outside of a side of the frustum are skipped
+        auto outside = [&p0, &p1, &p2](auto&& test) {
+            return test(p0) && test(p1) && test(p2);
+        };
+        if (outside([](const auto& p) { return p[0] < -p[3]; }) ||
+            outside([](const auto& p) { return p[0] > p[3]; }) ||
+            outside([](const auto& p) { return p[1] < -p[3]; }) ||
+            outside([](const auto& p) { return p[1] > p[3]; })) {
+            continue;
+        }
+        _AddClipTriangle(p0, p1, p2);
+    }
+    ++m_Stats.num_occluders;
+}
+
+auto OcclusionBuffer::AddOccluder(const Mat4& model, const Geometry& geometry)
+    -> void {
+    if (!geometry.HasAttribute("position")) {
+        return;
+    }
+    const auto& positions = geometry.GetAttribute("position");
+    const uint32_t* indices = nullptr;
+    size_t num_indices = 0;
+    if (geometry.indices != nullptr) {
+        indices = geometry.indices->data();
+        num_indices = geometry.indices->num_indices();
+    }
+    AddOccluder(model, positions.data(), geometry.num_vertices(), indices,
+                num_indices);
+}
+
+auto OcclusionBuffer::Rasterize(ThreadPool* pool) -> void {
+    auto rasterize_rows = [this](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            _RasterizeTileRow(static_cast<uint32_t>(row));
+        }
+    };
+
+    if (pool == nullptr) {
+        rasterize_rows(0, m_TilesY);
+    } else {
+        pool->ParallelFor(m_TilesY, 1, rasterize_rows);
+    }
+    m_Triangles.clear();
+}
+
+auto OcclusionBuffer::TestBox(const AABB& box) const -> bool {
+    if (box.empty()) {
+        return false;
+    }
+    float x_min = static_cast<float>(m_Width);
+    float x_max = 0.0F;
+    float y_min = static_cast<float>(m_Height);
+    float y_max = 0.0F;
+    float depth = FAR_DEPTH;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        const auto CLIP = Transform(
+            m_ViewProj, ((corner & 1U) != 0) ? box.max.x() : box.min.x(),
+            ((corner & 2U) != 0) ? box.max.y() : box.min.y(),
+            ((corner & 4U) != 0) ? box.max.z() : box.min.z());
+        // Boxes that reach the near plane can't be hidden
+        if (_NearDistance(CLIP) < 0.0F || CLIP[3] < MIN_CLIP_W) {
+            return true;
+        }
+        const float X = (0.5F * CLIP[0] / CLIP[3] + 0.5F) *
+                        static_cast<float>(m_Width);
+        const float Y = (0.5F - 0.5F * CLIP[1] / CLIP[3]) *
+                        static_cast<float>(m_Height);
+        x_min = std::min(x_min, X);
+        x_max = std::max(x_max, X);
+        y_min = std::min(y_min, Y);
+        y_max = std::max(y_max, Y);
+        depth = std::min(depth, _Depth(CLIP));
+    }
+    // Outside of the view, so the buffer knows nothing about it
+    if (x_max < 0.0F || y_max < 0.0F || x_min >= static_cast<float>(m_Width) ||
+        y_min >= static_cast<float>(m_Height)) {
+        return true;
+    }
+    depth = std::max(depth, 0.0F);
+
+    const auto PX_MIN = static_cast<int32_t>(std::max(x_min, 0.0F));
+    const auto PY_MIN = static_cast<int32_t>(std::max(y_min, 0.0F));
+    const auto PX_MAX = static_cast<int32_t>(
+        std::min(x_max, static_cast<float>(m_Width - 1)));
+    const auto PY_MAX = static_cast<int32_t>(
+        std::min(y_max, static_cast<float>(m_Height - 1)));
+    constexpr auto TILE_W = static_cast<int32_t>(OCCLUSION_TILE_WIDTH);
+    constexpr auto TILE_H = static_cast<int32_t>(OCCLUSION_TILE_HEIGHT);
+    for (int32_t ty = PY_MIN / TILE_H; ty <= PY_MAX / TILE_H; ++ty) {
+        for (int32_t tx = PX_MIN / TILE_W; tx <= PX_MAX / TILE_W; ++tx) {
+            const auto TILE = static_cast<size_t>(ty) * m_TilesX +
+                              static_cast<size_t>(tx);
+            if (depth >= m_TileDepths[TILE]) {
+                continue;
+            }
+            // Closer than the tile depth, so it's only hidden if all of its
+            // pixels in the tile are in the working layer, and behind it
+            const auto* rows = m_Masks.data() + TILE * OCCLUSION_TILE_HEIGHT;
+            if (depth < m_LayerDepths[TILE] || IsEmpty(rows)) {
+                return true;
+            }
+            TileMask rect{};
+            const auto COL_MIN = std::max(PX_MIN - tx * TILE_W, 0);
+            const auto COL_MAX = std::min(PX_MAX - tx * TILE_W, TILE_W - 1);
+            for (int32_t r = 0; r < TILE_H; ++r) {
+                const auto ROW = ty * TILE_H + r;
+                if (ROW >= PY_MIN && ROW <= PY_MAX) {
+                    rect[static_cast<size_t>(r)] = RowBits(COL_MIN, COL_MAX);
+                }
+            }
+            if (!CoversRect(rows, rect)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+auto OcclusionBuffer::TestBounds(const BoundsArray& bounds, uint8_t* visible,
+                                 ThreadPool* pool) -> size_t {
+    std::atomic<size_t> num_tested{0};
+    std::atomic<size_t> num_occluded{0};
+    auto test_range = [&](size_t begin, size_t end) {
+        size_t tested = 0;
+        size_t occluded = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (visible[i] == 0 || bounds.extent_x[i] < 0.0F) {
+                continue;
+            }
+            const Vec3 CENTER(bounds.center_x[i], bounds.center_y[i],
+                              bounds.center_z[i]);
+            const Vec3 EXTENT(bounds.extent_x[i], bounds.extent_y[i],
+                              bounds.extent_z[i]);
+            ++tested;
+            if (!TestBox(AABB(CENTER - EXTENT, CENTER + EXTENT))) {
+                visible[i] = 0;
+                ++occluded;
+            }
+        }
+        num_tested += tested;
+        num_occluded += occluded;
+    };
+
+    if (pool == nullptr) {
+        test_range(0, bounds.size());
+    } else {
+        pool->ParallelFor(bounds.size(), BOXES_PER_TASK, test_range);
+    }
+    m_Stats.num_tested += num_tested.load();
+    m_Stats.num_occluded += num_occluded.load();
+    return num_occluded.load();
+}
+
+auto OcclusionBuffer::depth_bound(uint32_t x, uint32_t y) const -> float {
+    if (x >= m_Width || y >= m_Height) {
+        return FAR_DEPTH;
+    }
+    const auto TILE = static_cast<size_t>(y / OCCLUSION_TILE_HEIGHT) *
+                          m_TilesX +
+                      x / OCCLUSION_TILE_WIDTH;
+    const auto ROW =
+        m_Masks[TILE * OCCLUSION_TILE_HEIGHT + y % OCCLUSION_TILE_HEIGHT];
+    const bool COVERED = ((ROW >> (x % OCCLUSION_TILE_WIDTH)) & 1U) != 0;
+    return COVERED ? m_LayerDepths[TILE] : m_TileDepths[TILE];
+}
+
+auto OcclusionBuffer::_AddClipTriangle(const std::array<float, 4>& p0,
+                                       const std::array<float, 4>& p1,
+                                       const std::array<float, 4>& p2)
+    -> void {
+    const std::array<const std::array<float, 4>*, 3> VERTICES = {&p0, &p1,
+                                                                 &p2};
+    const std::array<float, 3> DISTANCES = {
+        _NearDistance(p0), _NearDistance(p1), _NearDistance(p2)};
+    const auto NUM_INSIDE = std::count_if(
+        DISTANCES.begin(), DISTANCES.end(), [](float d) { return d >= 0.0F; });
+    if (NUM_INSIDE == 3) {
+        _AddScreenTriangle(p0, p1, p2);
+        return;
+    }
+    if (NUM_INSIDE == 0) {
+        return;
+    }
+
+    // Clipping a triangle against a plane leaves at most four vertices
+    std::array<std::array<float, 4>, 4> polygon{};
+    size_t num_points = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto NEXT = (i + 1) % 3;
+        if (DISTANCES[i] >= 0.0F) {
+            polygon[num_points++] = *VERTICES[i];
+        }
+        if ((DISTANCES[i] >= 0.0F) != (DISTANCES[NEXT] >= 0.0F)) {
+            const float T = DISTANCES[i] / (DISTANCES[i] - DISTANCES[NEXT]);
+            polygon[num_points++] = Lerp(*VERTICES[i], *VERTICES[NEXT], T);
+        }
+    }
+    for (size_t i = 2; i < num_points; ++i) {
+        _AddScreenTriangle(polygon[0], polygon[i - 1], polygon[i]);
+    }
+}
+
+auto OcclusionBuffer::_AddScreenTriangle(const std::array<float, 4>& p0,
+                                         const std::array<float, 4>& p1,
+                                         const std::array<float, 4>& p2)
+    -> void {
+    const std::array<const std::array<float, 4>*, 3> VERTICES = {&p0, &p1,
+                                                                 &p2};
+    std::array<float, 3> xs{};
+    std::array<float, 3> ys{};
+    std::array<float, 3> depths{};
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& p = *VERTICES[i];
+        if (p[3] < MIN_CLIP_W) {
+            return;
+        }
+        xs[i] = (0.5F * p[0] / p[3] + 0.5F) * static_cast<float>(m_Width);
+        ys[i] = (0.5F - 0.5F * p[1] / p[3]) * static_cast<float>(m_Height);
+        depths[i] = _Depth(p);
+    }
+
+    // Edges get oriented such that the inside of the triangle is positive
+    const float AREA =
+        (xs[1] - xs[0]) * (ys[2] - ys[0]) - (xs[2] - xs[0]) * (ys[1] - ys[0]);
+    if (!(std::abs(AREA) > MIN_TRIANGLE_AREA)) {
+        return;
+    }
+
+    ScreenTriangle tri;
+    // Normalized depths are linear in screen space, so they lie on a plane
+    const float DZ1 = depths[1] - depths[0];
+    const float DZ2 = depths[2] - depths[0];
+    tri.depth_dx = (DZ1 * (ys[2] - ys[0]) - DZ2 * (ys[1] - ys[0])) / AREA;
+    tri.depth_dy = (DZ2 * (xs[1] - xs[0]) - DZ1 * (xs[2] - xs[0])) / AREA;
+    tri.depth_c = depths[0] - tri.depth_dx * xs[0] - tri.depth_dy * ys[0];
+    tri.depth = std::max({depths[0], depths[1], depths[2], 0.0F});
+
+    if (AREA < 0.0F) {
+        std::swap(xs[1], xs[2]);
+        std::swap(ys[1], ys[2]);
+    }
+
+    const float X_MIN = std::min({xs[0], xs[1], xs[2]});
+    const float X_MAX = std::max({xs[0], xs[1], xs[2]});
+    const float Y_MIN = std::min({ys[0], ys[1], ys[2]});
+    const float Y_MAX = std::max({ys[0], ys[1], ys[2]});
+    if (X_MAX < 0.0F || Y_MAX < 0.0F || X_MIN >= static_cast<float>(m_Width) ||
+        Y_MIN >= static_cast<float>(m_Height)) {
+        return;
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        const auto NEXT = (i + 1) % 3;
+        tri.a[i] = ys[i] - ys[NEXT];
+        tri.b[i] = xs[NEXT] - xs[i];
+        tri.c[i] = -(tri.a[i] * xs[i] + tri.b[i] * ys[i]);
+    }
+    tri.x_min = static_cast<int32_t>(std::max(X_MIN, 0.0F));
+    tri.y_min = static_cast<int32_t>(std::max(Y_MIN, 0.0F));
+    tri.x_max = static_cast<int32_t>(
+        std::min(X_MAX, static_cast<float>(m_Width - 1)));
+    tri.y_max = static_cast<int32_t>(
+        std::min(Y_MAX, static_cast<float>(m_Height - 1)));
+    m_Triangles.push_back(tri);
+    ++m_Stats.num_triangles;
+}
+
+auto OcclusionBuffer::_RasterizeTileRow(uint32_t tile_row) -> void {
+    constexpr auto TILE_W = static_cast<int32_t>(OCCLUSION_TILE_WIDTH);
+    constexpr auto TILE_H = static_cast<int32_t>(OCCLUSION_TILE_HEIGHT);
+    const auto ROW_MIN = static_cast<int32_t>(tile_row) * TILE_H;
+    const auto ROW_MAX = ROW_MIN + TILE_H - 1;
+    const auto WIDTH = static_cast<float>(m_Width);
+
+    for (const auto& tri : m_Triangles) {
+        if (tri.y_max < ROW_MIN || tri.y_min > ROW_MAX) {
+            continue;
+        }
+
+        // Span of the covered pixels of each row, from the edges crossing the
+        // center of the row (empty spans have first > last)
+        std::array<int32_t, OCCLUSION_TILE_HEIGHT> first{};
+        std::array<int32_t, OCCLUSION_TILE_HEIGHT> last{};
+        int32_t span_min = TILE_W * static_cast<int32_t>(m_TilesX);
+        int32_t span_max = -1;
+        for (int32_t r = 0; r < TILE_H; ++r) {
+            const auto R = static_cast<size_t>(r);
+            first[R] = 1;
+            last[R] = 0;
+            const auto ROW = ROW_MIN + r;
+            if (ROW < tri.y_min || ROW > tri.y_max) {
+                continue;
+            }
+            const float Y = static_cast<float>(ROW) + 0.5F;
+            float left = 0.0F;
+            float right = WIDTH;
+            bool empty = false;
+            for (size_t e = 0; e < 3; ++e) {
+                const float S = tri.b[e] * Y + tri.c[e];
+                if (tri.a[e] > 0.0F) {
+                    left = std::max(left, -S / tri.a[e]);
+                } else if (tri.a[e] < 0.0F) {
+                    right = std::min(right, -S / tri.a[e]);
+                } else {
+                    empty = empty || (S < 0.0F);
+                }
+            }
+            if (empty || !(left <= right) || right < 0.0F) {
+                continue;
+            }
+            right = std::min(right, WIDTH);
+            left = std::min(left, WIDTH);
+            // Pixels whose centers lie within [left, right]
+            first[R] = std::max(
+                static_cast<int32_t>(std::ceil(left - 0.5F)), tri.x_min);
+            last[R] = std::min(
+                static_cast<int32_t>(std::floor(right - 0.5F)), tri.x_max);
+            if (first[R] <= last[R]) {
+                span_min = std::min(span_min, first[R]);
+                span_max = std::max(span_max, last[R]);
+            }
+        }
+        if (span_min > span_max) {
+            continue;
+        }
+
+        for (int32_t tx = span_min / TILE_W; tx <= span_max / TILE_W; ++tx) {
+            TileMask coverage{};
+            bool covers_any = false;
+            for (size_t r = 0; r < OCCLUSION_TILE_HEIGHT; ++r) {
+                const auto COL_MIN = std::max(first[r] - tx * TILE_W, 0);
+                const auto COL_MAX =
+                    std::min(last[r] - tx * TILE_W, TILE_W - 1);
+                if (COL_MIN <= COL_MAX) {
+                    coverage[r] = RowBits(COL_MIN, COL_MAX);
+                    covers_any = true;
+                }
+            }
+            if (!covers_any) {
+                continue;
+            }
+
+            const auto TILE = static_cast<size_t>(tile_row) * m_TilesX +
+                              static_cast<size_t>(tx);
+            auto& tile_depth = m_TileDepths[TILE];
+            auto& layer_depth = m_LayerDepths[TILE];
+            auto* rows = m_Masks.data() + TILE * OCCLUSION_TILE_HEIGHT;
+            // Farthest depth of the triangle within the tile, from the corners
+            // of the tile on its depth plane
+            const auto X0 = static_cast<float>(tx * TILE_W);
+            const auto Y0 = static_cast<float>(ROW_MIN);
+            const float DEPTH = std::max(
+                std::min(tri.depth_c +
+                             std::max(tri.depth_dx * X0,
+                                      tri.depth_dx * (X0 + TILE_W)) +
+                             std::max(tri.depth_dy * Y0,
+                                      tri.depth_dy * (Y0 + TILE_H)),
+                         tri.depth),
+                0.0F);
+            if (DEPTH >= tile_depth) {
+                continue;  // Behind what the tile already hides
+            }
+            // A triangle much closer than the working layer starts a new one,
+            // instead of being merged into a layer that's mostly behind it
+            if (IsEmpty(rows) ||
+                layer_depth - DEPTH > tile_depth - layer_depth) {
+                ClearMask(rows);
+                layer_depth = DEPTH;
+            } else {
+                layer_depth = std::max(layer_depth, DEPTH);
+            }
+            MergeMask(rows, coverage);
+            // Once the layer covers the whole tile, it becomes the tile depth
+            if (IsFull(rows)) {
+                tile_depth = layer_depth;
+                layer_depth = 0.0F;
+                ClearMask(rows);
+            }
+        }
+    }
+}
+
+auto OcclusionBuffer::_NearDistance(const std::array<float, 4>& p) const
+    -> float {
+    // In front of the near plane means z >= -w, or z <= w for reversed depth
+    return m_ReverseZ ? p[3] - p[2] : p[2] + p[3];
+}
+
+auto OcclusionBuffer::_Depth(const std::array<float, 4>& p) const -> float {
+    const float NDC_Z = p[2] / p[3];
+    return m_ReverseZ ? 1.0F - NDC_Z : 0.5F * NDC_Z + 0.5F;
+}
+
+auto OcclusionBuffer::ToString() const -> std::string {
+    return fmt::format(
+        "<OcclusionBuffer\n"
+        "  width: {0}\n"
+        "  height: {1}\n"
+        "  numOccluders: {2}\n"
+        "  numTriangles: {3}\n"
+        "  numTested: {4}\n"
+        "  numOccluded: {5}\n"
+        ">\n",
+        m_Width, m_Height, m_Stats.num_occluders, m_Stats.num_triangles,
+        m_Stats.num_tested, m_Stats.num_occluded);
+}
+
+}  // namespace renderer
@@ -34,7 +34,7 @@ auto OrbitCameraController::Update(float dt) -> void {
     }
     constexpr auto TWO_PI = static_cast<float>(math::PI);
 
-    auto pos_offset = m_Camera->pose.position - target;
+    auto pos_offset = m_Camera->pose().position - target;
     Vec3 target_offset;
 
     m_Spherical.SetFromCartesian(pos_offset);
@@ -85,7 +85,7 @@ auto OrbitCameraController::Update(float dt) -> void {
 
     this->target = this->target + target_offset;
     m_Camera->target = this->target;
-    m_Camera->pose.position = this->target + pos_offset;
+    m_Camera->SetPosition(this->target + pos_offset);
     m_Camera->LookAt(this->target);
 
     if (enableDamping) {
@@ -191,7 +191,7 @@ auto OrbitCameraController::OnMouseMoveCallback(double x, double y) -> void {
 
             switch (m_Camera->data.projection) {
                 case eProjectionType::PERSPECTIVE: {
-                    auto offset = m_Camera->pose.position - target;
+                    auto offset = m_Camera->pose().position - target;
                     auto target_distance = math::norm(offset);
                     const auto FOV = m_Camera->data.fov;
                     target_distance *= std::tan((FOV / 2.0F) * PI / 180.0F);
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/engine/range_allocator_t.hpp>
+
+namespace renderer {
+
+RangeAllocator::RangeAllocator(uint32_t size) : m_Size(size), m_NumFree(size) {
+    if (size > 0) {
+        m_FreeRanges[0] = size;
+    }
+}
+
+auto RangeAllocator::Allocate(uint32_t count) -> uint32_t {
+    if (count == 0) {
+        return INVALID_RANGE;
+    }
+    for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it) {
+        if (it->second < count) {
+            continue;
+        }
+        const auto OFFSET = it->first;
+        const auto REMAINING = it->second - count;
+        m_FreeRanges.erase(it);
+        if (REMAINING > 0) {
+            m_FreeRanges[OFFSET + count] = REMAINING;
+        }
+        m_NumFree -= count;
+        return OFFSET;
+    }
+    return INVALID_RANGE;
+}
+
+auto RangeAllocator::Free(uint32_t offset, uint32_t count) -> void {
+    if (count == 0) {
+        return;
+    }
+    if (offset > m_Size || count > m_Size - offset) {
+        LOG_CORE_WARN(
+            "RangeAllocator::Free >>> range [{0}, {1}) is out of bounds",
+            offset, static_cast<uint64_t>(offset) + count);
+        return;
+    }
+
+    auto next = m_FreeRanges.lower_bound(offset);
+    if (next != m_FreeRanges.end() && next->first < offset + count) {
+        LOG_CORE_WARN(
+            "RangeAllocator::Free >>> range [{0}, {1}) was already released",
+            offset, offset + count);
+        return;
+    }
+    // Merge with the free ranges right before and after the released one
+    if (next != m_FreeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second > offset) {
+            LOG_CORE_WARN(
+                "RangeAllocator::Free >>> range [{0}, {1}) was already "
+                "released",
+                offset, offset + count);
+            return;
+        }
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            count += prev->second;
+            m_NumFree -= prev->second;
+            m_FreeRanges.erase(prev);
+        }
+    }
+    if (next != m_FreeRanges.end() && next->first == offset + count) {
+        count += next->second;
+        m_NumFree -= next->second;
+        m_FreeRanges.erase(next);
+    }
+    m_FreeRanges[offset] = count;
+    m_NumFree += count;
+}
+
+auto RangeAllocator::Grow(uint32_t new_size) -> void {
+    if (new_size <= m_Size) {
+        return;
+    }
+    const auto OLD_SIZE = m_Size;
+    m_Size = new_size;
+    Free(OLD_SIZE, new_size - OLD_SIZE);
+}
+
+auto RangeAllocator::largest_free_range() const -> uint32_t {
+    uint32_t largest = 0;
+    for (const auto& range : m_FreeRanges) {
+        largest = std::max(largest, range.second);
+    }
+    return largest;
+}
+
+auto RangeAllocator::ToString() const -> std::string {
+    return fmt::format(
+        "<RangeAllocator\n"
+        "  size: {0}\n"
+        "  numFree: {1}\n"
+        "  numFreeRanges: {2}\n"
+        ">\n",
+        m_Size, m_NumFree, m_FreeRanges.size());
+}
+
+}  // namespace renderer
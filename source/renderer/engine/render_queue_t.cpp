@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/render_queue_t.hpp>
+
+namespace renderer {
+
+namespace {
+constexpr uint64_t PASS_SHIFT = 62;
+constexpr uint64_t TRANSLUCENT_SHIFT = 61;
+constexpr uint64_t PASS_MASK = 0x3;
+constexpr uint64_t PROGRAM_MASK = MAX_RENDER_KEY_PROGRAM;
+constexpr uint64_t ID_MASK = MAX_RENDER_KEY_ID;
+constexpr uint64_t DEPTH_MASK = MAX_DEPTH_BUCKET;
+
+// Opaque layout: | program 8 | material 16 | vao 16 | depth 21 |
+constexpr uint64_t OPAQUE_PROGRAM_SHIFT = 53;
+constexpr uint64_t OPAQUE_MATERIAL_SHIFT = 37;
+constexpr uint64_t OPAQUE_VAO_SHIFT = 21;
+
+// Translucent layout: | ~depth 21 | program 8 | material 16 | vao 16 |
+constexpr uint64_t TRANSLUCENT_DEPTH_SHIFT = 40;
+constexpr uint64_t TRANSLUCENT_PROGRAM_SHIFT = 32;
+constexpr uint64_t TRANSLUCENT_MATERIAL_SHIFT = 16;
+
+constexpr size_t RADIX_BITS = 8;
+constexpr size_t RADIX_SIZE = 1 << RADIX_BITS;
+constexpr size_t NUM_DIGITS = 64 / RADIX_BITS;
+}  // namespace
+
+auto MakeRenderKey(const RenderKeyFields& fields) -> uint64_t {
+    const auto PASS = static_cast<uint64_t>(fields.pass) & PASS_MASK;
+    const auto PROGRAM = fields.program & PROGRAM_MASK;
+    const auto MATERIAL = fields.material & ID_MASK;
+    const auto VAO = fields.vao & ID_MASK;
+    const auto DEPTH = std::min(fields.depth, MAX_DEPTH_BUCKET) & DEPTH_MASK;
+
+    auto key = PASS << PASS_SHIFT;
+    if (!fields.translucent) {
+        return key | (PROGRAM << OPAQUE_PROGRAM_SHIFT) |
+               (MATERIAL << OPAQUE_MATERIAL_SHIFT) | (VAO << OPAQUE_VAO_SHIFT) |
+               DEPTH;
+    }
+    // Far draws get the smaller keys, so they're blended first
+    key |= 1ULL << TRANSLUCENT_SHIFT;
+    return key | ((DEPTH_MASK - DEPTH) << TRANSLUCENT_DEPTH_SHIFT) |
+           (PROGRAM << TRANSLUCENT_PROGRAM_SHIFT) |
+           (MATERIAL << TRANSLUCENT_MATERIAL_SHIFT) | VAO;
+}
+
+auto DecodeRenderKey(uint64_t key) -> RenderKeyFields {
+    RenderKeyFields fields;
+    fields.pass = static_cast<eRenderPass>((key >> PASS_SHIFT) & PASS_MASK);
+    fields.translucent = ((key >> TRANSLUCENT_SHIFT) & 1) != 0;
+    if (!fields.translucent) {
+        fields.program =
+            static_cast<uint32_t>((key >> OPAQUE_PROGRAM_SHIFT) & PROGRAM_MASK);
+        fields.material =
+            static_cast<uint32_t>((key >> OPAQUE_MATERIAL_SHIFT) & ID_MASK);
+        fields.vao = static_cast<uint32_t>((key >> OPAQUE_VAO_SHIFT) & ID_MASK);
+        fields.depth = static_cast<uint32_t>(key & DEPTH_MASK);
+        return fields;
+    }
+    fields.depth = static_cast<uint32_t>(
+        DEPTH_MASK - ((key >> TRANSLUCENT_DEPTH_SHIFT) & DEPTH_MASK));
+    fields.program = static_cast<uint32_t>(
+        (key >> TRANSLUCENT_PROGRAM_SHIFT) & PROGRAM_MASK);
+    fields.material =
+        static_cast<uint32_t>((key >> TRANSLUCENT_MATERIAL_SHIFT) & ID_MASK);
+    fields.vao = static_cast<uint32_t>(key & ID_MASK);
+    return fields;
+}
+
+auto ComputeDepthBucket(float depth, float near, float far) -> uint32_t {
+    if (!(far > near)) {
+        return 0;
+    }
+    const auto NORMALIZED = std::min(
+        std::max((depth - near) / (far - near), 0.0F), 1.0F);
+    return static_cast<uint32_t>(
+        std::lround(NORMALIZED * static_cast<float>(MAX_DEPTH_BUCKET)));
+}
+
+auto RenderStateChanges::ToString() const -> std::string {
+    return fmt::format(
+        "<RenderStateChanges\n"
+        "  numProgramChanges: {0}\n"
+        "  numMaterialChanges: {1}\n"
+        "  numVaoChanges: {2}\n"
+        ">\n",
+        num_program_changes, num_material_changes, num_vao_changes);
+}
+
+auto RenderQueue::Reserve(size_t capacity) -> void {
+    m_Entries.reserve(capacity);
+    m_Scratch.reserve(capacity);
+}
+
+auto RenderQueue::Sort() -> void {
+    const auto NUM_ENTRIES = m_Entries.size();
+    if (NUM_ENTRIES < 2) {
+        return;
+    }
+
+    // Gather the histograms of all digits in a single pass over the keys
+    std::array<std::array<size_t, RADIX_SIZE>, NUM_DIGITS> histograms{};
+    for (const auto& entry : m_Entries) {
+        for (size_t digit = 0; digit < NUM_DIGITS; ++digit) {
+            const auto BUCKET =
+                (entry.key >> (digit * RADIX_BITS)) & (RADIX_SIZE - 1);
+            ++histograms[digit][BUCKET];
+        }
+    }
+
+    // LSD radix sort, skipping the digits all keys have in common (e.g. the
+    // pass, or the depth bits of translucent draws when there are none)
+    m_Scratch.resize(NUM_ENTRIES);
+    for (size_t digit = 0; digit < NUM_DIGITS; ++digit) {
+        auto& histogram = histograms[digit];
+        const auto SHIFT = digit * RADIX_BITS;
+        const auto FIRST_BUCKET =
+            (m_Entries.front().key >> SHIFT) & (RADIX_SIZE - 1);
+        if (histogram[FIRST_BUCKET] == NUM_ENTRIES) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto& count : histogram) {
+            const auto COUNT = count;
+            count = offset;
+            offset += COUNT;
+        }
+        for (const auto& entry : m_Entries) {
+            const auto BUCKET = (entry.key >> SHIFT) & (RADIX_SIZE - 1);
+            m_Scratch[histogram[BUCKET]++] = entry;
+        }
+        m_Entries.swap(m_Scratch);
+    }
+}
+
+auto RenderQueue::CountStateChanges() const -> RenderStateChanges {
+    RenderStateChanges changes;
+    if (m_Entries.empty()) {
+        return changes;
+    }
+    changes.num_program_changes = 1;
+    changes.num_material_changes = 1;
+    changes.num_vao_changes = 1;
+    auto previous = DecodeRenderKey(m_Entries.front().key);
+    for (size_t i = 1; i < m_Entries.size(); ++i) {
+        const auto FIELDS = DecodeRenderKey(m_Entries[i].key);
+        const bool PROGRAM_CHANGED = FIELDS.program != previous.program;
+        changes.num_program_changes += PROGRAM_CHANGED ? 1 : 0;
+        // Binding a program resets the material uniforms
+        changes.num_material_changes +=
+            (PROGRAM_CHANGED || FIELDS.material != previous.material) ? 1 : 0;
+        changes.num_vao_changes += (FIELDS.vao != previous.vao) ? 1 : 0;
+        previous = FIELDS;
+    }
+    return changes;
+}
+
+auto RenderQueue::ToString() const -> std::string {
+    return fmt::format(
+        "<RenderQueue\n"
+        "  numEntries: {0}\n"
+        ">\n",
+        m_Entries.size());
+}
+
+}  // namespace renderer
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <string>
 
 #include <spdlog/fmt/bundled/format.h>
 
+#include <renderer/engine/mesh_t.hpp>
 #include <renderer/engine/renderer_t.hpp>
 
 namespace renderer {
@@ -11,8 +13,179 @@ auto IRenderer::ToString() const -> std::string {
         "<IRenderer\n"
         "  enabled: {0}\n"
         "  debugEnabled: {1}\n"
+        "  occlusionCulling: {2}\n"
+        "  lodSettings: {3}\n"
+        "  shadowSettings: {4}\n"
+        "  lightClusterSettings: {5}\n"
         ">\n",
-        m_Enabled, m_DebugEnabled);
+        m_Enabled, m_DebugEnabled, m_OcclusionCulling,
+        m_LodSettings.ToString(), m_ShadowSettings.ToString(),
+        m_LightClusterSettings.ToString());
+}
+
+auto IRenderer::_CullScene(const Scene& scene, const Camera& camera) -> void {
+    const auto& bounds = scene.bounds_array();
+    const auto& leaves = scene.bvh().leaves();
+    m_Visibility.resize(bounds.size());
+    const auto PARAMS = camera.ComputeCullingParams(m_MinScreenSize);
+    const auto STATS = CullBounds(PARAMS, bounds, m_Visibility.data());
+
+    for (size_t i = 0; i < m_Visibility.size(); ++i) {
+        if (m_Visibility[i] != 0 &&
+            (!leaves[i].object->visible() ||
+             (leaves[i].object->layers() & camera.culling_mask) == 0)) {
+            m_Visibility[i] = 0;
+        }
+    }
+
+    size_t num_occlusion_culled = 0;
+    m_Stats.num_occluders = 0;
+    if (m_OcclusionCulling) {
+        num_occlusion_culled = _CullOccluded(scene, camera, PARAMS);
+    }
+
+    m_VisibleObjects.clear();
+    for (size_t i = 0; i < m_Visibility.size(); ++i) {
+        if (m_Visibility[i] != 0) {
+            m_VisibleObjects.push_back(leaves[i].object);
+        }
+    }
+
+    m_Stats.num_objects = scene.bvh().num_objects();
+    m_Stats.num_visible = m_VisibleObjects.size();
+    m_Stats.num_frustum_culled = STATS.num_frustum_culled;
+    m_Stats.num_size_culled = STATS.num_size_culled;
+    m_Stats.num_occlusion_culled = num_occlusion_culled;
+}
+
+auto IRenderer::_CullOccluded(const Scene& scene, const Camera& camera,
+                              const CullingParams& params) -> size_t {
+    if (m_OcclusionBuffer == nullptr) {
+        m_OcclusionBuffer = std::make_unique<OcclusionBuffer>();
+    }
+    const auto& leaves = scene.bvh().leaves();
+    m_OcclusionBuffer->Begin(camera);
+
+    // Occluders are picked among the visible meshes: the flagged ones, and
+    // the ones that are both large on screen and cheap to rasterize
+    auto occluder_params = params;
+    occluder_params.min_screen_size = m_OccluderMinScreenSize;
+    m_OcclusionTests.assign(m_Visibility.begin(), m_Visibility.end());
+    m_Occluders.clear();
+    for (size_t i = 0; i < m_Visibility.size(); ++i) {
+        const auto* object = leaves[i].object;
+        if (m_Visibility[i] == 0 || object->type() != eObjectType::MESH) {
+            continue;
+        }
+        const auto* mesh = static_cast<const Mesh*>(object);
+        const auto& geometry = mesh->geometry();
+        if (geometry == nullptr) {
+            continue;
+        }
+        if (!mesh->occluder()) {
+            const auto NUM_TRIANGLES =
+                (geometry->indices != nullptr)
+                    ? geometry->indices->num_indices() / 3
+                    : geometry->num_vertices() / 3;
+            if (NUM_TRIANGLES > MAX_AUTO_OCCLUDER_TRIANGLES ||
+                !occluder_params.PassesScreenSize(leaves[i].bounds)) {
+                continue;
+            }
+        }
+        m_OcclusionBuffer->AddOccluder(object->world_transform(), *geometry);
+        // An occluder would always be hidden behind itself, so it's not tested
+        m_OcclusionTests[i] = 0;
+        m_Occluders.push_back(i);
+    }
+    m_OcclusionBuffer->Rasterize(m_ThreadPool);
+    m_Stats.num_occluders = m_OcclusionBuffer->stats().num_occluders;
+
+    const auto NUM_CULLED = m_OcclusionBuffer->TestBounds(
+        scene.bounds_array(), m_OcclusionTests.data(), m_ThreadPool);
+    if (NUM_CULLED == 0) {
+        return 0;
+    }
+    for (const auto INDEX : m_Occluders) {
+        m_OcclusionTests[INDEX] = 1;
+    }
+    for (size_t i = 0; i < m_Visibility.size(); ++i) {
+        m_Visibility[i] &= m_OcclusionTests[i];
+    }
+    return NUM_CULLED;
+}
+
+auto IRenderer::_SyncDrawList(const Scene& scene) -> void {
+    m_DrawList.Sync(scene);
+    m_Stats.num_draw_items = m_DrawList.items().size();
+    m_Stats.num_changes_applied = m_DrawList.num_changes_applied();
+    m_Stats.num_transforms_patched = m_DrawList.dirty_slots().size();
+}
+
+auto IRenderer::_SelectLod(const DrawItem& item, const LodView& view)
+    -> uint32_t {
+    const auto& geometry = static_cast<const Mesh*>(item.object)->geometry();
+    if (geometry == nullptr || geometry->num_lods() == 1) {
+        return 0;
+    }
+    if (item.slot >= m_LodLevels.size()) {
+        m_LodLevels.resize(m_DrawList.num_slots(), 0);
+    }
+    // Slots reused by other meshes start from a stale level, which the
+    // selection moves away from right away if needed
+    const auto LEVEL = SelectLod(*geometry, item.object->world_bounds(), view,
+                                 m_LodLevels[item.slot], m_LodSettings);
+    m_LodLevels[item.slot] = static_cast<uint8_t>(LEVEL);
+    return LEVEL;
+}
+
+auto IRenderer::_UpdateShadowCascades(const Scene& scene,
+                                      const Camera& camera) -> const Light* {
+    const Light* light = nullptr;
+    for (const auto& candidate : scene.lights()) {
+        if (m_ShadowSettings.enabled && candidate != nullptr &&
+            candidate->type == eLightType::DIRECTIONAL) {
+            light = candidate.get();
+            break;
+        }
+    }
+    if (light == nullptr) {
+        // Changes of the casters aren't tracked meanwhile, so the layers get
+        // redrawn from scratch once the shadows come back
+        m_ShadowCache.InvalidateAll();
+        return nullptr;
+    }
+
+    const auto FAR =
+        std::min(m_ShadowSettings.max_distance, camera.data.far);
+    const auto NUM_CASCADES = std::clamp<uint32_t>(
+        m_ShadowSettings.num_cascades, 1,
+        static_cast<uint32_t>(MAX_SHADOW_CASCADES));
+    const auto SPLITS =
+        ComputeCascadeSplits(camera.data.near, FAR, NUM_CASCADES,
+                             m_ShadowSettings.split_lambda);
+    m_ShadowCascades.clear();
+    for (uint32_t i = 0; i < NUM_CASCADES; ++i) {
+        m_ShadowCascades.push_back(
+            ComputeShadowCascade(camera, light->direction, SPLITS.at(i),
+                                 SPLITS.at(i + 1), m_ShadowSettings));
+    }
+    // Cascades that moved get invalidated first, so the changes of the
+    // casters are only tested against the layers that are still valid
+    m_ShadowCache.SetCascades(m_ShadowCascades);
+    m_ShadowCache.SyncCasters(m_DrawList);
+    return light;
+}
+
+auto IRenderer::_UpdateLightClusters(const Scene& scene, const Camera& camera)
+    -> void {
+    if (!m_LightClusterSettings.enabled) {
+        m_LightClusters.Clear();
+    } else {
+        m_LightClusters.Build(camera, scene.lights(), m_LightClusterSettings,
+                              m_ThreadPool);
+    }
+    m_Stats.num_clustered_lights = m_LightClusters.lights().size();
+    m_Stats.num_light_assignments = m_LightClusters.indices().size();
 }
 
 }  // namespace renderer
@@ -0,0 +1,18 @@
+#include <string>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/scene_snapshot_t.hpp>
+
+namespace renderer {
+
+auto PoseSnapshot::ToString() const -> std::string {
+    return fmt::format(
+        "<PoseSnapshot\n"
+        "  step: {0}\n"
+        "  numObjects: {1}\n"
+        ">\n",
+        step, handles.size());
+}
+
+}  // namespace renderer
@@ -1,37 +1,126 @@
+#include <algorithm>
+#include <array>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <utils/logging.hpp>
 
 #include <spdlog/fmt/bundled/format.h>
 
+#include <renderer/engine/mesh_t.hpp>
 #include <renderer/engine/scene_t.hpp>
 
 namespace renderer {
 
-Scene::Scene() : Object3D("scene") {}
+auto MakePose(const float* positions, const float* quats, size_t index)
+    -> Pose {
+    Pose pose(Vec3(0.0F, 0.0F, 0.0F), Quat());
+    if (positions != nullptr) {
+        const auto* pos = positions + 3 * index;
+        pose.position = Vec3(pos[0], pos[1], pos[2]);
+    }
+    if (quats != nullptr) {
+        const auto* quat = quats + 4 * index;
+        pose.orientation = Quat(quat[0], quat[1], quat[2], quat[3]);
+    }
+    return pose;
+}
 
-auto Scene::AddChild(Object3D::ptr obj) -> void {
-    if (m_Name2Id.find(obj->name()) != m_Name2Id.end()) {
+Scene::Scene() : Object3D("scene") {
+    m_ObjectsPool = std::make_shared<ObjectPool>();
+}
+
+auto Scene::AddChild(Object3D::ptr obj) -> void { AddObject(std::move(obj)); }
+
+auto Scene::AddObject(Object3D::ptr obj) -> ObjectHandle {
+    if (obj == nullptr) {
+        LOG_CORE_WARN("Scene::AddObject >>> received a nullptr object");
+        return {};
+    }
+
+    const auto NAME_ID = obj->name_id();
+    if (m_Name2Handle.find(NAME_ID) != m_Name2Handle.end()) {
         LOG_CORE_WARN(
-            "Scene::AddChild >>> object \"{0}\" already exists in the scene. "
+            "Scene::AddObject >>> object \"{0}\" already exists in the scene. "
             "Won't add to avoid duplicates",
             obj->name());
-        return;
+        return {};
     }
 
-    auto obj_name = obj->name();
     obj->parent = shared_from_this();
-    this->children.push_back(std::move(obj));
-    m_Name2Id[obj_name] = this->children.size() - 1;
+    obj->MarkTransformDirty();
+    obj->_AttachJournal(&m_ChangeJournal);
+    m_Children.push_back(obj);
+    auto handle = m_Objects.Insert(std::move(obj));
+    m_Name2Handle[NAME_ID] = handle;
+    return handle;
+}
+
+auto Scene::SetPoses(const ObjectHandle* handles, size_t num_objects,
+                     const float* positions, const float* quats) -> size_t {
+    size_t num_updated = 0;
+    for (size_t i = 0; i < num_objects; ++i) {
+        auto* obj = m_Objects.Get(handles[i]);
+        if (obj == nullptr) {
+            continue;
+        }
+        (*obj)->SetPose(MakePose(positions, quats, i));
+        ++num_updated;
+    }
+    return num_updated;
+}
+
+auto Scene::GetPoses(const ObjectHandle* handles, size_t num_objects,
+                     float* positions, float* quats) const -> size_t {
+    size_t num_found = 0;
+    for (size_t i = 0; i < num_objects; ++i) {
+        const auto* obj = m_Objects.Get(handles[i]);
+        if (obj == nullptr) {
+            continue;
+        }
+        const auto& pose = (*obj)->pose();
+        for (uint32_t k = 0; k < 3; ++k) {
+            positions[3 * i + k] = pose.position[k];
+        }
+        quats[4 * i + 0] = pose.orientation.w();
+        quats[4 * i + 1] = pose.orientation.x();
+        quats[4 * i + 2] = pose.orientation.y();
+        quats[4 * i + 3] = pose.orientation.z();
+        ++num_found;
+    }
+    return num_found;
+}
+
+auto Scene::AddLight(Light::ptr light) -> void {
+    if (light == nullptr || std::find(m_Lights.begin(), m_Lights.end(),
+                                      light) != m_Lights.end()) {
+        return;
+    }
+    m_Lights.push_back(std::move(light));
+}
+
+auto Scene::RemoveLight(const Light::ptr& light) -> void {
+    m_Lights.erase(std::remove(m_Lights.begin(), m_Lights.end(), light),
+                   m_Lights.end());
+}
+
+auto Scene::ExistsChild(std::string_view name) const -> bool {
+    return ExistsChild(NameTable::Find(name));
+}
+
+auto Scene::ExistsChild(NameId name_id) const -> bool {
+    return m_Name2Handle.find(name_id) != m_Name2Handle.end();
 }
 
-auto Scene::ExistsChild(const std::string& name) -> bool {
-    return m_Name2Id.find(name) != m_Name2Id.end();
+auto Scene::ExistsChild(ObjectHandle handle) const -> bool {
+    return m_Objects.Contains(handle);
 }
 
-auto Scene::RemoveChild(const std::string& name) -> void {
-    if (!ExistsChild(name)) {
+auto Scene::RemoveChild(std::string_view name) -> void {
+    auto it_handle = m_Name2Handle.find(NameTable::Find(name));
+    if (it_handle == m_Name2Handle.end()) {
         LOG_CORE_WARN(
             "Scene::RemoveChild >>> object with name \"{0}\" doesn't "
             "exists in scene. Won't remove anything for the moment",
@@ -39,44 +128,291 @@ auto Scene::RemoveChild(const std::string& name) -> void {
         return;
     }
 
-    auto obj_idx = m_Name2Id.at(name);
-    this->children.erase(this->children.begin() +
-                         static_cast<int64_t>(obj_idx));
-    m_Name2Id.erase(name);
-    for (auto& [obj_name, idx] : m_Name2Id) {
-        if (idx > obj_idx) {
-            idx--;
-        }
+    RemoveChild(it_handle->second);
+}
+
+auto Scene::RemoveChild(ObjectHandle handle) -> void {
+    if (!m_Objects.Contains(handle)) {
+        LOG_CORE_WARN(
+            "Scene::RemoveChild >>> handle {0} doesn't reference an object in "
+            "the scene. Won't remove anything for the moment",
+            handle.ToString());
+        return;
+    }
+
+    // Mirror the swap-and-pop done by the slot-map on the children container
+    const auto OBJ_IDX = m_Objects.dense_index(handle);
+    auto& obj = m_Children[OBJ_IDX];
+    obj->parent.reset();
+    obj->_DetachJournal();
+    _RemoveFromBvh(*obj);
+    m_Name2Handle.erase(obj->name_id());
+    if (OBJ_IDX != m_Children.size() - 1) {
+        obj = std::move(m_Children.back());
     }
+    m_Children.pop_back();
+    m_Objects.Remove(handle);
 }
 
-auto Scene::GetChild(const std::string& name) -> Object3D::ptr {
-    if (!ExistsChild(name)) {
+auto Scene::GetChild(std::string_view name) -> Object3D::ptr {
+    return GetChild(NameTable::Find(name));
+}
+
+auto Scene::GetChild(NameId name_id) -> Object3D::ptr {
+    auto it_handle = m_Name2Handle.find(name_id);
+    if (it_handle == m_Name2Handle.end()) {
         return nullptr;
     }
+    return GetChild(it_handle->second);
+}
 
-    auto obj_idx = m_Name2Id.at(name);
-    if (obj_idx >= this->children.size()) {
+auto Scene::GetChild(ObjectHandle handle) -> Object3D::ptr {
+    auto* obj = m_Objects.Get(handle);
+    return (obj != nullptr) ? *obj : nullptr;
+}
+
+auto Scene::GetHandle(std::string_view name) const -> ObjectHandle {
+    return GetHandle(NameTable::Find(name));
+}
+
+auto Scene::GetHandle(NameId name_id) const -> ObjectHandle {
+    auto it_handle = m_Name2Handle.find(name_id);
+    return (it_handle != m_Name2Handle.end()) ? it_handle->second
+                                              : ObjectHandle{};
+}
+
+auto Scene::UpdateWorldTransforms() -> void {
+    // The scene is the root of the hierarchy, so its pose is already given
+    // respect to the world frame
+    m_BoundsChanges.buckets.resize(1);
+    UpdateWorldTransform(Mat4::Identity(), false, nullptr, &m_BoundsChanges);
+    _SyncBvh();
+}
+
+auto Scene::UpdateWorldTransforms(ThreadPool& pool) -> void {
+    m_BoundsChanges.buckets.resize(pool.num_workers() + 1);
+    const bool WORLD_CHANGED = m_TransformDirty;
+    if (!WORLD_CHANGED && !m_SubtreeDirty) {
+        _SyncBvh();
+        return;
+    }
+
+    if (WORLD_CHANGED) {
+        m_WorldTransform = ComputeTransformMatrix(m_Pose);
+        m_TransformDirty = false;
+    }
+    m_SubtreeDirty = false;
+
+    // The children of the scene are usually the roots of independent bodies
+    // (e.g. robots), so these are always split, using a few tasks per thread
+    // to let the workers balance uneven subtrees by stealing
+    constexpr size_t TASKS_PER_THREAD = 4;
+    const auto NUM_THREADS = pool.num_workers() + 1;
+    const auto GRAIN = std::max<size_t>(
+        1, m_Children.size() / (TASKS_PER_THREAD * NUM_THREADS));
+    pool.ParallelFor(m_Children.size(), GRAIN,
+                     [&](size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; ++i) {
+                             m_Children[i]->UpdateWorldTransform(
+                                 m_WorldTransform, WORLD_CHANGED, &pool,
+                                 &m_BoundsChanges);
+                         }
+                     });
+    _SyncBvh();
+}
+
+auto Scene::_SyncBvh() -> void {
+    for (auto& bucket : m_BoundsChanges.buckets) {
+        for (auto* obj : bucket) {
+            if (obj->m_BvhLeaf == INVALID_BVH_LEAF) {
+                obj->m_BvhLeaf = m_Bvh.Insert(obj, obj->m_WorldBounds);
+            } else {
+                m_Bvh.Update(obj->m_BvhLeaf, obj->m_WorldBounds);
+            }
+            m_BoundsArray.Set(obj->m_BvhLeaf, obj->m_WorldBounds);
+            obj->_RecordChange(eSceneChange::POSE_CHANGED);
+        }
+        bucket.clear();
+    }
+    m_Bvh.Commit();
+}
+
+auto Scene::_RemoveFromBvh(Object3D& obj) -> void {
+    if (obj.m_BvhLeaf != INVALID_BVH_LEAF) {
+        m_Bvh.Remove(obj.m_BvhLeaf);
+        m_BoundsArray.Set(obj.m_BvhLeaf, AABB());
+        obj.m_BvhLeaf = INVALID_BVH_LEAF;
+    }
+    for (auto& child : obj.m_Children) {
+        _RemoveFromBvh(*child);
+    }
+}
+
+auto Scene::ApplySnapshot(const PoseSnapshot& snapshot) -> size_t {
+    size_t num_applied = 0;
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        auto* obj = m_Objects.Get(snapshot.handles[i]);
+        if (obj == nullptr) {
+            continue;
+        }
+        (*obj)->SetPose(snapshot.poses[i]);
+        (*obj)->SetVisible(snapshot.visible[i] != 0);
+        ++num_applied;
+    }
+    return num_applied;
+}
+
+auto Scene::ApplyLatestSnapshot() -> bool {
+    if (!m_Snapshots.Acquire()) {
+        return false;
+    }
+    ApplySnapshot(m_Snapshots.front());
+    return true;
+}
+
+auto Scene::CullCameras(const Camera* const* cameras, size_t num_cameras,
+                        float min_screen_size,
+                        MultiViewVisibility& result) const -> void {
+    if (num_cameras > MAX_CULLING_VIEWS) {
         LOG_CORE_WARN(
-            "Scene::GetChild >>> object {0} has index out of range {1} "
-            "/ {2}",
-            name, obj_idx, this->children.size());
-        return nullptr;
+            "Scene::CullCameras >>> got {0} cameras, but at most {1} are "
+            "supported. Only the first {1} cameras are used",
+            num_cameras, MAX_CULLING_VIEWS);
+        num_cameras = MAX_CULLING_VIEWS;
     }
+    std::array<CullingParams, MAX_CULLING_VIEWS> views;
+    for (size_t i = 0; i < num_cameras; ++i) {
+        views[i] = cameras[i]->ComputeCullingParams(min_screen_size);
+    }
+    CullBvhMultiView(m_Bvh, views.data(), num_cameras, result);
+}
+
+auto Scene::CullCameras(const std::vector<Camera::ptr>& cameras,
+                        float min_screen_size,
+                        MultiViewVisibility& result) const -> void {
+    std::vector<const Camera*> cameras_ptrs;
+    cameras_ptrs.reserve(cameras.size());
+    for (const auto& camera : cameras) {
+        cameras_ptrs.push_back(camera.get());
+    }
+    CullCameras(cameras_ptrs.data(), cameras_ptrs.size(), min_screen_size,
+                result);
+}
 
-    return this->children[static_cast<size_t>(obj_idx)];
+auto Scene::Raycast(const Vec3& origin, const Vec3& direction,
+                    float max_distance) const -> RaycastHit {
+    return Raycast(Ray{origin, ::math::normalize<float>(direction)},
+                   max_distance);
+}
+
+auto Scene::Raycast(const Ray& ray, float max_distance) const -> RaycastHit {
+    std::vector<uint32_t> stack;
+    return _Raycast(ray, max_distance, stack);
+}
+
+auto Scene::RaycastBatch(const Ray* rays, size_t num_rays, RaycastHit* hits,
+                         float max_distance, ThreadPool* pool) const -> void {
+    auto cast_range = [&](size_t begin, size_t end) {
+        std::vector<uint32_t> stack;
+        for (size_t i = begin; i < end; ++i) {
+            hits[i] = _Raycast(rays[i], max_distance, stack);
+        }
+    };
+
+    if (pool == nullptr) {
+        cast_range(0, num_rays);
+        return;
+    }
+    constexpr size_t RAYS_PER_TASK = 64;
+    pool->ParallelFor(num_rays, RAYS_PER_TASK, cast_range);
+}
+
+auto Scene::_Raycast(const Ray& ray, float max_distance,
+                     std::vector<uint32_t>& stack) const -> RaycastHit {
+    RaycastHit hit;
+    const auto& nodes = m_Bvh.nodes();
+    const auto& leaves = m_Bvh.leaves();
+    if (m_Bvh.root() == INVALID_BVH_NODE) {
+        return hit;
+    }
+
+    const auto INV_DIR = InverseDirection(ray.direction);
+    float closest = max_distance;
+    stack.clear();
+    stack.push_back(m_Bvh.root());
+    while (!stack.empty()) {
+        const auto& node = nodes[stack.back()];
+        stack.pop_back();
+        if (IntersectRayAABB(ray.origin, INV_DIR, node.bounds, closest) <
+            0.0F) {
+            continue;
+        }
+
+        if (!node.is_leaf()) {
+            // Visit the closest child first, so farther ones get pruned sooner
+            const float T_LEFT = IntersectRayAABB(
+                ray.origin, INV_DIR, nodes[node.left].bounds, closest);
+            const float T_RIGHT = IntersectRayAABB(
+                ray.origin, INV_DIR, nodes[node.right].bounds, closest);
+            const bool LEFT_FIRST = (T_RIGHT < 0.0F) ||
+                                    (T_LEFT >= 0.0F && T_LEFT <= T_RIGHT);
+            stack.push_back(LEFT_FIRST ? node.right : node.left);
+            stack.push_back(LEFT_FIRST ? node.left : node.right);
+            continue;
+        }
+
+        auto* object = leaves[node.leaf].object;
+        if (object == nullptr || object->type() != eObjectType::MESH) {
+            continue;
+        }
+        const auto& geometry = static_cast<const Mesh*>(object)->geometry();
+        if (geometry == nullptr) {
+            continue;
+        }
+
+        // Bring the ray into the frame of the mesh. World transforms are rigid,
+        // so the inverse is just (R^T, -R^T p), and distances are preserved
+        const auto& world = object->world_transform();
+        const auto DELTA = ray.origin - Vec3(world(0, 3), world(1, 3),
+                                             world(2, 3));
+        Ray local_ray;
+        for (uint32_t col = 0; col < 3; ++col) {
+            local_ray.origin[col] = world(0, col) * DELTA.x() +
+                                    world(1, col) * DELTA.y() +
+                                    world(2, col) * DELTA.z();
+            local_ray.direction[col] = world(0, col) * ray.direction.x() +
+                                       world(1, col) * ray.direction.y() +
+                                       world(2, col) * ray.direction.z();
+        }
+
+        float distance = closest;
+        uint32_t triangle = INVALID_TRIANGLE;
+        if (geometry->triangle_bvh().Intersect(local_ray, closest, distance,
+                                               triangle)) {
+            closest = distance;
+            hit.object = object;
+            hit.triangle = triangle;
+        }
+    }
+
+    if (hit.hit()) {
+        hit.distance = closest;
+        hit.point = ray.At(closest);
+    }
+    return hit;
 }
 
-auto Scene::operator[](const char* name) -> Object3D::ptr {
-    return GetChild(name);
+auto Scene::operator[](std::string_view name) -> Object3D::ptr {
+    return GetChild(NameTable::Find(name));
 }
 
 auto Scene::ToString() const -> std::string {
     return fmt::format(
         "<Scene\n"
         "  children: {0}\n"
-        "?\n",
-        this->children.size());
+        "  lights: {1}\n"
+        ">\n",
+        m_Children.size(), m_Lights.size());
 }
 
 }  // namespace renderer
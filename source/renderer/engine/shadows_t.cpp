@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/shadows_t.hpp>
+
+namespace renderer {
+
+namespace {
+// Returns the half-size and the center of the projection of the given box
+// onto the given axis
+auto ProjectBounds(const Vec3& center, const Vec3& extents, const Vec3& axis)
+    -> std::pair<float, float> {
+    const auto RADIUS = std::abs(extents.x() * axis.x()) +
+                        std::abs(extents.y() * axis.y()) +
+                        std::abs(extents.z() * axis.z());
+    return {RADIUS, ::math::dot<float>(center, axis)};
+}
+
+auto SameBounds(const AABB& lhs, const AABB& rhs) -> bool {
+    return lhs.min == rhs.min && lhs.max == rhs.max;
+}
+}  // namespace
+
+auto ShadowSettings::ToString() const -> std::string {
+    return fmt::format(
+        "<ShadowSettings\n"
+        "  enabled: {0}\n"
+        "  numCascades: {1}\n"
+        "  resolution: {2}\n"
+        "  maxDistance: {3}\n"
+        "  splitLambda: {4}\n"
+        "  casterDistance: {5}\n"
+        "  depthBias: {6}\n"
+        "  slopeBias: {7}\n"
+        "  cacheStatic: {8}\n"
+        "  cacheSnapTexels: {9}\n"
+        ">\n",
+        this->enabled, this->num_cascades, this->resolution,
+        this->max_distance, this->split_lambda, this->caster_distance,
+        this->depth_bias, this->slope_bias, this->cache_static,
+        this->cache_snap_texels);
+}
+
+auto ShadowCascade::Overlaps(const AABB& bounds) const -> bool {
+    if (bounds.empty()) {
+        return false;
+    }
+    const auto CENTER = bounds.center() - this->center;
+    const auto EXTENTS = bounds.extents();
+    const auto X = ProjectBounds(CENTER, EXTENTS, this->right);
+    const auto Y = ProjectBounds(CENTER, EXTENTS, this->up);
+    const auto Z = ProjectBounds(CENTER, EXTENTS, this->front);
+    // The front axis points towards the light, where the casters are
+    return std::abs(X.second) <= this->half_size + X.first &&
+           std::abs(Y.second) <= this->half_size + Y.first &&
+           Z.second >= -this->half_depth - Z.first &&
+           Z.second <= this->half_depth + this->caster_distance + Z.first;
+}
+
+auto ShadowCascade::SameVolume(const ShadowCascade& other) const -> bool {
+    return this->cell == other.cell && this->right == other.right &&
+           this->up == other.up && this->front == other.front &&
+           this->half_size == other.half_size &&
+           this->half_depth == other.half_depth &&
+           this->caster_distance == other.caster_distance;
+}
+
+auto ComputeCascadeSplits(float near, float far, uint32_t num_cascades,
+                          float lambda)
+    -> std::array<float, MAX_SHADOW_CASCADES + 1> {
+    const auto NUM_CASCADES = std::clamp<uint32_t>(
+        num_cascades, 1, static_cast<uint32_t>(MAX_SHADOW_CASCADES));
+    // The logarithmic splits need a near distance above zero
+    const auto NEAR = std::max(near, 1e-4F);
+    const auto FAR = std::max(far, NEAR);
+    std::array<float, MAX_SHADOW_CASCADES + 1> splits{};
+    splits.fill(FAR);
+    splits[0] = NEAR;
+    for (uint32_t i = 1; i < NUM_CASCADES; ++i) {
+        const auto T = static_cast<float>(i) / static_cast<float>(NUM_CASCADES);
+        const auto LOG = NEAR * std::pow(FAR / NEAR, T);
+        const auto UNIFORM = NEAR + (FAR - NEAR) * T;
+        splits.at(i) = lambda * LOG + (1.0F - lambda) * UNIFORM;
+    }
+    return splits;
+}
+
+auto ComputeShadowCascade(const Camera& camera, const Vec3& light_direction,
+                          float split_near, float split_far,
+                          const ShadowSettings& settings) -> ShadowCascade {
+    ShadowCascade cascade;
+    cascade.split_near = split_near;
+    cascade.split_far = split_far;
+
+    // Light space, looking along the light direction like a camera looks
+    // down its -front axis
+    const auto LENGTH = ::math::norm(light_direction);
+    cascade.front = (LENGTH > 1e-6F) ? Vec3((-1.0F / LENGTH) * light_direction)
+                                     : Vec3(0.0F, 0.0F, 1.0F);
+    const Vec3 REFERENCE = (std::abs(cascade.front.z()) < 0.99F)
+                               ? Vec3(0.0F, 0.0F, 1.0F)
+                               : Vec3(1.0F, 0.0F, 0.0F);
+    cascade.right = ::math::normalize<float>(
+        ::math::cross<float>(REFERENCE, cascade.front));
+    cascade.up = ::math::cross<float>(cascade.front, cascade.right);
+
+    // Sphere around the slice of the view, centered on the view axis
+    const auto NEAR = split_near;
+    const auto FAR = std::max(split_far, split_near);
+    float center_dist = 0.0F;
+    float radius2 = 0.0F;
+    if (camera.data.projection == eProjectionType::PERSPECTIVE) {
+        const auto TAN_V =
+            std::tan(camera.data.fov * 0.5F * PI / 180.0F) / camera.zoom;
+        const auto TAN_H = camera.data.aspect * TAN_V;
+        const auto K2 = TAN_V * TAN_V + TAN_H * TAN_H;
+        // Equidistant to the corners of both ends, unless past the far end
+        center_dist = std::min(0.5F * (NEAR + FAR) * (1.0F + K2), FAR);
+        radius2 = std::max(
+            (center_dist - NEAR) * (center_dist - NEAR) + NEAR * NEAR * K2,
+            (FAR - center_dist) * (FAR - center_dist) + FAR * FAR * K2);
+    } else {
+        const auto HALF_W = 0.5F * camera.data.width / camera.zoom;
+        const auto HALF_H = 0.5F * camera.data.height / camera.zoom;
+        center_dist = 0.5F * (NEAR + FAR);
+        radius2 = 0.25F * (FAR - NEAR) * (FAR - NEAR) + HALF_W * HALF_W +
+                  HALF_H * HALF_H;
+    }
+    const Vec3 SLICE_CENTER =
+        camera.pose().position - center_dist * camera.v_front;
+    // Rounded up, so the noise of the math doesn't change the size
+    const auto RADIUS = std::ceil(std::sqrt(radius2) * 16.0F) / 16.0F;
+
+    // The map gets a margin of a snapping step on each side, so the slice
+    // stays inside of it wherever the center snaps to
+    const auto RESOLUTION = std::max<uint32_t>(settings.resolution, 16);
+    const auto MARGIN =
+        settings.cache_static
+            ? std::clamp<uint32_t>(settings.cache_snap_texels, 1,
+                                   RESOLUTION / 4)
+            : 1;
+    cascade.texel_size =
+        2.0F * RADIUS / static_cast<float>(RESOLUTION - 2 * MARGIN);
+    const auto STEP = static_cast<float>(MARGIN) * cascade.texel_size;
+    cascade.half_size = 0.5F * static_cast<float>(RESOLUTION) *
+                        cascade.texel_size;
+    cascade.half_depth = RADIUS + STEP;
+    cascade.caster_distance = std::max(settings.caster_distance, 0.0F);
+
+    const std::array<Vec3, 3> AXES = {cascade.right, cascade.up,
+                                      cascade.front};
+    cascade.center = Vec3(0.0F, 0.0F, 0.0F);
+    for (size_t i = 0; i < AXES.size(); ++i) {
+        cascade.cell.at(i) = std::llround(
+            ::math::dot<float>(SLICE_CENTER, AXES.at(i)) / STEP);
+        cascade.center = cascade.center +
+                         (static_cast<float>(cascade.cell.at(i)) * STEP) *
+                             AXES.at(i);
+    }
+
+    // The light "camera" sits on the side of the volume towards the light,
+    // past the casters in front of it
+    const Vec3 EYE =
+        cascade.center +
+        (cascade.half_depth + cascade.caster_distance) * cascade.front;
+    for (size_t i = 0; i < AXES.size(); ++i) {
+        const auto& axis = AXES.at(i);
+        const auto ROW = static_cast<uint32_t>(i);
+        cascade.view(ROW, 0) = axis.x();
+        cascade.view(ROW, 1) = axis.y();
+        cascade.view(ROW, 2) = axis.z();
+        cascade.view(ROW, 3) = -::math::dot<float>(axis, EYE);
+    }
+    cascade.view(3, 0) = 0.0F;
+    cascade.view(3, 1) = 0.0F;
+    cascade.view(3, 2) = 0.0F;
+    cascade.view(3, 3) = 1.0F;
+    cascade.proj = Mat4::Ortho(
+        2.0F * cascade.half_size, 2.0F * cascade.half_size, 0.0F,
+        2.0F * cascade.half_depth + cascade.caster_distance);
+    return cascade;
+}
+
+auto IsShadowCaster(const DrawItem& item) -> bool {
+    // Meshes without a material get the default one, which casts shadows
+    return item.object != nullptr && item.object->visible() &&
+           (item.material == nullptr || item.material->castShadows);
+}
+
+auto IsStaticCaster(const DrawItem& item) -> bool {
+    return IsShadowCaster(item) &&
+           item.object->type() == eObjectType::MESH &&
+           static_cast<const Mesh*>(item.object)->is_static();
+}
+
+auto ShadowCache::SetCascades(const std::vector<ShadowCascade>& cascades)
+    -> void {
+    m_Valid.resize(cascades.size(), 0);
+    for (size_t i = 0; i < cascades.size(); ++i) {
+        if (m_Valid[i] != 0 && (i >= m_Cascades.size() ||
+                                !cascades[i].SameVolume(m_Cascades[i]))) {
+            m_Valid[i] = 0;
+            ++m_NumInvalidations;
+        }
+    }
+    m_Cascades = cascades;
+}
+
+auto ShadowCache::SyncCasters(const DrawList& draw_list) -> void {
+    const auto NUM_SLOTS = draw_list.num_slots();
+    if (m_Synced && m_ItemsVersion == draw_list.items_version()) {
+        // Same items, so only the slots written this frame might have moved
+        // (or changed their material)
+        for (const auto SLOT : draw_list.dirty_slots()) {
+            if (SLOT < m_SlotItems.size() && m_SlotItems[SLOT] != nullptr) {
+                _UpdateSlot(SLOT, m_SlotItems[SLOT]);
+            }
+        }
+    } else {
+        // The set of items changed, so every slot gets compared again
+        m_Synced = true;
+        m_ItemsVersion = draw_list.items_version();
+        m_SlotItems.assign(NUM_SLOTS, nullptr);
+        for (const auto& item : draw_list.items()) {
+            m_SlotItems[item.slot] = &item;
+        }
+        m_Casters.resize(std::max(m_Casters.size(), NUM_SLOTS));
+        for (size_t slot = 0; slot < m_Casters.size(); ++slot) {
+            _UpdateSlot(slot,
+                        (slot < NUM_SLOTS) ? m_SlotItems[slot] : nullptr);
+        }
+        m_Casters.resize(NUM_SLOTS);
+        // The items the list points to might have moved
+        m_DynamicCastersDirty = true;
+    }
+    _CheckMaterials();
+
+    if (m_DynamicCastersDirty) {
+        m_DynamicCastersDirty = false;
+        m_DynamicCasters.clear();
+        for (size_t slot = 0; slot < m_Casters.size(); ++slot) {
+            if (m_Casters[slot].is_dynamic) {
+                m_DynamicCasters.push_back(m_SlotItems[slot]);
+            }
+        }
+    }
+}
+
+auto ShadowCache::Invalidate(const AABB& bounds) -> void {
+    for (size_t i = 0; i < m_Cascades.size(); ++i) {
+        if (m_Valid[i] != 0 && m_Cascades[i].Overlaps(bounds)) {
+            m_Valid[i] = 0;
+            ++m_NumInvalidations;
+        }
+    }
+}
+
+auto ShadowCache::InvalidateAll() -> void {
+    for (auto& valid : m_Valid) {
+        m_NumInvalidations += (valid != 0) ? 1 : 0;
+        valid = 0;
+    }
+}
+
+auto ShadowCache::MarkValid(size_t cascade) -> void {
+    if (cascade < m_Valid.size()) {
+        m_Valid[cascade] = 1;
+    }
+}
+
+auto ShadowCache::_UpdateSlot(size_t slot, const DrawItem* item) -> void {
+    auto& caster = m_Casters[slot];
+    const Object3D* object = (item != nullptr) ? item->object : nullptr;
+    const Material* material = (item != nullptr) ? item->material : nullptr;
+    if (material != caster.material) {
+        caster.material = material;
+        m_MaterialsDirty = true;
+    }
+    caster.cast_shadows = (material == nullptr) || material->castShadows;
+    const bool IS_STATIC = (item != nullptr) && IsStaticCaster(*item);
+    const bool IS_DYNAMIC =
+        (item != nullptr) && !IS_STATIC && IsShadowCaster(*item) &&
+        !(item->object->type() == eObjectType::MESH &&
+          static_cast<const Mesh*>(item->object)->is_static());
+    if (IS_DYNAMIC != caster.is_dynamic) {
+        caster.is_dynamic = IS_DYNAMIC;
+        m_DynamicCastersDirty = true;
+    }
+    const AABB BOUNDS = (object != nullptr) ? object->world_bounds() : AABB();
+    if (object == caster.object && IS_STATIC == caster.is_static &&
+        (!IS_STATIC || SameBounds(BOUNDS, caster.bounds))) {
+        return;
+    }
+    // The shadows are gone from where the caster was, and show up where it is
+    if (caster.is_static) {
+        Invalidate(caster.bounds);
+        --m_NumStaticCasters;
+    }
+    if (IS_STATIC) {
+        Invalidate(BOUNDS);
+        ++m_NumStaticCasters;
+    }
+    caster.object = object;
+    caster.bounds = BOUNDS;
+    caster.is_static = IS_STATIC;
+}
+
+auto ShadowCache::_CheckMaterials() -> void {
+    bool changed = false;
+    if (m_MaterialsDirty) {
+        // Only the slots that changed were compared, so the others might
+        // have missed a change of their material
+        m_MaterialsDirty = false;
+        m_Materials.clear();
+        for (const auto& caster : m_Casters) {
+            if (caster.material == nullptr) {
+                continue;
+            }
+            changed = changed ||
+                      caster.cast_shadows != caster.material->castShadows;
+            m_Materials.emplace_back(caster.material, false);
+        }
+        std::sort(m_Materials.begin(), m_Materials.end());
+        m_Materials.erase(std::unique(m_Materials.begin(), m_Materials.end()),
+                          m_Materials.end());
+        for (auto& entry : m_Materials) {
+            entry.second = entry.first->castShadows;
+        }
+    } else {
+        for (auto& entry : m_Materials) {
+            if (entry.second != entry.first->castShadows) {
+                entry.second = entry.first->castShadows;
+                changed = true;
+            }
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    for (size_t slot = 0; slot < m_Casters.size(); ++slot) {
+        _UpdateSlot(slot, m_SlotItems[slot]);
+    }
+}
+
+auto ShadowCache::ToString() const -> std::string {
+    size_t num_valid = 0;
+    for (const auto VALID : m_Valid) {
+        num_valid += (VALID != 0) ? 1 : 0;
+    }
+    return fmt::format(
+        "<ShadowCache\n"
+        "  numCascades: {0}\n"
+        "  numValid: {1}\n"
+        "  numStaticCasters: {2}\n"
+        "  numInvalidations: {3}\n"
+        ">\n",
+        m_Cascades.size(), num_valid, m_NumStaticCasters, m_NumInvalidations);
+}
+
+}  // namespace renderer
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace renderer {
+
+namespace {
+/// Pool that the current thread works for (if it's a worker thread)
+thread_local const ThreadPool* t_WorkerPool = nullptr;  // NOLINT
+/// Index of the queue owned by the current thread (if it's a worker thread)
+thread_local size_t t_WorkerIndex = 0;  // NOLINT
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_workers) {
+    // The last queue is shared by all threads that aren't workers of the pool
+    for (size_t i = 0; i <= num_workers; ++i) {
+        m_Queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t i = 0; i < num_workers; ++i) {
+        m_Workers.emplace_back([this, i]() { _WorkerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Stop = true;
+    }
+    m_SleepCondition.notify_all();
+    for (auto& worker : m_Workers) {
+        worker.join();
+    }
+}
+
+auto ThreadPool::Submit(Task task) -> void {
+    const bool IS_WORKER = (t_WorkerPool == this);
+    auto& queue = IS_WORKER ? *m_Queues[t_WorkerIndex] : *m_Queues.back();
+    m_NumPending++;
+    m_NumQueued++;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        // Grab the lock to avoid missing the wakeup of a worker about to sleep
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+    }
+    m_SleepCondition.notify_one();
+}
+
+auto ThreadPool::ParallelFor(size_t count, size_t grain, const RangeTask& body)
+    -> void {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const auto NUM_CHUNKS = (count + grain - 1) / grain;
+    if (NUM_CHUNKS == 1 || m_Workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // Chunks are queued for the workers, except for the first one that is run
+    // right away by the calling thread
+    std::atomic<size_t> num_remaining{NUM_CHUNKS - 1};
+    for (size_t chunk = 1; chunk < NUM_CHUNKS; ++chunk) {
+        const auto BEGIN = chunk * grain;
+        const auto END = std::min(count, BEGIN + grain);
+        Submit([&body, &num_remaining, BEGIN, END]() {
+            body(BEGIN, END);
+            num_remaining--;
+        });
+    }
+    body(0, std::min(count, grain));
+
+    const auto QUEUE_HINT =
+        (t_WorkerPool == this) ? t_WorkerIndex : m_Queues.size() - 1;
+    while (num_remaining.load() > 0) {
+        if (!_RunPendingTask(QUEUE_HINT)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto ThreadPool::WaitIdle() -> void {
+    const auto QUEUE_HINT =
+        (t_WorkerPool == this) ? t_WorkerIndex : m_Queues.size() - 1;
+    while (m_NumPending.load() > 0) {
+        if (!_RunPendingTask(QUEUE_HINT)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto ThreadPool::_WorkerLoop(size_t worker_index) -> void {
+    t_WorkerPool = this;
+    t_WorkerIndex = worker_index;
+    while (!m_Stop) {
+        if (_RunPendingTask(worker_index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_SleepCondition.wait(
+            lock, [this]() { return m_Stop || m_NumQueued.load() > 0; });
+    }
+}
+
+auto ThreadPool::_RunPendingTask(size_t queue_hint) -> bool {
+    Task task;
+    // Our own queue first (LIFO, keeps caches warm), then steal from others
+    bool found = _PopLocal(*m_Queues[queue_hint], task);
+    for (size_t i = 1; !found && i < m_Queues.size(); ++i) {
+        found = _Steal(*m_Queues[(queue_hint + i) % m_Queues.size()], task);
+    }
+    if (!found) {
+        return false;
+    }
+    m_NumQueued--;
+    task();
+    m_NumPending--;
+    return true;
+}
+
+auto ThreadPool::_PopLocal(TaskQueue& queue, Task& task) -> bool {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+auto ThreadPool::_Steal(TaskQueue& queue, Task& task) -> bool {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+auto ThreadPool::current_thread_index() const -> size_t {
+    return (t_WorkerPool == this) ? t_WorkerIndex : m_Workers.size();
+}
+
+auto ThreadPool::ToString() const -> std::string {
+    return fmt::format(
+        "<ThreadPool\n"
+        "  numWorkers: {0}\n"
+        "  numPending: {1}\n"
+        ">\n",
+        m_Workers.size(), m_NumPending.load());
+}
+
+}  // namespace renderer
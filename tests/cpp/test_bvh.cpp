@@ -0,0 +1,196 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <renderer/engine/bvh_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+
+#include "test_helpers.hpp"
+
+namespace {
+using ::test::CreateUnitCube;
+
+auto Collect(const ::renderer::BVH& bvh, const ::renderer::AABB& box)
+    -> std::vector<::renderer::Object3D*> {
+    std::vector<::renderer::Object3D*> result;
+    bvh.Query(box, [&](::renderer::Object3D* obj) { result.push_back(obj); });
+    return result;
+}
+}  // namespace
+
+TEST_CASE("AABB operations (bvh_t)", "[bvh_t]") {
+    ::renderer::AABB box;
+    REQUIRE(box.empty());
+    box.Expand(Vec3(1.0F, 2.0F, 3.0F));
+    box.Expand(Vec3(-1.0F, 0.0F, 1.0F));
+    REQUIRE_FALSE(box.empty());
+    REQUIRE(box.surface_area() == Approx(2.0F * (4.0F + 4.0F + 4.0F)));
+
+    auto moved = box.Transformed(::renderer::ComputeTransformMatrix(
+        Pose(Vec3(10.0F, 0.0F, 0.0F), Quat())));
+    REQUIRE(moved.min.x() == Approx(9.0F));
+    REQUIRE(moved.max.x() == Approx(11.0F));
+    REQUIRE_FALSE(moved.Intersects(box));
+}
+
+TEST_CASE("Geometry and mesh bounds (bvh_t)", "[bvh_t]") {
+    auto geometry = CreateUnitCube();
+    REQUIRE(geometry->bounds().min.x() == Approx(-0.5F));
+    REQUIRE(geometry->bounds().max.z() == Approx(0.5F));
+
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto mesh = std::make_shared<::renderer::Mesh>(
+        "bounds_mesh", geometry, Pose(Vec3(0.0F, 3.0F, 0.0F), Quat()));
+    scene->AddChild(mesh);
+    scene->UpdateWorldTransforms();
+    REQUIRE(mesh->world_bounds().min.y() == Approx(2.5F));
+    REQUIRE(mesh->world_bounds().max.y() == Approx(3.5F));
+    REQUIRE(mesh->bvh_leaf() != ::renderer::INVALID_BVH_LEAF);
+}
+
+TEST_CASE("Scene BVH refit and rebuild (bvh_t)", "[bvh_t]") {
+    auto geometry = CreateUnitCube();
+    auto scene = std::make_shared<::renderer::Scene>();
+    std::vector<::renderer::Mesh::ptr> meshes;
+    constexpr size_t NUM_MESHES = 64;
+    for (size_t i = 0; i < NUM_MESHES; ++i) {
+        auto mesh = std::make_shared<::renderer::Mesh>(
+            ("bvh_mesh_" + std::to_string(i)).c_str(), geometry,
+            Pose(Vec3(2.0F * static_cast<float>(i), 0.0F, 0.0F), Quat()));
+        scene->AddChild(mesh);
+        meshes.push_back(mesh);
+    }
+    scene->UpdateWorldTransforms();
+
+    const auto& bvh = scene->bvh();
+    REQUIRE(bvh.num_objects() == NUM_MESHES);
+    REQUIRE(bvh.nodes().size() == 2 * NUM_MESHES - 1);
+    const auto NUM_REBUILDS = bvh.num_rebuilds();
+
+    SECTION("Queries only return overlapping objects") {
+        auto hits = Collect(bvh, {Vec3(3.9F, -1.0F, -1.0F),
+                                  Vec3(4.1F, 1.0F, 1.0F)});
+        REQUIRE(hits.size() == 1);
+        REQUIRE(hits[0] == meshes[2].get());
+    }
+
+    SECTION("Static scenes don't touch the tree") {
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_rebuilds() == NUM_REBUILDS);
+        REQUIRE(bvh.num_refit_nodes() == 0);
+    }
+
+    SECTION("Small motions are handled by refitting") {
+        meshes[5]->SetPosition(Vec3(10.0F, 0.2F, 0.0F));
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_rebuilds() == NUM_REBUILDS);
+        REQUIRE(bvh.num_refit_nodes() > 0);
+        REQUIRE(bvh.num_refit_nodes() < bvh.nodes().size());
+
+        auto hits = Collect(bvh, {Vec3(9.9F, 0.6F, -0.1F),
+                                  Vec3(10.1F, 0.65F, 0.1F)});
+        REQUIRE(hits.size() == 1);
+        REQUIRE(hits[0] == meshes[5].get());
+    }
+
+    SECTION("Large degradation triggers a rebuild") {
+        // Scrambling the row makes the nodes of the refit tree very loose
+        for (size_t i = 0; i < NUM_MESHES; ++i) {
+            const auto NEW_SLOT = (i * 37) % NUM_MESHES;
+            meshes[i]->SetPosition(
+                Vec3(2.0F * static_cast<float>(NEW_SLOT), 0.0F, 0.0F));
+        }
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_rebuilds() == NUM_REBUILDS + 1);
+        REQUIRE(bvh.quality() == Approx(1.0F));
+    }
+
+    SECTION("Removed objects are dropped from the tree") {
+        scene->RemoveChild(meshes[2]->name());
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_objects() == NUM_MESHES - 1);
+        REQUIRE(meshes[2]->bvh_leaf() == ::renderer::INVALID_BVH_LEAF);
+        auto hits = Collect(bvh, {Vec3(3.9F, -1.0F, -1.0F),
+                                  Vec3(4.1F, 1.0F, 1.0F)});
+        REQUIRE(hits.empty());
+    }
+
+    SECTION("Removed subtrees leave no dangling leaves") {
+        auto child = std::make_shared<::renderer::Mesh>(
+            "bvh_mesh_child", geometry,
+            Pose(Vec3(0.0F, 5.0F, 0.0F), Quat()));
+        meshes[2]->AddChild(child);
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_objects() == NUM_MESHES + 1);
+
+        std::weak_ptr<::renderer::Object3D> child_ref = child;
+        child = nullptr;
+        scene->RemoveChild(meshes[2]->name());
+        meshes.erase(meshes.begin() + 2);
+        REQUIRE(child_ref.expired());
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_objects() == NUM_MESHES - 1);
+        auto hits = Collect(bvh, {Vec3(-1000.0F, -1000.0F, -1000.0F),
+                                  Vec3(1000.0F, 1000.0F, 1000.0F)});
+        REQUIRE(hits.size() == NUM_MESHES - 1);
+        for (const auto* hit : hits) {
+            REQUIRE(std::find_if(meshes.begin(), meshes.end(),
+                                 [hit](const ::renderer::Mesh::ptr& mesh) {
+                                     return mesh.get() == hit;
+                                 }) != meshes.end());
+        }
+    }
+
+    SECTION("Added objects are inserted without a rebuild") {
+        auto added = std::make_shared<::renderer::Mesh>(
+            "bvh_mesh_added", geometry,
+            Pose(Vec3(7.0F, 3.0F, 0.0F), Quat()));
+        scene->AddChild(added);
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_rebuilds() == NUM_REBUILDS);
+        REQUIRE(bvh.num_objects() == NUM_MESHES + 1);
+        REQUIRE(bvh.quality() < bvh.rebuild_threshold());
+        auto hits = Collect(bvh, {Vec3(6.9F, 2.9F, -0.1F),
+                                  Vec3(7.1F, 3.1F, 0.1F)});
+        REQUIRE(hits.size() == 1);
+        REQUIRE(hits[0] == added.get());
+
+        // The leaf of a removed object gets reused, along with its nodes
+        scene->RemoveChild(meshes[2]->name());
+        scene->UpdateWorldTransforms();
+        auto readded = std::make_shared<::renderer::Mesh>(
+            "bvh_mesh_readded", geometry,
+            Pose(Vec3(4.0F, -3.0F, 0.0F), Quat()));
+        scene->AddChild(readded);
+        scene->UpdateWorldTransforms();
+        REQUIRE(bvh.num_rebuilds() == NUM_REBUILDS);
+        REQUIRE(bvh.nodes().size() == 2 * (NUM_MESHES + 1) - 1);
+        REQUIRE(Collect(bvh, {Vec3(3.9F, -0.1F, -0.1F),
+                              Vec3(4.1F, 0.1F, 0.1F)})
+                    .empty());
+        hits = Collect(bvh, {Vec3(3.9F, -3.1F, -0.1F),
+                             Vec3(4.1F, -2.9F, 0.1F)});
+        REQUIRE(hits.size() == 1);
+        REQUIRE(hits[0] == readded.get());
+
+        // Every leaf is still reachable from the root
+        const auto ALL = Collect(bvh, {Vec3(-1000.0F, -1000.0F, -1000.0F),
+                                       Vec3(1000.0F, 1000.0F, 1000.0F)});
+        REQUIRE(ALL.size() == NUM_MESHES + 1);
+    }
+
+    SECTION("Parallel updates report the changes as well") {
+        ::renderer::ThreadPool pool(3);
+        meshes[7]->SetPosition(Vec3(0.0F, 50.0F, 0.0F));
+        scene->UpdateWorldTransforms(pool);
+        auto hits = Collect(bvh, {Vec3(-1.0F, 49.0F, -1.0F),
+                                  Vec3(1.0F, 51.0F, 1.0F)});
+        REQUIRE(hits.size() == 1);
+        REQUIRE(hits[0] == meshes[7].get());
+    }
+}
@@ -0,0 +1,187 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/culling_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+
+#include "test_helpers.hpp"
+
+namespace {
+using ::test::CreateCamera;
+using ::test::UnitBox;
+using ::test::CreateUnitCube;
+
+// Depth (in normalized device coordinates) of the point at the given distance
+// in front of the camera
+auto ProjectedDepth(const ::renderer::Camera& camera, float distance) -> float {
+    const auto POINT = camera.pose().position - distance * camera.v_front;
+    const auto CLIP = camera.ComputeProjectionMatrix() *
+                      (camera.ComputeViewMatrix() *
+                       Vec4(POINT.x(), POINT.y(), POINT.z(), 1.0F));
+    return CLIP.z() / CLIP.w();
+}
+}  // namespace
+
+TEST_CASE("Camera frustum planes (culling_t)", "[culling_t]") {
+    auto camera = CreateCamera();
+    const auto FRUSTUM = camera->ComputeFrustum();
+
+    REQUIRE(FRUSTUM.Intersects(UnitBox(Vec3(0.0F, 0.0F, 0.0F))));
+    REQUIRE(FRUSTUM.Intersects(UnitBox(Vec3(-50.0F, 5.0F, 0.0F))));
+    // Behind the camera, beyond the far plane, and way off to the sides
+    REQUIRE_FALSE(FRUSTUM.Intersects(UnitBox(Vec3(20.0F, 0.0F, 0.0F))));
+    REQUIRE_FALSE(FRUSTUM.Intersects(UnitBox(Vec3(-200.0F, 0.0F, 0.0F))));
+    REQUIRE_FALSE(FRUSTUM.Intersects(UnitBox(Vec3(0.0F, 50.0F, 0.0F))));
+    REQUIRE_FALSE(FRUSTUM.Intersects(UnitBox(Vec3(0.0F, 0.0F, -50.0F))));
+}
+
+TEST_CASE("Reverse-z projection (culling_t)", "[culling_t]") {
+    auto camera = CreateCamera();
+    camera->data.near = 0.01F;
+    camera->data.far = 1000.0F;
+
+    SECTION("Standard depth range goes from -1 to 1") {
+        REQUIRE(ProjectedDepth(*camera, 0.01F) == Approx(-1.0F).margin(1e-4));
+        REQUIRE(ProjectedDepth(*camera, 1000.0F) == Approx(1.0F));
+    }
+
+    SECTION("Reversed depth range goes from 1 to 0") {
+        camera->data.reverse_z = true;
+        REQUIRE(ProjectedDepth(*camera, 0.01F) == Approx(1.0F).margin(1e-4));
+        REQUIRE(ProjectedDepth(*camera, 1000.0F) == Approx(0.0F).margin(1e-6));
+        REQUIRE(ProjectedDepth(*camera, 1.0F) > ProjectedDepth(*camera, 2.0F));
+    }
+
+    SECTION("Orthographic reversed depth range is linear") {
+        camera->data.projection = ::renderer::eProjectionType::ORTHOGRAPHIC;
+        camera->data.reverse_z = true;
+        REQUIRE(ProjectedDepth(*camera, 0.01F) == Approx(1.0F).margin(1e-4));
+        REQUIRE(ProjectedDepth(*camera, 500.005F) == Approx(0.5F));
+        REQUIRE(ProjectedDepth(*camera, 1000.0F) == Approx(0.0F).margin(1e-6));
+    }
+
+    SECTION("Frustum planes don't depend on the depth range") {
+        camera->data.reverse_z = true;
+        const auto FRUSTUM = camera->ComputeFrustum();
+        REQUIRE(FRUSTUM.Intersects(UnitBox(Vec3(-500.0F, 0.0F, 0.0F))));
+        REQUIRE_FALSE(FRUSTUM.Intersects(UnitBox(Vec3(20.0F, 0.0F, 0.0F))));
+        REQUIRE_FALSE(
+            FRUSTUM.Intersects(UnitBox(Vec3(-1200.0F, 0.0F, 0.0F))));
+    }
+}
+
+TEST_CASE("Batched culling of bounds (culling_t)", "[culling_t]") {
+    auto camera = CreateCamera();
+
+    SECTION("Frustum and screen size tests") {
+        ::renderer::BoundsArray bounds;
+        bounds.Set(0, UnitBox(Vec3(0.0F, 0.0F, 0.0F)));
+        bounds.Set(1, UnitBox(Vec3(20.0F, 0.0F, 0.0F)));
+        bounds.Set(2, ::renderer::AABB(Vec3(-80.0F, 0.0F, 0.0F),
+                                       Vec3(-80.0F, 0.01F, 0.01F)));
+        bounds.Set(3, ::renderer::AABB());
+
+        std::vector<uint8_t> visible(bounds.size());
+        auto stats = ::renderer::CullBounds(camera->ComputeCullingParams(0.01F),
+                                            bounds, visible.data());
+        REQUIRE(visible == std::vector<uint8_t>{1, 0, 0, 0});
+        REQUIRE(stats.num_visible == 1);
+        REQUIRE(stats.num_frustum_culled == 1);
+        REQUIRE(stats.num_size_culled == 1);
+    }
+
+    SECTION("SIMD and scalar paths agree") {
+        std::mt19937 rng(42);  // NOLINT
+        std::uniform_real_distribution<float> pos(-120.0F, 120.0F);
+        std::uniform_real_distribution<float> size(0.0F, 2.0F);
+        ::renderer::BoundsArray bounds;
+        constexpr size_t NUM_BOUNDS = 1003;
+        for (size_t i = 0; i < NUM_BOUNDS; ++i) {
+            if (i % 17 == 0) {
+                bounds.Set(i, ::renderer::AABB());
+                continue;
+            }
+            const Vec3 CENTER(pos(rng), pos(rng), pos(rng));
+            const Vec3 HALF(size(rng), size(rng), size(rng));
+            bounds.Set(i, {CENTER - HALF, CENTER + HALF});
+        }
+
+        const auto PARAMS = camera->ComputeCullingParams(0.02F);
+        std::vector<uint8_t> visible_simd(NUM_BOUNDS);
+        std::vector<uint8_t> visible_scalar(NUM_BOUNDS);
+        auto stats_simd =
+            ::renderer::CullBounds(PARAMS, bounds, visible_simd.data());
+        auto stats_scalar = ::renderer::CullBoundsScalar(
+            PARAMS, bounds, visible_scalar.data());
+
+        REQUIRE(visible_simd == visible_scalar);
+        REQUIRE(stats_simd.num_visible == stats_scalar.num_visible);
+        REQUIRE(stats_simd.num_frustum_culled ==
+                stats_scalar.num_frustum_culled);
+        REQUIRE(stats_simd.num_size_culled == stats_scalar.num_size_culled);
+        REQUIRE(stats_simd.num_visible > 0);
+        REQUIRE(stats_simd.num_frustum_culled > 0);
+    }
+}
+
+TEST_CASE("Multi-view culling of a scene (culling_t)", "[culling_t]") {
+    auto geometry = CreateUnitCube();
+
+    // A grid of boxes on the xy-plane, and cameras looking at different parts
+    auto scene = std::make_shared<::renderer::Scene>();
+    std::vector<::renderer::Mesh::ptr> meshes;
+    for (int i = -10; i <= 10; ++i) {
+        for (int j = -10; j <= 10; ++j) {
+            auto mesh = std::make_shared<::renderer::Mesh>(
+                ("multiview_" + std::to_string(i) + "_" + std::to_string(j))
+                    .c_str(),
+                geometry,
+                Pose(Vec3(4.0F * static_cast<float>(i),
+                          4.0F * static_cast<float>(j), 0.0F),
+                     Quat()));
+            scene->AddChild(mesh);
+            meshes.push_back(mesh);
+        }
+    }
+    scene->UpdateWorldTransforms();
+
+    std::vector<::renderer::Camera::ptr> cameras;
+    for (size_t i = 0; i < 8; ++i) {
+        auto camera = std::make_shared<::renderer::Camera>(
+            ("multiview_cam_" + std::to_string(i)).c_str());
+        const auto OFFSET = 10.0F * static_cast<float>(i) - 35.0F;
+        camera->SetPosition(Vec3(OFFSET + 3.0F, OFFSET, 3.0F));
+        camera->LookAt(Vec3(OFFSET, OFFSET, 0.0F));
+        camera->data.far = 10.0F;
+        cameras.push_back(camera);
+    }
+    // The last camera doesn't see the objects in the first layer
+    cameras.back()->culling_mask = 0x2;
+
+    ::renderer::MultiViewVisibility visibility;
+    scene->CullCameras(cameras, 0.0F, visibility);
+    REQUIRE(visibility.num_visible.size() == cameras.size());
+    REQUIRE(visibility.num_visible.back() == 0);
+
+    // Should match the results of culling each camera separately
+    for (size_t c = 0; c + 1 < cameras.size(); ++c) {
+        const auto FRUSTUM = cameras[c]->ComputeFrustum();
+        size_t num_visible = 0;
+        for (const auto& mesh : meshes) {
+            const bool EXPECTED = FRUSTUM.Intersects(mesh->world_bounds());
+            REQUIRE(visibility.IsVisible(mesh->bvh_leaf(), c) == EXPECTED);
+            num_visible += EXPECTED ? 1 : 0;
+        }
+        REQUIRE(visibility.num_visible[c] == num_visible);
+        REQUIRE(num_visible > 0);
+    }
+
+    // Sparse views share most of the traversal (and skip what's out of view)
+    REQUIRE(visibility.num_nodes_visited < scene->bvh().nodes().size());
+}
@@ -0,0 +1,189 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <renderer/engine/change_journal_t.hpp>
+#include <renderer/engine/draw_list_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+
+namespace {
+auto CreateTriangle() -> ::renderer::Geometry::ptr {
+    std::vector<float> positions = {0.0F, 0.0F, 0.0F, 1.0F, 0.0F,
+                                    0.0F, 0.0F, 1.0F, 0.0F};
+    std::vector<float> normals(positions.size(), 0.0F);
+    std::vector<float> texcoords(6, 0.0F);
+    return std::make_shared<::renderer::Geometry>(
+        3, positions.data(), normals.data(), texcoords.data());
+}
+
+auto CountChanges(const ::renderer::ChangeJournal& journal, uint64_t since,
+                  ::renderer::eSceneChange type) -> size_t {
+    size_t count = 0;
+    journal.ForEachSince(since, [&](const ::renderer::SceneChange& change) {
+        count += (change.type == type) ? 1 : 0;
+    });
+    return count;
+}
+}  // namespace
+
+TEST_CASE("Scene change journal (change_journal_t)", "[change_journal_t]") {
+    using ::renderer::eSceneChange;
+    auto geometry = CreateTriangle();
+    auto scene = std::make_shared<::renderer::Scene>();
+    const auto& journal = scene->journal();
+
+    auto mesh = std::make_shared<::renderer::Mesh>("journal_mesh", geometry);
+    auto child = std::make_shared<::renderer::Object3D>("journal_child");
+    mesh->AddChild(child);
+    scene->AddChild(mesh);
+    REQUIRE(CountChanges(journal, 0, eSceneChange::ADDED) == 2);
+
+    // Objects added below objects already in the scene are recorded as well
+    auto grandchild =
+        std::make_shared<::renderer::Mesh>("journal_grandchild", geometry);
+    child->AddChild(grandchild);
+    REQUIRE(CountChanges(journal, 0, eSceneChange::ADDED) == 3);
+
+    // Pose changes are recorded for objects with bounds, when updated
+    auto since = journal.end_sequence();
+    scene->UpdateWorldTransforms();
+    REQUIRE(CountChanges(journal, since, eSceneChange::POSE_CHANGED) == 2);
+    since = journal.end_sequence();
+    scene->UpdateWorldTransforms();
+    REQUIRE(journal.end_sequence() == since);
+    grandchild->SetPosition(Vec3(1.0F, 0.0F, 0.0F));
+    scene->UpdateWorldTransforms();
+    REQUIRE(CountChanges(journal, since, eSceneChange::POSE_CHANGED) == 1);
+
+    since = journal.end_sequence();
+    mesh->SetMaterial(std::make_shared<::renderer::Material>());
+    REQUIRE(CountChanges(journal, since, eSceneChange::MATERIAL_CHANGED) == 1);
+
+    since = journal.end_sequence();
+    scene->RemoveChild("journal_mesh");
+    REQUIRE(CountChanges(journal, since, eSceneChange::REMOVED) == 3);
+    // Once out of the scene, changes aren't recorded anymore
+    mesh->MarkMaterialDirty();
+    REQUIRE(CountChanges(journal, since, eSceneChange::MATERIAL_CHANGED) == 0);
+
+    SECTION("Oldest entries are dropped past the capacity") {
+        ::renderer::ChangeJournal small_journal(8);
+        for (size_t i = 0; i < 20; ++i) {
+            small_journal.Record(eSceneChange::POSE_CHANGED, *mesh);
+        }
+        REQUIRE(small_journal.size() <= small_journal.capacity());
+        REQUIRE(small_journal.end_sequence() == 20);
+        REQUIRE_FALSE(small_journal.IsAvailable(0));
+        REQUIRE(small_journal.IsAvailable(small_journal.first_sequence()));
+        small_journal.Trim(small_journal.end_sequence());
+        REQUIRE(small_journal.size() == 0);
+    }
+}
+
+TEST_CASE("Retained draw list (draw_list_t)", "[draw_list_t]") {
+    auto geometry_a = CreateTriangle();
+    auto geometry_b = CreateTriangle();
+    auto material = std::make_shared<::renderer::Material>();
+    auto scene = std::make_shared<::renderer::Scene>();
+
+    constexpr size_t NUM_MESHES = 100;
+    std::vector<::renderer::Mesh::ptr> meshes;
+    for (size_t i = 0; i < NUM_MESHES; ++i) {
+        auto mesh = std::make_shared<::renderer::Mesh>(
+            ("draw_mesh_" + std::to_string(i)).c_str(),
+            (i % 2 == 0) ? geometry_a : geometry_b,
+            Pose(Vec3(static_cast<float>(i), 0.0F, 0.0F), Quat()));
+        scene->AddChild(mesh);
+        meshes.push_back(mesh);
+    }
+    scene->AddChild(std::make_shared<::renderer::Object3D>("not_drawable"));
+    scene->UpdateWorldTransforms();
+
+    ::renderer::DrawList draw_list;
+    draw_list.Sync(*scene);
+    REQUIRE(draw_list.rebuilt());
+    REQUIRE(draw_list.items().size() == NUM_MESHES);
+    REQUIRE(draw_list.dirty_slots().size() == NUM_MESHES);
+    for (size_t i = 1; i < draw_list.items().size(); ++i) {
+        REQUIRE(draw_list.items()[i - 1].sort_key <=
+                draw_list.items()[i].sort_key);
+    }
+
+    SECTION("Only moved meshes get their transforms patched") {
+        meshes[3]->SetPosition(Vec3(0.0F, 7.0F, 0.0F));
+        meshes[42]->SetPosition(Vec3(0.0F, 9.0F, 0.0F));
+        scene->UpdateWorldTransforms();
+        draw_list.Sync(*scene);
+        REQUIRE_FALSE(draw_list.rebuilt());
+        REQUIRE(draw_list.num_changes_applied() == 2);
+        REQUIRE(draw_list.dirty_slots().size() == 2);
+        constexpr auto STRIDE = ::renderer::DrawList::FLOATS_PER_TRANSFORM;
+        for (const auto& item : draw_list.items()) {
+            const auto* transform =
+                draw_list.transforms().data() + item.slot * STRIDE;
+            REQUIRE(transform[12] == item.object->world_transform()(0, 3));
+            REQUIRE(transform[13] == item.object->world_transform()(1, 3));
+        }
+
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.dirty_slots().empty());
+    }
+
+    SECTION("Tinted meshes get their slots flagged, keeping the items") {
+        const auto VERSION = draw_list.items_version();
+        meshes[7]->SetColor(Vec3(1.0F, 0.0F, 0.0F));
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.dirty_slots().size() == 1);
+        REQUIRE(draw_list.items_version() == VERSION);
+
+        meshes[7]->SetMaterial(material);
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.items_version() != VERSION);
+    }
+
+    SECTION("Hidden and relayered meshes get their slots flagged") {
+        const auto VERSION = draw_list.items_version();
+        meshes[8]->SetVisible(false);
+        meshes[9]->SetLayers(1U << 3);
+        meshes[10]->SetLayers(meshes[10]->layers());
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.num_changes_applied() == 2);
+        REQUIRE(draw_list.dirty_slots().size() == 2);
+        REQUIRE(draw_list.items_version() == VERSION);
+    }
+
+    SECTION("Added, removed and restated meshes update the items") {
+        scene->RemoveChild("draw_mesh_10");
+        auto extra = std::make_shared<::renderer::Mesh>("draw_extra", nullptr);
+        scene->AddChild(extra);
+        meshes[5]->SetMaterial(material);
+        scene->UpdateWorldTransforms();
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.items().size() == NUM_MESHES - 1);
+        // Slots of removed meshes are reused by the new ones
+        extra->SetGeometry(geometry_a);
+        scene->UpdateWorldTransforms();
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.items().size() == NUM_MESHES);
+        REQUIRE(draw_list.num_slots() == NUM_MESHES);
+
+        size_t num_with_material = 0;
+        for (const auto& item : draw_list.items()) {
+            REQUIRE(item.object != meshes[10].get());
+            num_with_material += (item.material == material.get()) ? 1 : 0;
+        }
+        REQUIRE(num_with_material == 1);
+    }
+
+    SECTION("Falling behind the journal rebuilds the list") {
+        for (size_t i = 0; i <= scene->journal().capacity(); ++i) {
+            meshes[0]->MarkMaterialDirty();
+        }
+        draw_list.Sync(*scene);
+        REQUIRE(draw_list.rebuilt());
+        REQUIRE(draw_list.items().size() == NUM_MESHES);
+    }
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+#include <renderer/engine/frame_stats_t.hpp>
+
+namespace {
+auto MakeStats(uint64_t frame_index, float cpu_submit_ms, float gpu_scene_ms)
+    -> ::renderer::FrameStats {
+    ::renderer::FrameStats stats;
+    stats.frame_index = frame_index;
+    stats.cpu_time_ms.at(
+        static_cast<size_t>(::renderer::eFramePhase::SUBMIT)) = cpu_submit_ms;
+    stats.cpu_time_ms.at(static_cast<size_t>(::renderer::eFramePhase::CULL)) =
+        1.0F;
+    stats.gpu_time_ms.at(static_cast<size_t>(::renderer::eFramePass::SCENE)) =
+        gpu_scene_ms;
+    // GPU timings lag two frames behind, and are missing at first
+    stats.gpu_frame_index = (frame_index > 2) ? frame_index - 2 : 0;
+    return stats;
+}
+}  // namespace
+
+TEST_CASE("Frame stats totals (frame_stats_t)", "[frame_stats_t]") {
+    const auto STATS = MakeStats(1, 2.0F, 3.0F);
+    REQUIRE(STATS.cpu_time(::renderer::eFramePhase::SUBMIT) == Approx(2.0F));
+    REQUIRE(STATS.cpu_total_ms() == Approx(3.0F));
+    REQUIRE(STATS.gpu_total_ms() == Approx(3.0F));
+    REQUIRE_FALSE(STATS.ToString().empty());
+}
+
+TEST_CASE("Rolling history of frame stats (frame_stats_t)",
+          "[frame_stats_t]") {
+    ::renderer::FrameStatsHistory history(4);
+    REQUIRE(history.empty());
+    REQUIRE(history.capacity() == 4);
+    REQUIRE(history.ComputeMeanCpuTotal() == Approx(0.0F));
+    REQUIRE_THROWS_AS(history[0], std::out_of_range);
+
+    SECTION("Frames are kept oldest first, up to the capacity") {
+        for (uint64_t frame = 1; frame <= 6; ++frame) {
+            history.Push(MakeStats(frame, static_cast<float>(frame), 1.0F));
+        }
+        REQUIRE(history.size() == 4);
+        REQUIRE(history[0].frame_index == 3);
+        REQUIRE(history[3].frame_index == 6);
+        REQUIRE(history.latest().frame_index == 6);
+        REQUIRE_THROWS_AS(history[4], std::out_of_range);
+    }
+
+    SECTION("Means and maxima are computed over the kept frames") {
+        for (uint64_t frame = 1; frame <= 6; ++frame) {
+            history.Push(MakeStats(frame, static_cast<float>(frame), 2.0F));
+        }
+        // Frames 3 to 6, each with 1ms of culling
+        REQUIRE(history.ComputeMeanCpuTime(::renderer::eFramePhase::SUBMIT) ==
+                Approx(4.5F));
+        REQUIRE(history.ComputeMeanCpuTotal() == Approx(5.5F));
+        REQUIRE(history.ComputeMaxCpuTotal() == Approx(7.0F));
+        REQUIRE(history.ComputeMeanGpuTime(::renderer::eFramePass::SCENE) ==
+                Approx(2.0F));
+    }
+
+    SECTION("Frames without GPU timings are left out of the GPU means") {
+        history.Push(MakeStats(1, 1.0F, 0.0F));
+        history.Push(MakeStats(2, 1.0F, 0.0F));
+        history.Push(MakeStats(3, 1.0F, 5.0F));
+        REQUIRE(history.ComputeMeanGpuTime(::renderer::eFramePass::SCENE) ==
+                Approx(5.0F));
+    }
+
+    SECTION("Shrinking the history keeps the most recent frames") {
+        for (uint64_t frame = 1; frame <= 6; ++frame) {
+            history.Push(MakeStats(frame, 1.0F, 1.0F));
+        }
+        history.SetCapacity(2);
+        REQUIRE(history.size() == 2);
+        REQUIRE(history[0].frame_index == 5);
+        REQUIRE(history[1].frame_index == 6);
+
+        history.Push(MakeStats(7, 1.0F, 1.0F));
+        REQUIRE(history[0].frame_index == 6);
+        REQUIRE(history.latest().frame_index == 7);
+
+        history.Clear();
+        REQUIRE(history.empty());
+        REQUIRE(history.capacity() == 2);
+    }
+}
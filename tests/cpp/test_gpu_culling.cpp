@@ -0,0 +1,131 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <renderer/engine/graphics/window_t.hpp>
+#include <renderer/backend/graphics/opengl/gpu_culling_opengl_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl_t.hpp>
+
+namespace {
+using ::renderer::opengl::DrawElementsIndirectCommand;
+using ::renderer::opengl::OpenGLCullObject;
+
+// Small box at the given point, with clip space as its world space
+auto CreateObject(float x, uint32_t layers) -> OpenGLCullObject {
+    OpenGLCullObject object;
+    object.model = {1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F,
+                    0.0F, 0.0F, 1.0F, 0.0F, x,    0.0F, 0.0F, 1.0F};
+    object.color = {1.0F, 1.0F, 1.0F};
+    object.center = {x, 0.0F, 0.0F};
+    object.extent = {0.1F, 0.1F, 0.1F};
+    object.layers = layers;
+    return object;
+}
+
+// Reads back the draw commands written by the last call to Cull
+auto ReadCommands(const ::renderer::opengl::OpenGLGpuCuller& culler)
+    -> std::vector<DrawElementsIndirectCommand> {
+    std::vector<DrawElementsIndirectCommand> commands(culler.num_commands());
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    ::renderer::opengl::OpenGLStateCache::Current().BindBuffer(
+        GL_COPY_READ_BUFFER, culler.command_buffer());
+    glGetBufferSubData(
+        GL_COPY_READ_BUFFER, 0,
+        static_cast<GLsizeiptr>(commands.size() *
+                                sizeof(DrawElementsIndirectCommand)),
+        commands.data());
+    return commands;
+}
+}  // namespace
+
+TEST_CASE("GPU culling (gpu_culling_opengl_t)", "[gpu_culling_opengl_t]") {
+    // Create a window to have a valid OpenGL context
+    ::renderer::WindowConfig config;
+    config.backend = ::renderer::eWindowBackend::TYPE_GLFW;
+    config.width = 800;
+    config.height = 600;
+    config.title = "Test GPU culling";
+    config.gl_version_major = 4;
+    config.gl_version_minor = 3;
+    auto window = ::renderer::Window::Create(config);
+    if (!::renderer::opengl::OpenGLGpuCuller::IsSupported()) {
+        WARN("OpenGL 4.3 isn't supported, skipping the GPU culling tests");
+        return;
+    }
+
+    constexpr uint32_t LAYER_A = 1U << 0;
+    constexpr uint32_t LAYER_B = 1U << 1;
+    auto shown = CreateObject(-0.5F, LAYER_A);
+    auto hidden = CreateObject(0.0F, LAYER_A);
+    hidden.flags = 0;
+    auto other_layer = CreateObject(0.5F, LAYER_B);
+    auto out_of_view = CreateObject(5.0F, LAYER_A);
+    const std::vector<OpenGLCullObject> objects = {shown, hidden, other_layer,
+                                                   out_of_view};
+    DrawElementsIndirectCommand command;
+    command.count = 36;
+
+    ::renderer::opengl::OpenGLGpuCuller culler;
+    culler.SetObjects(objects, {command}, {0.0F},
+                      static_cast<uint32_t>(objects.size()));
+    REQUIRE(culler.num_objects() == objects.size());
+    REQUIRE(culler.num_commands() == 1);
+
+    SECTION("Hidden objects are culled") {
+        culler.Cull(Mat4::Identity(), false);
+        REQUIRE(ReadCommands(culler)[0].instance_count == 2);
+    }
+
+    SECTION("Objects out of the layers of the view are culled") {
+        culler.Cull(Mat4::Identity(), false, LAYER_A);
+        REQUIRE(ReadCommands(culler)[0].instance_count == 1);
+
+        culler.Cull(Mat4::Identity(), false, LAYER_B);
+        REQUIRE(ReadCommands(culler)[0].instance_count == 1);
+    }
+
+    SECTION("Patched objects get culled from the next frame on") {
+        hidden.flags = ::renderer::opengl::GPU_CULLING_FLAG_VISIBLE;
+        other_layer.layers = LAYER_A | LAYER_B;
+        culler.UpdateObjects(1, 1, &hidden);
+        culler.UpdateObjects(2, 1, &other_layer);
+        culler.Cull(Mat4::Identity(), false, LAYER_A);
+        REQUIRE(ReadCommands(culler)[0].instance_count == 3);
+    }
+
+    SECTION("Objects with levels of detail select them on the GPU") {
+        auto detailed = CreateObject(0.0F, LAYER_A);
+        detailed.flags |= 2U << ::renderer::opengl::GPU_CULLING_LODS_SHIFT;
+        DrawElementsIndirectCommand coarse;
+        coarse.count = 12;
+        coarse.base_instance = 1;
+        culler.SetObjects({detailed}, {command, coarse}, {0.0F, 0.1F}, 2);
+
+        // Orthographic view, where the error of the coarse level is 0.1 pixels
+        ::renderer::LodView view;
+        view.perspective = false;
+        ::renderer::LodSettings settings;
+        culler.SetLodView(view, settings);
+        culler.Cull(Mat4::Identity(), false);
+        auto commands = ReadCommands(culler);
+        REQUIRE(commands[0].instance_count == 0);
+        REQUIRE(commands[1].instance_count == 1);
+
+        view.pixels_per_unit = 100.0F;
+        culler.SetLodView(view, settings);
+        culler.Cull(Mat4::Identity(), false);
+        commands = ReadCommands(culler);
+        REQUIRE(commands[0].instance_count == 1);
+        REQUIRE(commands[1].instance_count == 0);
+
+        settings.enabled = false;
+        view.pixels_per_unit = 1.0F;
+        culler.SetLodView(view, settings);
+        culler.Cull(Mat4::Identity(), false);
+        REQUIRE(ReadCommands(culler)[0].instance_count == 1);
+    }
+}
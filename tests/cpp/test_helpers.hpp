@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/graphics/aabb_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+
+// Fixtures shared by the unittests
+namespace test {
+
+/// Camera placed along +x, looking towards the origin
+inline auto CreateCamera() -> ::renderer::Camera::ptr {
+    auto camera = std::make_shared<::renderer::Camera>("test_camera");
+    camera->SetPosition(Vec3(10.0F, 0.0F, 0.0F));
+    camera->LookAt(Vec3(0.0F, 0.0F, 0.0F));
+    return camera;
+}
+
+/// Box of unit size centered at the given point
+inline auto UnitBox(const Vec3& center) -> ::renderer::AABB {
+    return {center - Vec3(0.5F, 0.5F, 0.5F), center + Vec3(0.5F, 0.5F, 0.5F)};
+}
+
+/// Axis-aligned unit cube centered at the origin (12 indexed triangles)
+inline auto CreateUnitCube() -> ::renderer::Geometry::ptr {
+    std::vector<float> positions;
+    for (uint32_t i = 0; i < 8; ++i) {
+        positions.push_back((i & 1) != 0 ? 0.5F : -0.5F);
+        positions.push_back((i & 2) != 0 ? 0.5F : -0.5F);
+        positions.push_back((i & 4) != 0 ? 0.5F : -0.5F);
+    }
+    std::vector<float> normals(positions.size(), 0.0F);
+    std::vector<float> texcoords(16, 0.0F);
+    std::vector<uint32_t> indices = {
+        0, 2, 1, 1, 2, 3,  // -z
+        4, 5, 6, 5, 7, 6,  // +z
+        0, 1, 4, 1, 5, 4,  // -y
+        2, 6, 3, 3, 6, 7,  // +y
+        0, 4, 2, 2, 4, 6,  // -x
+        1, 3, 5, 3, 7, 5,  // +x
+    };
+    return std::make_shared<::renderer::Geometry>(
+        8, positions.data(), normals.data(), texcoords.data(), 36,
+        indices.data());
+}
+
+}  // namespace test
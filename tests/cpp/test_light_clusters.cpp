@@ -0,0 +1,192 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/light_clusters_t.hpp>
+#include <renderer/engine/light_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace {
+auto CreateCamera() -> ::renderer::Camera::ptr {
+    auto camera = std::make_shared<::renderer::Camera>("clusters_camera");
+    camera->data.aspect = 16.0F / 9.0F;
+    camera->data.near = 0.1F;
+    camera->data.far = 100.0F;
+    camera->SetPosition(Vec3(0.0F, 5.0F, 20.0F));
+    camera->LookAt(Vec3(0.0F, 0.0F, 0.0F));
+    return camera;
+}
+
+// Factory floor: a grid of lamps with a short reach, plus a few spot lights
+auto CreateLamps() -> std::vector<::renderer::Light::ptr> {
+    std::vector<::renderer::Light::ptr> lights;
+    lights.push_back(std::make_shared<::renderer::DirectionalLight>(
+        Vec3(0.0F, -1.0F, 0.0F)));
+    for (int i = 0; i < 15; ++i) {
+        for (int j = 0; j < 15; ++j) {
+            lights.push_back(std::make_shared<::renderer::PointLight>(
+                Vec3(4.0F * static_cast<float>(i - 7), 3.0F,
+                     4.0F * static_cast<float>(j - 7)),
+                Vec3(1.0F, 0.9F, 0.8F), 1.0F, 1.0F, 0.35F, 0.44F));
+        }
+    }
+    for (int i = 0; i < 5; ++i) {
+        lights.push_back(std::make_shared<::renderer::SpotLight>(
+            Vec3(static_cast<float>(i), 6.0F, 0.0F), Vec3(0.0F, -1.0F, 0.0F),
+            0.3F, 0.5F, Vec3(1.0F, 1.0F, 1.0F), 2.0F, 1.0F, 0.09F, 0.032F));
+    }
+    return lights;
+}
+
+// Returns whether or not the given cluster lists the given light
+auto Lists(const ::renderer::LightClusters& clusters, uint32_t cluster,
+           uint32_t light) -> bool {
+    const auto OFFSET = clusters.offsets()[cluster];
+    for (uint32_t i = 0; i < clusters.counts()[cluster]; ++i) {
+        if (clusters.indices()[OFFSET + i] == light) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+TEST_CASE("Range of the lights (light_clusters_t)", "[light_clusters_t]") {
+    constexpr float CUTOFF = 0.01F;
+    // Radiance (of the brightest channel) at the given distance
+    auto radiance = [](const ::renderer::Light& light, float dist) {
+        return light.intensity * 1.0F /
+               (light.attnConstant + light.attnLinear * dist +
+                light.attnQuadratic * dist * dist);
+    };
+
+    ::renderer::PointLight quadratic(Vec3(), Vec3(1.0F, 0.5F, 0.5F), 1.0F,
+                                     1.0F, 0.35F, 0.44F);
+    const auto RANGE = ::renderer::ComputeLightRange(quadratic, CUTOFF);
+    REQUIRE(RANGE > 0.0F);
+    REQUIRE(radiance(quadratic, RANGE) == Approx(CUTOFF));
+
+    ::renderer::PointLight linear(Vec3(), Vec3(1.0F, 1.0F, 1.0F), 2.0F, 1.0F,
+                                  0.5F, 0.0F);
+    const auto LINEAR_RANGE = ::renderer::ComputeLightRange(linear, CUTOFF);
+    REQUIRE(radiance(linear, LINEAR_RANGE) == Approx(CUTOFF));
+
+    // Brighter lights reach further
+    quadratic.intensity = 4.0F;
+    REQUIRE(::renderer::ComputeLightRange(quadratic, CUTOFF) > RANGE);
+
+    // Lights below the cutoff never reach anything
+    quadratic.intensity = 0.005F;
+    REQUIRE(::renderer::ComputeLightRange(quadratic, CUTOFF) == 0.0F);
+
+    // Lights without falloff reach everything
+    ::renderer::PointLight constant(Vec3(0.0F, 0.0F, 0.0F));
+    REQUIRE(::renderer::ComputeLightRange(constant, CUTOFF) ==
+            std::numeric_limits<float>::max());
+}
+
+TEST_CASE("Assignment of the lights (light_clusters_t)",
+          "[light_clusters_t]") {
+    auto camera = CreateCamera();
+    const auto LIGHTS = CreateLamps();
+    ::renderer::LightClusterSettings settings;
+    settings.enabled = true;
+
+    ::renderer::LightClusters clusters;
+    clusters.Build(*camera, LIGHTS, settings);
+    REQUIRE(clusters.num_clusters() ==
+            settings.tiles_x * settings.tiles_y * settings.num_slices);
+    // The directional light is left out
+    REQUIRE(clusters.lights().size() == LIGHTS.size() - 1);
+    REQUIRE(clusters.lights()[0] == LIGHTS[1].get());
+    REQUIRE(clusters.num_overflows() == 0);
+    // Fewer assignments than lights times clusters, by a wide margin
+    REQUIRE_FALSE(clusters.indices().empty());
+    REQUIRE(clusters.indices().size() <
+            clusters.lights().size() * clusters.num_clusters() / 4);
+
+    // Points behind the camera fall into no cluster
+    REQUIRE(clusters.ClusterAt(camera->pose().position +
+                               camera->v_front) == ::renderer::INVALID_CLUSTER);
+
+    SECTION("Every point lit by a light lists it in its cluster") {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> offset(-1.0F, 1.0F);
+        for (uint32_t i = 0; i < clusters.lights().size(); ++i) {
+            const auto& light = *clusters.lights()[i];
+            for (int sample = 0; sample < 20; ++sample) {
+                const Vec3 DIR(offset(rng), offset(rng), offset(rng));
+                const auto POINT =
+                    light.position +
+                    (0.99F * clusters.ranges()[i] * std::abs(offset(rng))) *
+                        ::math::normalize<float>(DIR);
+                const auto CLUSTER = clusters.ClusterAt(POINT);
+                if (CLUSTER == ::renderer::INVALID_CLUSTER) {
+                    continue;
+                }
+                REQUIRE(CLUSTER < clusters.num_clusters());
+                // Only points inside of the view volume, as the shaders
+                // clamp the ones out of it to the closest cluster
+                const auto CLIP = camera->ComputeProjectionMatrix() *
+                                  camera->ComputeViewMatrix() *
+                                  Vec4(POINT.x(), POINT.y(), POINT.z(), 1.0F);
+                if (std::abs(CLIP.x()) > CLIP.w() ||
+                    std::abs(CLIP.y()) > CLIP.w() ||
+                    std::abs(CLIP.z()) > CLIP.w()) {
+                    continue;
+                }
+                REQUIRE(Lists(clusters, CLUSTER, i));
+            }
+        }
+    }
+
+    SECTION("Full clusters drop the extra lights") {
+        settings.max_lights_per_cluster = 2;
+        clusters.Build(*camera, LIGHTS, settings);
+        REQUIRE(clusters.num_overflows() > 0);
+        for (const auto COUNT : clusters.counts()) {
+            REQUIRE(COUNT <= 2);
+        }
+    }
+
+    SECTION("Orthographic cameras get clusters too") {
+        camera->data.projection = ::renderer::eProjectionType::ORTHOGRAPHIC;
+        camera->data.width = 40.0F;
+        camera->data.height = 30.0F;
+        clusters.Build(*camera, LIGHTS, settings);
+        const auto& light = *clusters.lights()[0];
+        const auto CLUSTER = clusters.ClusterAt(light.position);
+        REQUIRE(CLUSTER != ::renderer::INVALID_CLUSTER);
+        REQUIRE(Lists(clusters, CLUSTER, 0));
+    }
+}
+
+TEST_CASE("Parallel assignment of the lights (light_clusters_t)",
+          "[light_clusters_t]") {
+    auto camera = CreateCamera();
+    const auto LIGHTS = CreateLamps();
+    ::renderer::LightClusterSettings settings;
+    settings.max_lights_per_cluster = 8;
+
+    ::renderer::LightClusters serial;
+    serial.Build(*camera, LIGHTS, settings);
+    ::renderer::ThreadPool pool(3);
+    ::renderer::LightClusters parallel;
+    parallel.Build(*camera, LIGHTS, settings, &pool);
+    REQUIRE(parallel.offsets() == serial.offsets());
+    REQUIRE(parallel.counts() == serial.counts());
+    REQUIRE(parallel.indices() == serial.indices());
+    REQUIRE(parallel.num_overflows() == serial.num_overflows());
+
+    // Rebuilding reuses the clusters without leftovers
+    parallel.Build(*camera, LIGHTS, settings, &pool);
+    REQUIRE(parallel.indices() == serial.indices());
+    parallel.Clear();
+    REQUIRE(parallel.num_clusters() == 0);
+    REQUIRE(parallel.ClusterAt(Vec3()) == ::renderer::INVALID_CLUSTER);
+}
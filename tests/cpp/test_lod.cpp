@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/lod_t.hpp>
+
+namespace {
+// Quad on the plane z = 0 (two triangles), with two single-triangle levels
+auto CreateQuad() -> ::renderer::Geometry::ptr {
+    const std::array<float, 12> POSITIONS = {0.0F, 0.0F, 0.0F, 1.0F,
+                                             0.0F, 0.0F, 1.0F, 1.0F,
+                                             0.0F, 0.0F, 1.0F, 0.0F};
+    const std::array<float, 12> NORMALS = {};
+    const std::array<float, 8> TEXCOORDS = {};
+    const std::array<uint32_t, 6> INDICES = {0, 1, 2, 0, 2, 3};
+    return std::make_shared<::renderer::Geometry>(
+        4, POSITIONS.data(), NORMALS.data(), TEXCOORDS.data(), INDICES.size(),
+        INDICES.data());
+}
+
+auto BoxAt(float distance) -> ::renderer::AABB {
+    return {Vec3(distance - 0.5F, -0.5F, -0.5F),
+            Vec3(distance + 0.5F, 0.5F, 0.5F)};
+}
+}  // namespace
+
+TEST_CASE("Levels of detail of a geometry (geometry_t)", "[lod_t]") {
+    auto geometry = CreateQuad();
+    REQUIRE(geometry->num_lods() == 1);
+    REQUIRE(geometry->lod_error(0) == 0.0F);
+    REQUIRE(geometry->lod_version() == 0);
+
+    const std::array<uint32_t, 3> LOD_1 = {0, 1, 2};
+    const std::array<uint32_t, 3> LOD_2 = {0, 2, 3};
+    geometry->AddLod(LOD_1.size(), LOD_1.data(), 0.1F);
+    geometry->AddLod(LOD_2.size(), LOD_2.data(), 0.5F);
+    REQUIRE(geometry->num_lods() == 3);
+    REQUIRE(geometry->lod_error(2) == 0.5F);
+    REQUIRE(geometry->lods()[1].first_index == 3);
+    REQUIRE(geometry->lod_indices().size() == 6);
+    REQUIRE(geometry->lod_version() == 2);
+
+    // Not triangles, out of order, and out of range levels are rejected
+    const std::array<uint32_t, 4> BAD_COUNT = {0, 1, 2, 3};
+    geometry->AddLod(BAD_COUNT.size(), BAD_COUNT.data(), 1.0F);
+    geometry->AddLod(LOD_1.size(), LOD_1.data(), 0.2F);
+    const std::array<uint32_t, 3> BAD_INDEX = {0, 1, 4};
+    geometry->AddLod(BAD_INDEX.size(), BAD_INDEX.data(), 1.0F);
+    REQUIRE(geometry->num_lods() == 3);
+    REQUIRE(geometry->lod_version() == 2);
+
+    geometry->ClearLods();
+    REQUIRE(geometry->num_lods() == 1);
+    REQUIRE(geometry->lod_indices().empty());
+    REQUIRE(geometry->lod_version() == 3);
+    geometry->ClearLods();
+    REQUIRE(geometry->lod_version() == 3);
+}
+
+TEST_CASE("Selection of the levels of detail (lod_t)", "[lod_t]") {
+    auto geometry = CreateQuad();
+    const std::array<uint32_t, 3> LOD_1 = {0, 1, 2};
+    const std::array<uint32_t, 3> LOD_2 = {0, 2, 3};
+    geometry->AddLod(LOD_1.size(), LOD_1.data(), 0.1F);
+    geometry->AddLod(LOD_2.size(), LOD_2.data(), 0.5F);
+
+    // Errors of 0.1 and 0.5 span 10 / d and 50 / d pixels at a distance d
+    ::renderer::LodView view;
+    view.pixels_per_unit = 100.0F;
+    ::renderer::LodSettings settings;
+    settings.max_screen_error = 1.0F;
+    settings.hysteresis = 0.25F;
+    REQUIRE(view.ScreenError(0.1F, BoxAt(10.5F)) == Approx(1.0F));
+
+    auto select = [&](float distance, uint32_t current) {
+        return ::renderer::SelectLod(*geometry, BoxAt(distance + 0.5F), view,
+                                     current, settings);
+    };
+
+    SECTION("Coarsest level under the largest error") {
+        REQUIRE(select(5.0F, 0) == 0);
+        REQUIRE(select(20.0F, 0) == 1);
+        REQUIRE(select(100.0F, 0) == 2);
+        // Levels jump as far as needed in a single call
+        REQUIRE(select(5.0F, 2) == 0);
+        // Unknown levels are clamped to the ones of the geometry
+        REQUIRE(select(100.0F, 7) == 2);
+    }
+
+    SECTION("Levels in the hysteresis band stick") {
+        // At a distance of 12, the level 1 spans 0.83 pixels: under the
+        // largest error, but above the threshold to switch to it
+        REQUIRE(select(12.0F, 0) == 0);
+        REQUIRE(select(12.0F, 1) == 1);
+        REQUIRE(select(9.0F, 1) == 0);
+    }
+
+    SECTION("Full detail from inside of the bounds, or when disabled") {
+        REQUIRE(::renderer::SelectLod(*geometry, BoxAt(0.0F), view, 2,
+                                      settings) == 0);
+        settings.enabled = false;
+        REQUIRE(select(100.0F, 2) == 0);
+    }
+
+    SECTION("Orthographic views don't depend on the distance") {
+        view.perspective = false;
+        view.pixels_per_unit = 4.0F;
+        REQUIRE(select(1.0F, 0) == 1);
+        REQUIRE(select(1000.0F, 0) == 1);
+    }
+
+    SECTION("Views of cameras") {
+        auto camera = std::make_shared<::renderer::Camera>("lod_camera");
+        camera->SetPosition(Vec3(10.0F, 0.0F, 0.0F));
+        camera->LookAt(Vec3(0.0F, 0.0F, 0.0F));
+        const auto CAMERA_VIEW =
+            ::renderer::LodView::FromCamera(*camera, 720.0F);
+        REQUIRE(CAMERA_VIEW.perspective);
+        REQUIRE(CAMERA_VIEW.pixels_per_unit ==
+                Approx(camera->ComputeProjectionMatrix()(1, 1) * 360.0F));
+    }
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <renderer/engine/graphics/geometry_factory_t.hpp>
+#include <renderer/engine/graphics/mesh_simplifier_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace {
+// Grid of (n + 1) x (n + 1) vertices on [0, 1]^2, displaced by a few bumps
+auto CreateTerrain(size_t n) -> ::renderer::Geometry::ptr {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+    std::vector<uint32_t> indices;
+    const auto STEP = 1.0F / static_cast<float>(n);
+    for (size_t iy = 0; iy <= n; ++iy) {
+        for (size_t ix = 0; ix <= n; ++ix) {
+            const auto X = static_cast<float>(ix) * STEP;
+            const auto Y = static_cast<float>(iy) * STEP;
+            const auto Z = 0.05F * std::sin(6.0F * X) * std::cos(6.0F * Y);
+            positions.insert(positions.end(), {X, Y, Z});
+            normals.insert(normals.end(), {0.0F, 0.0F, 1.0F});
+            texcoords.insert(texcoords.end(), {X, Y});
+        }
+    }
+    for (size_t iy = 0; iy < n; ++iy) {
+        for (size_t ix = 0; ix < n; ++ix) {
+            const auto A = static_cast<uint32_t>(ix + (n + 1) * iy);
+            const auto B = A + 1;
+            const auto C = A + static_cast<uint32_t>(n + 1);
+            const auto D = C + 1;
+            indices.insert(indices.end(), {A, B, D, A, D, C});
+        }
+    }
+    return std::make_shared<::renderer::Geometry>(
+        positions.size() / 3, positions.data(), normals.data(),
+        texcoords.data(), indices.size(), indices.data());
+}
+
+// Checks that the indices make non-degenerate triangles over the vertices
+auto CheckTriangles(const std::vector<uint32_t>& indices, size_t num_vertices)
+    -> void {
+    REQUIRE(indices.size() % 3 == 0);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        REQUIRE(indices[i] < num_vertices);
+        REQUIRE(indices[i + 1] < num_vertices);
+        REQUIRE(indices[i + 2] < num_vertices);
+        REQUIRE(indices[i] != indices[i + 1]);
+        REQUIRE(indices[i + 1] != indices[i + 2]);
+        REQUIRE(indices[i] != indices[i + 2]);
+    }
+}
+}  // namespace
+
+TEST_CASE("Simplification of flat surfaces (mesh_simplifier_t)",
+          "[mesh_simplifier_t]") {
+    auto plane = ::renderer::CreatePlane(2.0F, 2.0F, 16, 16);
+    const auto NUM_TRIANGLES = plane->indices->num_indices() / 3;
+    ::renderer::SimplifyOptions options;
+    options.ratios = {0.5F, 0.25F};
+
+    const auto LODS = ::renderer::SimplifyGeometry(*plane, options);
+    REQUIRE(LODS.size() == 2);
+    for (const auto& lod : LODS) {
+        CheckTriangles(lod.indices, plane->num_vertices());
+        // Collapses within the plane don't move the surface
+        REQUIRE(lod.error == Approx(0.0F).margin(1e-4F));
+    }
+    REQUIRE(LODS[0].indices.size() / 3 <= NUM_TRIANGLES / 2);
+    REQUIRE(LODS[1].indices.size() / 3 <= NUM_TRIANGLES / 4);
+
+    // The border vertices are locked, so the outline of the plane is kept
+    std::set<uint32_t> used(LODS[1].indices.begin(), LODS[1].indices.end());
+    const auto* positions = plane->GetAttribute("position").data();
+    for (uint32_t v = 0; v < plane->num_vertices(); ++v) {
+        const auto X = std::abs(positions[3 * v + 0]);
+        const auto Y = std::abs(positions[3 * v + 1]);
+        if (X == Approx(1.0F) || Y == Approx(1.0F)) {
+            REQUIRE(used.count(v) == 1);
+        }
+    }
+}
+
+TEST_CASE("Chains of levels of detail (mesh_simplifier_t)",
+          "[mesh_simplifier_t]") {
+    auto terrain = CreateTerrain(24);
+    const auto NUM_TRIANGLES = terrain->indices->num_indices() / 3;
+
+    SECTION("Errors grow along the chain") {
+        REQUIRE(::renderer::GenerateLods(*terrain) == 3);
+        REQUIRE(terrain->num_lods() == 4);
+        const auto& lods = terrain->lods();
+        for (size_t level = 1; level < terrain->num_lods(); ++level) {
+            REQUIRE(terrain->lod_error(level) >=
+                    terrain->lod_error(level - 1));
+        }
+        REQUIRE(terrain->lod_error(3) > 0.0F);
+        REQUIRE(lods[2].num_indices / 3 <= NUM_TRIANGLES / 10);
+        CheckTriangles(terrain->lod_indices(), terrain->num_vertices());
+    }
+
+    SECTION("The largest error stops the simplification short") {
+        ::renderer::SimplifyOptions options;
+        options.ratios = {0.01F};
+        options.max_error = 5e-3F;
+        const auto LODS = ::renderer::SimplifyGeometry(*terrain, options);
+        REQUIRE(LODS.size() == 1);
+        REQUIRE(LODS[0].indices.size() / 3 > NUM_TRIANGLES / 100);
+        REQUIRE(LODS[0].error <= 5e-3F);
+    }
+}
+
+TEST_CASE("Parallel generation of levels of detail (mesh_simplifier_t)",
+          "[mesh_simplifier_t]") {
+    std::vector<::renderer::Geometry::ptr> serial;
+    std::vector<::renderer::Geometry::ptr> parallel;
+    for (size_t i = 0; i < 6; ++i) {
+        serial.push_back(CreateTerrain(8 + 2 * i));
+        parallel.push_back(CreateTerrain(8 + 2 * i));
+    }
+    ::renderer::ThreadPool pool(3);
+    ::renderer::GenerateLods(serial);
+    ::renderer::GenerateLods(parallel, {}, &pool);
+    for (size_t i = 0; i < serial.size(); ++i) {
+        REQUIRE(serial[i]->num_lods() > 1);
+        REQUIRE(serial[i]->num_lods() == parallel[i]->num_lods());
+        REQUIRE(serial[i]->lod_indices() == parallel[i]->lod_indices());
+    }
+}
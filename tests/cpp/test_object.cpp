@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/object_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+TEST_CASE("Object3D world transforms (object_t)", "[object_t]") {
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto base = std::make_shared<::renderer::Object3D>(
+        "base", Vec3(1.0F, 0.0F, 0.0F));
+    auto link = std::make_shared<::renderer::Object3D>(
+        "link", Vec3(0.0F, 2.0F, 0.0F));
+    base->AddChild(link);
+    scene->AddChild(base);
+
+    SECTION("First update computes the full hierarchy") {
+        REQUIRE(base->transform_dirty());
+        REQUIRE(link->transform_dirty());
+        scene->UpdateWorldTransforms();
+        REQUIRE_FALSE(base->transform_dirty());
+        REQUIRE_FALSE(link->transform_dirty());
+
+        const auto& link_world = link->world_transform();
+        REQUIRE(link_world(0, 3) == Approx(1.0F));
+        REQUIRE(link_world(1, 3) == Approx(2.0F));
+        REQUIRE(link_world(2, 3) == Approx(0.0F));
+    }
+
+    SECTION("Changes in a parent spread down to its children") {
+        scene->UpdateWorldTransforms();
+        base->SetPosition(Vec3(0.0F, 0.0F, 3.0F));
+        REQUIRE(base->transform_dirty());
+        REQUIRE_FALSE(link->transform_dirty());
+
+        scene->UpdateWorldTransforms();
+        const auto& link_world = link->world_transform();
+        REQUIRE(link_world(0, 3) == Approx(0.0F));
+        REQUIRE(link_world(1, 3) == Approx(2.0F));
+        REQUIRE(link_world(2, 3) == Approx(3.0F));
+    }
+
+    SECTION("Changes in a child don't affect its parent") {
+        scene->UpdateWorldTransforms();
+        link->SetPosition(Vec3(0.0F, 5.0F, 0.0F));
+        scene->UpdateWorldTransforms();
+        REQUIRE(base->world_transform()(1, 3) == Approx(0.0F));
+        REQUIRE(link->world_transform()(1, 3) == Approx(5.0F));
+    }
+}
+
+TEST_CASE("Parallel world transforms (object_t)", "[object_t]") {
+    auto scene = std::make_shared<::renderer::Scene>();
+    std::vector<::renderer::Object3D::ptr> leaves;
+    for (size_t i = 0; i < 8; ++i) {
+        auto body = std::make_shared<::renderer::Object3D>(
+            ("body_" + std::to_string(i)).c_str(),
+            Vec3(static_cast<float>(i), 0.0F, 0.0F));
+        for (size_t j = 0; j < 100; ++j) {
+            auto leaf = std::make_shared<::renderer::Object3D>(
+                ("body_" + std::to_string(i) + "_" + std::to_string(j))
+                    .c_str(),
+                Vec3(0.0F, static_cast<float>(j), 0.0F));
+            body->AddChild(leaf);
+            leaves.push_back(leaf);
+        }
+        scene->AddChild(body);
+    }
+
+    ::renderer::ThreadPool pool(3);
+    scene->UpdateWorldTransforms(pool);
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        REQUIRE_FALSE(leaves[i]->transform_dirty());
+        REQUIRE(leaves[i]->world_transform()(0, 3) ==
+                Approx(static_cast<float>(i / 100)));
+        REQUIRE(leaves[i]->world_transform()(1, 3) ==
+                Approx(static_cast<float>(i % 100)));
+    }
+
+    scene->SetPosition(Vec3(0.0F, 0.0F, 1.0F));
+    scene->UpdateWorldTransforms(pool);
+    for (const auto& leaf : leaves) {
+        REQUIRE(leaf->world_transform()(2, 3) == Approx(1.0F));
+    }
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/culling_t.hpp>
+#include <renderer/engine/occlusion_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+#include "test_helpers.hpp"
+
+namespace {
+using ::test::CreateCamera;
+using ::test::UnitBox;
+
+// Square wall on the plane x = 0, centered at the origin
+auto AddWall(::renderer::OcclusionBuffer& buffer, float half_size) -> void {
+    const std::array<float, 12> POSITIONS = {
+        0.0F, -half_size, -half_size, 0.0F, half_size,  -half_size,
+        0.0F, half_size,  half_size,  0.0F, -half_size, half_size};
+    const std::array<uint32_t, 6> INDICES = {0, 1, 2, 0, 2, 3};
+    buffer.AddOccluder(Mat4::Identity(), POSITIONS.data(), 4, INDICES.data(),
+                       INDICES.size());
+}
+}  // namespace
+
+TEST_CASE("Boxes hidden behind an occluder (occlusion_t)", "[occlusion_t]") {
+    auto camera = CreateCamera();
+    ::renderer::OcclusionBuffer buffer;
+    REQUIRE(buffer.width() == ::renderer::DEFAULT_OCCLUSION_WIDTH);
+    REQUIRE(buffer.height() == ::renderer::DEFAULT_OCCLUSION_HEIGHT);
+
+    auto check_wall = [&]() {
+        buffer.Begin(*camera);
+        AddWall(buffer, 2.0F);
+        buffer.Rasterize();
+        REQUIRE(buffer.stats().num_occluders == 1);
+        REQUIRE(buffer.stats().num_triangles == 2);
+        // The center of the view is covered by the wall, the corners aren't
+        REQUIRE(buffer.depth_bound(buffer.width() / 2, buffer.height() / 2) <
+                1.0F);
+        REQUIRE(buffer.depth_bound(0, 0) == Approx(1.0F));
+
+        REQUIRE_FALSE(buffer.TestBox(UnitBox(Vec3(-5.0F, 0.0F, 0.0F))));
+        REQUIRE_FALSE(buffer.TestBox(UnitBox(Vec3(-1.0F, 1.0F, -1.0F))));
+        // In front of the wall, peeking out from behind it, and to its side
+        REQUIRE(buffer.TestBox(UnitBox(Vec3(5.0F, 0.0F, 0.0F))));
+        REQUIRE(buffer.TestBox(UnitBox(Vec3(-5.0F, 3.0F, 0.0F))));
+        REQUIRE(buffer.TestBox(UnitBox(Vec3(-5.0F, 4.0F, 0.0F))));
+        // Crossing the near plane
+        REQUIRE(buffer.TestBox(UnitBox(Vec3(10.0F, 0.0F, 0.0F))));
+    };
+
+    SECTION("Standard depth range") { check_wall(); }
+
+    SECTION("Reversed depth range") {
+        camera->data.reverse_z = true;
+        check_wall();
+    }
+
+    SECTION("Batches of bounds") {
+        buffer.Begin(*camera);
+        AddWall(buffer, 2.0F);
+        buffer.Rasterize();
+
+        ::renderer::BoundsArray bounds;
+        bounds.Resize(4);
+        bounds.Set(0, UnitBox(Vec3(-5.0F, 0.0F, 0.0F)));
+        bounds.Set(1, UnitBox(Vec3(5.0F, 0.0F, 0.0F)));
+        bounds.Set(2, UnitBox(Vec3(-3.0F, 0.0F, 0.5F)));
+        std::vector<uint8_t> visible = {1, 1, 0, 1};
+        REQUIRE(buffer.TestBounds(bounds, visible.data()) == 1);
+        // Already culled and unused entries are left as they are
+        REQUIRE(visible == std::vector<uint8_t>{0, 1, 0, 1});
+        REQUIRE(buffer.stats().num_tested == 2);
+        REQUIRE(buffer.stats().num_occluded == 1);
+    }
+}
+
+TEST_CASE("Occluders crossing the near plane (occlusion_t)", "[occlusion_t]") {
+    auto camera = CreateCamera();
+    ::renderer::OcclusionBuffer buffer;
+    buffer.Begin(*camera);
+
+    // Floor under the camera, reaching behind it
+    const std::array<float, 12> POSITIONS = {
+        -50.0F, -50.0F, -1.0F, 50.0F,  -50.0F, -1.0F,
+        50.0F,  50.0F,  -1.0F, -50.0F, 50.0F,  -1.0F};
+    const std::array<uint32_t, 6> INDICES = {0, 1, 2, 0, 2, 3};
+    buffer.AddOccluder(Mat4::Identity(), POSITIONS.data(), 4, INDICES.data(),
+                       INDICES.size());
+    buffer.Rasterize();
+
+    REQUIRE(buffer.stats().num_triangles >= 2);
+    REQUIRE_FALSE(buffer.TestBox(UnitBox(Vec3(-5.0F, 0.0F, -3.0F))));
+    REQUIRE(buffer.TestBox(UnitBox(Vec3(-5.0F, 0.0F, 0.0F))));
+}
+
+TEST_CASE("Parallel rasterization of occluders (occlusion_t)",
+          "[occlusion_t]") {
+    auto camera = CreateCamera();
+    ::renderer::OcclusionBuffer serial;
+    ::renderer::OcclusionBuffer parallel;
+    ::renderer::ThreadPool pool(3);
+
+    // A few overlapping walls at different depths and heights
+    for (auto* buffer : {&serial, &parallel}) {
+        buffer->Begin(*camera);
+        for (int i = 0; i < 8; ++i) {
+            const auto OFFSET = static_cast<float>(i);
+            std::array<float, 12> positions = {
+                -OFFSET, -3.0F + OFFSET, -2.0F, -OFFSET, -1.0F + OFFSET, -2.0F,
+                -OFFSET, -1.0F + OFFSET, 2.0F,  -OFFSET, -3.0F + OFFSET, 2.0F};
+            const std::array<uint32_t, 6> INDICES = {0, 1, 2, 0, 2, 3};
+            buffer->AddOccluder(Mat4::Identity(), positions.data(), 4,
+                                INDICES.data(), INDICES.size());
+        }
+    }
+    serial.Rasterize();
+    parallel.Rasterize(&pool);
+
+    for (uint32_t y = 0; y < serial.height(); ++y) {
+        for (uint32_t x = 0; x < serial.width(); ++x) {
+            REQUIRE(serial.depth_bound(x, y) == parallel.depth_bound(x, y));
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <renderer/engine/range_allocator_t.hpp>
+
+TEST_CASE("Range suballocation (range_allocator_t)", "[range_allocator_t]") {
+    ::renderer::RangeAllocator allocator(100);
+    REQUIRE(allocator.size() == 100);
+    REQUIRE(allocator.num_free() == 100);
+
+    const auto A = allocator.Allocate(30);
+    const auto B = allocator.Allocate(30);
+    const auto C = allocator.Allocate(30);
+    REQUIRE(A == 0);
+    REQUIRE(B == 30);
+    REQUIRE(C == 60);
+    REQUIRE(allocator.num_free() == 10);
+    REQUIRE(allocator.Allocate(20) == ::renderer::INVALID_RANGE);
+
+    SECTION("Released ranges are reused, first fit") {
+        allocator.Free(B, 30);
+        REQUIRE(allocator.num_free_ranges() == 2);
+        REQUIRE(allocator.Allocate(20) == B);
+        REQUIRE(allocator.Allocate(10) == B + 20);
+        REQUIRE(allocator.largest_free_range() == 10);
+    }
+
+    SECTION("Neighbouring free ranges get merged") {
+        allocator.Free(A, 30);
+        allocator.Free(C, 30);
+        REQUIRE(allocator.num_free_ranges() == 2);
+        allocator.Free(B, 30);
+        REQUIRE(allocator.num_free_ranges() == 1);
+        REQUIRE(allocator.num_free() == 100);
+        REQUIRE(allocator.Allocate(100) == 0);
+    }
+
+    SECTION("Invalid releases are ignored") {
+        allocator.Free(B, 30);
+        allocator.Free(B + 10, 5);
+        allocator.Free(95, 10);
+        REQUIRE(allocator.num_free() == 40);
+    }
+
+    SECTION("Growing adds room at the end") {
+        allocator.Grow(200);
+        REQUIRE(allocator.size() == 200);
+        REQUIRE(allocator.num_free() == 110);
+        // The tail merges with the free range already at the end
+        REQUIRE(allocator.num_free_ranges() == 1);
+        REQUIRE(allocator.Allocate(110) == 90);
+    }
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/graphics/geometry_t.hpp>
+#include <renderer/engine/graphics/triangle_bvh_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+#include "test_helpers.hpp"
+
+namespace {
+using ::test::CreateUnitCube;
+}  // namespace
+
+TEST_CASE("Triangle BVH of a geometry (triangle_bvh_t)", "[triangle_bvh_t]") {
+    auto geometry = CreateUnitCube();
+    const auto& bvh = geometry->triangle_bvh();
+    REQUIRE(bvh.num_triangles() == 12);
+    REQUIRE(&bvh == &geometry->triangle_bvh());
+
+    float distance = 0.0F;
+    uint32_t triangle = ::renderer::INVALID_TRIANGLE;
+    ::renderer::Ray ray{Vec3(0.0F, 0.0F, 5.0F), Vec3(0.0F, 0.0F, -1.0F)};
+    REQUIRE(bvh.Intersect(ray, 100.0F, distance, triangle));
+    REQUIRE(distance == Approx(4.5F));
+    REQUIRE((triangle == 2 || triangle == 3));  // triangles of the +z face
+
+    // Too short, and pointing away from the cube
+    REQUIRE_FALSE(bvh.Intersect(ray, 4.0F, distance, triangle));
+    ray.direction = Vec3(0.0F, 0.0F, 1.0F);
+    REQUIRE_FALSE(bvh.Intersect(ray, 100.0F, distance, triangle));
+}
+
+TEST_CASE("Ray casts against a scene (scene_t)", "[scene_t]") {
+    auto geometry = CreateUnitCube();
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto near_box = std::make_shared<::renderer::Mesh>(
+        "near_box", geometry, Pose(Vec3(0.0F, 0.0F, 0.0F), Quat()));
+    auto far_box = std::make_shared<::renderer::Mesh>(
+        "far_box", geometry, Pose(Vec3(-4.0F, 0.0F, 0.0F), Quat()));
+    // Rotated 45 degrees around z, so its corner points towards +x
+    const float HALF_ANGLE = 0.25F * PI * 0.5F;
+    auto side_box = std::make_shared<::renderer::Mesh>(
+        "side_box", geometry,
+        Pose(Vec3(0.0F, 5.0F, 0.0F),
+             Quat(std::cos(HALF_ANGLE), 0.0F, 0.0F, std::sin(HALF_ANGLE))));
+    scene->AddChild(near_box);
+    scene->AddChild(far_box);
+    scene->AddChild(side_box);
+    scene->UpdateWorldTransforms();
+
+    SECTION("Closest hit along the ray") {
+        auto hit = scene->Raycast(Vec3(10.0F, 0.0F, 0.0F),
+                                  Vec3(-2.0F, 0.0F, 0.0F));
+        REQUIRE(hit.hit());
+        REQUIRE(hit.object == near_box.get());
+        REQUIRE(hit.distance == Approx(9.5F));
+        REQUIRE(hit.point.x() == Approx(0.5F));
+        REQUIRE(hit.triangle != ::renderer::INVALID_TRIANGLE);
+
+        // Starting in between both boxes, looking at the far one
+        hit = scene->Raycast(Vec3(-2.0F, 0.0F, 0.0F), Vec3(-1.0F, 0.0F, 0.0F));
+        REQUIRE(hit.object == far_box.get());
+        REQUIRE(hit.distance == Approx(1.5F));
+
+        hit = scene->Raycast(Vec3(10.0F, 0.0F, 0.0F), Vec3(-1.0F, 0.0F, 0.0F),
+                             5.0F);
+        REQUIRE_FALSE(hit.hit());
+        hit = scene->Raycast(Vec3(10.0F, 2.0F, 0.0F), Vec3(-1.0F, 0.0F, 0.0F));
+        REQUIRE_FALSE(hit.hit());
+    }
+
+    SECTION("Ray is brought into the frame of the mesh") {
+        auto hit = scene->Raycast(Vec3(10.0F, 5.0F, 0.0F),
+                                  Vec3(-1.0F, 0.0F, 0.0F));
+        REQUIRE(hit.object == side_box.get());
+        REQUIRE(hit.distance == Approx(10.0F - 0.5F * std::sqrt(2.0F)));
+
+        // Misses the rotated box, but would've hit it if it wasn't rotated
+        hit = scene->Raycast(Vec3(10.0F, 5.45F, 0.0F),
+                             Vec3(-1.0F, 0.0F, 0.0F), 9.6F);
+        REQUIRE_FALSE(hit.hit());
+    }
+
+    SECTION("Objects removed from the scene are not hit") {
+        scene->RemoveChild("near_box");
+        auto hit = scene->Raycast(Vec3(10.0F, 0.0F, 0.0F),
+                                  Vec3(-1.0F, 0.0F, 0.0F));
+        REQUIRE(hit.object == far_box.get());
+    }
+
+    SECTION("Batches of rays match single queries") {
+        std::vector<::renderer::Ray> rays;
+        for (int i = 0; i < 300; ++i) {
+            const auto OFFSET = 0.05F * static_cast<float>(i) - 2.0F;
+            rays.push_back({Vec3(10.0F, OFFSET, 0.1F * OFFSET),
+                            Vec3(-1.0F, 0.0F, 0.0F)});
+        }
+        ::renderer::ThreadPool pool(4);
+        std::vector<::renderer::RaycastHit> hits(rays.size());
+        scene->RaycastBatch(rays.data(), rays.size(), hits.data(), 100.0F,
+                            &pool);
+        size_t num_hits = 0;
+        for (size_t i = 0; i < rays.size(); ++i) {
+            const auto EXPECTED = scene->Raycast(rays[i], 100.0F);
+            REQUIRE(hits[i].object == EXPECTED.object);
+            REQUIRE(hits[i].triangle == EXPECTED.triangle);
+            num_hits += hits[i].hit() ? 1 : 0;
+        }
+        REQUIRE(num_hits > 0);
+        REQUIRE(num_hits < rays.size());
+    }
+}
+
+TEST_CASE("Rays through points of the viewport (camera_t)", "[camera_t]") {
+    auto geometry = CreateUnitCube();
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto box = std::make_shared<::renderer::Mesh>(
+        "picked_box", geometry, Pose(Vec3(0.0F, 0.0F, 0.0F), Quat()));
+    scene->AddChild(box);
+    scene->UpdateWorldTransforms();
+
+    auto camera = std::make_shared<::renderer::Camera>("picking_camera");
+    camera->SetPosition(Vec3(10.0F, 0.0F, 0.0F));
+    camera->LookAt(Vec3(0.0F, 0.0F, 0.0F));
+
+    const auto CENTER_RAY = camera->ScreenPointToRay(0.5F, 0.5F);
+    REQUIRE(CENTER_RAY.direction.x() == Approx(-1.0F));
+    REQUIRE(scene->Raycast(CENTER_RAY).object == box.get());
+    REQUIRE_FALSE(scene->Raycast(camera->ScreenPointToRay(0.0F, 0.0F)).hit());
+
+    // Rays through the corners lie on the side planes of the frustum
+    const auto FRUSTUM = camera->ComputeFrustum();
+    const auto CORNER_RAY = camera->ScreenPointToRay(1.0F, 0.0F);
+    const auto POINT = CORNER_RAY.At(20.0F);
+    float min_distance = std::numeric_limits<float>::max();
+    for (const auto& plane : FRUSTUM.planes) {
+        min_distance = std::min(min_distance, std::abs(plane.Distance(POINT)));
+    }
+    REQUIRE(min_distance == Approx(0.0F).margin(1e-3));
+}
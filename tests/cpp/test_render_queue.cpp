@@ -0,0 +1,130 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <renderer/engine/render_queue_t.hpp>
+
+TEST_CASE("Render keys (render_queue_t)", "[render_queue_t]") {
+    using ::renderer::eRenderPass;
+    using ::renderer::RenderKeyFields;
+
+    SECTION("Fields round-trip through the key") {
+        for (bool translucent : {false, true}) {
+            RenderKeyFields fields;
+            fields.pass = eRenderPass::OVERLAY;
+            fields.translucent = translucent;
+            fields.program = 7;
+            fields.material = 1234;
+            fields.vao = 42;
+            fields.depth = 98765;
+            const auto DECODED =
+                ::renderer::DecodeRenderKey(::renderer::MakeRenderKey(fields));
+            REQUIRE(DECODED.pass == fields.pass);
+            REQUIRE(DECODED.translucent == fields.translucent);
+            REQUIRE(DECODED.program == fields.program);
+            REQUIRE(DECODED.material == fields.material);
+            REQUIRE(DECODED.vao == fields.vao);
+            REQUIRE(DECODED.depth == fields.depth);
+        }
+    }
+
+    SECTION("Keys order passes, translucency, state and depth") {
+        RenderKeyFields near_opaque;
+        near_opaque.program = 1;
+        near_opaque.depth = 10;
+        auto far_opaque = near_opaque;
+        far_opaque.depth = 1000;
+        auto other_program = near_opaque;
+        other_program.program = 2;
+        other_program.depth = 0;
+        auto near_translucent = near_opaque;
+        near_translucent.translucent = true;
+        near_translucent.program = 0;
+        auto far_translucent = near_translucent;
+        far_translucent.depth = 1000;
+        auto overlay = near_opaque;
+        overlay.pass = eRenderPass::OVERLAY;
+
+        using ::renderer::MakeRenderKey;
+        // Opaque draws are grouped by state, and front-to-back within a group
+        REQUIRE(MakeRenderKey(near_opaque) < MakeRenderKey(far_opaque));
+        REQUIRE(MakeRenderKey(far_opaque) < MakeRenderKey(other_program));
+        // Translucent draws go after the opaque ones, and back-to-front
+        REQUIRE(MakeRenderKey(other_program) < MakeRenderKey(far_translucent));
+        REQUIRE(MakeRenderKey(far_translucent) <
+                MakeRenderKey(near_translucent));
+        REQUIRE(MakeRenderKey(near_translucent) < MakeRenderKey(overlay));
+    }
+
+    SECTION("Depth buckets cover the view range") {
+        using ::renderer::ComputeDepthBucket;
+        REQUIRE(ComputeDepthBucket(0.1F, 0.1F, 100.0F) == 0);
+        REQUIRE(ComputeDepthBucket(-5.0F, 0.1F, 100.0F) == 0);
+        REQUIRE(ComputeDepthBucket(100.0F, 0.1F, 100.0F) ==
+                ::renderer::MAX_DEPTH_BUCKET);
+        REQUIRE(ComputeDepthBucket(500.0F, 0.1F, 100.0F) ==
+                ::renderer::MAX_DEPTH_BUCKET);
+        REQUIRE(ComputeDepthBucket(10.0F, 0.1F, 100.0F) <
+                ComputeDepthBucket(20.0F, 0.1F, 100.0F));
+    }
+}
+
+TEST_CASE("Render queue sorting (render_queue_t)", "[render_queue_t]") {
+    constexpr uint32_t NUM_DRAWS = 5000;
+    std::mt19937 rng(1234);  // NOLINT
+    std::uniform_int_distribution<uint32_t> program_dist(0, 3);
+    std::uniform_int_distribution<uint32_t> id_dist(0, 50);
+    std::uniform_int_distribution<uint32_t> depth_dist(
+        0, ::renderer::MAX_DEPTH_BUCKET);
+    std::bernoulli_distribution translucent_dist(0.1);
+
+    ::renderer::RenderQueue queue;
+    std::vector<uint64_t> keys;
+    for (uint32_t i = 0; i < NUM_DRAWS; ++i) {
+        ::renderer::RenderKeyFields fields;
+        fields.translucent = translucent_dist(rng);
+        fields.program = program_dist(rng);
+        fields.material = id_dist(rng);
+        fields.vao = id_dist(rng);
+        fields.depth = depth_dist(rng);
+        keys.push_back(::renderer::MakeRenderKey(fields));
+        queue.Push(keys.back(), i);
+    }
+    const auto UNSORTED_CHANGES = queue.CountStateChanges();
+
+    queue.Sort();
+    REQUIRE(queue.size() == NUM_DRAWS);
+    std::sort(keys.begin(), keys.end());
+    for (uint32_t i = 0; i < NUM_DRAWS; ++i) {
+        REQUIRE(queue.entries()[i].key == keys[i]);
+    }
+    // Sorting is stable, so equal keys keep their order
+    for (uint32_t i = 1; i < NUM_DRAWS; ++i) {
+        const auto& previous = queue.entries()[i - 1];
+        const auto& current = queue.entries()[i];
+        if (previous.key == current.key) {
+            REQUIRE(previous.index < current.index);
+        }
+    }
+
+    // Grouping opaque draws by state saves most of the switches
+    const auto SORTED_CHANGES = queue.CountStateChanges();
+    REQUIRE(SORTED_CHANGES.num_program_changes * 10 <
+            UNSORTED_CHANGES.num_program_changes);
+    REQUIRE(SORTED_CHANGES.num_material_changes * 2 <
+            UNSORTED_CHANGES.num_material_changes);
+
+    SECTION("Keys sharing their high digits are sorted as well") {
+        queue.Clear();
+        for (uint32_t i = 0; i < 100; ++i) {
+            queue.Push(static_cast<uint64_t>((i * 37) % 100), i);
+        }
+        queue.Sort();
+        for (uint32_t i = 0; i < 100; ++i) {
+            REQUIRE(queue.entries()[i].key == i);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <renderer/engine/name_table_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/slot_map_t.hpp>
+
+TEST_CASE("SlotMap container (slot_map_t)", "[slot_map_t]") {
+    ::renderer::SlotMap<int> slot_map;
+    auto handle_a = slot_map.Insert(1);
+    auto handle_b = slot_map.Insert(2);
+    auto handle_c = slot_map.Insert(3);
+    REQUIRE(slot_map.size() == 3);
+
+    SECTION("Removal keeps the remaining handles valid") {
+        REQUIRE(slot_map.Remove(handle_a));
+        REQUIRE_FALSE(slot_map.Contains(handle_a));
+        REQUIRE(slot_map.Get(handle_a) == nullptr);
+        REQUIRE(*slot_map.Get(handle_b) == 2);
+        REQUIRE(*slot_map.Get(handle_c) == 3);
+        REQUIRE(slot_map.size() == 2);
+    }
+
+    SECTION("Reused slots don't resolve stale handles") {
+        REQUIRE(slot_map.Remove(handle_b));
+        auto handle_d = slot_map.Insert(4);
+        REQUIRE(handle_d.index == handle_b.index);
+        REQUIRE(handle_d.generation != handle_b.generation);
+        REQUIRE_FALSE(slot_map.Contains(handle_b));
+        REQUIRE(*slot_map.Get(handle_d) == 4);
+        REQUIRE_FALSE(slot_map.Remove(handle_b));
+    }
+
+    SECTION("Handles can be packed into 64-bit integers") {
+        auto packed = handle_c.ToUint64();
+        REQUIRE(::renderer::SlotHandle::FromUint64(packed) == handle_c);
+    }
+}
+
+TEST_CASE("NameTable interning (name_table_t)", "[name_table_t]") {
+    auto name_id = ::renderer::NameTable::Intern("test_name_table");
+    REQUIRE(::renderer::NameTable::Intern("test_name_table") == name_id);
+    REQUIRE(::renderer::NameTable::Find("test_name_table") == name_id);
+    REQUIRE(::renderer::NameTable::GetString(name_id) == "test_name_table");
+    REQUIRE(::renderer::NameTable::Find("test_not_interned") ==
+            ::renderer::INVALID_NAME_ID);
+}
+
+TEST_CASE("Scene container (scene_t)", "[scene_t]") {
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto handle_a = scene->CreateObject("obj_a", Vec3(1.0F, 0.0F, 0.0F));
+    auto handle_b = scene->CreateObject("obj_b");
+    scene->AddChild(std::make_shared<::renderer::Object3D>("obj_c"));
+    auto handle_c = scene->GetHandle("obj_c");
+    REQUIRE(handle_a.valid());
+    REQUIRE(handle_c.valid());
+    REQUIRE(scene->num_objects() == 3);
+
+    SECTION("Lookups by name and by handle agree") {
+        REQUIRE(scene->GetChild("obj_a") == scene->GetChild(handle_a));
+        REQUIRE(scene->GetChild(handle_b)->name() == "obj_b");
+        REQUIRE(scene->GetChild(handle_a)->parent.lock() == scene);
+        auto name_id = ::renderer::NameTable::Find("obj_c");
+        REQUIRE(scene->GetChild(name_id) == scene->GetChild(handle_c));
+        REQUIRE((*scene)["obj_c"] == scene->GetChild(handle_c));
+        // Names given as views need no terminator, nor a temporary string
+        const std::string_view PATH = "obj_b/link_0";
+        REQUIRE(scene->ExistsChild(PATH.substr(0, 5)));
+        REQUIRE(scene->GetHandle(PATH.substr(0, 5)) == handle_b);
+        REQUIRE_FALSE(scene->ExistsChild(PATH));
+    }
+
+    SECTION("Duplicates are rejected") {
+        auto handle_dup = scene->CreateObject("obj_a");
+        REQUIRE_FALSE(handle_dup.valid());
+        REQUIRE(scene->num_objects() == 3);
+    }
+
+    SECTION("Removal keeps other handles and names valid") {
+        scene->RemoveChild(handle_a);
+        REQUIRE_FALSE(scene->ExistsChild(handle_a));
+        REQUIRE_FALSE(scene->ExistsChild("obj_a"));
+        REQUIRE(scene->GetChild(handle_a) == nullptr);
+        REQUIRE(scene->GetChild(handle_c)->name() == "obj_c");
+        REQUIRE(scene->GetChild("obj_b") == scene->GetChild(handle_b));
+        REQUIRE(scene->children().size() == 2);
+
+        scene->RemoveChild("obj_c");
+        REQUIRE(scene->children().size() == 1);
+        REQUIRE(scene->children()[0]->name() == "obj_b");
+    }
+
+    SECTION("Lights are kept in the order they were added") {
+        auto sun = std::make_shared<::renderer::DirectionalLight>(
+            Vec3(0.0F, 0.0F, -1.0F));
+        auto bulb = std::make_shared<::renderer::PointLight>(
+            Vec3(0.0F, 0.0F, 2.0F));
+        scene->AddLight(sun);
+        scene->AddLight(bulb);
+        scene->AddLight(sun);
+        REQUIRE(scene->lights().size() == 2);
+        REQUIRE(scene->lights()[0] == sun);
+        REQUIRE(scene->lights()[1]->type == ::renderer::eLightType::POINT);
+
+        scene->RemoveLight(sun);
+        REQUIRE(scene->lights().size() == 1);
+        REQUIRE(scene->lights()[0] == bulb);
+    }
+}
+
+TEST_CASE("Bulk pose APIs (scene_t)", "[scene_t]") {
+    constexpr size_t NUM_OBJECTS = 100;
+    std::vector<float> positions(3 * NUM_OBJECTS);
+    std::vector<float> quats(4 * NUM_OBJECTS, 0.0F);
+    for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+        positions[3 * i + 0] = static_cast<float>(i);
+        quats[4 * i + 0] = 1.0F;
+    }
+
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto handles = scene->CreateObjects("bulk_", NUM_OBJECTS, positions.data(),
+                                        quats.data());
+    REQUIRE(handles.size() == NUM_OBJECTS);
+    REQUIRE(scene->num_objects() == NUM_OBJECTS);
+    REQUIRE(scene->GetHandle("bulk_42") == handles[42]);
+    REQUIRE(scene->GetChild(handles[42])->pose().position.x() == 42.0F);
+
+    // Names are taken, so creating them again fails for every object
+    auto duplicates =
+        scene->CreateObjects("bulk_", 2, positions.data(), nullptr);
+    REQUIRE_FALSE(duplicates[0].valid());
+    REQUIRE_FALSE(duplicates[1].valid());
+
+    for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+        positions[3 * i + 1] = 2.0F * static_cast<float>(i);
+        // Half turn around the z-axis
+        quats[4 * i + 0] = 0.0F;
+        quats[4 * i + 3] = 1.0F;
+    }
+    scene->RemoveChild(handles[7]);
+    REQUIRE(scene->SetPoses(handles.data(), NUM_OBJECTS, positions.data(),
+                            quats.data()) == NUM_OBJECTS - 1);
+    scene->UpdateWorldTransforms();
+    const auto& world = scene->GetChild(handles[10])->world_transform();
+    REQUIRE(world(1, 3) == 20.0F);
+    REQUIRE(world(0, 0) == Approx(-1.0F));
+
+    std::vector<float> out_positions(3 * NUM_OBJECTS, -1.0F);
+    std::vector<float> out_quats(4 * NUM_OBJECTS, -1.0F);
+    REQUIRE(scene->GetPoses(handles.data(), NUM_OBJECTS, out_positions.data(),
+                            out_quats.data()) == NUM_OBJECTS - 1);
+    REQUIRE(out_positions[3 * 10 + 1] == 20.0F);
+    REQUIRE(out_quats[4 * 10 + 3] == 1.0F);
+    REQUIRE(out_positions[3 * 7] == -1.0F);
+}
@@ -0,0 +1,286 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <renderer/engine/camera_t.hpp>
+#include <renderer/engine/draw_list_t.hpp>
+#include <renderer/engine/graphics/geometry_factory_t.hpp>
+#include <renderer/engine/mesh_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/shadows_t.hpp>
+
+#include "test_helpers.hpp"
+
+namespace {
+using ::test::UnitBox;
+
+// Directional light coming from above, slightly tilted
+const Vec3 LIGHT_DIRECTION(-0.3F, -1.0F, -0.2F);
+
+auto CreateCamera() -> ::renderer::Camera::ptr {
+    auto camera = std::make_shared<::renderer::Camera>("shadows_camera");
+    camera->SetPosition(Vec3(0.0F, 5.0F, 20.0F));
+    camera->LookAt(Vec3(0.0F, 0.0F, 0.0F));
+    return camera;
+}
+
+auto ComputeCascades(const ::renderer::Camera& camera,
+                     const ::renderer::ShadowSettings& settings)
+    -> std::vector<::renderer::ShadowCascade> {
+    const auto SPLITS = ::renderer::ComputeCascadeSplits(
+        camera.data.near, settings.max_distance, settings.num_cascades,
+        settings.split_lambda);
+    std::vector<::renderer::ShadowCascade> cascades;
+    for (uint32_t i = 0; i < settings.num_cascades; ++i) {
+        cascades.push_back(::renderer::ComputeShadowCascade(
+            camera, LIGHT_DIRECTION, SPLITS.at(i), SPLITS.at(i + 1),
+            settings));
+    }
+    return cascades;
+}
+
+// Returns whether or not the given point lands inside of the map
+auto InsideMap(const ::renderer::ShadowCascade& cascade, const Vec3& point)
+    -> bool {
+    const auto CLIP = cascade.view_proj() *
+                      Vec4(point.x(), point.y(), point.z(), 1.0F);
+    return std::abs(CLIP.x() / CLIP.w()) <= 1.0F &&
+           std::abs(CLIP.y() / CLIP.w()) <= 1.0F &&
+           std::abs(CLIP.z() / CLIP.w()) <= 1.0F;
+}
+}  // namespace
+
+TEST_CASE("Splits of the cascades (shadows_t)", "[shadows_t]") {
+    const auto SPLITS =
+        ::renderer::ComputeCascadeSplits(0.1F, 100.0F, 4, 0.75F);
+    REQUIRE(SPLITS[0] == Approx(0.1F));
+    REQUIRE(SPLITS[4] == Approx(100.0F));
+    for (size_t i = 1; i < SPLITS.size(); ++i) {
+        REQUIRE(SPLITS.at(i) > SPLITS.at(i - 1));
+    }
+
+    // Uniform splits without the logarithmic part
+    const auto UNIFORM = ::renderer::ComputeCascadeSplits(1.0F, 4.0F, 3, 0.0F);
+    REQUIRE(UNIFORM[1] == Approx(2.0F));
+    REQUIRE(UNIFORM[2] == Approx(3.0F));
+    REQUIRE(UNIFORM[3] == Approx(4.0F));
+    // Entries past the last cascade stay at the far distance
+    REQUIRE(UNIFORM[4] == Approx(4.0F));
+}
+
+TEST_CASE("Stability of the cascades (shadows_t)", "[shadows_t]") {
+    auto camera = CreateCamera();
+    ::renderer::ShadowSettings settings;
+    settings.num_cascades = 3;
+    settings.max_distance = 50.0F;
+    settings.resolution = 1024;
+    const auto CASCADES = ComputeCascades(*camera, settings);
+
+    // The view of each slice lands inside of its map
+    for (const auto& cascade : CASCADES) {
+        for (const auto DISTANCE : {cascade.split_near, cascade.split_far}) {
+            const auto POINT =
+                camera->pose().position - DISTANCE * camera->v_front;
+            REQUIRE(InsideMap(cascade, POINT));
+        }
+    }
+
+    SECTION("Small moves of the camera keep the volumes") {
+        camera->SetPosition(Vec3(0.01F, 5.0F, 20.0F));
+        const auto MOVED = ComputeCascades(*camera, settings);
+        for (size_t i = 0; i < CASCADES.size(); ++i) {
+            REQUIRE(MOVED[i].SameVolume(CASCADES[i]));
+        }
+    }
+
+    SECTION("Large moves of the camera snap to other volumes") {
+        camera->SetPosition(Vec3(30.0F, 5.0F, 20.0F));
+        const auto MOVED = ComputeCascades(*camera, settings);
+        for (size_t i = 0; i < CASCADES.size(); ++i) {
+            REQUIRE_FALSE(MOVED[i].SameVolume(CASCADES[i]));
+            REQUIRE(MOVED[i].half_size == CASCADES[i].half_size);
+        }
+    }
+
+    SECTION("Rotations of the camera keep the sizes") {
+        camera->LookAt(Vec3(10.0F, -3.0F, 0.0F));
+        const auto ROTATED = ComputeCascades(*camera, settings);
+        for (size_t i = 0; i < CASCADES.size(); ++i) {
+            REQUIRE(ROTATED[i].half_size == CASCADES[i].half_size);
+            REQUIRE(ROTATED[i].texel_size == CASCADES[i].texel_size);
+        }
+    }
+}
+
+TEST_CASE("Casters overlapping a cascade (shadows_t)", "[shadows_t]") {
+    auto camera = CreateCamera();
+    ::renderer::ShadowSettings settings;
+    settings.num_cascades = 1;
+    settings.max_distance = 30.0F;
+    settings.caster_distance = 20.0F;
+    const auto CASCADE = ComputeCascades(*camera, settings)[0];
+    const auto& center = CASCADE.center;
+    const auto& front = CASCADE.front;
+
+    REQUIRE(CASCADE.Overlaps(UnitBox(center)));
+    REQUIRE_FALSE(CASCADE.Overlaps(::renderer::AABB()));
+    // Across the light direction, only within the map
+    const auto ACROSS = CASCADE.half_size + 1.0F;
+    REQUIRE_FALSE(CASCADE.Overlaps(UnitBox(center + ACROSS * CASCADE.right)));
+    REQUIRE_FALSE(CASCADE.Overlaps(UnitBox(center - ACROSS * CASCADE.up)));
+    // Towards the light, up to the caster distance past the volume
+    const auto TOWARDS = CASCADE.half_depth + CASCADE.caster_distance;
+    REQUIRE(CASCADE.Overlaps(UnitBox(center + (TOWARDS - 1.0F) * front)));
+    REQUIRE_FALSE(CASCADE.Overlaps(UnitBox(center + (TOWARDS + 1.0F) * front)));
+    // Away from the light, only within the volume
+    const auto AWAY = CASCADE.half_depth + 1.0F;
+    REQUIRE_FALSE(CASCADE.Overlaps(UnitBox(center - AWAY * front)));
+}
+
+TEST_CASE("Cache of the static casters (shadows_t)", "[shadows_t]") {
+    ::renderer::Geometry::ptr box = ::renderer::CreateBox(1.0F, 1.0F, 1.0F);
+    auto scene = std::make_shared<::renderer::Scene>();
+    auto near_static = std::make_shared<::renderer::Mesh>(
+        "near_static", box, Pose(Vec3(0.0F, 0.0F, 0.0F), Quat()));
+    auto far_static = std::make_shared<::renderer::Mesh>(
+        "far_static", box, Pose(Vec3(500.0F, 0.0F, 0.0F), Quat()));
+    auto dynamic = std::make_shared<::renderer::Mesh>(
+        "dynamic", box, Pose(Vec3(2.0F, 0.0F, 0.0F), Quat()));
+    near_static->SetStatic(true);
+    far_static->SetStatic(true);
+    scene->AddChild(near_static);
+    scene->AddChild(far_static);
+    scene->AddChild(dynamic);
+
+    auto camera = CreateCamera();
+    ::renderer::ShadowSettings settings;
+    settings.num_cascades = 2;
+    settings.max_distance = 50.0F;
+    settings.resolution = 1024;
+
+    ::renderer::DrawList draw_list;
+    ::renderer::ShadowCache cache;
+    auto cascades = ComputeCascades(*camera, settings);
+    // Brings the cache up to date, as the renderer does every frame
+    auto update = [&]() {
+        scene->UpdateWorldTransforms();
+        draw_list.Sync(*scene);
+        cache.SetCascades(ComputeCascades(*camera, settings));
+        cache.SyncCasters(draw_list);
+    };
+    // Flags all layers as redrawn
+    auto redraw = [&]() {
+        for (size_t i = 0; i < cache.cascades().size(); ++i) {
+            cache.MarkValid(i);
+        }
+    };
+    update();
+    REQUIRE(cache.num_static_casters() == 2);
+    REQUIRE(cache.dynamic_casters().size() == 1);
+    REQUIRE(cache.dynamic_casters()[0]->object == dynamic.get());
+    REQUIRE_FALSE(cache.valid(0));
+    redraw();
+    REQUIRE(cache.valid(0));
+    REQUIRE(cache.valid(1));
+
+    SECTION("Dynamic casters don't invalidate the layers") {
+        dynamic->SetPosition(Vec3(-2.0F, 0.0F, 0.0F));
+        update();
+        REQUIRE(cache.valid(0));
+        REQUIRE(cache.valid(1));
+    }
+
+    SECTION("Static casters invalidate the layers they overlap") {
+        const auto OLD_BOUNDS = near_static->world_bounds();
+        near_static->SetPosition(Vec3(1.0F, 0.0F, 0.0F));
+        update();
+        const auto NEW_BOUNDS = near_static->world_bounds();
+        bool any_invalid = false;
+        for (size_t i = 0; i < cascades.size(); ++i) {
+            const bool OVERLAPS = cascades[i].Overlaps(OLD_BOUNDS) ||
+                                  cascades[i].Overlaps(NEW_BOUNDS);
+            REQUIRE(cache.valid(i) == !OVERLAPS);
+            any_invalid = any_invalid || OVERLAPS;
+        }
+        REQUIRE(any_invalid);
+
+        // Far from every cascade, so nothing to redraw
+        redraw();
+        far_static->SetPosition(Vec3(500.0F, 1.0F, 0.0F));
+        update();
+        REQUIRE(cache.valid(0));
+        REQUIRE(cache.valid(1));
+    }
+
+    SECTION("Restated and removed static casters invalidate the layers") {
+        near_static->SetStatic(false);
+        update();
+        REQUIRE(cache.num_static_casters() == 1);
+        REQUIRE(cache.dynamic_casters().size() == 2);
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+
+        redraw();
+        near_static->SetStatic(true);
+        update();
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+
+        redraw();
+        scene->RemoveChild("near_static");
+        update();
+        REQUIRE(cache.num_static_casters() == 1);
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+    }
+
+    SECTION("Hidden and non-casting static casters invalidate the layers") {
+        near_static->SetVisible(false);
+        update();
+        REQUIRE(cache.num_static_casters() == 1);
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+
+        redraw();
+        near_static->SetVisible(true);
+        update();
+        REQUIRE(cache.num_static_casters() == 2);
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+
+        // Writes to the flag of the material get picked up without a call
+        auto material = std::make_shared<::renderer::Material>();
+        near_static->SetMaterial(material);
+        update();
+        redraw();
+        material->castShadows = false;
+        update();
+        REQUIRE(cache.num_static_casters() == 1);
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+
+        redraw();
+        material->castShadows = true;
+        update();
+        REQUIRE(cache.num_static_casters() == 2);
+        REQUIRE_FALSE((cache.valid(0) && cache.valid(1)));
+
+        // Hidden dynamic casters are left out of the list
+        redraw();
+        dynamic->SetVisible(false);
+        update();
+        REQUIRE(cache.dynamic_casters().empty());
+        REQUIRE(cache.valid(0));
+        REQUIRE(cache.valid(1));
+    }
+
+    SECTION("Moves of the camera invalidate the layers by whole steps") {
+        camera->SetPosition(Vec3(0.01F, 5.0F, 20.0F));
+        update();
+        REQUIRE(cache.valid(0));
+        REQUIRE(cache.valid(1));
+
+        camera->SetPosition(Vec3(30.0F, 5.0F, 20.0F));
+        update();
+        REQUIRE_FALSE(cache.valid(0));
+        REQUIRE_FALSE(cache.valid(1));
+        REQUIRE(cache.num_invalidations() >= 2);
+    }
+}
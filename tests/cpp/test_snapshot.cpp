@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <renderer/engine/scene_snapshot_t.hpp>
+#include <renderer/engine/scene_t.hpp>
+#include <renderer/engine/triple_buffer_t.hpp>
+
+TEST_CASE("Lock-free triple buffer (triple_buffer_t)", "[triple_buffer_t]") {
+    SECTION("Reader gets the latest published buffer") {
+        ::renderer::TripleBuffer<int> buffer;
+        REQUIRE_FALSE(buffer.Acquire());
+
+        buffer.back() = 1;
+        buffer.Publish();
+        buffer.back() = 2;
+        buffer.Publish();
+        REQUIRE(buffer.Acquire());
+        REQUIRE(buffer.front() == 2);
+        REQUIRE_FALSE(buffer.Acquire());
+        REQUIRE(buffer.front() == 2);
+
+        buffer.back() = 3;
+        buffer.Publish();
+        REQUIRE(buffer.Acquire());
+        REQUIRE(buffer.front() == 3);
+    }
+
+    SECTION("Concurrent writer and reader never see torn snapshots") {
+        constexpr uint64_t NUM_STEPS = 5000;
+        constexpr size_t NUM_OBJECTS = 64;
+        ::renderer::SnapshotBuffer buffer;
+        std::atomic<bool> done{false};
+
+        std::thread writer([&]() {
+            for (uint64_t step = 1; step <= NUM_STEPS; ++step) {
+                auto& snapshot = buffer.back();
+                snapshot.Clear();
+                snapshot.step = step;
+                const auto VALUE = static_cast<float>(step);
+                for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+                    snapshot.Add(::renderer::ObjectHandle{},
+                                 Pose(Vec3(VALUE, VALUE, VALUE), Quat()));
+                }
+                buffer.Publish();
+            }
+            done = true;
+        });
+
+        uint64_t last_step = 0;
+        size_t num_acquired = 0;
+        bool consistent = true;
+        while (true) {
+            const bool FINISHED = done;
+            if (!buffer.Acquire()) {
+                if (FINISHED) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            const auto& snapshot = buffer.front();
+            consistent = consistent && (snapshot.size() == NUM_OBJECTS) &&
+                         (snapshot.step > last_step);
+            const auto VALUE = static_cast<float>(snapshot.step);
+            for (const auto& pose : snapshot.poses) {
+                consistent = consistent && (pose.position.x() == VALUE);
+            }
+            last_step = snapshot.step;
+            ++num_acquired;
+        }
+        writer.join();
+
+        REQUIRE(consistent);
+        REQUIRE(num_acquired > 0);
+        REQUIRE(buffer.front().step == NUM_STEPS);
+    }
+}
+
+TEST_CASE("Applying snapshots to a scene (scene_t)", "[scene_t]") {
+    auto scene = std::make_shared<::renderer::Scene>();
+    std::vector<::renderer::ObjectHandle> handles;
+    for (size_t i = 0; i < 10; ++i) {
+        handles.push_back(scene->CreateObject(
+            ("snapshot_obj_" + std::to_string(i)).c_str()));
+    }
+    scene->UpdateWorldTransforms();
+
+    // Writer side (e.g. a physics thread)
+    auto& snapshot = scene->snapshots().back();
+    snapshot.Clear();
+    for (size_t i = 0; i < handles.size(); ++i) {
+        snapshot.Add(handles[i],
+                     Pose(Vec3(static_cast<float>(i), 0.0F, 0.0F), Quat()),
+                     i != 3);
+    }
+    // Stale handles are skipped
+    scene->RemoveChild(handles[9]);
+    scene->snapshots().Publish();
+
+    // Reader side (the render thread, at a frame boundary)
+    REQUIRE(scene->ApplyLatestSnapshot());
+    REQUIRE_FALSE(scene->ApplyLatestSnapshot());
+    scene->UpdateWorldTransforms();
+    for (size_t i = 0; i < 9; ++i) {
+        auto obj = scene->GetChild(handles[i]);
+        REQUIRE(obj->world_transform()(0, 3) == static_cast<float>(i));
+        REQUIRE(obj->visible() == (i != 3));
+    }
+}
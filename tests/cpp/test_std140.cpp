@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <renderer/engine/graphics/std140_writer_t.hpp>
+
+namespace {
+auto ReadFloat(const ::renderer::Std140Writer& writer, uint32_t offset)
+    -> float {
+    float value = 0.0F;
+    std::memcpy(&value, writer.data() + offset, sizeof(float));
+    return value;
+}
+}  // namespace
+
+TEST_CASE("Std140 member offsets (std140_writer_t)", "[std140_writer_t]") {
+    ::renderer::Std140Writer writer;
+
+    SECTION("Scalars and vectors are aligned to their base alignment") {
+        REQUIRE(writer.Write(1.0F) == 0);
+        REQUIRE(writer.Write(Vec2(2.0F, 3.0F)) == 8);
+        REQUIRE(writer.Write(Vec3(4.0F, 5.0F, 6.0F)) == 16);
+        // A scalar fits right after a vec3
+        REQUIRE(writer.Write(static_cast<int32_t>(7)) == 28);
+        REQUIRE(writer.Write(Vec4(8.0F, 9.0F, 10.0F, 11.0F)) == 32);
+        REQUIRE(writer.size() == 48);
+
+        REQUIRE(ReadFloat(writer, 8) == Approx(2.0F));
+        REQUIRE(ReadFloat(writer, 24) == Approx(6.0F));
+        REQUIRE(ReadFloat(writer, 44) == Approx(11.0F));
+    }
+
+    SECTION("Matrices are written as vec4 columns") {
+        writer.Write(1.0F);
+        Mat4 mat;
+        mat(0, 0) = 1.0F;
+        mat(0, 3) = 5.0F;
+        mat(2, 1) = 7.0F;
+        REQUIRE(writer.Write(mat) == 16);
+        REQUIRE(writer.size() == 16 + 64);
+        // Element (row, col) lands at column * 16 + row * 4
+        REQUIRE(ReadFloat(writer, 16 + 3 * 16 + 0 * 4) == Approx(5.0F));
+        REQUIRE(ReadFloat(writer, 16 + 1 * 16 + 2 * 4) == Approx(7.0F));
+        REQUIRE(ReadFloat(writer, 16 + 0 * 16 + 0 * 4) == Approx(1.0F));
+    }
+
+    SECTION("Structs are aligned and padded to 16 bytes") {
+        writer.Write(1.0F);
+        for (int32_t i = 0; i < 3; ++i) {
+            REQUIRE(writer.BeginStruct() ==
+                    static_cast<uint32_t>(16 + i * 32));
+            writer.Write(Vec3(1.0F, 2.0F, 3.0F));
+            writer.Write(i);
+            writer.Write(Vec2(4.0F, 5.0F));
+            writer.EndStruct();
+        }
+        REQUIRE(writer.size() == 16 + 3 * 32);
+        REQUIRE(writer.Write(2.0F) == 16 + 3 * 32);
+    }
+
+    SECTION("Clearing keeps no data") {
+        writer.Write(Vec4(1.0F, 2.0F, 3.0F, 4.0F));
+        writer.Clear();
+        REQUIRE(writer.size() == 0);
+        REQUIRE(writer.Write(1.0F) == 0);
+    }
+}
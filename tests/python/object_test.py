@@ -0,0 +1,33 @@
+import math3d as m3d
+import numpy as np
+
+import renderer as rdr
+
+
+def test_object_pose_setters() -> None:
+    scene = rdr.Scene()
+    obj = rdr.Object3D("pose_object")
+    scene.AddChild(obj)
+    scene.UpdateWorldTransforms()
+    assert obj.transform_dirty is False
+
+    # Setting the position through the pose goes through the object
+    obj.pose.position = m3d.Vec3(1.0, 2.0, 3.0)
+    assert np.allclose(obj.pose.position, [1.0, 2.0, 3.0])
+    assert obj.transform_dirty is True
+    scene.UpdateWorldTransforms()
+    assert obj.transform_dirty is False
+
+    orientation = obj.pose.orientation
+    obj.pose.orientation = orientation
+    assert obj.transform_dirty is True
+
+
+def test_object_pose_copy() -> None:
+    obj = rdr.Object3D("pose_object", m3d.Vec3(1.0, 0.0, 0.0))
+    pose = obj.pose.ToPose()
+    pose.position = m3d.Vec3(5.0, 0.0, 0.0)
+    # The copy is detached from the object, until set back
+    assert np.allclose(obj.pose.position, [1.0, 0.0, 0.0])
+    obj.pose = pose
+    assert np.allclose(obj.pose.position, [5.0, 0.0, 0.0])
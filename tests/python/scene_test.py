@@ -0,0 +1,22 @@
+import pytest
+
+import renderer as rdr
+
+
+def test_scene_lookups_by_name() -> None:
+    scene = rdr.Scene()
+    obj = rdr.Object3D("lookup_object")
+    scene.AddChild(obj)
+
+    assert scene.ExistsChild("lookup_object")
+    assert scene["lookup_object"] is not None
+    assert scene["lookup_object"].name == "lookup_object"
+    assert scene.GetChild("missing_object") is None
+
+
+def test_scene_lookups_reject_none() -> None:
+    scene = rdr.Scene()
+    with pytest.raises(TypeError):
+        scene[None]
+    with pytest.raises(TypeError):
+        scene.ExistsChild(None)